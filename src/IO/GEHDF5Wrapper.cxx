@@ -811,32 +811,20 @@ GEHDF5Wrapper::read_sinogram(Array<3, unsigned char>& output,
   // We know the size of the DataSpace
   hsize_t str_dimsf[3]{ m_NX_SUB, m_NY_SUB, m_NZ_SUB };
 
-  // get a temporary buffer here,
-  std::vector<unsigned char> aux_buffer(m_NX_SUB * m_NY_SUB * m_NZ_SUB);
-
-  m_dataspace.selectHyperslab(H5S_SELECT_SET, str_dimsf, offset.data());
-  H5::DataSpace memspace(3, str_dimsf);
-  m_dataset_sptr->read(static_cast<void*>(aux_buffer.data()), H5::PredType::STD_U8LE, memspace, m_dataspace);
-
-  // the data is not in the correct size if its RDF9, so we will need to transpose the output of the data read.
+  // the data is not in the correct size if its RDF9, so we will need to reshape the output of the data read.
   if (rdf_ver == 9)
     {
-      output.resize(IndexRange3D(m_NZ_SUB, m_NY_SUB, m_NX_SUB));
-      // now transpose the output.
-      // AB: todo
-      // todo 1: test
-      for (unsigned int i = 0; i < m_NZ_SUB; ++i)
-        {
-          unsigned int ioffset = i * m_NX_SUB * m_NY_SUB;
-          for (unsigned int j = 0; j < m_NY_SUB; ++j)
-            {
-              unsigned int joffset = j * m_NX_SUB;
-              for (unsigned int k = 0; k < m_NX_SUB; ++k)
-                {
-                  output[i][j][k] = aux_buffer[ioffset + joffset + k];
-                }
-            }
-        }
+      // Read directly into the output, which is (re)allocated as a contiguous array if necessary.
+      // Note that this means that the output is the data in the file (in the same order), but
+      // indexed as [m_NZ_SUB][m_NY_SUB][m_NX_SUB].
+      const IndexRange3D range(m_NZ_SUB, m_NY_SUB, m_NX_SUB);
+      if (output.get_index_range() != range || !output.is_contiguous())
+        output = Array<3, unsigned char>(range);
+
+      m_dataspace.selectHyperslab(H5S_SELECT_SET, str_dimsf, offset.data());
+      H5::DataSpace memspace(3, str_dimsf);
+      m_dataset_sptr->read(static_cast<void*>(output.get_full_data_ptr()), H5::PredType::STD_U8LE, memspace, m_dataspace);
+      output.release_full_data_ptr();
     }
 
   return Succeeded::yes;
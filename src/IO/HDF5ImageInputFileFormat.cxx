@@ -0,0 +1,103 @@
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+/*!
+  \file
+  \ingroup IO
+  \brief Implementation of class stir::HDF5ImageInputFileFormat
+*/
+
+#include "stir/IO/HDF5ImageInputFileFormat.h"
+#include "stir/IO/HDF5_utilities.h"
+#include "stir/IO/interfile.h"
+#include "stir/IO/FileSignature.h"
+#include "stir/VoxelsOnCartesianGrid.h"
+#include "stir/is_null_ptr.h"
+#include "stir/error.h"
+#include <sstream>
+#include <vector>
+#include <exception>
+#include <algorithm>
+#include <cstring>
+
+START_NAMESPACE_STIR
+
+bool
+HDF5ImageInputFileFormat::actual_can_read(const FileSignature& signature, std::istream& input) const
+{
+  // HDF5 files cannot be read from a stream
+  return false;
+}
+
+bool
+HDF5ImageInputFileFormat::can_read(const FileSignature& signature, const std::string& filename) const
+{
+  // quick check on the HDF5 signature, i.e. "\211HDF\r\n\032\n", before opening the file with HDF5
+  if (std::strncmp(signature.get_signature() + 1, "HDF", 3) != 0)
+    return false;
+  return is_STIR_HDF5_file(filename, "image");
+}
+
+unique_ptr<HDF5ImageInputFileFormat::data_type>
+HDF5ImageInputFileFormat::read_from_file(std::istream& input) const
+{
+  error("HDF5ImageInputFileFormat: cannot read from a stream");
+  return unique_ptr<data_type>();
+}
+
+unique_ptr<HDF5ImageInputFileFormat::data_type>
+HDF5ImageInputFileFormat::read_from_file(const std::string& filename) const
+{
+  unique_ptr<VoxelsOnCartesianGrid<float>> image_uptr;
+  std::string header;
+  std::vector<float> buffer;
+  std::string error_message;
+  std::exception_ptr exception_ptr;
+#ifdef STIR_OPENMP
+#  pragma omp critical(STIR_HDF5)
+#endif
+  {
+    try
+      {
+        H5::H5File file(filename, H5F_ACC_RDONLY);
+        header = read_STIR_HDF5_header(file, "image");
+        H5::DataSet dataset = file.openDataSet("image");
+        H5::DataSpace dataspace = dataset.getSpace();
+        if (dataspace.getSimpleExtentNdims() != 3)
+          error_message = "HDF5ImageInputFileFormat: the image in " + filename + " is not 3D";
+        else
+          {
+            buffer.resize(static_cast<std::size_t>(dataspace.getSimpleExtentNpoints()));
+            dataset.read(&buffer[0], H5::PredType::NATIVE_FLOAT);
+          }
+      }
+    catch (H5::Exception& e)
+      {
+        error_message = "HDF5ImageInputFileFormat: error reading " + filename + ": " + e.getDetailMsg();
+      }
+    catch (...)
+      {
+        exception_ptr = std::current_exception();
+      }
+  }
+  if (exception_ptr)
+    std::rethrow_exception(exception_ptr);
+  if (!error_message.empty())
+    error(error_message);
+
+  std::istringstream header_stream(header);
+  image_uptr.reset(create_image_from_interfile_header(header_stream));
+  if (is_null_ptr(image_uptr))
+    error("HDF5ImageInputFileFormat: parsing of the Interfile header in " + filename + " failed");
+  if (buffer.size() != image_uptr->size_all())
+    error("HDF5ImageInputFileFormat: size of the image in " + filename + " does not correspond to its header");
+  std::copy(buffer.begin(), buffer.end(), image_uptr->begin_all());
+  return unique_ptr<data_type>(image_uptr.release());
+}
+
+END_NAMESPACE_STIR
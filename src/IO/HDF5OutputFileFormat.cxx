@@ -0,0 +1,181 @@
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+/*!
+  \file
+  \ingroup IO
+  \brief Implementation of class stir::HDF5OutputFileFormat
+*/
+
+#include "stir/IO/HDF5OutputFileFormat.h"
+#include "stir/IO/HDF5_utilities.h"
+#include "stir/IO/interfile.h"
+#include "stir/VoxelsOnCartesianGrid.h"
+#include "stir/utilities.h"
+#include "stir/Succeeded.h"
+#include "stir/warning.h"
+#include <boost/format.hpp>
+#include <sstream>
+#include <vector>
+#include <exception>
+
+START_NAMESPACE_STIR
+
+const char* const HDF5OutputFileFormat::registered_name = "HDF5";
+
+HDF5OutputFileFormat::HDF5OutputFileFormat(const NumericType& type, const ByteOrder& byte_order)
+{
+  this->set_defaults();
+  this->set_type_of_numbers(type, true);
+  this->set_byte_order(byte_order);
+}
+
+void
+HDF5OutputFileFormat::set_defaults()
+{
+  base_type::set_defaults();
+  this->compression_level = 1;
+}
+
+void
+HDF5OutputFileFormat::initialise_keymap()
+{
+  parser.add_start_key("HDF5 Output File Format Parameters");
+  parser.add_key("compression level", &this->compression_level);
+  parser.add_stop_key("End HDF5 Output File Format Parameters");
+  base_type::initialise_keymap();
+}
+
+bool
+HDF5OutputFileFormat::post_processing()
+{
+  if (base_type::post_processing())
+    return true;
+  if (this->compression_level < 0 || this->compression_level > 9)
+    {
+      warning(boost::format("HDF5OutputFileFormat: compression level should be between 0 and 9, but is %1%")
+              % this->compression_level);
+      return true;
+    }
+  this->set_type_of_numbers(this->type_of_numbers, true);
+  this->set_scale_to_write_data(this->scale_to_write_data, true);
+  return false;
+}
+
+void
+HDF5OutputFileFormat::set_compression_level(const int level)
+{
+  this->compression_level = level;
+}
+
+int
+HDF5OutputFileFormat::get_compression_level() const
+{
+  return this->compression_level;
+}
+
+NumericType
+HDF5OutputFileFormat::set_type_of_numbers(const NumericType& new_type, const bool warn)
+{
+  if (warn && new_type != NumericType::FLOAT)
+    warning("HDF5OutputFileFormat: can only write floats. Ignoring requested type of numbers");
+  this->type_of_numbers = NumericType::FLOAT;
+  return this->type_of_numbers;
+}
+
+// note 'warn' commented below to avoid compiler warning message about unused variables
+ByteOrder
+HDF5OutputFileFormat::set_byte_order(const ByteOrder& /* new_byte_order */, const bool /* warn */)
+{
+  // HDF5 takes care of the byte order
+  this->file_byte_order = ByteOrder::native;
+  return this->file_byte_order;
+}
+
+float
+HDF5OutputFileFormat::set_scale_to_write_data(const float new_scale_to_write_data, const bool warn)
+{
+  if (warn && new_scale_to_write_data != 0 && new_scale_to_write_data != 1)
+    warning("HDF5OutputFileFormat: data are never scaled. Ignoring requested scale factor");
+  this->scale_to_write_data = 1.F;
+  return this->scale_to_write_data;
+}
+
+Succeeded
+HDF5OutputFileFormat::actual_write_to_file(std::string& filename, const DiscretisedDensity<3, float>& density) const
+{
+  const VoxelsOnCartesianGrid<float>* image_ptr = dynamic_cast<const VoxelsOnCartesianGrid<float>*>(&density);
+  if (image_ptr == 0)
+    {
+      warning("HDF5OutputFileFormat: can only write images of type VoxelsOnCartesianGrid");
+      return Succeeded::no;
+    }
+  const VoxelsOnCartesianGrid<float>& image = *image_ptr;
+  add_extension(filename, ".h5");
+
+  VectorWithOffset<float> scaling_factors(1);
+  scaling_factors.fill(1.F);
+  VectorWithOffset<unsigned long> file_offsets(1);
+  file_offsets.fill(0UL);
+  std::ostringstream header;
+  if (write_basic_interfile_image_header(header,
+                                         find_filename(filename.c_str()),
+                                         image.get_exam_info(),
+                                         image.get_index_range(),
+                                         image.get_voxel_size(),
+                                         image.get_origin(),
+                                         NumericType::FLOAT,
+                                         ByteOrder::native,
+                                         scaling_factors,
+                                         file_offsets)
+      == Succeeded::no)
+    return Succeeded::no;
+
+  const hsize_t dims[3] = { static_cast<hsize_t>(image.get_z_size()),
+                            static_cast<hsize_t>(image.get_y_size()),
+                            static_cast<hsize_t>(image.get_x_size()) };
+  // one chunk per plane
+  const std::vector<hsize_t> chunk_dims = { 1, dims[1], dims[2] };
+  const std::vector<float> buffer(image.begin_all(), image.end_all());
+  std::string error_message;
+  std::exception_ptr exception_ptr;
+#ifdef STIR_OPENMP
+#  pragma omp critical(STIR_HDF5)
+#endif
+  {
+    try
+      {
+        H5::H5File file(filename, H5F_ACC_TRUNC);
+        write_STIR_HDF5_header(file, "image", header.str());
+        const H5::DataSpace dataspace(3, dims);
+        H5::DataSet dataset = file.createDataSet("image",
+                                                 H5::PredType::NATIVE_FLOAT,
+                                                 dataspace,
+                                                 create_STIR_HDF5_dataset_properties(chunk_dims, this->compression_level));
+        dataset.write(&buffer[0], H5::PredType::NATIVE_FLOAT);
+      }
+    catch (H5::Exception& e)
+      {
+        error_message = "HDF5OutputFileFormat: error writing " + filename + ": " + e.getDetailMsg();
+      }
+    catch (...)
+      {
+        exception_ptr = std::current_exception();
+      }
+  }
+  if (exception_ptr)
+    std::rethrow_exception(exception_ptr);
+  if (!error_message.empty())
+    {
+      warning(error_message);
+      return Succeeded::no;
+    }
+  return Succeeded::yes;
+}
+
+END_NAMESPACE_STIR
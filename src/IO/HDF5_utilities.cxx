@@ -0,0 +1,107 @@
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+/*!
+  \file
+  \ingroup IO
+  \brief Implementation of utility functions for the STIR HDF5 file format
+*/
+
+#include "stir/IO/HDF5_utilities.h"
+#include "stir/error.h"
+#include <boost/format.hpp>
+
+START_NAMESPACE_STIR
+
+static const char* const data_type_attribute_name = "STIR data type";
+static const char* const header_attribute_name = "STIR Interfile header";
+
+static std::string
+read_string_attribute(const H5::Group& group, const char* const name)
+{
+  H5::Attribute attribute = group.openAttribute(name);
+  H5::StrType str_type(H5::PredType::C_S1, H5T_VARIABLE);
+  std::string value;
+  attribute.read(str_type, value);
+  return value;
+}
+
+static void
+write_string_attribute(H5::Group& group, const char* const name, const std::string& value)
+{
+  H5::StrType str_type(H5::PredType::C_S1, H5T_VARIABLE);
+  H5::Attribute attribute = group.createAttribute(name, str_type, H5::DataSpace(H5S_SCALAR));
+  attribute.write(str_type, value);
+}
+
+bool
+is_STIR_HDF5_file(const std::string& filename, const std::string& data_type)
+{
+  bool result = false;
+#ifdef STIR_OPENMP
+#  pragma omp critical(STIR_HDF5)
+#endif
+  {
+    try
+      {
+        if (H5::H5File::isHdf5(filename))
+          {
+            H5::H5File file(filename, H5F_ACC_RDONLY);
+            H5::Group root = file.openGroup("/");
+            result = root.attrExists(data_type_attribute_name) && root.attrExists(header_attribute_name)
+                     && read_string_attribute(root, data_type_attribute_name) == data_type;
+          }
+      }
+    catch (...)
+      {
+        result = false;
+      }
+  }
+  return result;
+}
+
+void
+write_STIR_HDF5_header(H5::H5File& file, const std::string& data_type, const std::string& interfile_header)
+{
+  H5::Group root = file.openGroup("/");
+  write_string_attribute(root, data_type_attribute_name, data_type);
+  write_string_attribute(root, header_attribute_name, interfile_header);
+}
+
+std::string
+read_STIR_HDF5_header(H5::H5File& file, const std::string& data_type)
+{
+  H5::Group root = file.openGroup("/");
+  if (!root.attrExists(data_type_attribute_name) || !root.attrExists(header_attribute_name))
+    error("read_STIR_HDF5_header: file " + file.getFileName() + " is not a STIR HDF5 file");
+  const std::string data_type_in_file = read_string_attribute(root, data_type_attribute_name);
+  if (data_type_in_file != data_type)
+    error(boost::format("read_STIR_HDF5_header: file %1% contains %2%, not %3%") % file.getFileName() % data_type_in_file
+          % data_type);
+  return read_string_attribute(root, header_attribute_name);
+}
+
+H5::DSetCreatPropList
+create_STIR_HDF5_dataset_properties(const std::vector<hsize_t>& chunk_dims, const int compression_level)
+{
+  if (compression_level < 0 || compression_level > 9)
+    error(boost::format("STIR HDF5: compression level should be between 0 and 9, but is %1%") % compression_level);
+  H5::DSetCreatPropList properties;
+  properties.setChunk(static_cast<int>(chunk_dims.size()), &chunk_dims[0]);
+  if (compression_level > 0)
+    {
+      // shuffle the bytes of the floats such that deflate can find more redundancy
+      properties.setShuffle();
+      properties.setDeflate(compression_level);
+    }
+  const float fill_value = 0.F;
+  properties.setFillValue(H5::PredType::NATIVE_FLOAT, &fill_value);
+  return properties;
+}
+
+END_NAMESPACE_STIR
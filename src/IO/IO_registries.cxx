@@ -55,6 +55,8 @@
 
 #  ifdef HAVE_HDF5
 #    include "stir/IO/GEHDF5ListmodeInputFileFormat.h"
+#    include "stir/IO/HDF5OutputFileFormat.h"
+#    include "stir/IO/HDF5ImageInputFileFormat.h"
 #  endif
 //! Addition for SAFIR listmode input file format
 #  include "stir/IO/SAFIRCListmodeInputFileFormat.h"
@@ -87,6 +89,10 @@ static RegisterInputFileFormat<InterfileImageInputFileFormat> idummy0(0);
 #  ifdef HAVE_ITK
 static ITKOutputFileFormat::RegisterIt dummyITK1;
 #  endif
+#  ifdef HAVE_HDF5
+static HDF5OutputFileFormat::RegisterIt dummyHDF5Out;
+static RegisterInputFileFormat<HDF5ImageInputFileFormat> idummyHDF5(5);
+#  endif
 static InterfileDynamicDiscretisedDensityOutputFileFormat::RegisterIt dummydynIntfOut;
 static InterfileParametricDiscretisedDensityOutputFileFormat<ParametricVoxelsOnCartesianGridBaseType>::RegisterIt dummyparIntfOut;
 static MultiDynamicDiscretisedDensityOutputFileFormat::RegisterIt dummydynMultiOut;
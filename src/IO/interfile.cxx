@@ -165,6 +165,14 @@ read_interfile_image(istream& input, const string& directory_for_data)
   return image_ptr;
 }
 
+VoxelsOnCartesianGrid<float>*
+create_image_from_interfile_header(istream& input)
+{
+  InterfileImageHeader hdr;
+  char full_data_file_name[max_filename_length];
+  return create_image_and_header_from(hdr, full_data_file_name, input, "");
+}
+
 DynamicDiscretisedDensity*
 read_interfile_dynamic_image(istream& input, const string& directory_for_data)
 {
@@ -519,8 +527,8 @@ interfile_create_filenames(const std::string& filename, std::string& data_name,
 ////// end static functions
 
 Succeeded
-write_basic_interfile_image_header(const string& header_file_name,
-                                   const string& image_file_name,
+write_basic_interfile_image_header(std::ostream& output_header,
+                                   const string& data_file_name_in_header,
                                    const ExamInfo& exam_info,
                                    const IndexRange<3>& index_range,
                                    const CartesianCoordinate3D<float>& voxel_size,
@@ -539,17 +547,6 @@ write_basic_interfile_image_header(const string& header_file_name,
       return Succeeded::no;
     }
   CartesianCoordinate3D<int> dimensions = max_indices - min_indices + 1;
-  string header_name = header_file_name;
-  add_extension(header_name, ".hv");
-  ofstream output_header(header_name.c_str(), ios::out);
-  if (!output_header.good())
-    {
-      warning("Error opening Interfile header '%s' for writing\n", header_name.c_str());
-      return Succeeded::no;
-    }
-
-  // handle directory names
-  const string data_file_name_in_header = interfile_get_data_file_name_in_header(header_file_name, image_file_name);
 
   output_header << "!INTERFILE  :=\n";
   const bool is_spect = exam_info.imaging_modality.get_modality() == ImagingModality::NM;
@@ -673,6 +670,58 @@ write_basic_interfile_image_header(const string& header_file_name,
   // output_header << "maximum pixel count := " << image.find_max()/scale << endl;
   output_header << "!END OF INTERFILE :=\n";
 
+  return Succeeded::yes;
+}
+
+Succeeded
+write_basic_interfile_image_header(const string& header_file_name,
+                                   const string& image_file_name,
+                                   const ExamInfo& exam_info,
+                                   const IndexRange<3>& index_range,
+                                   const CartesianCoordinate3D<float>& voxel_size,
+                                   const CartesianCoordinate3D<float>& origin,
+                                   const NumericType output_type,
+                                   const ByteOrder byte_order,
+                                   const VectorWithOffset<float>& scaling_factors,
+                                   const VectorWithOffset<unsigned long>& file_offsets,
+                                   const std::vector<std::string>& data_type_descriptions)
+{
+  CartesianCoordinate3D<int> min_indices;
+  CartesianCoordinate3D<int> max_indices;
+  if (!index_range.get_regular_range(min_indices, max_indices))
+    {
+      warning("write_basic_interfile: can handle only regular index ranges\n. No output\n");
+      return Succeeded::no;
+    }
+  CartesianCoordinate3D<int> dimensions = max_indices - min_indices + 1;
+  string header_name = header_file_name;
+  add_extension(header_name, ".hv");
+  {
+    ofstream output_header(header_name.c_str(), ios::out);
+    if (!output_header.good())
+      {
+        warning("Error opening Interfile header '%s' for writing\n", header_name.c_str());
+        return Succeeded::no;
+      }
+
+    // handle directory names
+    const string data_file_name_in_header = interfile_get_data_file_name_in_header(header_file_name, image_file_name);
+
+    if (write_basic_interfile_image_header(output_header,
+                                           data_file_name_in_header,
+                                           exam_info,
+                                           index_range,
+                                           voxel_size,
+                                           origin,
+                                           output_type,
+                                           byte_order,
+                                           scaling_factors,
+                                           file_offsets,
+                                           data_type_descriptions)
+        == Succeeded::no)
+      return Succeeded::no;
+  }
+
   // temporary copy to make an old-style header to satisfy Analyze
   {
     string header_name = header_file_name;
@@ -1115,6 +1164,14 @@ write_basic_interfile_PDFS_header(const string& header_file_name, const string&
   // handle directory names
   const string data_file_name_in_header = interfile_get_data_file_name_in_header(header_file_name, data_file_name);
 
+  return write_basic_interfile_PDFS_header(output_header, data_file_name_in_header, pdfs);
+}
+
+Succeeded
+write_basic_interfile_PDFS_header(std::ostream& output_header,
+                                  const string& data_file_name_in_header,
+                                  const ProjDataFromStream& pdfs)
+{
   const vector<int> segment_sequence = pdfs.get_segment_sequence_in_stream();
 
   const float angle_first_view
@@ -111,8 +111,12 @@ Box3D::Box3D(const float length_xv,
 bool
 Box3D::is_inside_shape(const CartesianCoordinate3D<float>& coord) const
 {
-  const CartesianCoordinate3D<float> r = this->transform_to_shape_coords(coord);
+  return this->is_inside_shape_in_shape_coords(this->transform_to_shape_coords(coord));
+}
 
+bool
+Box3D::is_inside_shape_in_shape_coords(const CartesianCoordinate3D<float>& r) const
+{
   const float distance_along_x_axis = r.x();
   const float distance_along_y_axis = r.y();
   const float distance_along_z_axis = r.z();
@@ -121,6 +125,13 @@ Box3D::is_inside_shape(const CartesianCoordinate3D<float>& coord) const
          && fabs(distance_along_z_axis) < length_z / 2;
 }
 
+Succeeded
+Box3D::get_bounding_box(CartesianCoordinate3D<float>& min_coord, CartesianCoordinate3D<float>& max_coord) const
+{
+  return this->get_bounding_box_of_shape_coords_box(
+      min_coord, max_coord, CartesianCoordinate3D<float>(length_z / 2, length_y / 2, length_x / 2));
+}
+
 float
 Box3D::get_geometric_volume() const
 {
@@ -115,14 +115,20 @@ get_geometric_area()const
 
 bool
 Ellipsoid::is_inside_shape(const CartesianCoordinate3D<float>& coord) const
+{
+  return this->is_inside_shape_in_shape_coords(this->transform_to_shape_coords(coord));
+}
 
+bool
+Ellipsoid::is_inside_shape_in_shape_coords(const CartesianCoordinate3D<float>& r) const
 {
-  const CartesianCoordinate3D<float> r = this->transform_to_shape_coords(coord);
+  return square(r.z() / radii.z()) + square(r.y() / radii.y()) + square(r.x() / radii.x()) <= 1;
+}
 
-  if (norm_squared(r / this->radii) <= 1)
-    return true;
-  else
-    return false;
+Succeeded
+Ellipsoid::get_bounding_box(CartesianCoordinate3D<float>& min_coord, CartesianCoordinate3D<float>& max_coord) const
+{
+  return this->get_bounding_box_of_shape_coords_box(min_coord, max_coord, this->radii);
 }
 
 Shape3D*
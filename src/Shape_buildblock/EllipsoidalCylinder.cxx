@@ -161,16 +161,22 @@ EllipsoidalCylinder::set_radius_y(const float new_radius_y)
 
 bool
 EllipsoidalCylinder::is_inside_shape(const CartesianCoordinate3D<float>& coord) const
-
 {
-  const CartesianCoordinate3D<float> r = this->transform_to_shape_coords(coord);
+  return this->is_inside_shape_in_shape_coords(this->transform_to_shape_coords(coord));
+}
 
+bool
+EllipsoidalCylinder::is_inside_shape_in_shape_coords(const CartesianCoordinate3D<float>& r) const
+{
   const float distance_along_axis = r.z();
 
   if (fabs(distance_along_axis) < length / 2)
     {
       if (square(r.x() / radius_x) + square(r.y() / radius_y) <= 1)
         {
+          // avoid the atan2 for a full cylinder
+          if (theta_1 == 0.F && theta_2 == 360.F)
+            return true;
           const float x_pos = r.x();
           const float y_pos = r.y();
           const float phi_1 = static_cast<float>(_PI * theta_1 / 180.0);
@@ -189,6 +195,13 @@ EllipsoidalCylinder::is_inside_shape(const CartesianCoordinate3D<float>& coord)
     return false;
 }
 
+Succeeded
+EllipsoidalCylinder::get_bounding_box(CartesianCoordinate3D<float>& min_coord, CartesianCoordinate3D<float>& max_coord) const
+{
+  return this->get_bounding_box_of_shape_coords_box(
+      min_coord, max_coord, CartesianCoordinate3D<float>(length / 2, radius_y, radius_x));
+}
+
 float
 EllipsoidalCylinder::get_geometric_volume() const
 {
@@ -21,7 +21,12 @@
 #include "stir/Shape/DiscretisedShape3D.h"
 #include "stir/DiscretisedDensity.h"
 #include "stir/VoxelsOnCartesianGrid.h"
+#include "stir/Succeeded.h"
 #include "stir/info.h"
+#include <boost/format.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
 
 using std::cerr;
 using std::endl;
@@ -90,6 +95,12 @@ Shape3D::get_voxel_weight(const CartesianCoordinate3D<float>& voxel_centre,
   return float(value) / (num_samples.z() * num_samples.y() * num_samples.x());
 }
 
+Succeeded
+Shape3D::get_bounding_box(CartesianCoordinate3D<float>&, CartesianCoordinate3D<float>&) const
+{
+  return Succeeded::no;
+}
+
 /* Construct the volume- use the convexity, e.g
    the inner voxels sampled with num_samples=1, only the outer
    voxels checked with the user defined num_samples
@@ -110,57 +121,133 @@ Shape3D::construct_volume(VoxelsOnCartesianGrid<float>& image, const CartesianCo
   const int max_y = image.get_max_y();
   const int max_x = image.get_max_x();
 
-  CartesianCoordinate3D<int> crude_num_samples(1, 1, 1);
-
-  for (int z = min_z; z <= max_z; z++)
+  image.fill(0.F);
+
+  // find range of voxels that can intersect the shape (with a margin of 1 voxel)
+  CartesianCoordinate3D<int> min_index(min_z, min_y, min_x);
+  CartesianCoordinate3D<int> max_index(max_z, max_y, max_x);
+  {
+    CartesianCoordinate3D<float> min_coord, max_coord;
+    if (this->get_bounding_box(min_coord, max_coord) == Succeeded::yes)
+      {
+        const CartesianCoordinate3D<float> min_float_index = (min_coord - origin) / voxel_size;
+        const CartesianCoordinate3D<float> max_float_index = (max_coord - origin) / voxel_size;
+        for (int d = 1; d <= 3; ++d)
+          {
+            // voxel sizes could be negative
+            const float low = std::min(min_float_index[d], max_float_index[d]);
+            const float high = std::max(min_float_index[d], max_float_index[d]);
+            min_index[d] = std::max(min_index[d], static_cast<int>(std::floor(low)) - 1);
+            max_index[d] = std::min(max_index[d], static_cast<int>(std::ceil(high)) + 1);
+          }
+      }
+  }
+  if (min_index.z() > max_index.z() || min_index.y() > max_index.y() || min_index.x() > max_index.x())
     {
-      for (int y = min_y; y <= max_y; y++)
-        for (int x = min_x; x <= max_x; x++)
+      info("Shape3D::construct_volume: shape is outside the image", 2);
+      return;
+    }
+
+  // first pass: only check the centre of every voxel, and find the range of voxels that are inside per slice
+  std::vector<int> first_y(max_index.z() - min_index.z() + 1, max_index.y() + 1);
+  std::vector<int> last_y(first_y.size(), min_index.y() - 1);
+  std::vector<int> first_x(first_y.size(), max_index.x() + 1);
+  std::vector<int> last_x(first_y.size(), min_index.x() - 1);
 
+#ifdef STIR_OPENMP
+#  pragma omp parallel for schedule(dynamic)
+#endif
+  for (int z = min_index.z(); z <= max_index.z(); z++)
+    {
+      const std::size_t slice = static_cast<std::size_t>(z - min_index.z());
+      for (int y = min_index.y(); y <= max_index.y(); y++)
+        for (int x = min_index.x(); x <= max_index.x(); x++)
           {
             const CartesianCoordinate3D<float> current_index(static_cast<float>(z), static_cast<float>(y), static_cast<float>(x));
 
             // image[z][y][x] = get_voxel_weight(current_point,voxel_size,crude_num_samples);
 
-            image[z][y][x] = (is_inside_shape(current_index * voxel_size + origin)) ? 1.F : 0.F;
+            if (is_inside_shape(current_index * voxel_size + origin))
+              {
+                image[z][y][x] = 1.F;
+                first_y[slice] = std::min(first_y[slice], y);
+                last_y[slice] = std::max(last_y[slice], y);
+                first_x[slice] = std::min(first_x[slice], x);
+                last_x[slice] = std::max(last_x[slice], x);
+              }
           }
     }
 
   if (num_samples.x() == 1 && num_samples.y() == 1 && num_samples.z() == 1)
     return;
 
-  int num_recomputed = 0;
-  for (int z = min_z; z <= max_z; z++)
-    for (int y = min_y; y <= max_y; y++)
-      for (int x = min_x; x <= max_x; x++)
+  // second pass: resample edge voxels, i.e. voxels which have a neighbour with a different value.
+  // As the first pass only finds values 0 or 1, these have to be next to a voxel inside the shape.
+  // We first find all edge voxels, such that the image is not modified while checking neighbours.
+  std::vector<std::vector<BasicCoordinate<2, int>>> edge_voxels(first_y.size());
+#ifdef STIR_OPENMP
+#  pragma omp parallel for schedule(dynamic)
+#endif
+  for (int z = min_index.z(); z <= max_index.z(); z++)
+    {
+      // find range of voxels inside the shape in this and neighbouring slices
+      int start_y = max_y + 1, end_y = min_y - 1, start_x = max_x + 1, end_x = min_x - 1;
+      for (int i = std::max(z - 1, min_index.z()); i <= std::min(z + 1, max_index.z()); ++i)
         {
-          const float current_value = image[z][y][x];
+          const std::size_t slice = static_cast<std::size_t>(i - min_index.z());
+          start_y = std::min(start_y, first_y[slice] - 1);
+          end_y = std::max(end_y, last_y[slice] + 1);
+          start_x = std::min(start_x, first_x[slice] - 1);
+          end_x = std::max(end_x, last_x[slice] + 1);
+        }
+      start_y = std::max(start_y, min_y);
+      end_y = std::min(end_y, max_y);
+      start_x = std::max(start_x, min_x);
+      end_x = std::min(end_x, max_x);
+
+      std::vector<BasicCoordinate<2, int>>& edge_voxels_in_slice = edge_voxels[z - min_index.z()];
+      for (int y = start_y; y <= end_y; y++)
+        for (int x = start_x; x <= end_x; x++)
+          {
+            const float current_value = image[z][y][x];
+            // check neighbour values. If they are all equal, we'll assume it's ok.
+            bool recompute = false;
+            for (int i = z - 1; !recompute && (i <= z + 1); i++)
+              for (int j = y - 1; !recompute && (j <= y + 1); j++)
+                for (int k = x - 1; !recompute && (k <= x + 1); k++)
+                  {
+                    const float value_of_neighbour
+                        = ((i < min_z) || (i > max_z) || (j < min_y) || (j > max_y) || (k < min_x) || (k > max_x))
+                              ? 0
+                              : image[i][j][k];
+                    recompute = (value_of_neighbour != current_value);
+                  }
+            if (recompute)
+              {
+                BasicCoordinate<2, int> yx;
+                yx[1] = y;
+                yx[2] = x;
+                edge_voxels_in_slice.push_back(yx);
+              }
+          }
+    }
 
-          // first check if we're already at an edge voxel
-          // Note:  this allow fuzzy boundaries
-          bool recompute = current_value < .999F && current_value > .00F;
-          if (!recompute)
-            {
-              // check neighbour values. If they are all equal, we'll assume it's ok.
-              for (int i = z - 1; !recompute && (i <= z + 1); i++)
-                for (int j = y - 1; !recompute && (j <= y + 1); j++)
-                  for (int k = x - 1; !recompute && (k <= x + 1); k++)
-                    {
-                      const float value_of_neighbour
-                          = ((i < min_z) || (i > max_z) || (j < min_y) || (j > max_y) || (k < min_x) || (k > max_x))
-                                ? 0
-                                : image[i][j][k];
-                      recompute = (value_of_neighbour != current_value);
-                    }
-            }
-          if (recompute)
-            {
-              num_recomputed++;
-              const CartesianCoordinate3D<float> current_index(
-                  static_cast<float>(z), static_cast<float>(y), static_cast<float>(x));
-              image[z][y][x] = get_voxel_weight(current_index * voxel_size + origin, voxel_size, num_samples);
-            }
+  int num_recomputed = 0;
+#ifdef STIR_OPENMP
+#  pragma omp parallel for schedule(dynamic) reduction(+ : num_recomputed)
+#endif
+  for (int z = min_index.z(); z <= max_index.z(); z++)
+    {
+      const std::vector<BasicCoordinate<2, int>>& edge_voxels_in_slice = edge_voxels[z - min_index.z()];
+      for (std::size_t i = 0; i < edge_voxels_in_slice.size(); ++i)
+        {
+          const int y = edge_voxels_in_slice[i][1];
+          const int x = edge_voxels_in_slice[i][2];
+          const CartesianCoordinate3D<float> current_index(static_cast<float>(z), static_cast<float>(y), static_cast<float>(x));
+          image[z][y][x] = get_voxel_weight(current_index * voxel_size + origin, voxel_size, num_samples);
         }
+      num_recomputed += static_cast<int>(edge_voxels_in_slice.size());
+    }
   info(boost::format("Number of voxels recomputed with finer sampling : %1%") % num_recomputed);
 }
 
@@ -115,6 +115,97 @@ Shape3DWithOrientation::transform_to_shape_coords(const CartesianCoordinate3D<fl
   return matrix_multiply(this->get_direction_vectors(), coord - this->get_origin());
 }
 
+//! compute the inverse of the direction vectors (times the determinant), returns the determinant
+static float
+inverse_times_determinant(float inverse[4][4], const Array<2, float>& m)
+{
+  inverse[1][1] = m[2][2] * m[3][3] - m[2][3] * m[3][2];
+  inverse[1][2] = m[1][3] * m[3][2] - m[1][2] * m[3][3];
+  inverse[1][3] = m[1][2] * m[2][3] - m[1][3] * m[2][2];
+  inverse[2][1] = m[2][3] * m[3][1] - m[2][1] * m[3][3];
+  inverse[2][2] = m[1][1] * m[3][3] - m[1][3] * m[3][1];
+  inverse[2][3] = m[1][3] * m[2][1] - m[1][1] * m[2][3];
+  inverse[3][1] = m[2][1] * m[3][2] - m[2][2] * m[3][1];
+  inverse[3][2] = m[1][2] * m[3][1] - m[1][1] * m[3][2];
+  inverse[3][3] = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+  return determinant(m);
+}
+
+CartesianCoordinate3D<float>
+Shape3DWithOrientation::transform_from_shape_coords(const CartesianCoordinate3D<float>& r) const
+{
+  float inverse[4][4];
+  const float det = inverse_times_determinant(inverse, this->get_direction_vectors());
+  if (det == 0)
+    error("Shape3DWithOrientation: direction vectors are not invertible");
+  CartesianCoordinate3D<float> coord = this->get_origin();
+  for (int d = 1; d <= 3; ++d)
+    for (int i = 1; i <= 3; ++i)
+      coord[d] += inverse[d][i] / det * r[i];
+  return coord;
+}
+
+bool
+Shape3DWithOrientation::is_inside_shape_in_shape_coords(const CartesianCoordinate3D<float>& r) const
+{
+  return this->is_inside_shape(this->transform_from_shape_coords(r));
+}
+
+float
+Shape3DWithOrientation::get_voxel_weight(const CartesianCoordinate3D<float>& voxel_centre,
+                                         const CartesianCoordinate3D<float>& voxel_size,
+                                         const CartesianCoordinate3D<int>& num_samples) const
+{
+  const Array<2, float>& directions = this->get_direction_vectors();
+  // steps in shape coordinates corresponding to moving one sample along z, y or x
+  CartesianCoordinate3D<float> steps[3];
+  for (int d = 1; d <= 3; ++d)
+    for (int i = 1; i <= 3; ++i)
+      steps[d - 1][i] = directions[i][d] * voxel_size[d] / num_samples[d];
+
+  // shape coordinate of the first sample
+  CartesianCoordinate3D<float> first_r = this->transform_to_shape_coords(voxel_centre);
+  for (int d = 1; d <= 3; ++d)
+    first_r -= steps[d - 1] * (float(num_samples[d] - 1) / 2.F);
+
+  int value = 0;
+  CartesianCoordinate3D<float> r_z = first_r;
+  for (int z = 0; z < num_samples.z(); ++z, r_z += steps[0])
+    {
+      CartesianCoordinate3D<float> r_y = r_z;
+      for (int y = 0; y < num_samples.y(); ++y, r_y += steps[1])
+        {
+          CartesianCoordinate3D<float> r = r_y;
+          for (int x = 0; x < num_samples.x(); ++x, r += steps[2])
+            if (this->is_inside_shape_in_shape_coords(r))
+              ++value;
+        }
+    }
+  return float(value) / (num_samples.z() * num_samples.y() * num_samples.x());
+}
+
+Succeeded
+Shape3DWithOrientation::get_bounding_box_of_shape_coords_box(CartesianCoordinate3D<float>& min_coord,
+                                                             CartesianCoordinate3D<float>& max_coord,
+                                                             const CartesianCoordinate3D<float>& half_lengths) const
+{
+  // coord = origin + inverse(directions) * r, so we need the inverse of the direction matrix
+  float inverse[4][4];
+  const float det = inverse_times_determinant(inverse, this->get_direction_vectors());
+  if (det == 0)
+    return Succeeded::no;
+
+  for (int d = 1; d <= 3; ++d)
+    {
+      float half_extent = 0.F;
+      for (int i = 1; i <= 3; ++i)
+        half_extent += std::fabs(inverse[d][i] / det) * half_lengths[i];
+      min_coord[d] = this->get_origin()[d] - half_extent;
+      max_coord[d] = this->get_origin()[d] + half_extent;
+    }
+  return Succeeded::yes;
+}
+
 void
 Shape3DWithOrientation::scale(const CartesianCoordinate3D<float>& scale3D)
 {
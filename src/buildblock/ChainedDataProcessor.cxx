@@ -2,6 +2,7 @@
 //
 /*
     Copyright (C) 2000- 2011, Hammersmith Imanet Ltd
+    Copyright (C) 2026, University College London
     This file is part of STIR.
 
     SPDX-License-Identifier: Apache-2.0
@@ -21,8 +22,6 @@
 #include "stir/modelling/ParametricDiscretisedDensity.h"
 #include "stir/modelling/KineticParameters.h"
 #include "stir/is_null_ptr.h"
-#include <memory>
-#include "stir/unique_ptr.h"
 
 START_NAMESPACE_STIR
 
@@ -44,32 +43,105 @@ ChainedDataProcessor<DataT>::virtual_set_up(const DataT& data)
 
 template <typename DataT>
 void
-ChainedDataProcessor<DataT>::virtual_apply(DataT& data) const
+ChainedDataProcessor<DataT>::append_processors(processors_type& processors) const
 {
-  if (!is_null_ptr(this->apply_first))
-    this->apply_first->apply(data);
-  if (!is_null_ptr(this->apply_second))
-    this->apply_second->apply(data);
+  for (const auto& processor_sptr : { this->apply_first, this->apply_second })
+    {
+      if (is_null_ptr(processor_sptr))
+        continue;
+      if (const auto chained_ptr = dynamic_cast<const ChainedDataProcessor<DataT>*>(processor_sptr.get()))
+        chained_ptr->append_processors(processors);
+      else
+        processors.push_back(processor_sptr);
+    }
 }
 
 template <typename DataT>
 void
-ChainedDataProcessor<DataT>::virtual_apply(DataT& out_data, const DataT& in_data) const
+ChainedDataProcessor<DataT>::apply_pointwise_processors(DataT& data,
+                                                        typename processors_type::const_iterator begin,
+                                                        typename processors_type::const_iterator end)
 {
-  if (!is_null_ptr(this->apply_first))
+  // note: only the first processor can depend on the whole input, see apply_processors()
+  std::vector<DataProcessor<DataT>*> prepared_processors;
+  for (auto iter = begin; iter != end; ++iter)
+    if ((*iter)->prepare_pointwise(data) == Succeeded::yes)
+      prepared_processors.push_back(iter->get());
+
+  if (prepared_processors.empty())
+    return;
+
+  // apply_pointwise() does not use the timers, so we time the fused pass for every processor in it
+  for (const auto processor_ptr : prepared_processors)
+    processor_ptr->start_timers();
+  const int min_index = data.get_min_index();
+  const int max_index = data.get_max_index();
+#ifdef STIR_OPENMP
+#  pragma omp parallel for schedule(dynamic)
+#endif
+  for (int outer_index = min_index; outer_index <= max_index; ++outer_index)
     {
-      if (!is_null_ptr(this->apply_second))
+      for (const auto processor_ptr : prepared_processors)
+        processor_ptr->apply_pointwise(data, outer_index);
+    }
+  for (const auto processor_ptr : prepared_processors)
+    processor_ptr->stop_timers();
+}
+
+template <typename DataT>
+void
+ChainedDataProcessor<DataT>::apply_processors(DataT& data,
+                                              typename processors_type::const_iterator begin,
+                                              typename processors_type::const_iterator end)
+{
+  auto iter = begin;
+  while (iter != end)
+    {
+      if (!(*iter)->is_pointwise())
         {
-          // a bit complicated because we need a temporary data copy
-          unique_ptr<DataT> temp_data_ptr(in_data.get_empty_copy());
-          this->apply_first->apply(*temp_data_ptr, in_data);
-          this->apply_second->apply(out_data, *temp_data_ptr);
+          (*iter)->apply(data);
+          ++iter;
+          continue;
         }
-      else
-        this->apply_first->apply(out_data, in_data);
+      // find the end of the sequence of point-wise processors that can be done in one pass
+      auto pointwise_end = iter + 1;
+      while (pointwise_end != end && (*pointwise_end)->is_pointwise() && !(*pointwise_end)->pointwise_depends_on_whole_input())
+        ++pointwise_end;
+      apply_pointwise_processors(data, iter, pointwise_end);
+      iter = pointwise_end;
     }
-  else if (!is_null_ptr(this->apply_second))
-    this->apply_second->apply(out_data, in_data);
+}
+
+template <typename DataT>
+void
+ChainedDataProcessor<DataT>::virtual_apply(DataT& data) const
+{
+  processors_type processors;
+  this->append_processors(processors);
+  apply_processors(data, processors.begin(), processors.end());
+}
+
+template <typename DataT>
+void
+ChainedDataProcessor<DataT>::virtual_apply(DataT& out_data, const DataT& in_data) const
+{
+  processors_type processors;
+  this->append_processors(processors);
+  if (processors.empty())
+    return;
+
+  auto iter = processors.begin();
+  if ((*iter)->is_pointwise())
+    {
+      // no need to call the out-of-place version
+      out_data = in_data;
+    }
+  else
+    {
+      (*iter)->apply(out_data, in_data);
+      ++iter;
+    }
+  apply_processors(out_data, iter, processors.end());
 }
 
 template <typename DataT>
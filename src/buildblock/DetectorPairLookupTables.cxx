@@ -0,0 +1,170 @@
+/*
+    Copyright (C) 2000- 2007-10-08, Hammersmith Imanet Ltd
+    Copyright (C) 2011-07-01 - 2011, Kris Thielemans
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+/*!
+  \file
+  \ingroup projdata
+
+  \brief Implementation of class stir::DetectorPairLookupTables
+*/
+
+#include "stir/DetectorPairLookupTables.h"
+#include "stir/error.h"
+#include <map>
+#include <limits>
+
+#include <boost/static_assert.hpp>
+
+START_NAMESPACE_STIR
+
+shared_ptr<const DetectorPairLookupTables>
+DetectorPairLookupTables::get_tables(const int num_detectors_per_ring)
+{
+  static std::map<int, std::weak_ptr<const DetectorPairLookupTables>> all_tables;
+
+  shared_ptr<const DetectorPairLookupTables> tables_sptr;
+#if defined(STIR_OPENMP)
+#  pragma omp critical(DETECTORPAIRLOOKUPTABLES)
+#endif
+  {
+    tables_sptr = all_tables[num_detectors_per_ring].lock();
+    if (!tables_sptr)
+      {
+        tables_sptr = std::make_shared<const DetectorPairLookupTables>(num_detectors_per_ring);
+        all_tables[num_detectors_per_ring] = tables_sptr;
+      }
+  }
+  return tables_sptr;
+}
+
+/*
+   Warning:
+   this code makes use of an implementation dependent feature:
+   bit shifting negative ints to the right.
+    -1 >> 1 should be -1
+    -2 >> 1 should be -1
+   This is ok on every system which uses the 2-complement convention.
+   A compile time assert is used to check this.
+
+  Go from sinograms to detectors.
+
+  Because sinograms are not arc-corrected, tang_pos_num corresponds
+  to an angle as well. Before interleaving we have that
+  \verbatim
+  det_angle_1 = LOR_angle + bin_angle
+  det_angle_2 = LOR_angle + (Pi - bin_angle)
+  \endverbatim
+  (Hint: understand this first at LOR_angle=0, then realise that
+  other LOR_angles follow just by rotation)
+
+  Code gets slightly intricate because:
+  - angles have to be defined modulo 2 Pi (so num_detectors)
+  - interleaving
+*/
+DetectorPairLookupTables::DetectorPairLookupTables(const int num_detectors_per_ring)
+    : num_detectors(num_detectors_per_ring),
+      min_tang_pos_num(-(num_detectors_per_ring / 2) + 1),
+      max_tang_pos_num(-(num_detectors_per_ring / 2) + num_detectors_per_ring)
+{
+  BOOST_STATIC_ASSERT(-1 >> 1 == -1);
+  BOOST_STATIC_ASSERT(-2 >> 1 == -1);
+
+  if (num_detectors <= 0 || num_detectors % 2 != 0)
+    error("DetectorPairLookupTables: Number of detectors per ring should be even and positive but is %d", num_detectors);
+  if (num_detectors > std::numeric_limits<std::int16_t>::max())
+    error("DetectorPairLookupTables: Number of detectors per ring (%d) is too large", num_detectors);
+
+  const int num_tang_poss = max_tang_pos_num - min_tang_pos_num + 1;
+  const int max_num_views = num_detectors / 2;
+
+  view_tangpos_to_det1det2.resize(static_cast<std::size_t>(max_num_views) * num_tang_poss);
+  for (int v_num = 0; v_num < max_num_views; ++v_num)
+    for (int tp_num = min_tang_pos_num; tp_num <= max_tang_pos_num; ++tp_num)
+      {
+        /*
+           adapted from CTI code
+           Note for implementation: avoid using % with negative numbers
+           so add num_detectors before doing modulo num_detectors)
+        */
+        Det1Det2& dets = view_tangpos_to_det1det2[v_num * num_tang_poss + (tp_num - min_tang_pos_num)];
+        dets.det1_num = static_cast<std::int16_t>((v_num + (tp_num >> 1) + num_detectors) % num_detectors);
+        dets.det2_num = static_cast<std::int16_t>((v_num - ((tp_num + 1) >> 1) + num_detectors / 2) % num_detectors);
+      }
+
+  det1det2_to_view_tangpos.resize(static_cast<std::size_t>(num_detectors) * num_detectors);
+  for (int det1_num = 0; det1_num < num_detectors; ++det1_num)
+    for (int det2_num = 0; det2_num < num_detectors; ++det2_num)
+      {
+        ViewTangPosSwap& entry = det1det2_to_view_tangpos[det1_num * num_detectors + det2_num];
+        if (det1_num == det2_num)
+          {
+            entry.view_num = 0;
+            entry.tang_pos_num = 0;
+            entry.swap_detectors = 0;
+            continue;
+          }
+        /*
+         This somewhat obscure formula was obtained by inverting the code for
+         get_det_num_pair_for_view_tangential_pos_num()
+        */
+        int swap_detectors;
+        /*
+        Note for implementation: avoid using % with negative numbers
+        so add num_detectors before doing modulo num_detectors
+        */
+        int tang_pos_num = (det1_num - det2_num + 3 * num_detectors / 2) % num_detectors;
+        int view_num = (det1_num - (tang_pos_num >> 1) + num_detectors) % num_detectors;
+
+        /* Now adjust ranges for view_num, tang_pos_num.
+        The next lines go only wrong in the singular (and irrelevant) case
+        det_num1 == det_num2 (when tang_pos_num == num_detectors - tang_pos_num)
+
+          We use the combinations of the following 'symmetries' of
+          (tang_pos_num, view_num) == (tang_pos_num+2*num_views, view_num + num_views)
+          == (-tang_pos_num, view_num + num_views)
+          Using the latter interchanges det_num1 and det_num2, and this leaves
+          the LOR the same in the 2D case. However, in 3D this interchanges the rings
+          as well. So, we keep track of this in swap_detectors, and return its final
+          value.
+        */
+        if (view_num < max_num_views)
+          {
+            if (tang_pos_num >= max_num_views)
+              {
+                tang_pos_num = num_detectors - tang_pos_num;
+                swap_detectors = 1;
+              }
+            else
+              {
+                swap_detectors = 0;
+              }
+          }
+        else
+          {
+            view_num -= max_num_views;
+            if (tang_pos_num >= max_num_views)
+              {
+                tang_pos_num -= num_detectors;
+                swap_detectors = 0;
+              }
+            else
+              {
+                tang_pos_num *= -1;
+                swap_detectors = 1;
+              }
+          }
+
+        entry.view_num = static_cast<std::int16_t>(view_num);
+        entry.tang_pos_num = static_cast<std::int16_t>(tang_pos_num);
+        entry.swap_detectors = static_cast<std::int16_t>(swap_detectors == 0);
+      }
+}
+
+END_NAMESPACE_STIR
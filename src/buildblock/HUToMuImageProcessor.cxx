@@ -9,7 +9,7 @@
 
 */
 /*
-    Copyright (C) 2019, 2020, UCL
+    Copyright (C) 2019, 2020, 2026, UCL
     This file is part of STIR.
 
     SPDX-License-Identifier: Apache-2.0
@@ -193,21 +193,28 @@ HUToMuImageProcessor<TargetT>::apply_scaling_to_HU(TargetT& output_image, const
 
   while (in_iter != input_image.end_all())
     {
-      if (*in_iter < breakPoint)
-        {
-          const float mu = a1 + b1 * (*in_iter);
-          *out_iter = (mu < 0.0f) ? 0.0f : mu;
-        }
-      else
-        {
-          *out_iter = a2 + b2 * (*in_iter);
-        }
-
+      *out_iter = this->HU_to_mu(*in_iter);
       ++in_iter;
       ++out_iter;
     }
 }
 
+template <typename TargetT>
+bool
+HUToMuImageProcessor<TargetT>::is_pointwise() const
+{
+  return true;
+}
+
+template <typename TargetT>
+void
+HUToMuImageProcessor<TargetT>::virtual_apply_pointwise(TargetT& density, const int outer_index) const
+{
+  auto& plane = density[outer_index];
+  for (auto iter = plane.begin_all(); iter != plane.end_all(); ++iter)
+    *iter = this->HU_to_mu(*iter);
+}
+
 template <typename TargetT>
 void
 HUToMuImageProcessor<TargetT>::virtual_apply(TargetT& out_density, const TargetT& in_density) const
@@ -219,8 +226,8 @@ template <typename TargetT>
 void
 HUToMuImageProcessor<TargetT>::virtual_apply(TargetT& density) const
 {
-  shared_ptr<TargetT> copy_sptr(density.clone());
-  this->apply_scaling_to_HU(density, *copy_sptr);
+  // point-wise, so no copy needed
+  this->apply_scaling_to_HU(density, density);
 }
 
 #ifdef _MSC_VER
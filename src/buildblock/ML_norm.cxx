@@ -870,6 +870,9 @@ FanProjData::sum() const
 {
   // return base_type::sum();
   float sum = 0;
+#ifdef STIR_OPENMP
+#  pragma omp parallel for reduction(+ : sum) schedule(dynamic)
+#endif
   for (int ra = get_min_ra(); ra <= get_max_ra(); ++ra)
     for (int a = get_min_a(); a <= get_max_a(); ++a)
       sum += this->sum(ra, a);
@@ -1282,6 +1285,10 @@ apply_block_norm(FanProjData& fan_data, const BlockData3D& block_data, const boo
   const int num_tangential_crystals_per_block = num_tangential_detectors / num_tangential_blocks;
   assert(num_tangential_blocks * num_tangential_crystals_per_block == num_tangential_detectors);
 
+#ifdef STIR_OPENMP
+  // note: only parallelise over ra, as entries with rb==ra are stored in the (ra,b) fan
+#  pragma omp parallel for schedule(dynamic)
+#endif
   for (int ra = fan_data.get_min_ra(); ra <= fan_data.get_max_ra(); ++ra)
     for (int a = fan_data.get_min_a(); a <= fan_data.get_max_a(); ++a)
       // loop rb from ra to avoid double counting
@@ -1394,6 +1401,10 @@ apply_geo_norm(FanProjData& fan_data, const GeoData3D& geo_data, const bool appl
               }
           }
 
+#ifdef STIR_OPENMP
+  // note: only parallelise over ra, as entries with rb==ra are stored in the (ra,b) fan
+#  pragma omp parallel for schedule(dynamic)
+#endif
   for (int ra = fan_data.get_min_ra(); ra <= fan_data.get_max_ra(); ++ra)
     for (int a = fan_data.get_min_a(); a <= fan_data.get_max_a(); ++a)
       //    for (int rb = fan_data.get_min_ra(); rb <= fan_data.get_max_ra(); ++rb)
@@ -1414,6 +1425,10 @@ void
 apply_efficiencies(FanProjData& fan_data, const DetectorEfficiencies& efficiencies, const bool apply)
 {
   const int num_detectors_per_ring = fan_data.get_num_detectors_per_ring();
+#ifdef STIR_OPENMP
+  // note: only parallelise over ra, as entries with rb==ra are stored in the (ra,b) fan
+#  pragma omp parallel for schedule(dynamic)
+#endif
   for (int ra = fan_data.get_min_ra(); ra <= fan_data.get_max_ra(); ++ra)
     for (int a = fan_data.get_min_a(); a <= fan_data.get_max_a(); ++a)
       // loop rb from ra to avoid double counting
@@ -1432,6 +1447,9 @@ apply_efficiencies(FanProjData& fan_data, const DetectorEfficiencies& efficienci
 void
 make_fan_sum_data(Array<2, float>& data_fan_sums, const FanProjData& fan_data)
 {
+#ifdef STIR_OPENMP
+#  pragma omp parallel for schedule(dynamic)
+#endif
   for (int ra = fan_data.get_min_ra(); ra <= fan_data.get_max_ra(); ++ra)
     for (int a = fan_data.get_min_a(); a <= fan_data.get_max_a(); ++a)
       data_fan_sums[ra][a] = fan_data.sum(ra, a);
@@ -1520,6 +1538,9 @@ make_fan_sum_data(Array<2, float>& data_fan_sums,
   assert(data_fan_sums.get_min_index() == 0);
   const int num_detectors_per_ring = data_fan_sums[0].get_length();
 
+#ifdef STIR_OPENMP
+#  pragma omp parallel for schedule(dynamic)
+#endif
   for (int ra = data_fan_sums.get_min_index(); ra <= data_fan_sums.get_max_index(); ++ra)
     for (int a = data_fan_sums[ra].get_min_index(); a <= data_fan_sums[ra].get_max_index(); ++a)
       {
@@ -1547,6 +1568,10 @@ make_geo_data(GeoData3D& geo_data, const FanProjData& fan_data)
   FanProjData work = fan_data;
   work.fill(0);
 
+#ifdef STIR_OPENMP
+  // note: only parallelise over ra, as entries with rb==ra are stored in the (ra,b) fan
+#  pragma omp parallel for schedule(dynamic)
+#endif
   for (int ra = fan_data.get_min_ra(); ra <= fan_data.get_max_ra(); ++ra)
     for (int a = fan_data.get_min_a(); a <= fan_data.get_max_a(); ++a)
       // 1// for (int rb = fan_data.get_min_ra(); rb <= fan_data.get_max_ra(); ++rb)
@@ -1568,6 +1593,10 @@ make_geo_data(GeoData3D& geo_data, const FanProjData& fan_data)
 
   geo_data.fill(0);
 
+#ifdef STIR_OPENMP
+  // every ra writes to different elements of geo_data
+#  pragma omp parallel for schedule(dynamic)
+#endif
   for (int ra = 0; ra < num_axial_crystals_per_block; ++ra)
     //  for (int a = 0; a <= num_transaxial_detectors/2; ++a)
     for (int a = 0; a < num_transaxial_crystals_per_block / 2; ++a)
@@ -1746,6 +1775,9 @@ double
 KL(const FanProjData& d1, const FanProjData& d2, const double threshold)
 {
   double sum = 0;
+#ifdef STIR_OPENMP
+#  pragma omp parallel for reduction(+ : sum) schedule(dynamic)
+#endif
   for (int ra = d1.get_min_ra(); ra <= d1.get_max_ra(); ++ra)
     {
       double asum = 0;
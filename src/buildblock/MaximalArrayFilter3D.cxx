@@ -18,8 +18,10 @@
 */
 #include "stir/MaximalArrayFilter3D.h"
 #include "stir/Coordinate3D.h"
+#include "stir/detail/extremum_filter_3d.h"
 #include <algorithm>
 #include <numeric>
+#include <functional>
 
 START_NAMESPACE_STIR
 
@@ -75,6 +77,16 @@ MaximalArrayFilter3D<elemT>::do_it(Array<3, elemT>& out_array, const Array<3, el
 {
   assert(out_array.get_index_range() == in_array.get_index_range());
 
+  if (in_array.is_regular())
+    {
+      detail::separable_extremum_filter_3d(out_array,
+                                           in_array,
+                                           Coordinate3D<int>(std::max(mask_radius_z, 0), std::max(mask_radius_y, 0), std::max(mask_radius_x, 0)),
+                                           std::greater<elemT>());
+      return;
+    }
+
+  // general case: find the maximum over all neighbours of every voxel
   Array<1, elemT> neighbours(0, (2 * mask_radius_x + 1) * (2 * mask_radius_y + 1) * (2 * mask_radius_z + 1) - 1);
 
   for (int z = out_array.get_min_index(); z <= out_array.get_max_index(); ++z)
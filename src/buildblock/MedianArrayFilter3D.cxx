@@ -28,8 +28,7 @@
 #include "stir/Coordinate3D.h"
 
 #include <algorithm>
-
-using std::nth_element;
+#include <vector>
 
 START_NAMESPACE_STIR
 
@@ -56,57 +55,83 @@ MedianArrayFilter3D<elemT>::MedianArrayFilter3D()
   this->mask_radius_z = 0;
 }
 
-template <typename elemT>
-int
-MedianArrayFilter3D<elemT>::extract_neighbours(Array<1, elemT>& neigbours,
-                                               const Array<3, elemT>& in_array,
-                                               const Coordinate3D<int>& c_pixel) const
-{
-  int index = 0;
-
-  for (int zi = -mask_radius_z; zi <= mask_radius_z; ++zi)
-    {
-      const int z = c_pixel[1] + zi;
-      if (z < in_array.get_min_index() || z > in_array.get_max_index())
-        continue;
-      for (int yi = -mask_radius_y; yi <= mask_radius_y; ++yi)
-        {
-          const int y = c_pixel[2] + yi;
-          if (y < in_array[z].get_min_index() || y > in_array[z].get_max_index())
-            continue;
-          for (int xi = -mask_radius_x; xi <= mask_radius_x; ++xi)
-            {
-              const int x = c_pixel[3] + xi;
-              if (x < in_array[z][y].get_min_index() || x > in_array[z][y].get_max_index())
-                continue;
-              neigbours[index++] = in_array[z][y][x];
-            }
-        }
-    }
-  return index;
-}
-
 template <typename elemT>
 void
 MedianArrayFilter3D<elemT>::do_it(Array<3, elemT>& out_array, const Array<3, elemT>& in_array) const
 {
   assert(out_array.get_index_range() == in_array.get_index_range());
 
-  Array<1, elemT> neighbours(0, (2 * mask_radius_x + 1) * (2 * mask_radius_y + 1) * (2 * mask_radius_z + 1) - 1);
-
-  for (int z = out_array.get_min_index(); z <= out_array.get_max_index(); ++z)
-    for (int y = out_array[z].get_min_index(); y <= out_array[z].get_max_index(); ++y)
-      for (int x = out_array[z][y].get_min_index(); x <= out_array[z][y].get_max_index(); ++x)
+  // We handle every row (along x) in the output by sliding the mask along x. The neighbours are kept
+  // in a sorted window, such that for every voxel we only need to remove the neighbours that leave the mask
+  // and insert the ones that enter it.
+#ifdef STIR_OPENMP
+#  pragma omp parallel
+#endif
+  {
+    std::vector<const Array<1, elemT>*> rows;
+    std::vector<elemT> window;
+    window.reserve((2 * mask_radius_x + 1) * (2 * mask_radius_y + 1) * (2 * mask_radius_z + 1));
+#ifdef STIR_OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+    for (int z = out_array.get_min_index(); z <= out_array.get_max_index(); ++z)
+      for (int y = out_array[z].get_min_index(); y <= out_array[z].get_max_index(); ++y)
         {
-          const int num_neighbours = extract_neighbours(neighbours, in_array, Coordinate3D<int>(z, y, x));
-          if (num_neighbours == 0)
-            continue;
-          nth_element(neighbours.begin(), neighbours.begin() + num_neighbours / 2, neighbours.end());
-          if (num_neighbours % 2 == 1)
-            out_array[z][y][x] = neighbours[num_neighbours / 2];
-          else
-            out_array[z][y][x] = (neighbours[num_neighbours / 2] + neighbours[num_neighbours / 2 - 1]) / 2;
+          // find all rows in the input that are in the mask
+          rows.clear();
+          for (int zi = -mask_radius_z; zi <= mask_radius_z; ++zi)
+            {
+              const int in_z = z + zi;
+              if (in_z < in_array.get_min_index() || in_z > in_array.get_max_index())
+                continue;
+              for (int yi = -mask_radius_y; yi <= mask_radius_y; ++yi)
+                {
+                  const int in_y = y + yi;
+                  if (in_y < in_array[in_z].get_min_index() || in_y > in_array[in_z].get_max_index())
+                    continue;
+                  rows.push_back(&in_array[in_z][in_y]);
+                }
+            }
+
+          window.clear();
+          const int min_x = out_array[z][y].get_min_index();
+          const int max_x = out_array[z][y].get_max_index();
+          for (int x = min_x; x <= max_x; ++x)
+            {
+              for (const Array<1, elemT>* row_ptr : rows)
+                {
+                  const Array<1, elemT>& row = *row_ptr;
+                  if (x == min_x)
+                    {
+                      for (int in_x = std::max(x - mask_radius_x, row.get_min_index());
+                           in_x <= std::min(x + mask_radius_x, row.get_max_index());
+                           ++in_x)
+                        window.insert(std::upper_bound(window.begin(), window.end(), row[in_x]), row[in_x]);
+                    }
+                  else
+                    {
+                      const int leaving_x = x - mask_radius_x - 1;
+                      if (leaving_x >= row.get_min_index() && leaving_x <= row.get_max_index())
+                        {
+                          const auto iter = std::lower_bound(window.begin(), window.end(), row[leaving_x]);
+                          assert(iter != window.end());
+                          window.erase(iter);
+                        }
+                      const int entering_x = x + mask_radius_x;
+                      if (entering_x >= row.get_min_index() && entering_x <= row.get_max_index())
+                        window.insert(std::upper_bound(window.begin(), window.end(), row[entering_x]), row[entering_x]);
+                    }
+                }
+              const std::size_t num_neighbours = window.size();
+              if (num_neighbours == 0)
+                continue;
+              if (num_neighbours % 2 == 1)
+                out_array[z][y][x] = window[num_neighbours / 2];
+              else
+                out_array[z][y][x] = (window[num_neighbours / 2] + window[num_neighbours / 2 - 1]) / 2;
+            }
         }
+  }
 }
 
 template <typename elemT>
@@ -0,0 +1,456 @@
+/*!
+  \file
+  \ingroup buildblock
+  \brief Implementation of class stir::Profiler
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+
+#include "stir/Profiler.h"
+#include "stir/error.h"
+#include <boost/format.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+START_NAMESPACE_STIR
+
+namespace
+{
+typedef std::chrono::steady_clock clock_type;
+
+//! a region in the tree of one thread
+struct RegionNode
+{
+  RegionNode(const char* const name_v, RegionNode* const parent_v)
+      : name(name_v),
+        parent(parent_v)
+  {}
+
+  RegionNode* find_or_add_child(const char* const child_name)
+  {
+    for (auto& child : children)
+      if (child->name == child_name || std::strcmp(child->name, child_name) == 0)
+        return child.get();
+    children.emplace_back(new RegionNode(child_name, this));
+    return children.back().get();
+  }
+
+  void reset()
+  {
+    num_calls = 0;
+    total_time = 0;
+    for (auto& child : children)
+      child->reset();
+  }
+
+  const char* const name;
+  RegionNode* const parent;
+  std::vector<std::unique_ptr<RegionNode>> children;
+  unsigned long num_calls = 0;
+  double total_time = 0;
+  clock_type::time_point start_time;
+};
+
+struct TraceEvent
+{
+  const char* name;
+  //! in microseconds since the start of the program
+  double start;
+  //! in microseconds
+  double duration;
+};
+
+struct ThreadData
+{
+  explicit ThreadData(const int thread_num_v)
+      : thread_num(thread_num_v),
+        root("", nullptr),
+        current(&root)
+  {}
+
+  const int thread_num;
+  RegionNode root;
+  RegionNode* current;
+  std::vector<TraceEvent> trace_events;
+  unsigned long num_dropped_trace_events = 0;
+  std::vector<std::pair<const char*, double>> counters;
+};
+
+//! all data of the profiler (for all threads)
+struct Registry
+{
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadData>> threads;
+  const clock_type::time_point origin = clock_type::now();
+  std::atomic<bool> trace_enabled{ false };
+  std::atomic<std::size_t> max_num_trace_events_per_thread{ 1000000 };
+};
+
+// Note: the registry needs to be constructed before (and therefore destructed after) profiler_from_environment below
+Registry registry;
+
+thread_local ThreadData* this_thread_data_ptr = nullptr;
+
+ThreadData&
+get_this_thread_data()
+{
+  if (!this_thread_data_ptr)
+    {
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      registry.threads.emplace_back(new ThreadData(static_cast<int>(registry.threads.size())));
+      this_thread_data_ptr = registry.threads.back().get();
+    }
+  return *this_thread_data_ptr;
+}
+
+double
+microseconds_since_origin(const clock_type::time_point t)
+{
+  return std::chrono::duration<double, std::micro>(t - registry.origin).count();
+}
+
+//! a region combined over threads
+struct MergedRegion
+{
+  std::map<std::string, MergedRegion> children;
+  unsigned long num_calls = 0;
+  double total_time = 0;
+  int num_threads = 0;
+  double max_thread_time = 0;
+};
+
+void
+merge_children(MergedRegion& merged, const RegionNode& node)
+{
+  for (const auto& child : node.children)
+    {
+      MergedRegion& merged_child = merged.children[child->name];
+      if (child->num_calls > 0)
+        {
+          merged_child.num_calls += child->num_calls;
+          merged_child.total_time += child->total_time;
+          ++merged_child.num_threads;
+          merged_child.max_thread_time = std::max(merged_child.max_thread_time, child->total_time);
+        }
+      merge_children(merged_child, *child);
+    }
+}
+
+void
+flatten(std::vector<Profiler::RegionSummary>& summaries, const MergedRegion& merged, const std::string& path, const int depth)
+{
+  std::vector<std::pair<const std::string*, const MergedRegion*>> children;
+  for (const auto& child : merged.children)
+    if (child.second.num_calls > 0)
+      children.push_back(std::make_pair(&child.first, &child.second));
+  std::stable_sort(children.begin(), children.end(), [](const auto& a, const auto& b) {
+    return a.second->total_time > b.second->total_time;
+  });
+  for (const auto& child : children)
+    {
+      const MergedRegion& region = *child.second;
+      double children_time = 0;
+      for (const auto& grand_child : region.children)
+        children_time += grand_child.second.total_time;
+      Profiler::RegionSummary summary;
+      summary.path = path.empty() ? *child.first : path + "/" + *child.first;
+      summary.depth = depth;
+      summary.num_calls = region.num_calls;
+      summary.total_time = region.total_time;
+      summary.self_time = std::max(0., region.total_time - children_time);
+      summary.num_threads = region.num_threads;
+      summary.max_thread_time = region.max_thread_time;
+      summaries.push_back(summary);
+      flatten(summaries, region, summary.path, depth + 1);
+    }
+}
+
+void
+write_json_string(std::ostream& s, const char* str)
+{
+  s << '"';
+  for (; *str != '\0'; ++str)
+    {
+      switch (*str)
+        {
+        case '"':
+          s << "\\\"";
+          break;
+        case '\\':
+          s << "\\\\";
+          break;
+        case '\n':
+          s << "\\n";
+          break;
+        case '\t':
+          s << "\\t";
+          break;
+        default:
+          s << *str;
+        }
+    }
+  s << '"';
+}
+
+//! enables the profiler if STIR_PROFILING is set, and writes the results at the end of the program
+class ProfilerFromEnvironment
+{
+public:
+  ProfilerFromEnvironment()
+  {
+    const char* const profiling = std::getenv("STIR_PROFILING");
+    const char* const trace_file = std::getenv("STIR_PROFILING_TRACE_FILE");
+    if (trace_file && trace_file[0] != '\0')
+      trace_filename = trace_file;
+    write_summary = profiling && profiling[0] != '\0' && std::strcmp(profiling, "0") != 0;
+    if (write_summary || !trace_filename.empty())
+      Profiler::set_enabled(true);
+    if (!trace_filename.empty())
+      Profiler::set_trace_enabled(true);
+  }
+
+  ~ProfilerFromEnvironment()
+  {
+    try
+      {
+        if (write_summary)
+          Profiler::write_summary(std::cerr);
+        if (!trace_filename.empty())
+          Profiler::write_chrome_trace(trace_filename);
+      }
+    catch (...)
+      {
+        std::cerr << "Profiler: error writing results at the end of the program\n";
+      }
+  }
+
+private:
+  bool write_summary;
+  std::string trace_filename;
+};
+
+ProfilerFromEnvironment profiler_from_environment;
+
+} // namespace
+
+std::atomic<bool> Profiler::enabled_flag(false);
+
+void
+Profiler::set_enabled(const bool enabled)
+{
+  enabled_flag.store(enabled);
+}
+
+bool
+Profiler::is_trace_enabled()
+{
+  return registry.trace_enabled.load();
+}
+
+void
+Profiler::set_trace_enabled(const bool enabled)
+{
+  registry.trace_enabled.store(enabled);
+}
+
+void
+Profiler::set_max_num_trace_events_per_thread(const std::size_t max_num_events)
+{
+  registry.max_num_trace_events_per_thread.store(max_num_events);
+}
+
+void
+Profiler::reset()
+{
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto& thread_data : registry.threads)
+    {
+      thread_data->root.reset();
+      thread_data->trace_events.clear();
+      thread_data->num_dropped_trace_events = 0;
+      thread_data->counters.clear();
+    }
+}
+
+void
+Profiler::enter_region(const char* const name)
+{
+  ThreadData& thread_data = get_this_thread_data();
+  RegionNode* const node = thread_data.current->find_or_add_child(name);
+  thread_data.current = node;
+  node->start_time = clock_type::now();
+}
+
+void
+Profiler::leave_region()
+{
+  const clock_type::time_point end_time = clock_type::now();
+  ThreadData& thread_data = get_this_thread_data();
+  RegionNode* const node = thread_data.current;
+  if (node == &thread_data.root)
+    return; // should not happen
+  const double duration = std::chrono::duration<double>(end_time - node->start_time).count();
+  ++node->num_calls;
+  node->total_time += duration;
+  thread_data.current = node->parent;
+  if (registry.trace_enabled.load(std::memory_order_relaxed))
+    {
+      if (thread_data.trace_events.size() < registry.max_num_trace_events_per_thread.load(std::memory_order_relaxed))
+        {
+          const TraceEvent event = { node->name, microseconds_since_origin(node->start_time), duration * 1.E6 };
+          thread_data.trace_events.push_back(event);
+        }
+      else
+        ++thread_data.num_dropped_trace_events;
+    }
+}
+
+void
+Profiler::add_to_counter(const char* const name, const double value)
+{
+  auto& counters = get_this_thread_data().counters;
+  for (auto& counter : counters)
+    if (counter.first == name || std::strcmp(counter.first, name) == 0)
+      {
+        counter.second += value;
+        return;
+      }
+  counters.push_back(std::make_pair(name, value));
+}
+
+std::vector<Profiler::RegionSummary>
+Profiler::get_region_summaries()
+{
+  MergedRegion merged_root;
+  {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto& thread_data : registry.threads)
+      merge_children(merged_root, thread_data->root);
+  }
+  std::vector<RegionSummary> summaries;
+  flatten(summaries, merged_root, "", 0);
+  return summaries;
+}
+
+std::vector<std::pair<std::string, double>>
+Profiler::get_counters()
+{
+  std::map<std::string, double> counters;
+  {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto& thread_data : registry.threads)
+      for (const auto& counter : thread_data->counters)
+        counters[counter.first] += counter.second;
+  }
+  return std::vector<std::pair<std::string, double>>(counters.begin(), counters.end());
+}
+
+void
+Profiler::write_summary(std::ostream& s)
+{
+  const std::vector<RegionSummary> summaries = get_region_summaries();
+  const std::vector<std::pair<std::string, double>> counters = get_counters();
+
+  // find width of first column
+  std::size_t name_width = 6;
+  for (const auto& summary : summaries)
+    {
+      const std::size_t name_start = summary.path.rfind('/') == std::string::npos ? 0 : summary.path.rfind('/') + 1;
+      name_width = std::max(name_width, 2 * summary.depth + summary.path.size() - name_start);
+    }
+  for (const auto& counter : counters)
+    name_width = std::max(name_width, counter.first.size());
+
+  std::ostringstream str;
+  str << "\nProfiler summary (wall-clock times in seconds)\n";
+  str << std::left << std::setw(static_cast<int>(name_width)) << "region" << std::right << std::setw(12) << "calls"
+      << std::setw(12) << "total" << std::setw(12) << "self" << std::setw(9) << "threads" << std::setw(12) << "max/thread"
+      << '\n';
+  str << std::fixed << std::setprecision(4);
+  for (const auto& summary : summaries)
+    {
+      const std::size_t name_start = summary.path.rfind('/') == std::string::npos ? 0 : summary.path.rfind('/') + 1;
+      const std::string name = std::string(2 * summary.depth, ' ') + summary.path.substr(name_start);
+      str << std::left << std::setw(static_cast<int>(name_width)) << name << std::right << std::setw(12) << summary.num_calls
+          << std::setw(12) << summary.total_time << std::setw(12) << summary.self_time << std::setw(9) << summary.num_threads
+          << std::setw(12) << summary.max_thread_time << '\n';
+    }
+  if (!counters.empty())
+    {
+      str << std::defaultfloat << "\ncounter\n";
+      for (const auto& counter : counters)
+        str << std::left << std::setw(static_cast<int>(name_width)) << counter.first << std::right << std::setw(12)
+            << counter.second << '\n';
+    }
+  s << str.str();
+}
+
+void
+Profiler::write_chrome_trace(std::ostream& s)
+{
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  s << std::fixed << std::setprecision(3);
+  s << "{\"traceEvents\":[\n";
+  bool first = true;
+  unsigned long num_dropped_trace_events = 0;
+  for (const auto& thread_data : registry.threads)
+    {
+      s << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << thread_data->thread_num
+        << ",\"args\":{\"name\":\"thread " << thread_data->thread_num << "\"}}";
+      first = false;
+      for (const auto& event : thread_data->trace_events)
+        {
+          s << ",\n{\"name\":";
+          write_json_string(s, event.name);
+          s << ",\"cat\":\"stir\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread_data->thread_num << ",\"ts\":" << event.start
+            << ",\"dur\":" << event.duration << "}";
+        }
+      num_dropped_trace_events += thread_data->num_dropped_trace_events;
+    }
+  // add counters (summed over threads) at the current time
+  {
+    std::map<std::string, double> counters;
+    for (const auto& thread_data : registry.threads)
+      for (const auto& counter : thread_data->counters)
+        counters[counter.first] += counter.second;
+    const double now = microseconds_since_origin(clock_type::now());
+    for (const auto& counter : counters)
+      {
+        s << (first ? "" : ",\n") << "{\"name\":";
+        first = false;
+        write_json_string(s, counter.first.c_str());
+        s << ",\"cat\":\"stir\",\"ph\":\"C\",\"pid\":0,\"tid\":0,\"ts\":" << now << ",\"args\":{\"value\":" << std::defaultfloat
+          << counter.second << std::fixed << "}}";
+      }
+  }
+  s << "\n],\n\"displayTimeUnit\":\"ms\",\n\"otherData\":{\"num_dropped_trace_events\":" << num_dropped_trace_events
+    << "}}\n";
+}
+
+void
+Profiler::write_chrome_trace(const std::string& filename)
+{
+  std::ofstream s(filename.c_str());
+  if (!s)
+    error(boost::format("Profiler: error opening file %1% for writing the trace") % filename);
+  write_chrome_trace(s);
+  if (!s)
+    error(boost::format("Profiler: error writing trace to file %1%") % filename);
+}
+
+END_NAMESPACE_STIR
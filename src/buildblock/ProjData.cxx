@@ -44,11 +44,14 @@
 #ifdef HAVE_HDF5
 #  include "stir/ProjDataGEHDF5.h"
 #  include "stir/IO/GEHDF5Wrapper.h"
+#  include "stir/ProjDataHDF5.h"
+#  include "stir/IO/HDF5_utilities.h"
 #endif
 #include "stir/IO/stir_ecat7.h"
 #include "stir/ViewgramIndices.h"
 #include "stir/is_null_ptr.h"
 #include "stir/numerics/norm.h"
+#include "stir/Profiler.h"
 #include <cstring>
 #include <fstream>
 #include <algorithm>
@@ -80,6 +83,7 @@ START_NAMESPACE_STIR
    <li> Interfile (using  read_interfile_PDFS())
    <li> ECAT 7 3D sinograms and attenuation files
    >li> GE RDF9 (in HDF5)
+   <li> STIR HDF5 (see ProjDataHDF5)
    </ul>
 
    Developer's note: ideally the return value would be an stir::unique_ptr.
@@ -137,6 +141,13 @@ ProjData::read_from_file(const string& filename, const std::ios::openmode openmo
     }
 
 #ifdef HAVE_HDF5
+  if (is_STIR_HDF5_file(actual_filename, "projection data"))
+    {
+#  ifndef NDEBUG
+      info("ProjData::read_from_file trying to read " + filename + " as STIR HDF5", 3);
+#  endif
+      return shared_ptr<ProjData>(new ProjDataHDF5(actual_filename, openmode));
+    }
   if (GE::RDF_HDF5::GEHDF5Wrapper::check_GE_signature(actual_filename))
     {
 #  ifndef NDEBUG
@@ -258,6 +269,7 @@ ProjData::get_related_viewgrams(const ViewgramIndices& viewgram_indices,
                                 const bool make_num_tangential_poss_odd,
                                 const int timing_pos) const
 {
+  STIR_PROFILE_REGION("read viewgrams");
   vector<ViewSegmentNumbers> pairs;
   symmetries_used->get_related_view_segment_numbers(pairs, viewgram_indices);
 
@@ -294,7 +306,7 @@ ProjData::get_related_viewgrams(const ViewgramIndices& viewgram_indices,
 Succeeded
 ProjData::set_related_viewgrams(const RelatedViewgrams<float>& viewgrams)
 {
-
+  STIR_PROFILE_REGION("write viewgrams");
   RelatedViewgrams<float>::const_iterator r_viewgrams_iter = viewgrams.begin();
   while (r_viewgrams_iter != viewgrams.end())
     {
@@ -404,6 +416,14 @@ Succeeded
 ProjData::write_to_file(const string& output_filename) const
 {
 
+#ifdef HAVE_HDF5
+  if (output_filename.size() > 3 && output_filename.compare(output_filename.size() - 3, 3, ".h5") == 0)
+    {
+      ProjDataHDF5 out_projdata(get_exam_info_sptr(), this->proj_data_info_sptr, output_filename);
+      out_projdata.fill(*this);
+      return Succeeded::yes;
+    }
+#endif
   ProjDataInterfile out_projdata(get_exam_info_sptr(), this->proj_data_info_sptr, output_filename, ios::out);
 
   out_projdata.fill(*this);
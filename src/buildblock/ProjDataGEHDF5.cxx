@@ -29,6 +29,10 @@
 #include "stir/error.h"
 #include "stir/CPUTimer.h"
 #include "stir/HighResWallClockTimer.h"
+#include "stir/is_null_ptr.h"
+#include <boost/format.hpp>
+#include <algorithm>
+#include <exception>
 using std::ofstream;
 using std::fstream;
 using std::ios;
@@ -67,23 +71,77 @@ ProjDataGEHDF5::initialise_from_wrapper()
 void
 ProjDataGEHDF5::initialise_viewgram_buffer()
 {
-
-  if (!this->tof_data.empty())
+  if (!this->cached_view_indices.empty())
     error("there is already data loaded. Aborting");
 
-  tof_data.reserve(get_num_views());
-  Array<3, unsigned char> buffer;
+  this->tof_data.resize(get_num_views());
+  this->max_num_cached_views = get_num_views();
+}
 
-  for (int view_num = get_min_view_num(); view_num <= get_max_view_num(); view_num++)
-    {
-      // view numbering for initialise_proj_data starts from 1
-      m_input_hdf5_sptr->initialise_proj_data(view_num - get_min_view_num() + 1);
+void
+ProjDataGEHDF5::set_max_num_cached_views(const int max_num)
+{
+  if (max_num < 1)
+    error(boost::format("ProjDataGEHDF5: maximum number of cached views should be at least 1, but is %1%") % max_num);
+  this->max_num_cached_views = max_num;
+  this->trim_viewgram_buffer();
+}
 
-      m_input_hdf5_sptr->read_sinogram(buffer);
-      this->tof_data.push_back(buffer);
+int
+ProjDataGEHDF5::get_max_num_cached_views() const
+{
+  return this->max_num_cached_views;
+}
+
+void
+ProjDataGEHDF5::trim_viewgram_buffer() const
+{
+  while (static_cast<int>(this->cached_view_indices.size()) > this->max_num_cached_views)
+    {
+      this->tof_data[this->cached_view_indices.back()].reset();
+      this->cached_view_indices.pop_back();
     }
 }
 
+shared_ptr<const Array<3, unsigned char>>
+ProjDataGEHDF5::get_tof_data_for_view(const int view_index) const
+{
+  shared_ptr<const Array<3, unsigned char>> view_data_sptr;
+  std::exception_ptr exception_ptr;
+  // the cache and the HDF5 reading cannot be accessed by multiple threads at the same time.
+  // We use the critical section for all HDF5 calls (see stir/IO/HDF5_utilities.h).
+  // Exceptions cannot leave the critical section, so they are rethrown afterwards.
+#ifdef STIR_OPENMP
+#  pragma omp critical(STIR_HDF5)
+#endif
+  {
+    try
+      {
+        view_data_sptr = this->tof_data[view_index];
+        if (is_null_ptr(view_data_sptr))
+          {
+            // view numbering for initialise_proj_data starts from 1
+            this->m_input_hdf5_sptr->initialise_proj_data(view_index + 1);
+            shared_ptr<Array<3, unsigned char>> buffer_sptr(new Array<3, unsigned char>);
+            this->m_input_hdf5_sptr->read_sinogram(*buffer_sptr);
+            view_data_sptr = buffer_sptr;
+            this->tof_data[view_index] = view_data_sptr;
+          }
+        else
+          this->cached_view_indices.remove(view_index);
+        this->cached_view_indices.push_front(view_index);
+        this->trim_viewgram_buffer();
+      }
+    catch (...)
+      {
+        exception_ptr = std::current_exception();
+      }
+  }
+  if (exception_ptr)
+    std::rethrow_exception(exception_ptr);
+  return view_data_sptr;
+}
+
 void
 ProjDataGEHDF5::initialise_segment_sequence()
 {
@@ -127,9 +185,12 @@ ProjDataGEHDF5::get_viewgram(const int view_num,
   // not necessary
   // ret_viewgram.fill(0.0);
 
+  const shared_ptr<const Array<3, unsigned char>> view_data_sptr = get_tof_data_for_view(get_max_view_num() - view_num);
+  const Array<3, unsigned char>& view_data = *view_data_sptr;
+
   // find num TOF bins
   BasicCoordinate<3, int> min_index, max_index;
-  tof_data[0].get_regular_range(min_index, max_index);
+  view_data.get_regular_range(min_index, max_index);
   const int num_tof_poss = max_index[2] - min_index[2] + 1;
   if (num_tof_poss <= 0)
     error("ProjDataGEHDF5: internal error on TOF data dimension");
@@ -142,17 +203,25 @@ ProjDataGEHDF5::get_viewgram(const int view_num,
     error("ProjDataGEHDF5: internal error on views");
   if (get_max_tangential_pos_num() + get_min_tangential_pos_num() != 0)
     error("ProjDataGEHDF5: internal error on tangential positions");
+  const int min_axial_pos_num = get_min_axial_pos_num(segment_num);
+  const int num_axial_poss = get_num_axial_poss(segment_num);
+  const int first_axial_pos = static_cast<int>(seg_ax_offset[find_segment_index_in_sequence(segment_num)]);
+  // Sum over TOF bins. The axial positions are contiguous in memory, so loop over them in the inner loop.
+  std::vector<float> sums(num_axial_poss);
   for (int tang_pos = ret_viewgram.get_min_tangential_pos_num(), i_tang = 0;
        tang_pos <= ret_viewgram.get_max_tangential_pos_num();
        ++tang_pos, ++i_tang)
-    for (int i_axial = get_min_axial_pos_num(segment_num), axial_pos = seg_ax_offset[find_segment_index_in_sequence(segment_num)];
-         i_axial <= get_max_axial_pos_num(segment_num);
-         i_axial++, axial_pos++)
+    {
+      std::fill(sums.begin(), sums.end(), 0.F);
       for (int tof_poss = 0; tof_poss <= num_tof_poss - 1; tof_poss++)
         {
-          ret_viewgram[i_axial][-tang_pos]
-              += static_cast<float>(tof_data[get_max_view_num() - view_num][i_tang][tof_poss][axial_pos]);
+          Array<1, unsigned char>::const_iterator data_iter = view_data[i_tang][tof_poss].begin() + first_axial_pos;
+          for (int i = 0; i < num_axial_poss; ++i, ++data_iter)
+            sums[i] += static_cast<float>(*data_iter);
         }
+      for (int i = 0; i < num_axial_poss; ++i)
+        ret_viewgram[min_axial_pos_num + i][-tang_pos] = sums[i];
+    }
 
 #if 0
     ofstream write_tof_data;
@@ -0,0 +1,346 @@
+/*!
+
+  \file
+  \ingroup projdata
+  \brief Implementation of class stir::ProjDataHDF5
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+
+#include "stir/ProjDataHDF5.h"
+#include "stir/ProjDataFromStream.h"
+#include "stir/ProjDataInfo.h"
+#include "stir/Viewgram.h"
+#include "stir/Sinogram.h"
+#include "stir/SegmentByView.h"
+#include "stir/SegmentBySinogram.h"
+#include "stir/IndexRange2D.h"
+#include "stir/IO/HDF5_utilities.h"
+#include "stir/IO/interfile.h"
+#include "stir/IO/InterfileHeader.h"
+#include "stir/IO/InterfilePDFSHeaderSPECT.h"
+#include "stir/utilities.h"
+#include "stir/Succeeded.h"
+#include "stir/error.h"
+#include "stir/warning.h"
+#include <boost/format.hpp>
+#include <exception>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+START_NAMESPACE_STIR
+
+static const char* const STIR_HDF5_data_type = "projection data";
+
+//! parse the header with the appropriate Interfile header class
+template <class HeaderT>
+static void
+parse_header(HeaderT& hdr,
+             std::istream& input,
+             shared_ptr<const ExamInfo>& exam_info_sptr,
+             shared_ptr<const ProjDataInfo>& pdi_sptr)
+{
+  if (!hdr.parse(input))
+    error("ProjDataHDF5: parsing of the Interfile header in the HDF5 file failed");
+  exam_info_sptr = hdr.get_exam_info_sptr();
+  pdi_sptr = hdr.data_info_sptr->create_shared_clone();
+}
+
+ProjDataHDF5::ProjDataHDF5(const std::string& filename, const std::ios::openmode open_mode)
+{
+  shared_ptr<const ExamInfo> new_exam_info_sptr;
+  shared_ptr<const ProjDataInfo> new_proj_data_info_sptr;
+  std::string header;
+  std::string error_message;
+  std::exception_ptr exception_ptr;
+#ifdef STIR_OPENMP
+#  pragma omp critical(STIR_HDF5)
+#endif
+  {
+    try
+      {
+        file.openFile(filename, (open_mode & std::ios::out) ? H5F_ACC_RDWR : H5F_ACC_RDONLY);
+        header = read_STIR_HDF5_header(file, STIR_HDF5_data_type);
+      }
+    catch (H5::Exception& e)
+      {
+        error_message = "ProjDataHDF5: error opening " + filename + ": " + e.getDetailMsg();
+      }
+    catch (...)
+      {
+        exception_ptr = std::current_exception();
+      }
+  }
+  if (exception_ptr)
+    std::rethrow_exception(exception_ptr);
+  if (!error_message.empty())
+    error(error_message);
+
+  bool is_spect;
+  {
+    std::istringstream header_stream(header);
+    MinimalInterfileHeader hdr;
+    if (!hdr.parse(header_stream, false))
+      error("ProjDataHDF5: parsing of the Interfile header in " + filename + " failed");
+    is_spect = hdr.get_exam_info().imaging_modality.get_modality() == ImagingModality::NM;
+  }
+  std::istringstream header_stream(header);
+  if (is_spect)
+    {
+      InterfilePDFSHeaderSPECT hdr;
+      parse_header(hdr, header_stream, new_exam_info_sptr, new_proj_data_info_sptr);
+    }
+  else
+    {
+      InterfilePDFSHeader hdr;
+      parse_header(hdr, header_stream, new_exam_info_sptr, new_proj_data_info_sptr);
+    }
+  this->exam_info_sptr = new_exam_info_sptr;
+  this->proj_data_info_sptr = new_proj_data_info_sptr;
+}
+
+ProjDataHDF5::ProjDataHDF5(shared_ptr<const ExamInfo> const& exam_info_sptr,
+                           shared_ptr<const ProjDataInfo> const& proj_data_info_sptr,
+                           const std::string& filename,
+                           const int compression_level)
+    : ProjData(exam_info_sptr, proj_data_info_sptr)
+{
+  // construct the Interfile header via a ProjDataFromStream (with a null stream, as the data are in the HDF5 file)
+  std::ostringstream header;
+  {
+    const ProjDataFromStream pdfs(exam_info_sptr, proj_data_info_sptr, shared_ptr<std::iostream>(), std::streamoff(0));
+    if (write_basic_interfile_PDFS_header(header, find_filename(filename.c_str()), pdfs) == Succeeded::no)
+      error("ProjDataHDF5: error constructing the Interfile header for " + filename);
+  }
+  std::string error_message;
+  std::exception_ptr exception_ptr;
+#ifdef STIR_OPENMP
+#  pragma omp critical(STIR_HDF5)
+#endif
+  {
+    try
+      {
+        file = H5::H5File(filename, H5F_ACC_TRUNC);
+        write_STIR_HDF5_header(file, STIR_HDF5_data_type, header.str());
+        create_datasets(compression_level);
+      }
+    catch (H5::Exception& e)
+      {
+        error_message = "ProjDataHDF5: error creating " + filename + ": " + e.getDetailMsg();
+      }
+    catch (...)
+      {
+        exception_ptr = std::current_exception();
+      }
+  }
+  if (exception_ptr)
+    std::rethrow_exception(exception_ptr);
+  if (!error_message.empty())
+    error(error_message);
+}
+
+ProjDataHDF5::~ProjDataHDF5()
+{
+#ifdef STIR_OPENMP
+#  pragma omp critical(STIR_HDF5)
+#endif
+  {
+    try
+      {
+        file.close();
+      }
+    catch (H5::Exception&)
+      {
+        // cannot call error() in a destructor
+      }
+  }
+}
+
+std::string
+ProjDataHDF5::get_dataset_name(const int segment_num, const int timing_pos)
+{
+  return boost::str(boost::format("segment_%1%_timing_pos_%2%") % segment_num % timing_pos);
+}
+
+void
+ProjDataHDF5::create_datasets(const int compression_level)
+{
+  const hsize_t num_views = static_cast<hsize_t>(get_num_views());
+  const hsize_t num_tangential_poss = static_cast<hsize_t>(get_num_tangential_poss());
+  for (int timing_pos = get_min_tof_pos_num(); timing_pos <= get_max_tof_pos_num(); ++timing_pos)
+    for (int segment_num = get_min_segment_num(); segment_num <= get_max_segment_num(); ++segment_num)
+      {
+        const hsize_t num_axial_poss = static_cast<hsize_t>(get_num_axial_poss(segment_num));
+        const hsize_t dims[3] = { num_views, num_axial_poss, num_tangential_poss };
+        // one chunk per viewgram
+        const std::vector<hsize_t> chunk_dims = { 1, num_axial_poss, num_tangential_poss };
+        const H5::DataSpace dataspace(3, dims);
+        file.createDataSet(get_dataset_name(segment_num, timing_pos),
+                           H5::PredType::NATIVE_FLOAT,
+                           dataspace,
+                           create_STIR_HDF5_dataset_properties(chunk_dims, compression_level));
+      }
+}
+
+void
+ProjDataHDF5::read_hyperslab(
+    float* data, const int segment_num, const int timing_pos, const hsize_t* offset, const hsize_t* count) const
+{
+  std::string error_message;
+#ifdef STIR_OPENMP
+#  pragma omp critical(STIR_HDF5)
+#endif
+  {
+    try
+      {
+        H5::DataSet dataset = file.openDataSet(get_dataset_name(segment_num, timing_pos));
+        H5::DataSpace file_space = dataset.getSpace();
+        file_space.selectHyperslab(H5S_SELECT_SET, count, offset);
+        const H5::DataSpace memory_space(3, count);
+        dataset.read(data, H5::PredType::NATIVE_FLOAT, memory_space, file_space);
+      }
+    catch (H5::Exception& e)
+      {
+        error_message = boost::str(boost::format("ProjDataHDF5: error reading segment %1%, TOF bin %2% from %3%: %4%")
+                                   % segment_num % timing_pos % file.getFileName() % e.getDetailMsg());
+      }
+  }
+  if (!error_message.empty())
+    error(error_message);
+}
+
+Succeeded
+ProjDataHDF5::write_hyperslab(
+    const float* data, const int segment_num, const int timing_pos, const hsize_t* offset, const hsize_t* count)
+{
+  std::string error_message;
+#ifdef STIR_OPENMP
+#  pragma omp critical(STIR_HDF5)
+#endif
+  {
+    try
+      {
+        H5::DataSet dataset = file.openDataSet(get_dataset_name(segment_num, timing_pos));
+        H5::DataSpace file_space = dataset.getSpace();
+        file_space.selectHyperslab(H5S_SELECT_SET, count, offset);
+        const H5::DataSpace memory_space(3, count);
+        dataset.write(data, H5::PredType::NATIVE_FLOAT, memory_space, file_space);
+      }
+    catch (H5::Exception& e)
+      {
+        error_message = boost::str(boost::format("ProjDataHDF5: error writing segment %1%, TOF bin %2% to %3%: %4%")
+                                   % segment_num % timing_pos % file.getFileName() % e.getDetailMsg());
+      }
+  }
+  if (!error_message.empty())
+    {
+      warning(error_message);
+      return Succeeded::no;
+    }
+  return Succeeded::yes;
+}
+
+Viewgram<float>
+ProjDataHDF5::get_viewgram(const int view_num,
+                           const int segment_num,
+                           const bool make_num_tangential_poss_odd,
+                           const int timing_pos) const
+{
+  Viewgram<float> viewgram(proj_data_info_sptr, view_num, segment_num, timing_pos);
+  const hsize_t offset[3] = { static_cast<hsize_t>(view_num - get_min_view_num()), 0, 0 };
+  const hsize_t count[3]
+      = { 1, static_cast<hsize_t>(get_num_axial_poss(segment_num)), static_cast<hsize_t>(get_num_tangential_poss()) };
+  std::vector<float> buffer(viewgram.size_all());
+  read_hyperslab(&buffer[0], segment_num, timing_pos, offset, count);
+  std::copy(buffer.begin(), buffer.end(), viewgram.begin_all());
+
+  if (make_num_tangential_poss_odd && (get_num_tangential_poss() % 2 == 0))
+    {
+      viewgram.grow(IndexRange2D(get_min_axial_pos_num(segment_num),
+                                 get_max_axial_pos_num(segment_num),
+                                 get_min_tangential_pos_num(),
+                                 get_max_tangential_pos_num() + 1));
+    }
+  return viewgram;
+}
+
+Succeeded
+ProjDataHDF5::set_viewgram(const Viewgram<float>& v)
+{
+  if (get_num_tangential_poss() != v.get_num_tangential_poss()
+      || get_num_axial_poss(v.get_segment_num()) != v.get_num_axial_poss())
+    {
+      warning("ProjDataHDF5::set_viewgram: viewgram has incorrect size");
+      return Succeeded::no;
+    }
+  const hsize_t offset[3] = { static_cast<hsize_t>(v.get_view_num() - get_min_view_num()), 0, 0 };
+  const hsize_t count[3] = { 1,
+                             static_cast<hsize_t>(get_num_axial_poss(v.get_segment_num())),
+                             static_cast<hsize_t>(get_num_tangential_poss()) };
+  std::vector<float> buffer(v.begin_all(), v.end_all());
+  return write_hyperslab(&buffer[0], v.get_segment_num(), v.get_timing_pos_num(), offset, count);
+}
+
+Sinogram<float>
+ProjDataHDF5::get_sinogram(const int ax_pos_num,
+                           const int segment_num,
+                           const bool make_num_tangential_poss_odd,
+                           const int timing_pos) const
+{
+  Sinogram<float> sinogram(proj_data_info_sptr, ax_pos_num, segment_num, timing_pos);
+  const hsize_t offset[3] = { 0, static_cast<hsize_t>(ax_pos_num - get_min_axial_pos_num(segment_num)), 0 };
+  const hsize_t count[3] = { static_cast<hsize_t>(get_num_views()), 1, static_cast<hsize_t>(get_num_tangential_poss()) };
+  std::vector<float> buffer(sinogram.size_all());
+  read_hyperslab(&buffer[0], segment_num, timing_pos, offset, count);
+  std::copy(buffer.begin(), buffer.end(), sinogram.begin_all());
+
+  if (make_num_tangential_poss_odd && (get_num_tangential_poss() % 2 == 0))
+    {
+      sinogram.grow(
+          IndexRange2D(get_min_view_num(), get_max_view_num(), get_min_tangential_pos_num(), get_max_tangential_pos_num() + 1));
+    }
+  return sinogram;
+}
+
+Succeeded
+ProjDataHDF5::set_sinogram(const Sinogram<float>& s)
+{
+  if (get_num_tangential_poss() != s.get_num_tangential_poss() || get_num_views() != s.get_num_views())
+    {
+      warning("ProjDataHDF5::set_sinogram: sinogram has incorrect size");
+      return Succeeded::no;
+    }
+  const hsize_t offset[3] = { 0, static_cast<hsize_t>(s.get_axial_pos_num() - get_min_axial_pos_num(s.get_segment_num())), 0 };
+  const hsize_t count[3] = { static_cast<hsize_t>(get_num_views()), 1, static_cast<hsize_t>(get_num_tangential_poss()) };
+  std::vector<float> buffer(s.begin_all(), s.end_all());
+  return write_hyperslab(&buffer[0], s.get_segment_num(), s.get_timing_pos_num(), offset, count);
+}
+
+SegmentByView<float>
+ProjDataHDF5::get_segment_by_view(const int segment_num, const int timing_pos) const
+{
+  SegmentByView<float> segment = proj_data_info_sptr->get_empty_segment_by_view(segment_num, false, timing_pos);
+  const hsize_t offset[3] = { 0, 0, 0 };
+  const hsize_t count[3] = { static_cast<hsize_t>(get_num_views()),
+                             static_cast<hsize_t>(get_num_axial_poss(segment_num)),
+                             static_cast<hsize_t>(get_num_tangential_poss()) };
+  std::vector<float> buffer(segment.size_all());
+  read_hyperslab(&buffer[0], segment_num, timing_pos, offset, count);
+  std::copy(buffer.begin(), buffer.end(), segment.begin_all());
+  return segment;
+}
+
+SegmentBySinogram<float>
+ProjDataHDF5::get_segment_by_sinogram(const int segment_num, const int timing_pos) const
+{
+  return SegmentBySinogram<float>(get_segment_by_view(segment_num, timing_pos));
+}
+
+END_NAMESPACE_STIR
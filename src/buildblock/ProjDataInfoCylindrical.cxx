@@ -260,6 +260,33 @@ ProjDataInfoCylindrical::initialise_ring_diff_arrays() const
             }
         }
     }
+  // initialise ring_pair_to_segment_axial_pos (uses ring_diff_to_segment_num and ax_pos_num_offset)
+  if (sampling_corresponds_to_physical_rings)
+    {
+      const int num_rings = get_scanner_ptr()->get_num_rings();
+      const int min_ring_difference = get_min_ring_difference(get_min_segment_num());
+      const int max_ring_difference = get_max_ring_difference(get_max_segment_num());
+      ring_pair_to_segment_axial_pos.resize(static_cast<std::size_t>(num_rings) * num_rings);
+      for (int ring1 = 0; ring1 < num_rings; ++ring1)
+        for (int ring2 = 0; ring2 < num_rings; ++ring2)
+          {
+            SegmentAxialPos& entry = ring_pair_to_segment_axial_pos[ring1 * num_rings + ring2];
+            // first set to impossible value
+            entry.segment_num = get_max_segment_num() + 1;
+            entry.axial_pos_num = 0;
+            // KT 01/08/2002 swapped rings
+            const int ring_diff = ring2 - ring1;
+            if (ring_diff > max_ring_difference || ring_diff < min_ring_difference)
+              continue;
+            const int segment_num = ring_diff_to_segment_num[ring_diff];
+            if (segment_num > get_max_segment_num())
+              continue;
+            entry.segment_num = segment_num;
+            // see above for some info
+            entry.axial_pos_num
+                = (ring1 + ring2 - ax_pos_num_offset[segment_num]) * get_num_axial_poss_per_ring_inc(segment_num) / 2;
+          }
+    }
   // initialise segment_axial_pos_to_ring1_plus_ring2
   if (sampling_corresponds_to_physical_rings)
     {
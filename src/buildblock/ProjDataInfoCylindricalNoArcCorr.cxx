@@ -31,11 +31,10 @@
 #include "stir/LORCoordinates.h"
 #include "stir/round.h"
 #include <algorithm>
+#include "stir/is_null_ptr.h"
 #include "stir/error.h"
 #include <sstream>
 
-#include <boost/static_assert.hpp>
-
 using std::endl;
 using std::ends;
 using std::string;
@@ -66,14 +65,12 @@ ProjDataInfoCylindricalNoArcCorr::ProjDataInfoCylindricalNoArcCorr(const shared_
     error("ProjDataInfoCylindricalNoArcCorr: number of tangential positions exceeds the maximum number of non arc-corrected bins "
           "set for the scanner.");
 
-  uncompressed_view_tangpos_to_det1det2_initialised = false;
-  det1det2_to_uncompressed_view_tangpos_initialised = false;
+  // look-up tables only make sense for an even number of detectors (checked when they are used)
+  if (scanner_sptr->get_num_detectors_per_ring() > 0 && scanner_sptr->get_num_detectors_per_ring() % 2 == 0)
+    det_pair_tables_sptr = DetectorPairLookupTables::get_tables(scanner_sptr->get_num_detectors_per_ring());
+  check_det_pair_tables_range();
   if (scanner_sptr->is_tof_ready())
     set_tof_mash_factor(tof_mash_factor);
-#ifdef STIR_OPENMP_SAFE_BUT_SLOW
-  this->initialise_uncompressed_view_tangpos_to_det1det2();
-  this->initialise_det1det2_to_uncompressed_view_tangpos();
-#endif
 }
 
 ProjDataInfoCylindricalNoArcCorr::ProjDataInfoCylindricalNoArcCorr(const shared_ptr<Scanner> scanner_sptr,
@@ -127,195 +124,57 @@ ProjDataInfoCylindricalNoArcCorr::parameter_info() const
   return s.str();
 }
 
-float
-ProjDataInfoCylindricalNoArcCorr::get_psi_offset() const
+void
+ProjDataInfoCylindricalNoArcCorr::set_num_tangential_poss(const int num_tang_poss)
 {
-  return this->get_scanner_ptr()->get_intrinsic_azimuthal_tilt();
+  ProjDataInfoCylindrical::set_num_tangential_poss(num_tang_poss);
+  check_det_pair_tables_range();
 }
 
-/*
-   Warning:
-   this code makes use of an implementation dependent feature:
-   bit shifting negative ints to the right.
-    -1 >> 1 should be -1
-    -2 >> 1 should be -1
-   This is ok on SUNs (gcc, but probably SUNs cc as well), Parsytec (gcc),
-   Pentium (gcc, VC++) and probably every other system which uses
-   the 2-complement convention.
-
-   Update: compile time assert is implemented.
-*/
-
-/*!
-  Go from sinograms to detectors.
-
-  Because sinograms are not arc-corrected, tang_pos_num corresponds
-  to an angle as well. Before interleaving we have that
-  \verbatim
-  det_angle_1 = LOR_angle + bin_angle
-  det_angle_2 = LOR_angle + (Pi - bin_angle)
-  \endverbatim
-  (Hint: understand this first at LOR_angle=0, then realise that
-  other LOR_angles follow just by rotation)
-
-  Code gets slightly intricate because:
-  - angles have to be defined modulo 2 Pi (so num_detectors)
-  - interleaving
-*/
 void
-ProjDataInfoCylindricalNoArcCorr::initialise_uncompressed_view_tangpos_to_det1det2() const
+ProjDataInfoCylindricalNoArcCorr::set_min_tangential_pos_num(const int min_tang_poss)
 {
-  BOOST_STATIC_ASSERT(-1 >> 1 == -1);
-  BOOST_STATIC_ASSERT(-2 >> 1 == -1);
-
-  const int num_detectors = get_scanner_ptr()->get_num_detectors_per_ring();
-
-  assert(num_detectors % 2 == 0);
-#ifndef NDEBUG
-  // check views range from 0 to Pi
-  // PW Supports intrinsic tilt.
-  const float v_offset = get_azimuthal_angle_offset();
-  assert(fabs(get_phi(Bin(0, 0, 0, 0)) - v_offset) < 1.E-4);
-  assert(fabs(get_phi(Bin(0, get_num_views(), 0, 0)) - v_offset - _PI) < 1.E-4);
-#endif
-  const int min_tang_pos_num = -(num_detectors / 2) + 1;
-  const int max_tang_pos_num = -(num_detectors / 2) + num_detectors;
-
-  if (this->get_min_tangential_pos_num() < min_tang_pos_num || this->get_max_tangential_pos_num() > max_tang_pos_num)
-    {
-      error("The tangential_pos range (%d to %d) for this projection data is too large.\n"
-            "Maximum supported range is from %d to %d",
-            this->get_min_tangential_pos_num(),
-            this->get_max_tangential_pos_num(),
-            min_tang_pos_num,
-            max_tang_pos_num);
-    }
-
-  uncompressed_view_tangpos_to_det1det2.grow(0, num_detectors / 2 - 1);
-  for (int v_num = 0; v_num <= num_detectors / 2 - 1; ++v_num)
-    {
-      uncompressed_view_tangpos_to_det1det2[v_num].grow(min_tang_pos_num, max_tang_pos_num);
-
-      for (int tp_num = min_tang_pos_num; tp_num <= max_tang_pos_num; ++tp_num)
-        {
-          /*
-             adapted from CTI code
-             Note for implementation: avoid using % with negative numbers
-             so add num_detectors before doing modulo num_detectors)
-            */
-          uncompressed_view_tangpos_to_det1det2[v_num][tp_num].det1_num = (v_num + (tp_num >> 1) + num_detectors) % num_detectors;
-          uncompressed_view_tangpos_to_det1det2[v_num][tp_num].det2_num
-              = (v_num - ((tp_num + 1) >> 1) + num_detectors / 2) % num_detectors;
-        }
-    }
-    // thanks to yohjp:
-    // http://stackoverflow.com/questions/27975737/how-to-handle-cached-data-structures-with-multi-threading-e-g-openmp
-#if defined(STIR_OPENMP) && _OPENMP >= 201012
-#  pragma omp atomic write
-#endif
-  uncompressed_view_tangpos_to_det1det2_initialised = true;
+  ProjDataInfoCylindrical::set_min_tangential_pos_num(min_tang_poss);
+  check_det_pair_tables_range();
 }
 
 void
-ProjDataInfoCylindricalNoArcCorr::initialise_det1det2_to_uncompressed_view_tangpos() const
+ProjDataInfoCylindricalNoArcCorr::set_max_tangential_pos_num(const int max_tang_poss)
 {
-  BOOST_STATIC_ASSERT(-1 >> 1 == -1);
-  BOOST_STATIC_ASSERT(-2 >> 1 == -1);
-
-  const int num_detectors = get_scanner_ptr()->get_num_detectors_per_ring();
-
-  if (num_detectors % 2 != 0)
-    {
-      error("Number of detectors per ring should be even but is %d", num_detectors);
-    }
-  if (this->get_min_view_num() != 0)
-    {
-      error("Minimum view number should currently be zero to be able to use get_view_tangential_pos_num_for_det_num_pair()");
-    }
-#ifndef NDEBUG
-  // check views range from 0 to Pi
-  // PW Supports intrinsic tilt.
-  const float v_offset = get_azimuthal_angle_offset();
-  assert(fabs(get_phi(Bin(0, 0, 0, 0)) - v_offset) < 1.E-4);
-  assert(fabs(get_phi(Bin(0, get_max_view_num() + 1, 0, 0)) - v_offset - _PI) < 1.E-4);
-#endif
-  // const int min_tang_pos_num = -(num_detectors/2);
-  // const int max_tang_pos_num = -(num_detectors/2)+num_detectors;
-  const int max_num_views = num_detectors / 2;
+  ProjDataInfoCylindrical::set_max_tangential_pos_num(max_tang_poss);
+  check_det_pair_tables_range();
+}
 
-  det1det2_to_uncompressed_view_tangpos.grow(0, num_detectors - 1);
-  for (int det1_num = 0; det1_num < num_detectors; ++det1_num)
-    {
-      det1det2_to_uncompressed_view_tangpos[det1_num].grow(0, num_detectors - 1);
+/*! This does not call error() if the range is too large, as that is fine as long as
+  get_det_num_pair_for_view_tangential_pos_num() etc are not used
+  (e.g. ProjDataInfo::get_empty_viewgram() can add a tangential position).
+*/
+void
+ProjDataInfoCylindricalNoArcCorr::check_det_pair_tables_range()
+{
+  det_pair_tables_cover_tangential_range
+      = !is_null_ptr(det_pair_tables_sptr)
+        && get_min_tangential_pos_num() >= det_pair_tables_sptr->get_min_tangential_pos_num()
+        && get_max_tangential_pos_num() <= det_pair_tables_sptr->get_max_tangential_pos_num();
+}
 
-      for (int det2_num = 0; det2_num < num_detectors; ++det2_num)
-        {
-          if (det1_num == det2_num)
-            continue;
-          /*
-           This somewhat obscure formula was obtained by inverting the code for
-           get_det_num_pair_for_view_tangential_pos_num()
-           This can be simplified (especially all the branching later on), but
-           as we execute this code only occasionally, it's probably not worth it.
-          */
-          int swap_detectors;
-          /*
-          Note for implementation: avoid using % with negative numbers
-          so add num_detectors before doing modulo num_detectors
-          */
-          int tang_pos_num = (det1_num - det2_num + 3 * num_detectors / 2) % num_detectors;
-          int view_num = (det1_num - (tang_pos_num >> 1) + num_detectors) % num_detectors;
-
-          /* Now adjust ranges for view_num, tang_pos_num.
-          The next lines go only wrong in the singular (and irrelevant) case
-          det_num1 == det_num2 (when tang_pos_num == num_detectors - tang_pos_num)
-
-            We use the combinations of the following 'symmetries' of
-            (tang_pos_num, view_num) == (tang_pos_num+2*num_views, view_num + num_views)
-            == (-tang_pos_num, view_num + num_views)
-            Using the latter interchanges det_num1 and det_num2, and this leaves
-            the LOR the same in the 2D case. However, in 3D this interchanges the rings
-            as well. So, we keep track of this in swap_detectors, and return its final
-            value.
-          */
-          if (view_num < max_num_views)
-            {
-              if (tang_pos_num >= max_num_views)
-                {
-                  tang_pos_num = num_detectors - tang_pos_num;
-                  swap_detectors = 1;
-                }
-              else
-                {
-                  swap_detectors = 0;
-                }
-            }
-          else
-            {
-              view_num -= max_num_views;
-              if (tang_pos_num >= max_num_views)
-                {
-                  tang_pos_num -= num_detectors;
-                  swap_detectors = 0;
-                }
-              else
-                {
-                  tang_pos_num *= -1;
-                  swap_detectors = 1;
-                }
-            }
+void
+ProjDataInfoCylindricalNoArcCorr::error_det_pair_tables_do_not_cover_tangential_range() const
+{
+  if (is_null_ptr(det_pair_tables_sptr))
+    error("Number of detectors per ring should be even but is %d", get_scanner_ptr()->get_num_detectors_per_ring());
+  error("The tangential_pos range (%d to %d) for this projection data is too large.\n"
+        "Maximum supported range is from %d to %d",
+        get_min_tangential_pos_num(),
+        get_max_tangential_pos_num(),
+        det_pair_tables_sptr->get_min_tangential_pos_num(),
+        det_pair_tables_sptr->get_max_tangential_pos_num());
+}
 
-          det1det2_to_uncompressed_view_tangpos[det1_num][det2_num].view_num = view_num;
-          det1det2_to_uncompressed_view_tangpos[det1_num][det2_num].tang_pos_num = tang_pos_num;
-          det1det2_to_uncompressed_view_tangpos[det1_num][det2_num].swap_detectors = swap_detectors == 0;
-        }
-    }
-    // thanks to yohjp:
-    // http://stackoverflow.com/questions/27975737/how-to-handle-cached-data-structures-with-multi-threading-e-g-openmp
-#if defined(STIR_OPENMP) && _OPENMP >= 201012
-#  pragma omp atomic write
-#endif
-  det1det2_to_uncompressed_view_tangpos_initialised = true;
+float
+ProjDataInfoCylindricalNoArcCorr::get_psi_offset() const
+{
+  return this->get_scanner_ptr()->get_intrinsic_azimuthal_tilt();
 }
 
 unsigned int
@@ -330,7 +189,8 @@ ProjDataInfoCylindricalNoArcCorr::get_all_det_pos_pairs_for_bin(vector<Detection
                                                                 const Bin& bin,
                                                                 bool ignore_non_spatial_dimensions) const
 {
-  this->initialise_uncompressed_view_tangpos_to_det1det2_if_not_done_yet();
+  if (!det_pair_tables_cover_tangential_range)
+    error_det_pair_tables_do_not_cover_tangential_range();
 
   dps.resize(get_num_det_pos_pairs_for_bin(bin, ignore_non_spatial_dimensions));
 
@@ -355,8 +215,9 @@ ProjDataInfoCylindricalNoArcCorr::get_all_det_pos_pairs_for_bin(vector<Detection
        uncompressed_view_num < (bin.view_num() + 1) * get_view_mashing_factor();
        ++uncompressed_view_num)
     {
-      const int det1_num = uncompressed_view_tangpos_to_det1det2[uncompressed_view_num][bin.tangential_pos_num()].det1_num;
-      const int det2_num = uncompressed_view_tangpos_to_det1det2[uncompressed_view_num][bin.tangential_pos_num()].det2_num;
+      int det1_num, det2_num;
+      det_pair_tables_sptr->get_det_num_pair_for_view_tangential_pos_num(
+          det1_num, det2_num, uncompressed_view_num, bin.tangential_pos_num());
       for (auto rings_iter = ring_pairs.begin(); rings_iter != ring_pairs.end(); ++rings_iter)
         {
           for (int uncompressed_timing_pos_num = min_timing_pos_num; uncompressed_timing_pos_num <= max_timing_pos_num;
@@ -473,9 +334,8 @@ ProjDataInfoCylindricalNoArcCorr::find_cartesian_coordinates_given_scanner_coord
   int d1, d2, r1, r2;
   int tpos = timing_pos_num;
 
-  this->initialise_det1det2_to_uncompressed_view_tangpos_if_not_done_yet();
-
-  if (!det1det2_to_uncompressed_view_tangpos[det1][det2].swap_detectors)
+  int view_num, tang_pos_num;
+  if (!get_view_tangential_pos_num_for_det_num_pair(view_num, tang_pos_num, det1, det2))
     {
       d1 = det2;
       d2 = det1;
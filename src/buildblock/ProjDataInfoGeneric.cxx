@@ -33,6 +33,7 @@
 
 #include "stir/round.h"
 #include "stir/error.h"
+#include "stir/warning.h"
 #include <math.h>
 
 using std::min_element;
@@ -89,9 +90,147 @@ set_ring_spacing(float ring_spacing_v)
 }
 #endif
 
+void
+ProjDataInfoGeneric::set_num_tangential_poss(const int num_tang_poss)
+{
+  clear_LOR_geometry_cache();
+  ProjDataInfoCylindrical::set_num_tangential_poss(num_tang_poss);
+}
+
+void
+ProjDataInfoGeneric::set_num_axial_poss_per_segment(const VectorWithOffset<int>& num_axial_poss_per_segment)
+{
+  clear_LOR_geometry_cache();
+  ProjDataInfoCylindrical::set_num_axial_poss_per_segment(num_axial_poss_per_segment);
+}
+
+void
+ProjDataInfoGeneric::set_min_axial_pos_num(const int min_ax_pos_num, const int segment_num)
+{
+  clear_LOR_geometry_cache();
+  ProjDataInfoCylindrical::set_min_axial_pos_num(min_ax_pos_num, segment_num);
+}
+
+void
+ProjDataInfoGeneric::set_max_axial_pos_num(const int max_ax_pos_num, const int segment_num)
+{
+  clear_LOR_geometry_cache();
+  ProjDataInfoCylindrical::set_max_axial_pos_num(max_ax_pos_num, segment_num);
+}
+
+void
+ProjDataInfoGeneric::set_min_tangential_pos_num(const int min_tang_poss)
+{
+  clear_LOR_geometry_cache();
+  ProjDataInfoCylindrical::set_min_tangential_pos_num(min_tang_poss);
+}
+
+void
+ProjDataInfoGeneric::set_max_tangential_pos_num(const int max_tang_poss)
+{
+  clear_LOR_geometry_cache();
+  ProjDataInfoCylindrical::set_max_tangential_pos_num(max_tang_poss);
+}
+
+void
+ProjDataInfoGeneric::reduce_segment_range(const int min_segment_num, const int max_segment_num)
+{
+  clear_LOR_geometry_cache();
+  ProjDataInfoCylindrical::reduce_segment_range(min_segment_num, max_segment_num);
+}
+
+void
+ProjDataInfoGeneric::clear_LOR_geometry_cache()
+{
+  LOR_geometry_cache_sptr.reset();
+}
+
+void
+ProjDataInfoGeneric::set_up_LOR_geometry_cache() const
+{
+  if (has_LOR_geometry_cache())
+    return;
+
+  if (get_scanner_ptr()->get_detector_map_sptr() && get_scanner_ptr()->get_detector_map_sptr()->get_sigma() != 0)
+    {
+      warning("ProjDataInfoGeneric: detector positions are randomised, so not precomputing LOR geometry");
+      return;
+    }
+
+  auto cache_sptr = std::make_shared<LORGeometryCache>();
+  cache_sptr->segment_offset.grow(get_min_segment_num(), get_max_segment_num());
+  std::size_t num_bins = 0;
+  for (int segment_num = get_min_segment_num(); segment_num <= get_max_segment_num(); ++segment_num)
+    {
+      cache_sptr->segment_offset[segment_num] = num_bins;
+      num_bins += static_cast<std::size_t>(get_num_axial_poss(segment_num)) * get_num_views() * get_num_tangential_poss();
+    }
+  cache_sptr->z1.resize(num_bins);
+  cache_sptr->z2.resize(num_bins);
+  cache_sptr->phi.resize(num_bins);
+  cache_sptr->beta.resize(num_bins);
+  cache_sptr->radius.resize(num_bins);
+  cache_sptr->swapped.resize(num_bins);
+
+  // make sure lazily initialised look-up tables exist before going multi-threaded
+  {
+    const Bin bin(get_min_segment_num(), get_min_view_num(), get_min_axial_pos_num(get_min_segment_num()), 0);
+    LORInAxialAndNoArcCorrSinogramCoordinates<float> lor;
+    compute_LOR(lor, bin);
+  }
+
+  for (int segment_num = get_min_segment_num(); segment_num <= get_max_segment_num(); ++segment_num)
+    {
+#ifdef STIR_OPENMP
+#  pragma omp parallel for collapse(2) schedule(dynamic)
+#endif
+      for (int axial_pos_num = get_min_axial_pos_num(segment_num); axial_pos_num <= get_max_axial_pos_num(segment_num);
+           ++axial_pos_num)
+        for (int view_num = get_min_view_num(); view_num <= get_max_view_num(); ++view_num)
+          {
+            Bin bin(segment_num, view_num, axial_pos_num, get_min_tangential_pos_num());
+            LORInAxialAndNoArcCorrSinogramCoordinates<float> lor;
+            std::size_t idx = cache_sptr->segment_offset[segment_num]
+                              + (static_cast<std::size_t>(axial_pos_num - get_min_axial_pos_num(segment_num)) * get_num_views()
+                                 + (view_num - get_min_view_num()))
+                                    * get_num_tangential_poss();
+            for (bin.tangential_pos_num() = get_min_tangential_pos_num();
+                 bin.tangential_pos_num() <= get_max_tangential_pos_num();
+                 ++bin.tangential_pos_num(), ++idx)
+              {
+                compute_LOR(lor, bin);
+                cache_sptr->z1[idx] = lor.z1();
+                cache_sptr->z2[idx] = lor.z2();
+                cache_sptr->phi[idx] = lor.phi();
+                cache_sptr->beta[idx] = lor.beta();
+                cache_sptr->radius[idx] = lor.radius();
+                cache_sptr->swapped[idx] = lor.is_swapped();
+              }
+          }
+    }
+  LOR_geometry_cache_sptr = cache_sptr;
+}
+
 //! warning Find lor from cartesian coordinates of detector pair
 void
 ProjDataInfoGeneric::get_LOR(LORInAxialAndNoArcCorrSinogramCoordinates<float>& lor, const Bin& bin) const
+{
+  std::size_t idx;
+  if (get_LOR_geometry_cache_index(idx, bin))
+    {
+      lor = LORInAxialAndNoArcCorrSinogramCoordinates<float>(LOR_geometry_cache_sptr->z1[idx],
+                                                             LOR_geometry_cache_sptr->z2[idx],
+                                                             LOR_geometry_cache_sptr->phi[idx],
+                                                             LOR_geometry_cache_sptr->beta[idx],
+                                                             LOR_geometry_cache_sptr->radius[idx],
+                                                             LOR_geometry_cache_sptr->swapped[idx] != 0);
+      return;
+    }
+  compute_LOR(lor, bin);
+}
+
+void
+ProjDataInfoGeneric::compute_LOR(LORInAxialAndNoArcCorrSinogramCoordinates<float>& lor, const Bin& bin) const
 {
   CartesianCoordinate3D<float> _p1;
   CartesianCoordinate3D<float> _p2;
@@ -35,8 +35,6 @@
 
 #include <sstream>
 
-#include <boost/static_assert.hpp>
-
 using std::endl;
 using std::ends;
 
@@ -61,17 +59,38 @@ ProjDataInfoGenericNoArcCorr::ProjDataInfoGenericNoArcCorr(const shared_ptr<Scan
   if (scanner_sptr->get_max_num_views() != num_views)
     error("ProjDataInfoGenericNoArcCorr: view mashing is not supported");
 
-  uncompressed_view_tangpos_to_det1det2_initialised = false;
-  det1det2_to_uncompressed_view_tangpos_initialised = false;
-#ifdef STIR_OPENMP_SAFE_BUT_SLOW
-  this->initialise_uncompressed_view_tangpos_to_det1det2();
-  this->initialise_det1det2_to_uncompressed_view_tangpos();
-#endif
+  // look-up tables only make sense for an even number of detectors (checked when they are used)
+  if (scanner_sptr->get_num_detectors_per_ring() > 0 && scanner_sptr->get_num_detectors_per_ring() % 2 == 0)
+    det_pair_tables_sptr = DetectorPairLookupTables::get_tables(scanner_sptr->get_num_detectors_per_ring());
+  check_det_pair_tables_range();
 
   // find shift between "new" centre-of-scanner and "old" centre-of-first-ring coordinate system
   this->z_shift.z() = this->get_scanner_ptr()->get_coordinate_for_det_pos(DetectionPosition<>(0, 0, 0)).z();
   this->z_shift.y() = 0;
   this->z_shift.x() = 0;
+
+  this->initialise_detector_centres();
+}
+
+void
+ProjDataInfoGenericNoArcCorr::initialise_detector_centres()
+{
+  detector_centres_sptr.reset();
+  const auto detector_map_sptr = get_scanner_ptr()->get_detector_map_sptr();
+  if (!detector_map_sptr || detector_map_sptr->get_sigma() != 0)
+    return;
+
+  const int num_rings = get_scanner_ptr()->get_num_rings();
+  const int num_detectors = get_scanner_ptr()->get_num_detectors_per_ring();
+  auto centres_sptr = std::make_shared<std::vector<CartesianCoordinate3D<float>>>(num_rings * num_detectors);
+  for (int ring_num = 0; ring_num < num_rings; ++ring_num)
+    for (int det_num = 0; det_num < num_detectors; ++det_num)
+      {
+        CartesianCoordinate3D<float> coord = detector_map_sptr->get_coordinate_for_det_pos(DetectionPosition<>(det_num, ring_num, 0));
+        coord.z() -= z_shift.z();
+        (*centres_sptr)[ring_num * num_detectors + det_num] = coord;
+      }
+  detector_centres_sptr = centres_sptr;
 }
 
 ProjDataInfo*
@@ -107,180 +126,51 @@ ProjDataInfoGenericNoArcCorr::parameter_info() const
   return s.str();
 }
 
-/*
-   TODO make compile time assert
-
-   Warning:
-   this code makes use of an implementation dependent feature:
-   bit shifting negative ints to the right.
-    -1 >> 1 should be -1
-    -2 >> 1 should be -1
-   This is ok on SUNs (gcc, but probably SUNs cc as well), Parsytec (gcc),
-   Pentium (gcc, VC++) and probably every other system which uses
-   the 2-complement convention.
-
-   Update: compile time assert is implemented.
-*/
-
-/*!
-  Go from sinograms to detectors.
-
-  Because sinograms are not arc-corrected, tang_pos_num corresponds
-  to an angle as well. Before interleaving we have that
-  \verbatim
-  det_angle_1 = LOR_angle + bin_angle
-  det_angle_2 = LOR_angle + (Pi - bin_angle)
-  \endverbatim
-  (Hint: understand this first at LOR_angle=0, then realise that
-  other LOR_angles follow just by rotation)
-
-  Code gets slightly intricate because:
-  - angles have to be defined modulo 2 Pi (so num_detectors)
-  - interleaving
-*/
-
-//! build look-up table for get_view_tangential_pos_num_for_det_num_pair()
 void
-ProjDataInfoGenericNoArcCorr::initialise_uncompressed_view_tangpos_to_det1det2() const
+ProjDataInfoGenericNoArcCorr::set_num_tangential_poss(const int num_tang_poss)
 {
-  BOOST_STATIC_ASSERT(-1 >> 1 == -1);
-  BOOST_STATIC_ASSERT(-2 >> 1 == -1);
-
-  const int num_detectors = get_scanner_ptr()->get_num_detectors_per_ring();
-  assert(num_detectors % 2 == 0);
-
-  const int min_tang_pos_num = -(num_detectors / 2) + 1;
-  const int max_tang_pos_num = -(num_detectors / 2) + num_detectors;
-
-  if (this->get_min_tangential_pos_num() < min_tang_pos_num || this->get_max_tangential_pos_num() > max_tang_pos_num)
-    {
-      error("The tangential_pos range (%d to %d) for this projection data is too large.\n"
-            "Maximum supported range is from %d to %d",
-            this->get_min_tangential_pos_num(),
-            this->get_max_tangential_pos_num(),
-            min_tang_pos_num,
-            max_tang_pos_num);
-    }
-
-  uncompressed_view_tangpos_to_det1det2.grow(0, num_detectors / 2 - 1);
-  for (int v_num = 0; v_num <= num_detectors / 2 - 1; ++v_num)
-    {
-      uncompressed_view_tangpos_to_det1det2[v_num].grow(min_tang_pos_num, max_tang_pos_num);
-
-      for (int tp_num = min_tang_pos_num; tp_num <= max_tang_pos_num; ++tp_num)
-        {
-          /*
-             adapted from CTI code
-             Note for implementation: avoid using % with negative numbers
-             so add num_detectors before doing modulo num_detectors)
-            */
-          uncompressed_view_tangpos_to_det1det2[v_num][tp_num].det1_num = (v_num + (tp_num >> 1) + num_detectors) % num_detectors;
-          uncompressed_view_tangpos_to_det1det2[v_num][tp_num].det2_num
-              = (v_num - ((tp_num + 1) >> 1) + num_detectors / 2) % num_detectors;
-        }
-    }
-    // thanks to yohjp:
-    // http://stackoverflow.com/questions/27975737/how-to-handle-cached-data-structures-with-multi-threading-e-g-openmp
-#if defined(STIR_OPENMP) && _OPENMP >= 201012
-#  pragma omp atomic write
-#endif
-  uncompressed_view_tangpos_to_det1det2_initialised = true;
+  ProjDataInfoGeneric::set_num_tangential_poss(num_tang_poss);
+  check_det_pair_tables_range();
 }
 
 void
-ProjDataInfoGenericNoArcCorr::initialise_det1det2_to_uncompressed_view_tangpos() const
+ProjDataInfoGenericNoArcCorr::set_min_tangential_pos_num(const int min_tang_poss)
 {
-  BOOST_STATIC_ASSERT(-1 >> 1 == -1);
-  BOOST_STATIC_ASSERT(-2 >> 1 == -1);
-
-  const int num_detectors = get_scanner_ptr()->get_num_detectors_per_ring();
-
-  if (num_detectors % 2 != 0)
-    {
-      error("Number of detectors per ring should be even but is %d", num_detectors);
-    }
-  if (this->get_min_view_num() != 0)
-    {
-      error("Minimum view number should currently be zero to be able to use get_view_tangential_pos_num_for_det_num_pair()");
-    }
+  ProjDataInfoGeneric::set_min_tangential_pos_num(min_tang_poss);
+  check_det_pair_tables_range();
+}
 
-  // const int min_tang_pos_num = -(num_detectors/2);
-  // const int max_tang_pos_num = -(num_detectors/2)+num_detectors;
-  const int max_num_views = num_detectors / 2;
+void
+ProjDataInfoGenericNoArcCorr::set_max_tangential_pos_num(const int max_tang_poss)
+{
+  ProjDataInfoGeneric::set_max_tangential_pos_num(max_tang_poss);
+  check_det_pair_tables_range();
+}
 
-  det1det2_to_uncompressed_view_tangpos.grow(0, num_detectors - 1);
-  for (int det1_num = 0; det1_num < num_detectors; ++det1_num)
-    {
-      det1det2_to_uncompressed_view_tangpos[det1_num].grow(0, num_detectors - 1);
+/*! This does not call error() if the range is too large, as that is fine as long as
+  get_det_num_pair_for_view_tangential_pos_num() etc are not used
+  (e.g. ProjDataInfo::get_empty_viewgram() can add a tangential position).
+*/
+void
+ProjDataInfoGenericNoArcCorr::check_det_pair_tables_range()
+{
+  det_pair_tables_cover_tangential_range
+      = !is_null_ptr(det_pair_tables_sptr)
+        && get_min_tangential_pos_num() >= det_pair_tables_sptr->get_min_tangential_pos_num()
+        && get_max_tangential_pos_num() <= det_pair_tables_sptr->get_max_tangential_pos_num();
+}
 
-      for (int det2_num = 0; det2_num < num_detectors; ++det2_num)
-        {
-          if (det1_num == det2_num)
-            continue;
-          /*
-           This somewhat obscure formula was obtained by inverting the code for
-           get_det_num_pair_for_view_tangential_pos_num()
-           This can be simplified (especially all the branching later on), but
-           as we execute this code only occasionally, it's probably not worth it.
-          */
-          int swap_detectors;
-          /*
-          Note for implementation: avoid using % with negative numbers
-          so add num_detectors before doing modulo num_detectors
-          */
-          int tang_pos_num = (det1_num - det2_num + 3 * num_detectors / 2) % num_detectors;
-          int view_num = (det1_num - (tang_pos_num >> 1) + num_detectors) % num_detectors;
-
-          /* Now adjust ranges for view_num, tang_pos_num.
-          The next lines go only wrong in the singular (and irrelevant) case
-          det_num1 == det_num2 (when tang_pos_num == num_detectors - tang_pos_num)
-
-            We use the combinations of the following 'symmetries' of
-            (tang_pos_num, view_num) == (tang_pos_num+2*num_views, view_num + num_views)
-            == (-tang_pos_num, view_num + num_views)
-            Using the latter interchanges det_num1 and det_num2, and this leaves
-            the LOR the same in the 2D case. However, in 3D this interchanges the rings
-            as well. So, we keep track of this in swap_detectors, and return its final
-            value.
-          */
-          if (view_num < max_num_views)
-            {
-              if (tang_pos_num >= max_num_views)
-                {
-                  tang_pos_num = num_detectors - tang_pos_num;
-                  swap_detectors = 1;
-                }
-              else
-                {
-                  swap_detectors = 0;
-                }
-            }
-          else
-            {
-              view_num -= max_num_views;
-              if (tang_pos_num >= max_num_views)
-                {
-                  tang_pos_num -= num_detectors;
-                  swap_detectors = 0;
-                }
-              else
-                {
-                  tang_pos_num *= -1;
-                  swap_detectors = 1;
-                }
-            }
-
-          det1det2_to_uncompressed_view_tangpos[det1_num][det2_num].view_num = view_num;
-          det1det2_to_uncompressed_view_tangpos[det1_num][det2_num].tang_pos_num = tang_pos_num;
-          det1det2_to_uncompressed_view_tangpos[det1_num][det2_num].swap_detectors = swap_detectors == 0;
-        }
-    }
-    // thanks to yohjp:
-    // http://stackoverflow.com/questions/27975737/how-to-handle-cached-data-structures-with-multi-threading-e-g-openmp
-#if defined(STIR_OPENMP) && _OPENMP >= 201012
-#  pragma omp atomic write
-#endif
-  det1det2_to_uncompressed_view_tangpos_initialised = true;
+void
+ProjDataInfoGenericNoArcCorr::error_det_pair_tables_do_not_cover_tangential_range() const
+{
+  if (is_null_ptr(det_pair_tables_sptr))
+    error("Number of detectors per ring should be even but is %d", get_scanner_ptr()->get_num_detectors_per_ring());
+  error("The tangential_pos range (%d to %d) for this projection data is too large.\n"
+        "Maximum supported range is from %d to %d",
+        get_min_tangential_pos_num(),
+        get_max_tangential_pos_num(),
+        det_pair_tables_sptr->get_min_tangential_pos_num(),
+        det_pair_tables_sptr->get_max_tangential_pos_num());
 }
 
 unsigned int
@@ -292,7 +182,8 @@ ProjDataInfoGenericNoArcCorr::get_num_det_pos_pairs_for_bin(const Bin& bin) cons
 void
 ProjDataInfoGenericNoArcCorr::get_all_det_pos_pairs_for_bin(std::vector<DetectionPositionPair<>>& dps, const Bin& bin) const
 {
-  this->initialise_uncompressed_view_tangpos_to_det1det2_if_not_done_yet();
+  if (!det_pair_tables_cover_tangential_range)
+    error_det_pair_tables_do_not_cover_tangential_range();
 
   dps.resize(get_num_det_pos_pairs_for_bin(bin));
 
@@ -306,8 +197,9 @@ ProjDataInfoGenericNoArcCorr::get_all_det_pos_pairs_for_bin(std::vector<Detectio
        uncompressed_view_num < (bin.view_num() + 1) * get_view_mashing_factor();
        ++uncompressed_view_num)
     {
-      const int det1_num = uncompressed_view_tangpos_to_det1det2[uncompressed_view_num][bin.tangential_pos_num()].det1_num;
-      const int det2_num = uncompressed_view_tangpos_to_det1det2[uncompressed_view_num][bin.tangential_pos_num()].det2_num;
+      int det1_num, det2_num;
+      det_pair_tables_sptr->get_det_num_pair_for_view_tangential_pos_num(
+          det1_num, det2_num, uncompressed_view_num, bin.tangential_pos_num());
       for (ProjDataInfoGeneric::RingNumPairs::const_iterator rings_iter = ring_pairs.begin(); rings_iter != ring_pairs.end();
            ++rings_iter)
         {
@@ -352,6 +244,14 @@ ProjDataInfoGenericNoArcCorr::find_cartesian_coordinates_given_scanner_coordinat
   assert(0 <= det2);
   assert(det2 < get_scanner_ptr()->get_num_detectors_per_ring());
 
+  if (detector_centres_sptr)
+    {
+      const int num_detectors = get_scanner_ptr()->get_num_detectors_per_ring();
+      coord_1 = (*detector_centres_sptr)[Ring_A * num_detectors + det1];
+      coord_2 = (*detector_centres_sptr)[Ring_B * num_detectors + det2];
+      return;
+    }
+
   DetectionPosition<> det_pos1;
   DetectionPosition<> det_pos2;
   det_pos1.tangential_coord() = det1;
@@ -24,9 +24,12 @@
 #include "stir/SSRB.h"
 #include "stir/Sinogram.h"
 #include "stir/Bin.h"
+#include "stir/VectorWithOffset.h"
 #include "stir/round.h"
 #include <fstream>
 #include <algorithm>
+#include <vector>
+#include <utility>
 #include "stir/warning.h"
 #include "stir/error.h"
 
@@ -162,6 +165,18 @@ SSRB(const string& output_filename,
   SSRB(out_proj_data, in_proj_data, do_norm);
 }
 
+namespace
+{
+//! input sinograms (ignoring TOF) contributing to an output sinogram
+struct SSRBOutputSinogram
+{
+  int segment_num;
+  int axial_pos_num;
+  //! segment and axial position numbers of all contributing input sinograms
+  std::vector<std::pair<int, int>> in_sinograms;
+};
+} // namespace
+
 void
 SSRB(ProjData& out_proj_data, const ProjData& in_proj_data, const bool do_norm)
 {
@@ -187,6 +202,10 @@ SSRB(ProjData& out_proj_data, const ProjData& in_proj_data, const bool do_norm)
   if (in_proj_data.get_num_views() % out_proj_data.get_num_views())
     error("SSRB can only mash views when out_num_views divides in_num_views\n");
 
+  // First find which input sinograms contribute to every output sinogram (ignoring TOF).
+  // This only needs the ProjDataInfo objects, such that the data can then be processed in parallel,
+  // reading every input sinogram only once.
+  std::vector<SSRBOutputSinogram> out_sinograms;
   for (int out_segment_num = out_proj_data.get_min_segment_num(); out_segment_num <= out_proj_data.get_max_segment_num();
        ++out_segment_num)
     {
@@ -228,84 +247,126 @@ SSRB(ProjData& out_proj_data, const ProjData& in_proj_data, const bool do_norm)
                       out_max_ring_diff);
               }
           }
+      }
 
-        // keep sinograms out of the loop to avoid reallocations
-        // initialise to something because there's no default constructor
-        Sinogram<float> out_sino
-            = out_proj_data.get_empty_sinogram(out_proj_data.get_min_axial_pos_num(out_segment_num), out_segment_num);
-        Sinogram<float> in_sino
-            = in_proj_data.get_empty_sinogram(in_proj_data.get_min_axial_pos_num(out_segment_num), out_segment_num);
-        for (int out_timing_pos_num = out_proj_data.get_min_tof_pos_num();
-             out_timing_pos_num <= out_proj_data.get_max_tof_pos_num();
-             ++out_timing_pos_num)
+      const int out_min_ax_pos_num = out_proj_data.get_min_axial_pos_num(out_segment_num);
+      const int out_max_ax_pos_num = out_proj_data.get_max_axial_pos_num(out_segment_num);
+      const std::size_t first_out_sinogram = out_sinograms.size();
+      for (int out_ax_pos_num = out_min_ax_pos_num; out_ax_pos_num <= out_max_ax_pos_num; ++out_ax_pos_num)
+        {
+          SSRBOutputSinogram out_sinogram;
+          out_sinogram.segment_num = out_segment_num;
+          out_sinogram.axial_pos_num = out_ax_pos_num;
+          out_sinograms.push_back(out_sinogram);
+        }
+      // find the output axial position with the same m for every input sinogram (m is linear in the axial position)
+      const float out_min_m = out_proj_data_info_sptr->get_m(Bin(out_segment_num, 0, out_min_ax_pos_num, 0));
+      const float out_sampling_in_m = out_proj_data_info_sptr->get_axial_sampling(out_segment_num);
+      for (int in_segment_num = in_min_segment_num; in_segment_num <= in_max_segment_num; ++in_segment_num)
+        for (int in_ax_pos_num = in_proj_data.get_min_axial_pos_num(in_segment_num);
+             in_ax_pos_num <= in_proj_data.get_max_axial_pos_num(in_segment_num);
+             ++in_ax_pos_num)
           {
-            for (int out_ax_pos_num = out_proj_data.get_min_axial_pos_num(out_segment_num);
-                 out_ax_pos_num <= out_proj_data.get_max_axial_pos_num(out_segment_num);
-                 ++out_ax_pos_num)
-              {
-                Bin out_bin(out_segment_num, 0, out_ax_pos_num, 0, out_timing_pos_num);
-                out_sino = out_proj_data.get_empty_sinogram(out_bin);
-                const float out_m = out_proj_data_info_sptr->get_m(out_bin);
-
-                unsigned int num_in_ax_pos = 0;
+            const float in_m = in_proj_data_info_sptr->get_m(Bin(in_segment_num, 0, in_ax_pos_num, 0));
+            const int out_ax_pos_num = out_min_ax_pos_num + round((in_m - out_min_m) / out_sampling_in_m);
+            if (out_ax_pos_num < out_min_ax_pos_num || out_ax_pos_num > out_max_ax_pos_num)
+              continue;
+            const float out_m = out_proj_data_info_sptr->get_m(Bin(out_segment_num, 0, out_ax_pos_num, 0));
+            if (fabs(out_m - in_m) < 1E-4)
+              out_sinograms[first_out_sinogram + (out_ax_pos_num - out_min_ax_pos_num)].in_sinograms.push_back(
+                  std::make_pair(in_segment_num, in_ax_pos_num));
+          }
+    }
 
-                // get edges of TOF bin, currently only exposed via sampling
-                // for non-TOF data, the sampling in k is 0, which is incorrect and would lead to the TOF condition below never
-                // being met. Therefore: for non-TOF set out_lower_k to -1E20F and out_higher_k to 1E20F
-                const float out_lower_k
-                    = out_proj_data_info_sptr->is_tof_data()
-                          ? (out_proj_data_info_sptr->get_k(out_bin) - out_proj_data_info_sptr->get_sampling_in_k(out_bin) / 2)
-                          : -1E20F;
-                const float out_higher_k
-                    = out_proj_data_info_sptr->is_tof_data()
-                          ? (out_proj_data_info_sptr->get_k(out_bin) + out_proj_data_info_sptr->get_sampling_in_k(out_bin) / 2)
-                          : 1E20F;
+  // find the output TOF bin for every input TOF bin (or out_max_timing_pos_num+1 if there is none)
+  const int out_min_timing_pos_num = out_proj_data.get_min_tof_pos_num();
+  const int out_max_timing_pos_num = out_proj_data.get_max_tof_pos_num();
+  VectorWithOffset<int> out_timing_pos_nums(in_proj_data.get_min_tof_pos_num(), in_proj_data.get_max_tof_pos_num());
+  for (int in_timing_pos_num = in_proj_data.get_min_tof_pos_num(); in_timing_pos_num <= in_proj_data.get_max_tof_pos_num();
+       ++in_timing_pos_num)
+    {
+      out_timing_pos_nums[in_timing_pos_num] = out_max_timing_pos_num + 1;
+      const float in_k = in_proj_data_info_sptr->get_k(Bin(0, 0, 0, 0, in_timing_pos_num));
+      for (int out_timing_pos_num = out_min_timing_pos_num; out_timing_pos_num <= out_max_timing_pos_num; ++out_timing_pos_num)
+        {
+          // get edges of TOF bin, currently only exposed via sampling
+          // for non-TOF data, the sampling in k is 0, which is incorrect and would lead to the TOF condition below never
+          // being met. Therefore: for non-TOF set out_lower_k to -1E20F and out_higher_k to 1E20F
+          const Bin out_bin(0, 0, 0, 0, out_timing_pos_num);
+          const float out_lower_k
+              = out_proj_data_info_sptr->is_tof_data()
+                    ? (out_proj_data_info_sptr->get_k(out_bin) - out_proj_data_info_sptr->get_sampling_in_k(out_bin) / 2)
+                    : -1E20F;
+          const float out_higher_k
+              = out_proj_data_info_sptr->is_tof_data()
+                    ? (out_proj_data_info_sptr->get_k(out_bin) + out_proj_data_info_sptr->get_sampling_in_k(out_bin) / 2)
+                    : 1E20F;
+          if (in_k >= out_lower_k && in_k < out_higher_k)
+            {
+              out_timing_pos_nums[in_timing_pos_num] = out_timing_pos_num;
+              break;
+            }
+        }
+    }
 
-                for (int in_timing_pos_num = in_proj_data.get_min_tof_pos_num();
-                     in_timing_pos_num <= in_proj_data.get_max_tof_pos_num();
-                     ++in_timing_pos_num)
-                  for (int in_segment_num = in_min_segment_num; in_segment_num <= in_max_segment_num; ++in_segment_num)
-                    for (int in_ax_pos_num = in_proj_data.get_min_axial_pos_num(in_segment_num);
-                         in_ax_pos_num <= in_proj_data.get_max_axial_pos_num(in_segment_num);
-                         ++in_ax_pos_num)
-                      {
-                        Bin in_bin(in_segment_num, 0, in_ax_pos_num, 0, in_timing_pos_num);
-                        const float in_m = in_proj_data_info_sptr->get_m(in_bin);
-                        if (fabs(out_m - in_m) < 1E-4)
-                          {
-                            if (in_timing_pos_num == in_proj_data.get_min_tof_pos_num())
-                              ++num_in_ax_pos; // count number of in_sinograms contributing (ignoring TOF)
+  const int min_tangential_pos_num = max(in_proj_data.get_min_tangential_pos_num(), out_proj_data.get_min_tangential_pos_num());
+  const int max_tangential_pos_num = min(in_proj_data.get_max_tangential_pos_num(), out_proj_data.get_max_tangential_pos_num());
 
-                            const float in_k = in_proj_data_info_sptr->get_k(in_bin);
-                            // check if in_timing_pos_num is in the range for the out bin or not
-                            if (in_k < out_lower_k || in_k >= out_higher_k)
-                              continue;
-                            in_sino = in_proj_data.get_sinogram(in_bin);
+  // Process all output sinograms (for all TOF bins) for one output axial position at once, such that
+  // only the input sinograms for that axial position need to be in memory.
+#ifdef STIR_OPENMP
+#  pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i = 0; i < static_cast<int>(out_sinograms.size()); ++i)
+    {
+      const SSRBOutputSinogram& out_sinogram = out_sinograms[i];
+      VectorWithOffset<shared_ptr<Sinogram<float>>> out_sinos(out_min_timing_pos_num, out_max_timing_pos_num);
+      for (int out_timing_pos_num = out_min_timing_pos_num; out_timing_pos_num <= out_max_timing_pos_num; ++out_timing_pos_num)
+        out_sinos[out_timing_pos_num].reset(new Sinogram<float>(out_proj_data.get_empty_sinogram(
+            Bin(out_sinogram.segment_num, 0, out_sinogram.axial_pos_num, 0, out_timing_pos_num))));
 
-                            for (int in_view_num = in_proj_data.get_min_view_num();
-                                 in_view_num <= in_proj_data.get_max_view_num();
-                                 ++in_view_num)
-                              for (int tangential_pos_num
-                                   = max(in_proj_data.get_min_tangential_pos_num(), out_proj_data.get_min_tangential_pos_num());
-                                   tangential_pos_num
-                                   <= min(in_proj_data.get_max_tangential_pos_num(), out_proj_data.get_max_tangential_pos_num());
-                                   ++tangential_pos_num)
-                                out_sino[in_view_num / num_views_to_combine][tangential_pos_num]
-                                    += in_sino[in_view_num][tangential_pos_num];
+      for (int in_timing_pos_num = in_proj_data.get_min_tof_pos_num(); in_timing_pos_num <= in_proj_data.get_max_tof_pos_num();
+           ++in_timing_pos_num)
+        {
+          const int out_timing_pos_num = out_timing_pos_nums[in_timing_pos_num];
+          if (out_timing_pos_num > out_max_timing_pos_num)
+            continue;
+          Sinogram<float>& out_sino = *out_sinos[out_timing_pos_num];
+          for (std::vector<std::pair<int, int>>::const_iterator iter = out_sinogram.in_sinograms.begin();
+               iter != out_sinogram.in_sinograms.end();
+               ++iter)
+            {
+              const Bin in_bin(iter->first, 0, iter->second, 0, in_timing_pos_num);
+              shared_ptr<Sinogram<float>> in_sino_sptr;
+#ifdef STIR_OPENMP
+#  pragma omp critical(SSRB_GET_SINOGRAM)
+#endif
+              in_sino_sptr.reset(new Sinogram<float>(in_proj_data.get_sinogram(in_bin)));
+              const Sinogram<float>& in_sino = *in_sino_sptr;
 
-                            break; // out of loop over ax_pos as we found where to put it
-                          }
-                      }
-                if (do_norm && num_in_ax_pos != 0)
-                  out_sino /= static_cast<float>(num_in_ax_pos * num_views_to_combine);
-                if (num_in_ax_pos == 0)
-                  warning("SSRB: no sinograms contributing to output segment " + std::to_string(out_segment_num) + ", ax_pos "
-                          + std::to_string(out_ax_pos_num) + ", tof_pos_num " + std::to_string(out_timing_pos_num));
+              for (int in_view_num = in_proj_data.get_min_view_num(); in_view_num <= in_proj_data.get_max_view_num();
+                   ++in_view_num)
+                for (int tangential_pos_num = min_tangential_pos_num; tangential_pos_num <= max_tangential_pos_num;
+                     ++tangential_pos_num)
+                  out_sino[in_view_num / num_views_to_combine][tangential_pos_num] += in_sino[in_view_num][tangential_pos_num];
+            }
+        }
 
-                out_proj_data.set_sinogram(out_sino);
-              }
-          }
-      }
+      // number of input sinograms contributing (ignoring TOF)
+      const unsigned int num_in_ax_pos = static_cast<unsigned int>(out_sinogram.in_sinograms.size());
+      for (int out_timing_pos_num = out_min_timing_pos_num; out_timing_pos_num <= out_max_timing_pos_num; ++out_timing_pos_num)
+        {
+          Sinogram<float>& out_sino = *out_sinos[out_timing_pos_num];
+          if (do_norm && num_in_ax_pos != 0)
+            out_sino /= static_cast<float>(num_in_ax_pos * num_views_to_combine);
+          if (num_in_ax_pos == 0)
+            warning("SSRB: no sinograms contributing to output segment " + std::to_string(out_sinogram.segment_num) + ", ax_pos "
+                    + std::to_string(out_sinogram.axial_pos_num) + ", tof_pos_num " + std::to_string(out_timing_pos_num));
+#ifdef STIR_OPENMP
+#  pragma omp critical(SSRB_SET_SINOGRAM)
+#endif
+          out_proj_data.set_sinogram(out_sino);
+        }
     }
 }
 END_NAMESPACE_STIR
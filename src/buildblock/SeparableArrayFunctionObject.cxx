@@ -21,10 +21,242 @@
 
 #include "stir/SeparableArrayFunctionObject.h"
 #include "stir/ArrayFunction.h"
+#include "stir/ArrayFilter1DUsingConvolution.h"
+#include "stir/ArrayFilter1DUsingConvolutionSymmetricKernel.h"
+#include "stir/ArrayFilterUsingRealDFTWithPadding.h"
+#include "stir/detail/convolve_lines.h"
+#include "stir/modulo.h"
 #include "stir/is_null_ptr.h"
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
 
 START_NAMESPACE_STIR
 
+namespace detail
+{
+
+/*! \ingroup buildblock_detail
+  \brief Helper class for SeparableArrayFunctionObject that applies a 1D ArrayFunctionObject on blocks of lines
+
+  Lines are stored as in convolve_lines(), i.e. \c n elements of \c L lines, with the \c L lines contiguous.
+
+  Convolutions (i.e. ArrayFilter1DUsingConvolution and ArrayFilter1DUsingConvolutionSymmetricKernel)
+  are recognised and handled by convolve_lines() for short kernels, and by a
+  ArrayFilterUsingRealDFTWithPadding for long kernels (with zero boundary conditions). Other
+  1D function objects are called on every line, and cannot be used in parallel.
+*/
+template <typename elemT>
+class SeparableLineFilter
+{
+public:
+  //! set-up for a given 1D function object and length of the lines
+  SeparableLineFilter(const ArrayFunctionObject<1, elemT>& filter, const int min_index, const int max_index)
+      : filter_ptr(&filter),
+        min_index(min_index),
+        max_index(max_index),
+        bc(BoundaryConditions::zero)
+  {
+    if (const ArrayFilter1DUsingConvolution<elemT>* conv_ptr = dynamic_cast<const ArrayFilter1DUsingConvolution<elemT>*>(&filter))
+      {
+        kernel = conv_ptr->get_filter_coefficients();
+        bc = conv_ptr->get_boundary_conditions();
+      }
+    else if (const ArrayFilter1DUsingConvolutionSymmetricKernel<elemT>* sym_conv_ptr
+             = dynamic_cast<const ArrayFilter1DUsingConvolutionSymmetricKernel<elemT>*>(&filter))
+      {
+        const VectorWithOffset<elemT>& half_kernel = sym_conv_ptr->get_filter_coefficients();
+        if (half_kernel.get_length() > 0)
+          {
+            assert(half_kernel.get_min_index() == 0);
+            const int j_max = half_kernel.get_max_index();
+            kernel = VectorWithOffset<elemT>(-j_max, j_max);
+            for (int j = -j_max; j <= j_max; ++j)
+              kernel[j] = half_kernel[std::abs(j)];
+          }
+      }
+    else
+      return;
+
+    if (kernel.get_length() == 0)
+      {
+        // trivial kernel: the function object leaves the line unchanged
+        return;
+      }
+    // check if we need to use the DFT
+    const int n = max_index - min_index + 1;
+    const int kernel_length = kernel.get_length();
+    if (bc != BoundaryConditions::zero || kernel_length <= min_kernel_length_for_DFT)
+      return;
+    // find power of 2 that avoids aliasing
+    int padded_length = 1;
+    int log2_padded_length = 0;
+    while (padded_length < n + kernel_length - 1)
+      {
+        padded_length *= 2;
+        ++log2_padded_length;
+      }
+    // rough estimate of the relative cost of the DFT compared to direct convolution
+    if (kernel_length * n <= 8 * log2_padded_length * padded_length)
+      return;
+    Array<1, elemT> dft_kernel(0, padded_length - 1);
+    for (int j = kernel.get_min_index(); j <= kernel.get_max_index(); ++j)
+      dft_kernel[modulo(j, padded_length)] += kernel[j];
+    dft_filter_sptr.reset(new ArrayFilterUsingRealDFTWithPadding<1, elemT>(dft_kernel));
+  }
+
+  //! return true if the filter can be called from multiple threads concurrently
+  bool is_thread_safe() const { return kernel.get_length() > 0; }
+
+  //! filter the lines in \a in, put result in \a out
+  /*! \a in_line and \a out_line are used as scratch space
+   */
+  void apply(elemT* out, const elemT* in, const int L, Array<1, elemT>& in_line, Array<1, elemT>& out_line) const
+  {
+    const int n = max_index - min_index + 1;
+    if (kernel.get_length() > 0 && is_null_ptr(dft_filter_sptr))
+      {
+        convolve_lines(out, in, n, L, &*kernel.begin(), kernel.get_min_index(), kernel.get_max_index(), bc);
+        return;
+      }
+    const ArrayFunctionObject<1, elemT>& filter = is_null_ptr(dft_filter_sptr) ? *filter_ptr : *dft_filter_sptr;
+    if (in_line.get_min_index() != min_index || in_line.get_max_index() != max_index)
+      {
+        in_line.resize(min_index, max_index);
+        out_line.resize(min_index, max_index);
+      }
+    for (int l = 0; l < L; ++l)
+      {
+        for (int i = 0; i < n; ++i)
+          in_line[min_index + i] = in[static_cast<std::size_t>(i) * L + l];
+        filter(out_line, in_line);
+        for (int i = 0; i < n; ++i)
+          out[static_cast<std::size_t>(i) * L + l] = out_line[min_index + i];
+      }
+  }
+
+private:
+  //! kernels with at most this many elements always use direct convolution
+  static const int min_kernel_length_for_DFT = 32;
+
+  const ArrayFunctionObject<1, elemT>* filter_ptr;
+  int min_index;
+  int max_index;
+  //! kernel for convolutions, empty for other function objects
+  VectorWithOffset<elemT> kernel;
+  BoundaryConditions::BC bc;
+  shared_ptr<ArrayFilterUsingRealDFTWithPadding<1, elemT>> dft_filter_sptr;
+};
+
+//! apply the 1D filters along every index of a regular 3D array, parallelised over lines when possible
+template <typename elemT>
+static void
+separable_apply_3d(Array<3, elemT>& array, const VectorWithOffset<shared_ptr<ArrayFunctionObject<1, elemT>>>& all_1d_array_filters)
+{
+  assert(array.is_regular());
+  if (array.size_all() == 0)
+    return;
+
+  const int min_z = array.get_min_index();
+  const int max_z = array.get_max_index();
+  const int min_y = array[min_z].get_min_index();
+  const int max_y = array[min_z].get_max_index();
+  const int min_x = array[min_z][min_y].get_min_index();
+  const int max_x = array[min_z][min_y].get_max_index();
+  const int nz = max_z - min_z + 1;
+  const int ny = max_y - min_y + 1;
+  const int nx = max_x - min_x + 1;
+
+  const int first_filter_index = all_1d_array_filters.get_min_index();
+
+  // filter along z, handling all lines for a given y at once
+  if (!all_1d_array_filters[first_filter_index]->is_trivial())
+    {
+      const SeparableLineFilter<elemT> line_filter(*all_1d_array_filters[first_filter_index], min_z, max_z);
+#ifdef STIR_OPENMP
+#  pragma omp parallel if (line_filter.is_thread_safe())
+#endif
+      {
+        std::vector<elemT> lines(static_cast<std::size_t>(nz) * nx);
+        std::vector<elemT> filtered_lines(static_cast<std::size_t>(nz) * nx);
+        Array<1, elemT> in_line, out_line;
+#ifdef STIR_OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+        for (int y = min_y; y <= max_y; ++y)
+          {
+            for (int z = min_z; z <= max_z; ++z)
+              std::copy(array[z][y].begin(), array[z][y].end(), lines.begin() + static_cast<std::size_t>(z - min_z) * nx);
+            line_filter.apply(&filtered_lines[0], &lines[0], nx, in_line, out_line);
+            for (int z = min_z; z <= max_z; ++z)
+              std::copy(filtered_lines.begin() + static_cast<std::size_t>(z - min_z) * nx,
+                        filtered_lines.begin() + static_cast<std::size_t>(z - min_z + 1) * nx,
+                        array[z][y].begin());
+          }
+      }
+    }
+
+  // filter along y and x, plane by plane
+  const bool filter_y = !all_1d_array_filters[first_filter_index + 1]->is_trivial();
+  const bool filter_x = !all_1d_array_filters[first_filter_index + 2]->is_trivial();
+  if (!filter_y && !filter_x)
+    return;
+  const SeparableLineFilter<elemT> y_filter(*all_1d_array_filters[first_filter_index + 1], min_y, max_y);
+  const SeparableLineFilter<elemT> x_filter(*all_1d_array_filters[first_filter_index + 2], min_x, max_x);
+#ifdef STIR_OPENMP
+#  pragma omp parallel if ((!filter_y || y_filter.is_thread_safe()) && (!filter_x || x_filter.is_thread_safe()))
+#endif
+  {
+    std::vector<elemT> plane(static_cast<std::size_t>(ny) * nx);
+    std::vector<elemT> filtered_plane(static_cast<std::size_t>(ny) * nx);
+    Array<1, elemT> in_line, out_line;
+#ifdef STIR_OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+    for (int z = min_z; z <= max_z; ++z)
+      {
+        for (int y = min_y; y <= max_y; ++y)
+          std::copy(array[z][y].begin(), array[z][y].end(), plane.begin() + static_cast<std::size_t>(y - min_y) * nx);
+        if (filter_y)
+          {
+            y_filter.apply(&filtered_plane[0], &plane[0], nx, in_line, out_line);
+            std::swap(plane, filtered_plane);
+          }
+        if (filter_x)
+          {
+            for (int y = 0; y < ny; ++y)
+              x_filter.apply(
+                  &filtered_plane[static_cast<std::size_t>(y) * nx], &plane[static_cast<std::size_t>(y) * nx], 1, in_line, out_line);
+            std::swap(plane, filtered_plane);
+          }
+        for (int y = min_y; y <= max_y; ++y)
+          std::copy(plane.begin() + static_cast<std::size_t>(y - min_y) * nx,
+                    plane.begin() + static_cast<std::size_t>(y - min_y + 1) * nx,
+                    array[z][y].begin());
+      }
+  }
+}
+
+//! general case: use in_place_apply_array_functions_on_each_index()
+template <int num_dim, typename elemT>
+static void
+separable_apply(Array<num_dim, elemT>& array, const VectorWithOffset<shared_ptr<ArrayFunctionObject<1, elemT>>>& all_1d_array_filters)
+{
+  in_place_apply_array_functions_on_each_index(array, all_1d_array_filters.begin(), all_1d_array_filters.end());
+}
+
+template <typename elemT>
+static void
+separable_apply(Array<3, elemT>& array, const VectorWithOffset<shared_ptr<ArrayFunctionObject<1, elemT>>>& all_1d_array_filters)
+{
+  if (array.is_regular())
+    separable_apply_3d(array, all_1d_array_filters);
+  else
+    in_place_apply_array_functions_on_each_index(array, all_1d_array_filters.begin(), all_1d_array_filters.end());
+}
+
+} // namespace detail
+
 template <int num_dim, typename elemT>
 SeparableArrayFunctionObject<num_dim, elemT>::SeparableArrayFunctionObject()
     : all_1d_array_filters(VectorWithOffset<shared_ptr<ArrayFunctionObject<1, elemT>>>(num_dim))
@@ -53,7 +285,7 @@ SeparableArrayFunctionObject<num_dim, elemT>::do_it(Array<num_dim, elemT>& array
            ++iter)
         assert(!is_null_ptr(*iter));
 #endif
-      in_place_apply_array_functions_on_each_index(array, all_1d_array_filters.begin(), all_1d_array_filters.end());
+      detail::separable_apply(array, all_1d_array_filters);
     }
 }
 
@@ -2,6 +2,7 @@
 //
 /*
     Copyright (C) 2000- 2009, Hammersmith Imanet Ltd
+    Copyright (C) 2026, University College London
     This file is part of STIR.
 
     SPDX-License-Identifier: Apache-2.0
@@ -19,6 +20,7 @@
 */
 #include "stir/ThresholdMinToSmallPositiveValueDataProcessor.h"
 #include "stir/thresholding.h"
+#include "stir/min_positive_element.h"
 #include "stir/DiscretisedDensity.h"
 #include "stir/modelling/ParametricDiscretisedDensity.h"
 #include "stir/modelling/KineticParameters.h"
@@ -50,6 +52,56 @@ ThresholdMinToSmallPositiveValueDataProcessor<DataT>::virtual_apply(DataT& out_d
   threshold_min_to_small_positive_value(out_data.begin_all(), out_data.end_all(), 0.000001F);
 }
 
+template <typename DataT>
+bool
+ThresholdMinToSmallPositiveValueDataProcessor<DataT>::is_pointwise() const
+{
+  return true;
+}
+
+template <typename DataT>
+bool
+ThresholdMinToSmallPositiveValueDataProcessor<DataT>::pointwise_depends_on_whole_input() const
+{
+  return true;
+}
+
+template <typename DataT>
+void
+ThresholdMinToSmallPositiveValueDataProcessor<DataT>::virtual_prepare_pointwise(const DataT& data)
+{
+  // same as threshold_min_to_small_positive_value()
+  const auto smallest_positive_element_iter = min_positive_element(data.begin_all(), data.end_all());
+  if (smallest_positive_element_iter != data.end_all())
+    this->threshold = (*smallest_positive_element_iter) * 0.000001F;
+  else
+    this->threshold = 0.000001F;
+}
+
+// threshold one plane of an image
+template <typename elemT>
+static void
+threshold_lower_plane(Array<2, elemT>& plane, const float new_min)
+{
+  threshold_lower(plane.begin_all(), plane.end_all(), new_min);
+}
+
+// threshold one plane of a parametric image (all parameters)
+template <int num_param>
+static void
+threshold_lower_plane(Array<2, KineticParameters<num_param, float>>& plane, const float new_min)
+{
+  for (auto iter = plane.begin_all(); iter != plane.end_all(); ++iter)
+    threshold_lower(iter->begin(), iter->end(), new_min);
+}
+
+template <typename DataT>
+void
+ThresholdMinToSmallPositiveValueDataProcessor<DataT>::virtual_apply_pointwise(DataT& data, const int outer_index) const
+{
+  threshold_lower_plane(data[outer_index], this->threshold);
+}
+
 template <typename DataT>
 ThresholdMinToSmallPositiveValueDataProcessor<DataT>::ThresholdMinToSmallPositiveValueDataProcessor()
 {
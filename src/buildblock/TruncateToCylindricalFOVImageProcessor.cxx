@@ -2,6 +2,7 @@
 //
 /*
     Copyright (C) 2005- 2007, Hammersmith Imanet Ltd
+    Copyright (C) 2026, University College London
     This file is part of STIR.
 
     SPDX-License-Identifier: Apache-2.0
@@ -19,6 +20,7 @@
 #include "stir/TruncateToCylindricalFOVImageProcessor.h"
 #include "stir/DiscretisedDensityOnCartesianGrid.h"
 #include "stir/recon_array_functions.h"
+#include "stir/error.h"
 
 START_NAMESPACE_STIR
 
@@ -72,6 +74,29 @@ TruncateToCylindricalFOVImageProcessor<elemT>::virtual_apply(DiscretisedDensity<
   this->virtual_apply(out_density);
 }
 
+template <typename elemT>
+bool
+TruncateToCylindricalFOVImageProcessor<elemT>::is_pointwise() const
+{
+  return true;
+}
+
+template <typename elemT>
+void
+TruncateToCylindricalFOVImageProcessor<elemT>::virtual_prepare_pointwise(const DiscretisedDensity<3, elemT>& density)
+{
+  // check here, as virtual_apply_pointwise() cannot call error() when run in parallel
+  if (!dynamic_cast<const DiscretisedDensityOnCartesianGrid<3, elemT>&>(density).is_regular())
+    error("truncate_rim called for non-regular grid. Not implemented");
+}
+
+template <typename elemT>
+void
+TruncateToCylindricalFOVImageProcessor<elemT>::virtual_apply_pointwise(DiscretisedDensity<3, elemT>& density, const int z) const
+{
+  truncate_rim_in_plane(density[z], this->_truncate_rim, this->_strictly_less_than_radius);
+}
+
 template <typename elemT>
 TruncateToCylindricalFOVImageProcessor<elemT>::TruncateToCylindricalFOVImageProcessor()
 {
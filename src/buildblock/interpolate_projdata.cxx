@@ -33,9 +33,14 @@
 #include "stir/numerics/BSplinesRegularGrid.h"
 #include "stir/interpolate_projdata.h"
 #include "stir/extend_projdata.h"
-#include "stir/numerics/sampling_functions.h"
+#include "stir/Scanner.h"
+#include "stir/is_null_ptr.h"
 #include "stir/error.h"
+#include "stir/warning.h"
 #include <typeinfo>
+#include <vector>
+#include <algorithm>
+#include <cmath>
 
 START_NAMESPACE_STIR
 
@@ -151,6 +156,267 @@ make_non_interleaved_segment(const ProjDataInfo& non_interleaved_proj_data_info,
   return out_segment;
 }
 
+//! input indices and B-spline weights along one dimension, for every output index
+struct BSplinesWeights1D
+{
+  int min_out_index;
+  int num_weights;
+  //! the weights for output index \c i are stored at <code>(i-min_out_index)*num_weights</code> onwards
+  std::vector<int> in_indices;
+  std::vector<float> weights;
+};
+
+/* Computes the weights for in_index = out_index * step + offset.
+   This uses the same conventions as BSpline::detail::spline_convolution, including
+   the mirroring at the boundaries of the input range.
+*/
+static BSplinesWeights1D
+compute_BSplines_weights_1D(const int min_out_index,
+                            const int max_out_index,
+                            const double offset,
+                            const double step,
+                            const BSpline::BSplineType spline_type,
+                            const int min_in_index,
+                            const int max_in_index)
+{
+  const BSpline::PieceWiseFunction<BSpline::pos_type>& bspline = BSpline::bspline_function(spline_type);
+  BSplinesWeights1D result;
+  result.min_out_index = min_out_index;
+  result.num_weights = bspline.kernel_total_length();
+  const std::size_t size = static_cast<std::size_t>(max_out_index - min_out_index + 1) * result.num_weights;
+  result.in_indices.resize(size);
+  result.weights.resize(size);
+  std::size_t i = 0;
+  for (int out_index = min_out_index; out_index <= max_out_index; ++out_index)
+    {
+      const BSpline::pos_type relative_position = out_index * step + offset;
+      const int kmin = static_cast<int>(std::ceil(relative_position - bspline.kernel_length_right()));
+      BSpline::pos_type current_pos = relative_position - kmin;
+      int p = bspline.find_piece(current_pos);
+      for (int k = kmin; k < kmin + result.num_weights; ++k, --current_pos, --p, ++i)
+        {
+          result.in_indices[i] = k < min_in_index ? 2 * min_in_index - k : (k > max_in_index ? 2 * max_in_index - k : k);
+          result.weights[i] = static_cast<float>(bspline.function_piece(current_pos, p));
+        }
+    }
+  return result;
+}
+
+/* Evaluates the B-spline with coefficients \a coeffs at in_index = out_index * step + offset
+   for all elements of \a out.
+   As the weights are a tensor product, we first combine the coefficients along the axial and view
+   directions for all tangential positions (a contiguous loop that can be vectorised), and then
+   interpolate along the tangential direction. This is parallelised over output sinograms and views.
+*/
+static void
+sample_BSplines_on_separable_grid(Array<3, float>& out,
+                                  const Array<3, float>& coeffs,
+                                  const BasicCoordinate<3, BSpline::BSplineType>& spline_types,
+                                  const BasicCoordinate<3, double>& offset,
+                                  const BasicCoordinate<3, double>& step)
+{
+  BasicCoordinate<3, int> min_out, max_out, min_in, max_in;
+  if (!out.get_index_range().get_regular_range(min_out, max_out) || !coeffs.get_index_range().get_regular_range(min_in, max_in))
+    error("interpolate_projdata: can only handle regular ranges");
+
+  const BSplinesWeights1D axial_weights
+      = compute_BSplines_weights_1D(min_out[1], max_out[1], offset[1], step[1], spline_types[1], min_in[1], max_in[1]);
+  const BSplinesWeights1D view_weights
+      = compute_BSplines_weights_1D(min_out[2], max_out[2], offset[2], step[2], spline_types[2], min_in[2], max_in[2]);
+  const BSplinesWeights1D tang_weights
+      = compute_BSplines_weights_1D(min_out[3], max_out[3], offset[3], step[3], spline_types[3], min_in[3], max_in[3]);
+
+  const int num_views = max_out[2] - min_out[2] + 1;
+  const int num_out_rows = (max_out[1] - min_out[1] + 1) * num_views;
+  const int num_in_tang_poss = max_in[3] - min_in[3] + 1;
+#ifdef STIR_OPENMP
+#  pragma omp parallel for schedule(dynamic)
+#endif
+  for (int row_num = 0; row_num < num_out_rows; ++row_num)
+    {
+      const int axial_pos_num = min_out[1] + row_num / num_views;
+      const int view_num = min_out[2] + row_num % num_views;
+      std::vector<float> row(num_in_tang_poss, 0.F);
+      const std::size_t axial_offset = static_cast<std::size_t>(axial_pos_num - min_out[1]) * axial_weights.num_weights;
+      const std::size_t view_offset = static_cast<std::size_t>(view_num - min_out[2]) * view_weights.num_weights;
+      for (int i = 0; i < axial_weights.num_weights; ++i)
+        for (int j = 0; j < view_weights.num_weights; ++j)
+          {
+            const float weight = axial_weights.weights[axial_offset + i] * view_weights.weights[view_offset + j];
+            if (weight == 0)
+              continue;
+            const Array<1, float>& coeffs_row
+                = coeffs[axial_weights.in_indices[axial_offset + i]][view_weights.in_indices[view_offset + j]];
+            const float* coeffs_ptr = &*coeffs_row.begin();
+            float* row_ptr = &row[0];
+            for (int t = 0; t < num_in_tang_poss; ++t)
+              row_ptr[t] += weight * coeffs_ptr[t];
+          }
+
+      Array<1, float>& out_row = out[axial_pos_num][view_num];
+      for (int tang_pos_num = min_out[3]; tang_pos_num <= max_out[3]; ++tang_pos_num)
+        {
+          const std::size_t tang_offset = static_cast<std::size_t>(tang_pos_num - min_out[3]) * tang_weights.num_weights;
+          float value = 0.F;
+          for (int k = 0; k < tang_weights.num_weights; ++k)
+            value += tang_weights.weights[tang_offset + k] * row[tang_weights.in_indices[tang_offset + k] - min_in[3]];
+          out_row[tang_pos_num] = value;
+        }
+    }
+}
+
+//! input view/tangential positions and weights for every output view/tangential position, used for BlocksOnCylindrical
+/*! These only depend on the geometry, so can be reused between calls (see InterpolateProjDataCache). */
+struct BlocksTransaxialWeights
+{
+  struct Weight
+  {
+    int view_num;
+    int tangential_pos_num;
+    double weight;
+  };
+
+  shared_ptr<const ProjDataInfo> proj_data_in_info_sptr;
+  shared_ptr<const ProjDataInfo> proj_data_out_info_sptr;
+  int min_view_num;
+  int min_tangential_pos_num;
+  int num_tangential_poss;
+  //! weights for output bin \c i are stored in <code>weights[offsets[i]]</code> up to <code>weights[offsets[i+1]-1]</code>
+  std::vector<std::size_t> offsets;
+  std::vector<Weight> weights;
+
+  std::size_t get_bin_index(const int view_num, const int tangential_pos_num) const
+  {
+    return static_cast<std::size_t>(view_num - min_view_num) * num_tangential_poss
+           + (tangential_pos_num - min_tangential_pos_num);
+  }
+};
+
+/* For each bin in the output, we find the (up to) four closest LORs in the input. These are weighted using
+   bilinear interpolation based on the crystal positions of the two endpoints of the LOR.
+*/
+static shared_ptr<const BlocksTransaxialWeights>
+compute_blocks_transaxial_weights(const shared_ptr<const ProjDataInfo>& proj_data_in_info_sptr,
+                                  const shared_ptr<const ProjDataInfo>& proj_data_out_info_sptr)
+{
+  const auto proj_data_in_info_ptr = dynamic_cast<const ProjDataInfoGenericNoArcCorr*>(proj_data_in_info_sptr.get());
+  const auto proj_data_out_info_ptr = dynamic_cast<const ProjDataInfoGenericNoArcCorr*>(proj_data_out_info_sptr.get());
+  if (proj_data_in_info_ptr == 0 || proj_data_out_info_ptr == 0)
+    error("interpolate_blocks_on_cylindrical_projdata needs projection data of type ProjDataInfoGenericNoArcCorr");
+  const Scanner& scanner_in = *proj_data_in_info_ptr->get_scanner_sptr();
+  const Scanner& scanner_out = *proj_data_out_info_ptr->get_scanner_sptr();
+  const int dets_per_module_out = scanner_out.get_num_transaxial_crystals_per_bucket();
+  const int dets_per_module_in = scanner_in.get_num_transaxial_crystals_per_bucket();
+  const int min_in_tangential_pos_num = proj_data_in_info_ptr->get_min_tangential_pos_num();
+  const int max_in_tangential_pos_num = proj_data_in_info_ptr->get_max_tangential_pos_num();
+
+  shared_ptr<BlocksTransaxialWeights> result(new BlocksTransaxialWeights);
+  result->proj_data_in_info_sptr = proj_data_in_info_sptr;
+  result->proj_data_out_info_sptr = proj_data_out_info_sptr;
+  result->min_view_num = proj_data_out_info_ptr->get_min_view_num();
+  result->min_tangential_pos_num = proj_data_out_info_ptr->get_min_tangential_pos_num();
+  result->num_tangential_poss = proj_data_out_info_ptr->get_num_tangential_poss();
+  result->offsets.reserve(static_cast<std::size_t>(proj_data_out_info_ptr->get_num_views()) * result->num_tangential_poss + 1);
+  result->offsets.push_back(0);
+
+  // translate the crystal position on a module from the full size scanner to the downsampled scanner
+  auto crystal_num_in = [&](const int det_num_out) -> double {
+    const int module = det_num_out / dets_per_module_out;
+    const int crystal_out_module_idx = det_num_out % dets_per_module_out;
+    const double crystal_out_module_pos
+        = std::floor(static_cast<double>(crystal_out_module_idx) / scanner_out.get_num_transaxial_crystals_per_block())
+              * scanner_out.get_transaxial_block_spacing()
+          + static_cast<double>(crystal_out_module_idx % scanner_out.get_num_transaxial_crystals_per_block())
+                * scanner_out.get_transaxial_crystal_spacing();
+    return module * dets_per_module_in + crystal_out_module_pos / scanner_in.get_transaxial_crystal_spacing();
+  };
+  auto add_weight = [&](const int det1_num_in, const int det2_num_in, const double weight) {
+    BlocksTransaxialWeights::Weight w;
+    proj_data_in_info_ptr->get_view_tangential_pos_num_for_det_num_pair(
+        w.view_num, w.tangential_pos_num, det1_num_in, det2_num_in);
+    // TODO: why can we get positions out that are not even in the proj data?!
+    w.tangential_pos_num = std::min(std::max(min_in_tangential_pos_num, w.tangential_pos_num), max_in_tangential_pos_num);
+    w.weight = weight;
+    result->weights.push_back(w);
+  };
+
+  for (int view_num = proj_data_out_info_ptr->get_min_view_num(); view_num <= proj_data_out_info_ptr->get_max_view_num();
+       ++view_num)
+    for (int tangential_pos_num = proj_data_out_info_ptr->get_min_tangential_pos_num();
+         tangential_pos_num <= proj_data_out_info_ptr->get_max_tangential_pos_num();
+         ++tangential_pos_num)
+      {
+        // find the two crystals for this bin and on which buckets (modules) they are
+        int det1_num_out, det2_num_out;
+        proj_data_out_info_ptr->get_det_num_pair_for_view_tangential_pos_num(
+            det1_num_out, det2_num_out, view_num, tangential_pos_num);
+        const int det1_module = det1_num_out / dets_per_module_out;
+        const int det2_module = det2_num_out / dets_per_module_out;
+        const double crystal1_num_in = crystal_num_in(det1_num_out);
+        const double crystal2_num_in = crystal_num_in(det2_num_out);
+        const auto crystal1_num_in_floor
+            = std::max(static_cast<int>(std::floor(crystal1_num_in)), det1_module * dets_per_module_in);
+        const auto crystal1_num_in_ceil
+            = std::min(static_cast<int>(std::ceil(crystal1_num_in)), (det1_module + 1) * dets_per_module_in - 1);
+        const auto crystal2_num_in_floor
+            = std::max(static_cast<int>(std::floor(crystal2_num_in)), det2_module * dets_per_module_in);
+        const auto crystal2_num_in_ceil
+            = std::min(static_cast<int>(std::ceil(crystal2_num_in)), (det2_module + 1) * dets_per_module_in - 1);
+
+        // in these cases we can skip parts of the interpolation
+        if (crystal1_num_in_floor == crystal1_num_in_ceil)
+          {
+            if (crystal2_num_in_floor == crystal2_num_in_ceil)
+              {
+                add_weight(crystal1_num_in_floor, crystal2_num_in_floor, 1.);
+              }
+            else
+              {
+                add_weight(crystal1_num_in_floor, crystal2_num_in_floor, crystal2_num_in_ceil - crystal2_num_in);
+                add_weight(crystal1_num_in_floor, crystal2_num_in_ceil, crystal2_num_in - crystal2_num_in_floor);
+              }
+          }
+        else if (crystal2_num_in_floor == crystal2_num_in_ceil)
+          {
+            add_weight(crystal1_num_in_floor, crystal2_num_in_floor, crystal1_num_in_ceil - crystal1_num_in);
+            add_weight(crystal1_num_in_ceil, crystal2_num_in_floor, crystal1_num_in - crystal1_num_in_floor);
+          }
+        else // in this case we need to do a bilinear interpolation
+          {
+            add_weight(crystal1_num_in_floor,
+                       crystal2_num_in_floor,
+                       (crystal1_num_in_ceil - crystal1_num_in) * (crystal2_num_in_ceil - crystal2_num_in));
+            add_weight(crystal1_num_in_floor,
+                       crystal2_num_in_ceil,
+                       (crystal1_num_in_ceil - crystal1_num_in) * (crystal2_num_in - crystal2_num_in_floor));
+            add_weight(crystal1_num_in_ceil,
+                       crystal2_num_in_ceil,
+                       (crystal1_num_in - crystal1_num_in_floor) * (crystal2_num_in - crystal2_num_in_floor));
+            add_weight(crystal1_num_in_ceil,
+                       crystal2_num_in_floor,
+                       (crystal1_num_in - crystal1_num_in_floor) * (crystal2_num_in_ceil - crystal2_num_in));
+          }
+        result->offsets.push_back(result->weights.size());
+      }
+  return result;
+}
+
+//! returns the weights for the given geometry, reusing the ones in the cache (if any) if the geometry is the same
+static shared_ptr<const BlocksTransaxialWeights>
+get_blocks_transaxial_weights(const shared_ptr<const ProjDataInfo>& proj_data_in_info_sptr,
+                              const shared_ptr<const ProjDataInfo>& proj_data_out_info_sptr,
+                              InterpolateProjDataCache* cache_ptr)
+{
+  if (cache_ptr == nullptr)
+    return compute_blocks_transaxial_weights(proj_data_in_info_sptr, proj_data_out_info_sptr);
+
+  const shared_ptr<const BlocksTransaxialWeights>& cached_weights_sptr = cache_ptr->blocks_transaxial_weights_sptr;
+  if (is_null_ptr(cached_weights_sptr) || !(*cached_weights_sptr->proj_data_in_info_sptr == *proj_data_in_info_sptr)
+      || !(*cached_weights_sptr->proj_data_out_info_sptr == *proj_data_out_info_sptr))
+    cache_ptr->blocks_transaxial_weights_sptr = compute_blocks_transaxial_weights(proj_data_in_info_sptr, proj_data_out_info_sptr);
+  return cache_ptr->blocks_transaxial_weights_sptr;
+}
+
 } // end namespace detail_interpolate_projdata
 
 using namespace detail_interpolate_projdata;
@@ -159,11 +425,12 @@ Succeeded
 interpolate_projdata(ProjData& proj_data_out,
                      const ProjData& proj_data_in,
                      const BSpline::BSplineType these_types,
-                     const bool remove_interleaving)
+                     const bool remove_interleaving,
+                     InterpolateProjDataCache* cache_ptr)
 {
   BasicCoordinate<3, BSpline::BSplineType> these_types_3;
   these_types_3[1] = these_types_3[2] = these_types_3[3] = these_types;
-  interpolate_projdata(proj_data_out, proj_data_in, these_types_3, remove_interleaving);
+  interpolate_projdata(proj_data_out, proj_data_in, these_types_3, remove_interleaving, cache_ptr);
   return Succeeded::yes;
 }
 
@@ -171,7 +438,8 @@ Succeeded
 interpolate_projdata(ProjData& proj_data_out,
                      const ProjData& proj_data_in,
                      const BasicCoordinate<3, BSpline::BSplineType>& these_types,
-                     const bool remove_interleaving)
+                     const bool remove_interleaving,
+                     InterpolateProjDataCache* cache_ptr)
 {
   const ProjDataInfo& proj_data_in_info = *proj_data_in.get_proj_data_info_sptr();
   const ProjDataInfo& proj_data_out_info = *proj_data_out.get_proj_data_info_sptr();
@@ -194,7 +462,7 @@ interpolate_projdata(ProjData& proj_data_out,
 
   // handle BlocksOnCylindrical interpolation manually
   if (proj_data_in_info.get_scanner_sptr()->get_scanner_geometry() != "Cylindrical")
-    return interpolate_blocks_on_cylindrical_projdata(proj_data_out, proj_data_in, remove_interleaving);
+    return interpolate_blocks_on_cylindrical_projdata(proj_data_out, proj_data_in, remove_interleaving, cache_ptr);
 
   // initialise interpolator
   BSpline::BSplinesRegularGrid<3, float, float> proj_data_interpolator(these_types);
@@ -205,8 +473,6 @@ interpolate_projdata(ProjData& proj_data_out,
                                                                proj_data_in.get_segment_by_sinogram(0, k))
                                 : proj_data_in.get_segment_by_sinogram(0, k);
 
-      // for Cylindrical, spacing is regular in all directions, which makes mapping trivial
-      std::function<BasicCoordinate<3, double>(const BasicCoordinate<3, int>&)> index_converter;
       // especially in view direction, extending by 5 leads to much smaller artifacts
       proj_data_interpolator.set_coef(extend_segment(segment, 5, 5, 5));
 
@@ -229,19 +495,9 @@ interpolate_projdata(ProjData& proj_data_out,
       offset[3] = (proj_data_out_info.get_s(Bin(0, 0, 0, 0)) - proj_data_in_info.get_s(Bin(0, 0, 0, 0))) / in_sampling_s;
       step[3] = out_sampling_s / in_sampling_s;
 
-      // define a function to translate indices in the output proj data to indices in input proj data
-      index_converter
-          = [&proj_data_out_info, offset, step](const BasicCoordinate<3, int>& index_out) -> BasicCoordinate<3, double> {
-        // translate to indices in input proj data
-        BasicCoordinate<3, double> index_in;
-        for (auto dim = 1; dim <= 3; dim++)
-          index_in[dim] = index_out[dim] * step[dim] + offset[dim];
-
-        return index_in;
-      };
-
+      // for Cylindrical, spacing is regular in all directions, so the interpolation is separable
       SegmentBySinogram<float> sino_3D_out = proj_data_out.get_empty_segment_by_sinogram(0, false, k);
-      sample_function_using_index_converter(sino_3D_out, proj_data_interpolator, index_converter);
+      sample_BSplines_on_separable_grid(sino_3D_out, proj_data_interpolator.get_coefficients(), these_types, offset, step);
 
       if (proj_data_out.set_segment(sino_3D_out) == Succeeded::no)
         return Succeeded::no;
@@ -258,7 +514,10 @@ closest LORs in the downsampled proj_data_in. These are then weighted using bili
 of the two endpoints of the LOR.
 */
 Succeeded
-interpolate_blocks_on_cylindrical_projdata(ProjData& proj_data_out, const ProjData& proj_data_in, bool remove_interleaving)
+interpolate_blocks_on_cylindrical_projdata(ProjData& proj_data_out,
+                                           const ProjData& proj_data_in,
+                                           bool remove_interleaving,
+                                           InterpolateProjDataCache* cache_ptr)
 {
   const ProjDataInfo& proj_data_in_info = *proj_data_in.get_proj_data_info_sptr();
   const ProjDataInfo& proj_data_out_info = *proj_data_out.get_proj_data_info_sptr();
@@ -266,6 +525,18 @@ interpolate_blocks_on_cylindrical_projdata(ProjData& proj_data_out, const ProjDa
   auto m_offset = proj_data_in_info.get_m(Bin(0, 0, 0, 0));
   auto m_sampling = proj_data_in_info.get_sampling_in_m(Bin(0, 0, 0, 0));
 
+  // confirm that proj_data_in has equidistant sampling in m
+  for (auto axial_pos = proj_data_in_info.get_min_axial_pos_num(0); axial_pos <= proj_data_in_info.get_max_axial_pos_num(0);
+       axial_pos++)
+    {
+      if (abs(m_sampling - proj_data_in_info.get_sampling_in_m(Bin(0, 0, axial_pos, 0))) > 1E-4)
+        error("input projdata to interpolate_projdata are not equidistantly sampled in m.");
+    }
+
+  const shared_ptr<const BlocksTransaxialWeights> transaxial_weights_sptr
+      = get_blocks_transaxial_weights(proj_data_in.get_proj_data_info_sptr(), proj_data_out.get_proj_data_info_sptr(), cache_ptr);
+  const BlocksTransaxialWeights& transaxial_weights = *transaxial_weights_sptr;
+
   for (int k = proj_data_out_info.get_min_tof_pos_num(); k <= proj_data_out_info.get_max_tof_pos_num(); ++k)
     {
       SegmentBySinogram<float> segment
@@ -279,238 +550,42 @@ interpolate_blocks_on_cylindrical_projdata(ProjData& proj_data_out, const ProjDa
       if (!out_range.get_regular_range(min_out, max_out))
         warning("Output must be regular range!");
 
-      // confirm that proj_data_in has equidistant sampling in m
-      for (auto axial_pos = proj_data_in_info.get_min_axial_pos_num(0); axial_pos <= proj_data_in_info.get_max_axial_pos_num(0);
-           axial_pos++)
+      const int num_views = max_out[2] - min_out[2] + 1;
+      const int num_out_rows = (max_out[1] - min_out[1] + 1) * num_views;
+#ifdef STIR_OPENMP
+#  pragma omp parallel for schedule(dynamic)
+#endif
+      for (int row_num = 0; row_num < num_out_rows; ++row_num)
         {
-          if (abs(m_sampling - proj_data_in_info.get_sampling_in_m(Bin(0, 0, axial_pos, 0))) > 1E-4)
-            error("input projdata to interpolate_projdata are not equidistantly sampled in m.");
-        }
+          const int axial_pos_num = min_out[1] + row_num / num_views;
+          const int view_num = min_out[2] + row_num % num_views;
+
+          // find the 2 axial positions in the input for this output axial position
+          auto out_m = proj_data_out_info.get_m(Bin(0 /* segment */, view_num, axial_pos_num, 0 /* tangential pos */));
+          double axial_idx = (out_m - m_offset) / m_sampling;
+          int axial_floor = std::floor(axial_idx);
+          int axial_ceil = std::ceil(axial_idx);
+          if (axial_floor == axial_ceil)
+            {
+              if (axial_floor == 0)
+                axial_ceil++;
+              else
+                axial_floor--;
+            }
+          const double axial_floor_weight = axial_ceil - axial_idx;
+          const double axial_ceil_weight = axial_idx - axial_floor;
+          const Array<2, float>& sino_floor = segment[std::max(axial_floor, proj_data_in_info.get_min_axial_pos_num(0))];
+          const Array<2, float>& sino_ceil = segment[std::min(axial_ceil, proj_data_in_info.get_max_axial_pos_num(0))];
 
-      BasicCoordinate<3, int> index_out;
-      for (index_out[1] = min_out[1]; index_out[1] <= max_out[1]; ++index_out[1])
-        {
-          for (index_out[2] = min_out[2]; index_out[2] <= max_out[2]; ++index_out[2])
+          Array<1, float>& out_row = sino_3D_out[axial_pos_num][view_num];
+          for (int tang_pos_num = min_out[3]; tang_pos_num <= max_out[3]; ++tang_pos_num)
             {
-              for (index_out[3] = min_out[3]; index_out[3] <= max_out[3]; ++index_out[3])
+              const std::size_t bin_index = transaxial_weights.get_bin_index(view_num, tang_pos_num);
+              for (std::size_t i = transaxial_weights.offsets[bin_index]; i < transaxial_weights.offsets[bin_index + 1]; ++i)
                 {
-                  // translate index on output to coordinate
-                  auto bin
-                = Bin(0 /* segment */, index_out[2] /* view */, 
-                index_out[1] /* axial pos */, index_out[3] /* tangential pos
-                */);
-                  auto out_m = proj_data_out_info.get_m(bin);
-                  double axial_idx = (out_m - m_offset) / m_sampling;
-                  int axial_floor = std::floor(axial_idx);
-                  int axial_ceil = std::ceil(axial_idx);
-                  if (axial_floor == axial_ceil)
-                    {
-                      if (axial_floor == 0)
-                        axial_ceil++;
-                      else
-                        axial_floor--;
-                    }
-
-                  // find the two crystals for this bin and on which buckets (modules) they are
-                  int det1_num_out, det2_num_out;
-                  const auto proj_data_out_info_ptr = dynamic_cast<const ProjDataInfoGenericNoArcCorr*>(&proj_data_out_info);
-                  proj_data_out_info_ptr->get_det_num_pair_for_view_tangential_pos_num(det1_num_out,
-                                                                                       det2_num_out,
-                                                                                       index_out[2], /*view*/
-                                                                                       index_out[3] /* tangential pos */);
-                  const int dets_per_module_out = proj_data_out_info.get_scanner_sptr()->get_num_transaxial_crystals_per_bucket();
-                  const int det1_module = det1_num_out / dets_per_module_out;
-                  const int det2_module = det2_num_out / dets_per_module_out;
-
-                  // translate the crystal position on each module from the full size scanner to the downsampled scanner
-                  const auto proj_data_in_info_ptr = dynamic_cast<const ProjDataInfoGenericNoArcCorr*>(&proj_data_in_info);
-                  const int dets_per_module_in
-                      = proj_data_in_info_ptr->get_scanner_sptr()->get_num_transaxial_crystals_per_bucket();
-                  const int crystal1_out_module_idx = det1_num_out % dets_per_module_out;
-                  const double crystal1_out_module_pos
-                      = std::floor(static_cast<double>(crystal1_out_module_idx)
-                                   / proj_data_out_info_ptr->get_scanner_sptr()->get_num_transaxial_crystals_per_block())
-                            * proj_data_out_info_ptr->get_scanner_sptr()->get_transaxial_block_spacing()
-                        + static_cast<double>(
-                              crystal1_out_module_idx
-                              % proj_data_out_info_ptr->get_scanner_sptr()->get_num_transaxial_crystals_per_block())
-                              * proj_data_out_info_ptr->get_scanner_sptr()->get_transaxial_crystal_spacing();
-                  const double crystal1_num_in
-                      = det1_module * dets_per_module_in
-                        + crystal1_out_module_pos / proj_data_in_info.get_scanner_sptr()->get_transaxial_crystal_spacing();
-                  const int crystal2_out_module_idx = det2_num_out % dets_per_module_out;
-                  const double crystal2_out_module_pos
-                      = std::floor(static_cast<double>(crystal2_out_module_idx)
-                                   / proj_data_out_info_ptr->get_scanner_sptr()->get_num_transaxial_crystals_per_block())
-                            * proj_data_out_info_ptr->get_scanner_sptr()->get_transaxial_block_spacing()
-                        + static_cast<double>(
-                              crystal2_out_module_idx
-                              % proj_data_out_info_ptr->get_scanner_sptr()->get_num_transaxial_crystals_per_block())
-                              * proj_data_out_info_ptr->get_scanner_sptr()->get_transaxial_crystal_spacing();
-                  const double crystal2_num_in
-                      = det2_module * dets_per_module_in
-                        + crystal2_out_module_pos / proj_data_in_info.get_scanner_sptr()->get_transaxial_crystal_spacing();
-                  const auto crystal1_num_in_floor
-                      = std::max(static_cast<int>(std::floor(crystal1_num_in)), det1_module * dets_per_module_in);
-                  const auto crystal1_num_in_ceil
-                      = std::min(static_cast<int>(std::ceil(crystal1_num_in)), (det1_module + 1) * dets_per_module_in - 1);
-                  const auto crystal2_num_in_floor
-                      = std::max(static_cast<int>(std::floor(crystal2_num_in)), det2_module * dets_per_module_in);
-                  const auto crystal2_num_in_ceil
-                      = std::min(static_cast<int>(std::ceil(crystal2_num_in)), (det2_module + 1) * dets_per_module_in - 1);
-
-                  // translate to indices in input proj data
-                  BasicCoordinate<3, int> index_in;
-
-                  // in this case we can skip parts of the interpolation
-                  if (crystal1_num_in_floor == crystal1_num_in_ceil)
-                    {
-                      if (crystal2_num_in_floor == crystal2_num_in_ceil)
-                        {
-                          int one_view, one_tang;
-                          proj_data_in_info_ptr->get_view_tangential_pos_num_for_det_num_pair(
-                              one_view, one_tang, crystal1_num_in_floor, crystal2_num_in_floor);
-                          one_tang = std::min(std::max(proj_data_in_info_ptr->get_min_tangential_pos_num(), one_tang),
-                                              proj_data_in_info_ptr->get_max_tangential_pos_num());
-
-                          index_in[1] = std::max(axial_floor, proj_data_in_info_ptr->get_min_axial_pos_num(0));
-                          index_in[2] = one_view;
-                          index_in[3] = one_tang;
-                          sino_3D_out[index_out] += segment[index_in] * (axial_ceil - axial_idx);
-
-                          index_in[1] = std::min(axial_ceil, proj_data_in_info_ptr->get_max_axial_pos_num(0));
-                          sino_3D_out[index_out] += segment[index_in] * (axial_idx - axial_floor);
-                        }
-                      else
-                        {
-                          int ff_view, fc_view;
-                          int ff_tang, fc_tang;
-                          proj_data_in_info_ptr->get_view_tangential_pos_num_for_det_num_pair(
-                              ff_view, ff_tang, crystal1_num_in_floor, crystal2_num_in_floor);
-                          proj_data_in_info_ptr->get_view_tangential_pos_num_for_det_num_pair(
-                              fc_view, fc_tang, crystal1_num_in_floor, crystal2_num_in_ceil);
-
-                          ff_tang = std::min(std::max(proj_data_in_info_ptr->get_min_tangential_pos_num(), ff_tang),
-                                             proj_data_in_info_ptr->get_max_tangential_pos_num());
-                          fc_tang = std::min(std::max(proj_data_in_info_ptr->get_min_tangential_pos_num(), fc_tang),
-                                             proj_data_in_info_ptr->get_max_tangential_pos_num());
-
-                          index_in[1] = std::max(axial_floor, proj_data_in_info_ptr->get_min_axial_pos_num(0));
-                          index_in[2] = ff_view;
-                          index_in[3] = ff_tang;
-                          sino_3D_out[index_out]
-                              += segment[index_in] * (axial_ceil - axial_idx) * (crystal2_num_in_ceil - crystal2_num_in);
-                          index_in[2] = fc_view;
-                          index_in[3] = fc_tang;
-                          sino_3D_out[index_out]
-                              += segment[index_in] * (axial_ceil - axial_idx) * (crystal2_num_in - crystal2_num_in_floor);
-                          index_in[1] = std::min(axial_ceil, proj_data_in_info_ptr->get_max_axial_pos_num(0));
-                          sino_3D_out[index_out]
-                              += segment[index_in] * (axial_idx - axial_floor) * (crystal2_num_in - crystal2_num_in_floor);
-                          index_in[2] = ff_view;
-                          index_in[3] = ff_tang;
-                          sino_3D_out[index_out]
-                              += segment[index_in] * (axial_idx - axial_floor) * (crystal2_num_in_ceil - crystal2_num_in);
-                        }
-                    }
-                  else if (crystal2_num_in_floor == crystal2_num_in_ceil)
-                    {
-                      int ff_view, cf_view;
-                      int ff_tang, cf_tang;
-                      proj_data_in_info_ptr->get_view_tangential_pos_num_for_det_num_pair(
-                          ff_view, ff_tang, crystal1_num_in_floor, crystal2_num_in_floor);
-                      proj_data_in_info_ptr->get_view_tangential_pos_num_for_det_num_pair(
-                          cf_view, cf_tang, crystal1_num_in_ceil, crystal2_num_in_floor);
-
-                      ff_tang = std::min(std::max(proj_data_in_info_ptr->get_min_tangential_pos_num(), ff_tang),
-                                         proj_data_in_info_ptr->get_max_tangential_pos_num());
-                      cf_tang = std::min(std::max(proj_data_in_info_ptr->get_min_tangential_pos_num(), cf_tang),
-                                         proj_data_in_info_ptr->get_max_tangential_pos_num());
-
-                      index_in[1] = std::max(axial_floor, proj_data_in_info_ptr->get_min_axial_pos_num(0));
-                      index_in[2] = ff_view;
-                      index_in[3] = ff_tang;
-                      sino_3D_out[index_out]
-                          += segment[index_in] * (axial_ceil - axial_idx) * (crystal1_num_in_ceil - crystal1_num_in);
-                      index_in[2] = cf_view;
-                      index_in[3] = cf_tang;
-                      sino_3D_out[index_out]
-                          += segment[index_in] * (axial_ceil - axial_idx) * (crystal1_num_in - crystal1_num_in_floor);
-                      index_in[1] = std::min(axial_ceil, proj_data_in_info_ptr->get_max_axial_pos_num(0));
-                      sino_3D_out[index_out]
-                          += segment[index_in] * (axial_idx - axial_floor) * (crystal1_num_in - crystal1_num_in_floor);
-                      index_in[2] = ff_view;
-                      index_in[3] = ff_tang;
-                      sino_3D_out[index_out]
-                          += segment[index_in] * (axial_idx - axial_floor) * (crystal1_num_in_ceil - crystal1_num_in);
-                    }
-                  else // in this case we need to do a trilinear interpolation
-                    {
-                      int ff_view, fc_view, cf_view, cc_view;
-                      int ff_tang, fc_tang, cf_tang, cc_tang;
-                      proj_data_in_info_ptr->get_view_tangential_pos_num_for_det_num_pair(
-                          ff_view, ff_tang, crystal1_num_in_floor, crystal2_num_in_floor);
-                      proj_data_in_info_ptr->get_view_tangential_pos_num_for_det_num_pair(
-                          fc_view, fc_tang, crystal1_num_in_floor, crystal2_num_in_ceil);
-                      proj_data_in_info_ptr->get_view_tangential_pos_num_for_det_num_pair(
-                          cf_view, cf_tang, crystal1_num_in_ceil, crystal2_num_in_floor);
-                      proj_data_in_info_ptr->get_view_tangential_pos_num_for_det_num_pair(
-                          cc_view, cc_tang, crystal1_num_in_ceil, crystal2_num_in_ceil);
-
-                      // TODO: why can we get positions out that are not even in the proj data?!
-                      ff_tang = std::min(std::max(proj_data_in_info_ptr->get_min_tangential_pos_num(), ff_tang),
-                                         proj_data_in_info_ptr->get_max_tangential_pos_num());
-                      fc_tang = std::min(std::max(proj_data_in_info_ptr->get_min_tangential_pos_num(), fc_tang),
-                                         proj_data_in_info_ptr->get_max_tangential_pos_num());
-                      cf_tang = std::min(std::max(proj_data_in_info_ptr->get_min_tangential_pos_num(), cf_tang),
-                                         proj_data_in_info_ptr->get_max_tangential_pos_num());
-                      cc_tang = std::min(std::max(proj_data_in_info_ptr->get_min_tangential_pos_num(), cc_tang),
-                                         proj_data_in_info_ptr->get_max_tangential_pos_num());
-
-                      index_in[1] = std::max(axial_floor, proj_data_in_info_ptr->get_min_axial_pos_num(0));
-                      index_in[2] = ff_view;
-                      index_in[3] = ff_tang;
-                      sino_3D_out[index_out] += segment[index_in] * (axial_ceil - axial_idx)
-                                                * (crystal1_num_in_ceil - crystal1_num_in)
-                                                * (crystal2_num_in_ceil - crystal2_num_in);
-                      index_in[2] = fc_view;
-                      index_in[3] = fc_tang;
-                      sino_3D_out[index_out] += segment[index_in] * (axial_ceil - axial_idx)
-                                                * (crystal1_num_in_ceil - crystal1_num_in)
-                                                * (crystal2_num_in - crystal2_num_in_floor);
-                      index_in[2] = cc_view;
-                      index_in[3] = cc_tang;
-                      sino_3D_out[index_out] += segment[index_in] * (axial_ceil - axial_idx)
-                                                * (crystal1_num_in - crystal1_num_in_floor)
-                                                * (crystal2_num_in - crystal2_num_in_floor);
-                      index_in[2] = cf_view;
-                      index_in[3] = cf_tang;
-                      sino_3D_out[index_out] += segment[index_in] * (axial_ceil - axial_idx)
-                                                * (crystal1_num_in - crystal1_num_in_floor)
-                                                * (crystal2_num_in_ceil - crystal2_num_in);
-
-                      index_in[1] = std::min(axial_ceil, proj_data_in_info_ptr->get_max_axial_pos_num(0));
-                      index_in[2] = ff_view;
-                      index_in[3] = ff_tang;
-                      sino_3D_out[index_out] += segment[index_in] * (axial_idx - axial_floor)
-                                                * (crystal1_num_in_ceil - crystal1_num_in)
-                                                * (crystal2_num_in_ceil - crystal2_num_in);
-                      index_in[2] = fc_view;
-                      index_in[3] = fc_tang;
-                      sino_3D_out[index_out] += segment[index_in] * (axial_idx - axial_floor)
-                                                * (crystal1_num_in_ceil - crystal1_num_in)
-                                                * (crystal2_num_in - crystal2_num_in_floor);
-                      index_in[2] = cc_view;
-                      index_in[3] = cc_tang;
-                      sino_3D_out[index_out] += segment[index_in] * (axial_idx - axial_floor)
-                                                * (crystal1_num_in - crystal1_num_in_floor)
-                                                * (crystal2_num_in - crystal2_num_in_floor);
-                      index_in[2] = cf_view;
-                      index_in[3] = cf_tang;
-                      sino_3D_out[index_out] += segment[index_in] * (axial_idx - axial_floor)
-                                                * (crystal1_num_in - crystal1_num_in_floor)
-                                                * (crystal2_num_in_ceil - crystal2_num_in);
-                    }
+                  const BlocksTransaxialWeights::Weight& w = transaxial_weights.weights[i];
+                  out_row[tang_pos_num] += sino_floor[w.view_num][w.tangential_pos_num] * axial_floor_weight * w.weight;
+                  out_row[tang_pos_num] += sino_ceil[w.view_num][w.tangential_pos_num] * axial_ceil_weight * w.weight;
                 }
             }
         }
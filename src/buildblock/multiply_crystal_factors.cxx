@@ -25,20 +25,27 @@
 #include "stir/Sinogram.h"
 #include "stir/error.h"
 #include <memory>
+#include <vector>
 
 START_NAMESPACE_STIR
 
 // declaration of local function that does the work
 template <class TProjDataInfo>
 void
-multiply_crystal_factors_help(ProjData& proj_data,
+multiply_crystal_factors_help(const std::vector<ProjData*>& proj_datas,
                               const TProjDataInfo& proj_data_info,
-                              const Array<2, float>& efficiencies,
-                              float global_factor)
+                              const std::vector<const Array<2, float>*>& efficiencies,
+                              std::vector<float> global_factors)
 {
+  const std::size_t num_outputs = proj_datas.size();
+  assert(efficiencies.size() == num_outputs);
+  assert(global_factors.size() == num_outputs);
+  const ProjData& proj_data = *proj_datas[0];
+
   // we will duplicate TOF sinograms, so need to divide with their number such that
   // total remains preserved
-  global_factor /= proj_data.get_num_tof_poss();
+  for (auto& global_factor : global_factors)
+    global_factor /= proj_data.get_num_tof_poss();
 
   const auto non_tof_proj_data_info_sptr = std::dynamic_pointer_cast<TProjDataInfo>(proj_data_info.create_non_tof_clone());
   Bin bin;
@@ -51,7 +58,8 @@ multiply_crystal_factors_help(ProjData& proj_data,
            bin.axial_pos_num() <= proj_data.get_max_axial_pos_num(bin.segment_num());
            ++bin.axial_pos_num())
         {
-          Sinogram<float> sinogram = non_tof_proj_data_info_sptr->get_empty_sinogram(SinogramIndices(bin));
+          std::vector<Sinogram<float>> sinograms(num_outputs,
+                                                 non_tof_proj_data_info_sptr->get_empty_sinogram(SinogramIndices(bin)));
 
 #ifdef STIR_OPENMP
 #  if _OPENMP >= 200711
@@ -72,82 +80,132 @@ multiply_crystal_factors_help(ProjData& proj_data,
                   parallel_bin.view_num() = view_num;
                   parallel_bin.tangential_pos_num() = tangential_pos_num;
 
+                  // find the detector pairs only once for all outputs
                   std::vector<DetectionPositionPair<>> det_pos_pairs;
                   non_tof_proj_data_info_sptr->get_all_det_pos_pairs_for_bin(
                       det_pos_pairs, parallel_bin); // using the default argument to ignore TOF here
-                  float result = 0.F;
-                  for (unsigned int i = 0; i < det_pos_pairs.size(); ++i)
+                  for (std::size_t output_num = 0; output_num < num_outputs; ++output_num)
                     {
-                      const auto& p1 = det_pos_pairs[i].pos1();
-                      const auto& p2 = det_pos_pairs[i].pos2();
-                      result += efficiencies[p1.axial_coord()][p1.tangential_coord()]
-                                * efficiencies[p2.axial_coord()][p2.tangential_coord()];
-                    }
+                      const Array<2, float>& output_efficiencies = *efficiencies[output_num];
+                      float result = 0.F;
+                      for (unsigned int i = 0; i < det_pos_pairs.size(); ++i)
+                        {
+                          const auto& p1 = det_pos_pairs[i].pos1();
+                          const auto& p2 = det_pos_pairs[i].pos2();
+                          result += output_efficiencies[p1.axial_coord()][p1.tangential_coord()]
+                                    * output_efficiencies[p2.axial_coord()][p2.tangential_coord()];
+                        }
 #if defined(STIR_OPENMP)
 #  if _OPENMP >= 201012
 #    pragma omp atomic update
 #  else
 #    pragma omp critical(STIRMULTIPLYCRYSTALFACTORS)
-                  {
+                      {
 #  endif
 #endif
-                  // Use += such that the "atomic update" pragma compiles (OpenMP 3.0).
-                  // Presumably with OpenMP 3.1 we could use "atomic write"
-                  sinogram[parallel_bin.view_num()][parallel_bin.tangential_pos_num()] += result * global_factor;
+                      // Use += such that the "atomic update" pragma compiles (OpenMP 3.0).
+                      // Presumably with OpenMP 3.1 we could use "atomic write"
+                      sinograms[output_num][parallel_bin.view_num()][parallel_bin.tangential_pos_num()]
+                          += result * global_factors[output_num];
 #if defined(STIR_OPENMP) && _OPENMP < 201012
-                }
+                    }
 #endif
+                    }
+                }
             }
-        }
-      // now set sinogram, a bit complicated for TOF as we replicate
-      if (proj_data.get_num_tof_poss() == 1)
-        {
-          proj_data.set_sinogram(sinogram);
-        }
-      else
-        {
-          for (bin.timing_pos_num() = proj_data.get_min_tof_pos_num(); bin.timing_pos_num() <= proj_data.get_max_tof_pos_num();
-               ++bin.timing_pos_num())
+          // now set sinograms, a bit complicated for TOF as we replicate
+          for (std::size_t output_num = 0; output_num < num_outputs; ++output_num)
             {
-              // construct TOF sinogram with same values as the non-TOF sinogram,
-              // but appropriate meta-data.
-              const Sinogram<float> tof_sinogram(sinogram, proj_data.get_proj_data_info_sptr(), SinogramIndices(bin));
-              proj_data.set_sinogram(tof_sinogram);
+              ProjData& output_proj_data = *proj_datas[output_num];
+              if (output_proj_data.get_num_tof_poss() == 1)
+                {
+                  output_proj_data.set_sinogram(sinograms[output_num]);
+                }
+              else
+                {
+                  Bin tof_bin(bin);
+                  for (tof_bin.timing_pos_num() = output_proj_data.get_min_tof_pos_num();
+                       tof_bin.timing_pos_num() <= output_proj_data.get_max_tof_pos_num();
+                       ++tof_bin.timing_pos_num())
+                    {
+                      // construct TOF sinogram with same values as the non-TOF sinogram,
+                      // but appropriate meta-data.
+                      const Sinogram<float> tof_sinogram(
+                          sinograms[output_num], output_proj_data.get_proj_data_info_sptr(), SinogramIndices(tof_bin));
+                      output_proj_data.set_sinogram(tof_sinogram);
+                    }
+                }
             }
         }
     }
 }
-}
 
-void
-multiply_crystal_factors(ProjData& proj_data, const Array<2, float>& efficiencies, const float global_factor)
+static void
+multiply_crystal_factors_help(const std::vector<ProjData*>& proj_datas,
+                              const std::vector<const Array<2, float>*>& efficiencies,
+                              const std::vector<float>& global_factors)
 {
-  if (proj_data.get_proj_data_info_sptr()->get_scanner_ptr()->get_scanner_geometry() == "Cylindrical")
+  const ProjDataInfo& proj_data_info = *proj_datas[0]->get_proj_data_info_sptr();
+  for (const auto proj_data_ptr : proj_datas)
+    if (*proj_data_ptr->get_proj_data_info_sptr() != proj_data_info)
+      error("multiply_crystal_factors: all projection data need to have the same geometry");
+
+  if (proj_data_info.get_scanner_ptr()->get_scanner_geometry() == "Cylindrical")
     {
-      auto proj_data_info_ptr
-          = dynamic_cast<const ProjDataInfoCylindricalNoArcCorr* const>(proj_data.get_proj_data_info_sptr().get());
+      auto proj_data_info_ptr = dynamic_cast<const ProjDataInfoCylindricalNoArcCorr* const>(&proj_data_info);
 
       if (proj_data_info_ptr == 0)
         {
           error("Can only process not arc-corrected data\n");
         }
-      multiply_crystal_factors_help(proj_data, *proj_data_info_ptr, efficiencies, global_factor);
+      multiply_crystal_factors_help(proj_datas, *proj_data_info_ptr, efficiencies, global_factors);
     }
   else
     {
-      auto proj_data_info_ptr
-          = dynamic_cast<const ProjDataInfoBlocksOnCylindricalNoArcCorr* const>(proj_data.get_proj_data_info_sptr().get());
+      auto proj_data_info_ptr = dynamic_cast<const ProjDataInfoBlocksOnCylindricalNoArcCorr* const>(&proj_data_info);
 
       if (proj_data_info_ptr == 0)
         {
           error("Can only process not arc-corrected data\n");
         }
-      multiply_crystal_factors_help(proj_data, *proj_data_info_ptr, efficiencies, global_factor);
+      multiply_crystal_factors_help(proj_datas, *proj_data_info_ptr, efficiencies, global_factors);
+    }
+}
+
+void
+multiply_crystal_factors(ProjData& proj_data, const Array<2, float>& efficiencies, const float global_factor)
+{
+  multiply_crystal_factors_help(std::vector<ProjData*>(1, &proj_data),
+                                std::vector<const Array<2, float>*>(1, &efficiencies),
+                                std::vector<float>(1, global_factor));
+}
+
+void
+multiply_crystal_factors(const std::vector<shared_ptr<ProjData>>& proj_datas,
+                         const std::vector<Array<2, float>>& efficiencies,
+                         const std::vector<float>& global_factors)
+{
+  if (proj_datas.empty())
+    return;
+  if (efficiencies.size() != proj_datas.size() || global_factors.size() != proj_datas.size())
+    error("multiply_crystal_factors: inconsistent number of projection data, efficiencies and global factors");
+
+  std::vector<ProjData*> proj_data_ptrs;
+  std::vector<const Array<2, float>*> efficiencies_ptrs;
+  for (std::size_t i = 0; i < proj_datas.size(); ++i)
+    {
+      proj_data_ptrs.push_back(proj_datas[i].get());
+      efficiencies_ptrs.push_back(&efficiencies[i]);
     }
+  multiply_crystal_factors_help(proj_data_ptrs, efficiencies_ptrs, global_factors);
 }
 
-template void
-multiply_crystal_factors_help(ProjData&, const ProjDataInfoCylindricalNoArcCorr&, const Array<2, float>&, const float);
-template void
-multiply_crystal_factors_help(ProjData&, const ProjDataInfoBlocksOnCylindricalNoArcCorr&, const Array<2, float>&, const float);
+template void multiply_crystal_factors_help(const std::vector<ProjData*>&,
+                                            const ProjDataInfoCylindricalNoArcCorr&,
+                                            const std::vector<const Array<2, float>*>&,
+                                            std::vector<float>);
+template void multiply_crystal_factors_help(const std::vector<ProjData*>&,
+                                            const ProjDataInfoBlocksOnCylindricalNoArcCorr&,
+                                            const std::vector<const Array<2, float>*>&,
+                                            std::vector<float>);
 END_NAMESPACE_STIR
@@ -129,17 +129,21 @@ truncate_rim(DiscretisedDensity<3, float>& input_image, const int rim_truncation
   if (!input_image_cartesian.is_regular())
     error("truncate_rim called for non-regular grid. Not implemented");
 
-  const int zs = input_image_cartesian.get_min_index();
-  const int ys = input_image_cartesian[zs].get_min_index();
-  const int xs = input_image_cartesian[zs][ys].get_min_index();
+  for (int z = input_image_cartesian.get_min_index(); z <= input_image_cartesian.get_max_index(); z++)
+    truncate_rim_in_plane(input_image_cartesian[z], rim_truncation_image, strictly_less_than_radius);
+}
+
+void
+truncate_rim_in_plane(Array<2, float>& plane, const int rim_truncation_image, const bool strictly_less_than_radius)
+{
+  const int ys = plane.get_min_index();
+  const int xs = plane[ys].get_min_index();
 
-  const int ze = input_image_cartesian.get_max_index();
-  const int ye = input_image_cartesian[zs].get_max_index();
-  const int xe = input_image_cartesian[zs][ys].get_max_index();
+  const int ye = plane.get_max_index();
+  const int xe = plane[ys].get_max_index();
 
   // TODO check what happens with even-sized images (i.e. where is the centre?)
 
-  // const int zm=(zs+ze)/2;
   const int ym = (ys + ye) / 2;
   const int xm = (xs + xe) / 2;
 
@@ -147,23 +151,21 @@ truncate_rim(DiscretisedDensity<3, float>& input_image, const int rim_truncation
 
   if (strictly_less_than_radius)
     {
-      for (int z = zs; z <= ze; z++)
-        for (int y = ys; y <= ye; y++)
-          for (int x = xs; x <= xe; x++)
-            {
-              if (square(xm - x) + square(ym - y) >= square(truncated_radius))
-                input_image[z][y][x] = 0;
-            }
+      for (int y = ys; y <= ye; y++)
+        for (int x = xs; x <= xe; x++)
+          {
+            if (square(xm - x) + square(ym - y) >= square(truncated_radius))
+              plane[y][x] = 0;
+          }
     }
   else
     {
-      for (int z = zs; z <= ze; z++)
-        for (int y = ys; y <= ye; y++)
-          for (int x = xs; x <= xe; x++)
-            {
-              if (square(xm - x) + square(ym - y) > square(truncated_radius))
-                input_image[z][y][x] = 0;
-            }
+      for (int y = ys; y <= ye; y++)
+        for (int x = xs; x <= xe; x++)
+          {
+            if (square(xm - x) + square(ym - y) > square(truncated_radius))
+              plane[y][x] = 0;
+          }
     }
 }
 
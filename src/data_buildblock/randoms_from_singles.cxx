@@ -26,68 +26,122 @@
 #include "stir/decay_correction_factor.h"
 #include "stir/IndexRange2D.h"
 #include "stir/info.h"
+#include "stir/error.h"
+#include <vector>
 
 START_NAMESPACE_STIR
 
-void
-randoms_from_singles(ProjData& proj_data, const SinglesRates& singles, float coincidence_time_window, float isotope_halflife)
+//! Get total singles per crystal for a time interval
+/*! Singles are only integrated once per singles unit, and then copied to all crystals in that unit. */
+static Array<2, float>
+get_total_singles_per_crystal(const SinglesRates& singles, const Scanner& scanner, const double start_time, const double end_time)
 {
-  const auto& scanner = *proj_data.get_proj_data_info_sptr()->get_scanner_ptr();
-  if (coincidence_time_window <= 0.F)
-    coincidence_time_window = scanner.get_coincidence_window_width_in_ps() / 1e12F;
-  if (isotope_halflife <= 0.F)
-    isotope_halflife = proj_data.get_exam_info().get_radionuclide().get_half_life();
-
   const int num_rings = scanner.get_num_rings();
   const int num_detectors_per_ring = scanner.get_num_detectors_per_ring();
+  const int num_singles_units = scanner.get_num_singles_units();
 
-  const TimeFrameDefinitions frame_defs = proj_data.get_exam_info_sptr()->get_time_frame_definitions();
+  // Note: this loop is cheap, and get_singles() can call error() (i.e. throw) for an invalid time interval,
+  // which is not allowed inside an OpenMP parallel region. So we keep it serial.
+  std::vector<float> total_singles_per_unit(num_singles_units);
+  for (int singles_bin_index = 0; singles_bin_index < num_singles_units; ++singles_bin_index)
+    total_singles_per_unit[singles_bin_index] = singles.get_singles(singles_bin_index, start_time, end_time);
 
-  // get total singles for this frame
   Array<2, float> total_singles(IndexRange2D(num_rings, num_detectors_per_ring));
   for (int r = 0; r < num_rings; ++r)
     for (int c = 0; c < num_detectors_per_ring; ++c)
       {
         const DetectionPosition<> pos(c, r, 0);
-        total_singles[r][c] = singles.get_singles(pos, frame_defs.get_start_time(1), frame_defs.get_end_time(1));
+        total_singles[r][c] = total_singles_per_unit[scanner.get_singles_bin_index(pos)];
       }
+  return total_singles;
+}
 
-  {
-    /* Randoms from singles formula is
-
-       randoms-rate[t,i,j] = coinc_window * singles-rate[t,i] * singles-rate[t,j]
-
-       However, we actually have total counts in the singles for sinograms.
-       and need total counts in the randoms.
-       Assuming there is just decay going on, then we have
+//! Find factor from 2tau*(singles_totals)^2 to randoms_totals
+static double
+get_RFS_correction_factor(const double isotope_halflife, const double duration)
+{
+  /* Randoms from singles formula is
+
+     randoms-rate[t,i,j] = coinc_window * singles-rate[t,i] * singles-rate[t,j]
+
+     However, we actually have total counts in the singles for sinograms.
+     and need total counts in the randoms.
+     Assuming there is just decay going on, then we have
+
+     randoms-rate[t,i,j] = coinc_window * singles-rate[0,i] * singles-rate[0,j] exp (-2lambda t)
+
+     randoms-counts[i,j] = int_t1^t2 randoms-rate[t,i,j]
+               = coinc_window * singles-rate[0,i] * singles-rate[0,j] * int_t1^t2 exp (-2lambda t)
+               = coinc_window * singles-counts[i] * singles-counts[j] *
+                 int_t1^t2 exp (-2lambda t) / (int_t1^t2 exp (-lambda t))^2
+     where int indicates an integral.
+
+     Now we can use that decay_correction_factor(lambda,t1,t2) computes
+        duration/(int_t1^t2 exp (-lambda t))
+
+     That leads to the formula below (as it turns out that the above ratio only depends t2-t1)
+  */
+  const double decay_corr_factor = decay_correction_factor(isotope_halflife, 0., duration);
+  const double double_decay_corr_factor = decay_correction_factor(0.5 * isotope_halflife, 0., duration);
+  const double corr_factor = square(decay_corr_factor) / double_decay_corr_factor / duration;
+
+  info(boost::format("Isotope half-life: %1%\n"
+                     "RFS: decay correction factor: %2%,\n"
+                     "time frame duration: %3%.\n"
+                     "total correction factor from 2tau*(singles_totals)^2 to randoms_totals: %4%.\n")
+           % isotope_halflife % decay_corr_factor % duration % (1 / corr_factor),
+       2);
+  return corr_factor;
+}
 
-       randoms-rate[t,i,j] = coinc_window * singles-rate[0,i] * singles-rate[0,j] exp (-2lambda t)
+void
+randoms_from_singles(ProjData& proj_data, const SinglesRates& singles, float coincidence_time_window, float isotope_halflife)
+{
+  const auto& scanner = *proj_data.get_proj_data_info_sptr()->get_scanner_ptr();
+  if (coincidence_time_window <= 0.F)
+    coincidence_time_window = scanner.get_coincidence_window_width_in_ps() / 1e12F;
+  if (isotope_halflife <= 0.F)
+    isotope_halflife = proj_data.get_exam_info().get_radionuclide().get_half_life();
 
-       randoms-counts[i,j] = int_t1^t2 randoms-rate[t,i,j]
-                 = coinc_window * singles-rate[0,i] * singles-rate[0,j] * int_t1^t2 exp (-2lambda t)
-                 = coinc_window * singles-counts[i] * singles-counts[j] *
-                   int_t1^t2 exp (-2lambda t) / (int_t1^t2 exp (-lambda t))^2
-       where int indicates an integral.
+  const TimeFrameDefinitions frame_defs = proj_data.get_exam_info_sptr()->get_time_frame_definitions();
 
-       Now we can use that decay_correction_factor(lambda,t1,t2) computes
-          duration/(int_t1^t2 exp (-lambda t))
+  // get total singles for this frame
+  const Array<2, float> total_singles
+      = get_total_singles_per_crystal(singles, scanner, frame_defs.get_start_time(1), frame_defs.get_end_time(1));
 
-       That leads to the formula below (as it turns out that the above ratio only depends t2-t1)
-    */
-    const double duration = frame_defs.get_duration(1);
-    const double decay_corr_factor = decay_correction_factor(isotope_halflife, 0., duration);
-    const double double_decay_corr_factor = decay_correction_factor(0.5 * isotope_halflife, 0., duration);
-    const double corr_factor = square(decay_corr_factor) / double_decay_corr_factor / duration;
+  const double corr_factor = get_RFS_correction_factor(isotope_halflife, frame_defs.get_duration(1));
+  multiply_crystal_factors(proj_data, total_singles, static_cast<float>(coincidence_time_window * corr_factor));
+}
 
-    info(boost::format("Isotope half-life: %1%\n"
-                       "RFS: decay correction factor: %2%,\n"
-                       "time frame duration: %3%.\n"
-                       "total correction factor from 2tau*(singles_totals)^2 to randoms_totals: %4%.\n")
-             % isotope_halflife % decay_corr_factor % duration % (1 / corr_factor),
-         2);
+void
+randoms_from_singles(const std::vector<shared_ptr<ProjData>>& proj_datas,
+                     const SinglesRates& singles,
+                     float coincidence_time_window,
+                     float isotope_halflife)
+{
+  if (proj_datas.empty())
+    return;
 
-    multiply_crystal_factors(proj_data, total_singles, static_cast<float>(coincidence_time_window * corr_factor));
-  }
+  const auto& scanner = *proj_datas[0]->get_proj_data_info_sptr()->get_scanner_ptr();
+  if (coincidence_time_window <= 0.F)
+    coincidence_time_window = scanner.get_coincidence_window_width_in_ps() / 1e12F;
+  if (isotope_halflife <= 0.F)
+    isotope_halflife = proj_datas[0]->get_exam_info().get_radionuclide().get_half_life();
+
+  std::vector<Array<2, float>> total_singles_per_frame;
+  std::vector<float> global_factors;
+  for (const auto& proj_data_sptr : proj_datas)
+    {
+      const TimeFrameDefinitions& frame_defs = proj_data_sptr->get_exam_info().get_time_frame_definitions();
+      if (frame_defs.get_num_time_frames() == 0)
+        error("randoms_from_singles: all projection data need to have time frame information");
+      total_singles_per_frame.push_back(
+          get_total_singles_per_crystal(singles, scanner, frame_defs.get_start_time(1), frame_defs.get_end_time(1)));
+      const double corr_factor = get_RFS_correction_factor(isotope_halflife, frame_defs.get_duration(1));
+      global_factors.push_back(static_cast<float>(coincidence_time_window * corr_factor));
+    }
+
+  multiply_crystal_factors(proj_datas, total_singles_per_frame, global_factors);
 }
 
 END_NAMESPACE_STIR
@@ -0,0 +1,160 @@
+/*!
+  \file
+  \ingroup evaluation
+
+  \brief Implementation of class stir::DiscretisedROIs
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+#include "stir/evaluation/DiscretisedROIs.h"
+#include "stir/evaluation/compute_ROI_values.h"
+#include "stir/Shape/Shape3D.h"
+#include "stir/VoxelsOnCartesianGrid.h"
+#include "stir/error.h"
+#include <limits>
+
+START_NAMESPACE_STIR
+
+DiscretisedROIs::DiscretisedROIs(const std::vector<shared_ptr<Shape3D>>& shapes,
+                                 const DiscretisedDensity<3, float>& template_image,
+                                 const CartesianCoordinate3D<int>& num_samples)
+{
+  this->set_template(template_image);
+  const VoxelsOnCartesianGrid<float>& template_voxels = dynamic_cast<const VoxelsOnCartesianGrid<float>&>(template_image);
+  // use the same image for all shapes (construct_volume overwrites all voxels)
+  shared_ptr<VoxelsOnCartesianGrid<float>> discretised_shape_sptr(template_voxels.get_empty_voxels_on_cartesian_grid());
+  for (std::vector<shared_ptr<Shape3D>>::const_iterator iter = shapes.begin(); iter != shapes.end(); ++iter)
+    {
+      (*iter)->construct_volume(*discretised_shape_sptr, num_samples);
+      this->add_ROI(*discretised_shape_sptr);
+    }
+}
+
+DiscretisedROIs::DiscretisedROIs(const std::vector<shared_ptr<const DiscretisedDensity<3, float>>>& discretised_shapes)
+{
+  if (discretised_shapes.empty())
+    error("DiscretisedROIs: need at least one discretised shape");
+  this->set_template(*discretised_shapes[0]);
+  for (std::vector<shared_ptr<const DiscretisedDensity<3, float>>>::const_iterator iter = discretised_shapes.begin();
+       iter != discretised_shapes.end();
+       ++iter)
+    {
+      this->check_image(**iter);
+      this->add_ROI(**iter);
+    }
+}
+
+void
+DiscretisedROIs::set_template(const DiscretisedDensity<3, float>& template_image)
+{
+  const VoxelsOnCartesianGrid<float>* voxels_ptr = dynamic_cast<const VoxelsOnCartesianGrid<float>*>(&template_image);
+  if (voxels_ptr == 0)
+    error("DiscretisedROIs: can only handle images of type VoxelsOnCartesianGrid");
+  this->index_range = voxels_ptr->get_index_range();
+  this->origin = voxels_ptr->get_origin();
+  this->voxel_size = voxels_ptr->get_voxel_size();
+}
+
+void
+DiscretisedROIs::check_image(const DiscretisedDensity<3, float>& image) const
+{
+  const VoxelsOnCartesianGrid<float>* voxels_ptr = dynamic_cast<const VoxelsOnCartesianGrid<float>*>(&image);
+  if (voxels_ptr == 0)
+    error("DiscretisedROIs: can only handle images of type VoxelsOnCartesianGrid");
+  if (voxels_ptr->get_index_range() != this->index_range || norm(voxels_ptr->get_origin() - this->origin) > 1.E-2
+      || norm(voxels_ptr->get_voxel_size() - this->voxel_size) > 1.E-4F * norm(this->voxel_size))
+    error("DiscretisedROIs: image does not have the same characteristics as the one used for discretising the ROIs");
+}
+
+void
+DiscretisedROIs::add_ROI(const DiscretisedDensity<3, float>& discretised_shape)
+{
+  const int min_z = discretised_shape.get_min_index();
+  const int max_z = discretised_shape.get_max_index();
+  this->voxels.push_back(VectorWithOffset<std::vector<WeightedVoxel>>(min_z, max_z));
+  VectorWithOffset<std::vector<WeightedVoxel>>& voxels_in_ROI = this->voxels.back();
+  for (int z = min_z; z <= max_z; ++z)
+    for (int y = discretised_shape[z].get_min_index(); y <= discretised_shape[z].get_max_index(); ++y)
+      for (int x = discretised_shape[z][y].get_min_index(); x <= discretised_shape[z][y].get_max_index(); ++x)
+        {
+          const float weight = discretised_shape[z][y][x];
+          if (weight == 0)
+            continue;
+          const WeightedVoxel voxel = { y, x, weight };
+          voxels_in_ROI[z].push_back(voxel);
+        }
+}
+
+int
+DiscretisedROIs::get_num_ROIs() const
+{
+  return static_cast<int>(this->voxels.size());
+}
+
+void
+DiscretisedROIs::compute_ROI_values_per_plane(std::vector<VectorWithOffset<ROIValues>>& values,
+                                              const DiscretisedDensity<3, float>& image) const
+{
+  this->check_image(image);
+  const int min_z = this->index_range.get_min_index();
+  const int max_z = this->index_range.get_max_index();
+  const float voxel_volume = this->voxel_size.x() * this->voxel_size.y() * this->voxel_size.z();
+  const int num_ROIs = this->get_num_ROIs();
+
+  values.resize(num_ROIs);
+  for (int roi_num = 0; roi_num < num_ROIs; ++roi_num)
+    values[roi_num] = VectorWithOffset<ROIValues>(min_z, max_z);
+
+#ifdef STIR_OPENMP
+#  pragma omp parallel for schedule(dynamic)
+#endif
+  for (int z = min_z; z <= max_z; z++)
+    {
+      const Array<2, float>& plane = image[z];
+      for (int roi_num = 0; roi_num < num_ROIs; ++roi_num)
+        {
+          // same conventions as stir::compute_ROI_values_per_plane
+          float ROI_min = std::numeric_limits<float>::max();
+          float ROI_max = std::numeric_limits<float>::min();
+          double integral = 0;
+          double integral_square = 0;
+          double volume = 0;
+          const std::vector<WeightedVoxel>& voxels_in_plane = this->voxels[roi_num][z];
+          for (std::vector<WeightedVoxel>::const_iterator iter = voxels_in_plane.begin(); iter != voxels_in_plane.end(); ++iter)
+            {
+              volume += iter->weight;
+              const float org_value = plane[iter->y][iter->x];
+              if (org_value < ROI_min)
+                ROI_min = org_value;
+              if (org_value > ROI_max)
+                ROI_max = org_value;
+              const double value = static_cast<double>(iter->weight) * org_value;
+              integral += value;
+              integral_square += value * org_value;
+            }
+          values[roi_num][z] = ROIValues(static_cast<float>(volume * voxel_volume),
+                                         static_cast<float>(integral * voxel_volume),
+                                         static_cast<float>(integral_square * voxel_volume),
+                                         ROI_min,
+                                         ROI_max);
+        }
+    }
+}
+
+void
+DiscretisedROIs::compute_total_ROI_values(std::vector<ROIValues>& values, const DiscretisedDensity<3, float>& image) const
+{
+  std::vector<VectorWithOffset<ROIValues>> values_per_plane;
+  this->compute_ROI_values_per_plane(values_per_plane, image);
+  values.resize(values_per_plane.size());
+  for (std::size_t roi_num = 0; roi_num < values_per_plane.size(); ++roi_num)
+    values[roi_num] = stir::compute_total_ROI_values(values_per_plane[roi_num]);
+}
+
+END_NAMESPACE_STIR
@@ -61,6 +61,9 @@ compute_ROI_values_per_plane(VectorWithOffset<ROIValues>& values,
   // initialise values correct size
   values = VectorWithOffset<ROIValues>(min_z, max_z);
 
+#ifdef STIR_OPENMP
+#  pragma omp parallel for schedule(dynamic)
+#endif
   for (int z = min_z; z <= max_z; z++)
     {
 #if 0
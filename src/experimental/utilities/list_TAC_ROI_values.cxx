@@ -56,7 +56,7 @@
 
 */
 #include "stir/utilities.h"
-#include "stir/evaluation/compute_ROI_values.h"
+#include "stir/evaluation/DiscretisedROIs.h"
 #include "stir/Shape/DiscretisedShape3D.h"
 #include "stir/VoxelsOnCartesianGrid.h"
 #include "stir/DynamicDiscretisedDensity.h"
@@ -246,34 +246,29 @@ main(int argc, char* argv[])
   out << '\n';
 
   {
-    std::vector<shared_ptr<Shape3D>>::const_iterator current_shape_iter = parameters.shape_ptrs.begin();
-    std::vector<string>::const_iterator current_name_iter = parameters.shape_names.begin();
-    for (; current_shape_iter != parameters.shape_ptrs.end(); ++current_shape_iter, ++current_name_iter)
+    // discretise all ROIs once, and compute values for all of them in a single pass over every frame
+    const DiscretisedROIs ROIs(parameters.shape_ptrs, dyn_image[start_frame_num], parameters.num_samples);
+    std::vector<std::vector<ROIValues>> values(end_frame_num + 1);
+    for (unsigned int frame_num = start_frame_num; frame_num <= end_frame_num; frame_num++)
+      ROIs.compute_total_ROI_values(values[frame_num], dyn_image[frame_num]);
+
+    for (std::size_t roi_num = 0; roi_num < parameters.shape_names.size(); ++roi_num)
       {
         for (unsigned int frame_num = start_frame_num; frame_num <= end_frame_num; frame_num++)
           {
             const float frame_start_time = (dyn_image.get_time_frame_definitions()).get_start_time(frame_num);
             const float frame_end_time = (dyn_image.get_time_frame_definitions()).get_end_time(frame_num);
 
-            ROIValues values;
-            values = compute_total_ROI_values(dyn_image[frame_num], **current_shape_iter, parameters.num_samples);
-            out << std::setw(15) << *current_name_iter << std::setw(10) << frame_num << std::setw(15) << frame_start_time
-                << std::setw(15) << frame_end_time << std::setw(15) << values.get_mean() << std::setw(15) << values.get_stddev();
+            const ROIValues& current_values = values[frame_num][roi_num];
+            out << std::setw(15) << parameters.shape_names[roi_num] << std::setw(10) << frame_num << std::setw(15)
+                << frame_start_time << std::setw(15) << frame_end_time << std::setw(15) << current_values.get_mean()
+                << std::setw(15) << current_values.get_stddev();
             if (do_CV)
-              out << std::setw(15) << values.get_CV();
+              out << std::setw(15) << current_values.get_CV();
             if (do_V)
-              out << std::setw(15) << values.get_roi_volume();
+              out << std::setw(15) << current_values.get_roi_volume();
             out << '\n';
           }
-
-#if 0
-	for (VectorWithOffset<ROIValues>::const_iterator iter = values.begin();
-	     iter != values.end();
-	     iter++)
-	  {
-	    std::cout << iter->report();
-	  }
-#endif
       }
   }
 
@@ -18,6 +18,9 @@
     See STIR/LICENSE.txt for details
 */
 
+#ifndef __stir_BoundaryConditions_H__
+#define __stir_BoundaryConditions_H__
+
 #include "stir/common.h"
 
 START_NAMESPACE_STIR
@@ -37,3 +40,5 @@ public:
 };
 
 END_NAMESPACE_STIR
+
+#endif
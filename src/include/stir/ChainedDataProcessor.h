@@ -2,6 +2,7 @@
 //
 /*
     Copyright (C) 2000- 2011, Hammersmith Imanet Ltd
+    Copyright (C) 2026, University College London
     This file is part of STIR.
 
     SPDX-License-Identifier: Apache-2.0
@@ -23,6 +24,7 @@
 #include "stir/RegisteredParsingObject.h"
 #include "stir/DataProcessor.h"
 #include "stir/shared_ptr.h"
+#include <vector>
 
 START_NAMESPACE_STIR
 
@@ -33,9 +35,17 @@ START_NAMESPACE_STIR
 
   As it is derived from RegisteredParsingObject, it implements all the
   necessary things to parse parameter files etc.
+
+  Nested ChainedDataProcessor objects are handled as one sequence of data processors.
+  Consecutive point-wise data processors (see DataProcessor::is_pointwise()) in this sequence
+  are applied in a single pass over the data, parallelised over planes when using OpenMP.
+  A point-wise data processor whose DataProcessor::pointwise_depends_on_whole_input() returns
+  \c true starts a new pass, as it needs to see the result of the previous data processors first.
+
   \warning The 2 argument version of  ChainedDataProcessor::apply
-  calls the first data processor with a temporary output data with
-  the same characteristics as the input data.
+  calls the first data processor with the output data, and then applies the other
+  data processors in-place on the output data. No temporary data is allocated, but the
+  output data has to have the same characteristics as the input data.
 
 
   \warning ChainedDataProcessor::set_up builds only the data
@@ -73,9 +83,22 @@ public:
                                 shared_ptr<DataProcessor<DataT>> apply_second = shared_ptr<DataProcessor<DataT>>());
 
 private:
+  typedef std::vector<shared_ptr<DataProcessor<DataT>>> processors_type;
+
   shared_ptr<DataProcessor<DataT>> apply_first;
   shared_ptr<DataProcessor<DataT>> apply_second;
 
+  //! append all (non-chained) data processors to \a processors, expanding nested ChainedDataProcessor objects
+  void append_processors(processors_type& processors) const;
+  //! apply the processors in <tt>[begin,end)</tt> in-place, fusing consecutive point-wise processors
+  static void apply_processors(DataT& data,
+                               typename processors_type::const_iterator begin,
+                               typename processors_type::const_iterator end);
+  //! apply the point-wise processors in <tt>[begin,end)</tt> in-place in a single pass
+  static void apply_pointwise_processors(DataT& data,
+                                         typename processors_type::const_iterator begin,
+                                         typename processors_type::const_iterator end);
+
   void set_defaults() override;
   void initialise_keymap() override;
 
@@ -2,6 +2,7 @@
 //
 /*
     Copyright (C) 2000- 2009, Hammersmith Imanet Ltd
+    Copyright (C) 2026, University College London
     This file is part of STIR.
 
     SPDX-License-Identifier: Apache-2.0
@@ -90,6 +91,36 @@ public:
   */
   inline Succeeded apply(DataT& out_data, const DataT& in_data);
 
+  /*! \name point-wise processing
+
+      A data processor is point-wise if it changes every element without looking at its neighbours.
+      Its result may depend on the location of the element (as for TruncateToCylindricalFOVImageProcessor),
+      and on global quantities of the input data computed by prepare_pointwise()
+      (as for ThresholdMinToSmallPositiveValueDataProcessor).
+      ChainedDataProcessor uses these functions to apply consecutive point-wise processors
+      in a single (parallel) pass over the data.
+
+      Data are processed per "plane", i.e. for every index of the first dimension.
+  */
+  //@{
+  //! Returns \c true if the processor is point-wise. Default returns \c false.
+  virtual bool is_pointwise() const;
+  //! Returns \c true if prepare_pointwise() needs to see the input data before any element is processed
+  /*! Default returns \c false. Only relevant when is_pointwise() returns \c true. */
+  virtual bool pointwise_depends_on_whole_input() const;
+  //! Calls set_up() (if not already done before) and computes any parameters needed by apply_pointwise()
+  /*! If set_up() returns Succeeded::false, a warning message is written, and
+      apply_pointwise() should not be called.
+  */
+  inline Succeeded prepare_pointwise(const DataT& data);
+  //! Process the plane with index \a outer_index of \a data in-place
+  /*! prepare_pointwise() has to be called first. This function can be called by
+      multiple threads for different planes at the same time. It does not start or stop
+      the timers, this is left to the caller.
+  */
+  inline void apply_pointwise(DataT& data, const int outer_index) const;
+  //@}
+
   /*! \name parsing functions
 
       parse() returns false if there is some error, true otherwise.
@@ -113,6 +144,12 @@ protected:
   //! Performs actual operation (in-place)
   //*! \todo should return Succeeded */
   virtual void virtual_apply(DataT& data) const = 0;
+  //! Computes parameters for virtual_apply_pointwise() from the input data (set_up() is called before this function)
+  /*! Default does nothing. */
+  virtual void virtual_prepare_pointwise(const DataT& data);
+  //! Performs the point-wise operation on one plane (in-place)
+  /*! Default calls error(). Has to be overridden when is_pointwise() returns \c true. */
+  virtual void virtual_apply_pointwise(DataT& data, const int outer_index) const;
 
 private:
   bool is_set_up_already;
@@ -11,6 +11,7 @@
 */
 /*
     Copyright (C) 2000- 2009, Hammersmith Imanet Ltd
+    Copyright (C) 2026, University College London
     This file is part of STIR.
 
     SPDX-License-Identifier: Apache-2.0
@@ -19,6 +20,7 @@
 */
 
 #include "stir/warning.h"
+#include "stir/error.h"
 
 START_NAMESPACE_STIR
 
@@ -95,6 +97,56 @@ DataProcessor<DataT>::apply(DataT& data, const DataT& in_data)
   return Succeeded::yes;
 }
 
+template <typename DataT>
+bool
+DataProcessor<DataT>::is_pointwise() const
+{
+  return false;
+}
+
+template <typename DataT>
+bool
+DataProcessor<DataT>::pointwise_depends_on_whole_input() const
+{
+  return false;
+}
+
+template <typename DataT>
+Succeeded
+DataProcessor<DataT>::prepare_pointwise(const DataT& data)
+{
+  if (!is_set_up_already)
+    if (set_up(data) == Succeeded::no)
+      {
+        warning("DataProcessor::prepare_pointwise: Building was unsuccesfull. No processing done.\n");
+        return Succeeded::no;
+      }
+  start_timers();
+  virtual_prepare_pointwise(data);
+  stop_timers();
+  return Succeeded::yes;
+}
+
+template <typename DataT>
+void
+DataProcessor<DataT>::apply_pointwise(DataT& data, const int outer_index) const
+{
+  assert(is_set_up_already);
+  virtual_apply_pointwise(data, outer_index);
+}
+
+template <typename DataT>
+void
+DataProcessor<DataT>::virtual_prepare_pointwise(const DataT&)
+{}
+
+template <typename DataT>
+void
+DataProcessor<DataT>::virtual_apply_pointwise(DataT&, const int) const
+{
+  error("DataProcessor::apply_pointwise: " + this->get_registered_name() + " is not a point-wise data processor");
+}
+
 #if 0
 template <typename DataT>
 Succeeded 
@@ -118,6 +118,9 @@ public:
   unsigned get_num_tangential_coords() const { return num_tangential_coords; }
   unsigned get_num_axial_coords() const { return num_axial_coords; }
   unsigned get_num_radial_coords() const { return num_radial_coords; }
+  //! Returns the standard deviation (in mm) used to randomly displace detector positions
+  /*! If non-zero, get_coordinate_for_det_pos() returns a different result for every call. */
+  double get_sigma() const { return sigma; }
 
 protected:
   explicit DetectorCoordinateMap(double sigma = 0.0)
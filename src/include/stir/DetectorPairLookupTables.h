@@ -0,0 +1,123 @@
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+/*!
+  \file
+  \ingroup projdata
+
+  \brief Declaration of class stir::DetectorPairLookupTables
+*/
+#ifndef __stir_DetectorPairLookupTables_H__
+#define __stir_DetectorPairLookupTables_H__
+
+#include "stir/shared_ptr.h"
+#include <vector>
+#include <cstdint>
+#include <cassert>
+
+START_NAMESPACE_STIR
+
+/*!
+  \ingroup projdata
+  \brief Look-up tables between detector pairs and (uncompressed) view/tangential positions
+
+  For a full-ring scanner with discrete detectors and interleaved sinograms, the
+  relation between a detector pair (in one ring) and the uncompressed view and
+  tangential position only depends on the number of detectors per ring. This class stores
+  both directions of this relation in flat arrays, such that a look-up is a single load.
+
+  The tables are immutable after construction. Use get_tables() to obtain a shared
+  instance, such that all ProjDataInfo objects (and their clones) for the same
+  number of detectors use the same memory.
+
+  See ProjDataInfoCylindricalNoArcCorr for the conventions.
+*/
+class DetectorPairLookupTables
+{
+public:
+  //! Return shared tables for this number of detectors, constructing them if necessary
+  /*! This function is thread-safe. */
+  static shared_ptr<const DetectorPairLookupTables> get_tables(const int num_detectors_per_ring);
+
+  //! Construct the tables
+  /*! Calls error() if \a num_detectors_per_ring is odd or too large. */
+  explicit DetectorPairLookupTables(const int num_detectors_per_ring);
+
+  int get_num_detectors_per_ring() const { return num_detectors; }
+  //! Minimum tangential_pos_num supported by get_det_num_pair_for_view_tangential_pos_num()
+  int get_min_tangential_pos_num() const { return min_tang_pos_num; }
+  //! Maximum tangential_pos_num supported by get_det_num_pair_for_view_tangential_pos_num()
+  int get_max_tangential_pos_num() const { return max_tang_pos_num; }
+
+  //! Find the detectors for an uncompressed view and tangential position
+  inline void
+  get_det_num_pair_for_view_tangential_pos_num(int& det1_num, int& det2_num, const int view_num, const int tang_pos_num) const;
+
+  //! Find the uncompressed view and tangential position for a detector pair
+  /*! \return \c true if the detector pair is stored in a positive segment (i.e. detectors do not need to be swapped) */
+  inline bool
+  get_view_tangential_pos_num_for_det_num_pair(int& view_num, int& tang_pos_num, const int det1_num, const int det2_num) const;
+
+private:
+  struct Det1Det2
+  {
+    std::int16_t det1_num;
+    std::int16_t det2_num;
+  };
+  struct ViewTangPosSwap
+  {
+    std::int16_t view_num;
+    std::int16_t tang_pos_num;
+    std::int16_t swap_detectors;
+  };
+
+  int num_detectors;
+  int min_tang_pos_num;
+  int max_tang_pos_num;
+  //! indexed as view_num*(max_tang_pos_num-min_tang_pos_num+1) + tang_pos_num-min_tang_pos_num
+  std::vector<Det1Det2> view_tangpos_to_det1det2;
+  //! indexed as det1_num*num_detectors + det2_num
+  std::vector<ViewTangPosSwap> det1det2_to_view_tangpos;
+};
+
+void
+DetectorPairLookupTables::get_det_num_pair_for_view_tangential_pos_num(int& det1_num,
+                                                                       int& det2_num,
+                                                                       const int view_num,
+                                                                       const int tang_pos_num) const
+{
+  assert(view_num >= 0);
+  assert(view_num < num_detectors / 2);
+  assert(tang_pos_num >= min_tang_pos_num);
+  assert(tang_pos_num <= max_tang_pos_num);
+  const Det1Det2& dets
+      = view_tangpos_to_det1det2[view_num * (max_tang_pos_num - min_tang_pos_num + 1) + (tang_pos_num - min_tang_pos_num)];
+  det1_num = dets.det1_num;
+  det2_num = dets.det2_num;
+}
+
+bool
+DetectorPairLookupTables::get_view_tangential_pos_num_for_det_num_pair(int& view_num,
+                                                                       int& tang_pos_num,
+                                                                       const int det1_num,
+                                                                       const int det2_num) const
+{
+  assert(det1_num != det2_num);
+  assert(det1_num >= 0);
+  assert(det1_num < num_detectors);
+  assert(det2_num >= 0);
+  assert(det2_num < num_detectors);
+  const ViewTangPosSwap& entry = det1det2_to_view_tangpos[det1_num * num_detectors + det2_num];
+  view_num = entry.view_num;
+  tang_pos_num = entry.tang_pos_num;
+  return entry.swap_detectors != 0;
+}
+
+END_NAMESPACE_STIR
+
+#endif
@@ -8,7 +8,7 @@
 
 */
 /*
-    Copyright (C) 2020, UCL
+    Copyright (C) 2020, 2026, UCL
     See STIR/LICENSE.txt for details
 */
 
@@ -75,6 +75,8 @@ This implements the following transformation for every voxel in the image:
 with \f$a=a1, b=b1\f$ if \f$\mathrm{HI} < \mathrm{break}\f$, and $a2,b2$ otherwise.
 
 When adding your own entries, you want avoid a discontinuity at the break point.
+
+This is a point-wise data processor (see DataProcessor::is_pointwise()).
 */
 template <typename TargetT>
 class HUToMuImageProcessor
@@ -104,6 +106,9 @@ public:
   //! set the slope without JSON file
   void set_slope(float a1, float a2, float b1, float b2, float breakPoint);
 
+  //! Returns \c true
+  bool is_pointwise() const override;
+
 protected:
   // parsing functions
   //! sets default values
@@ -119,6 +124,7 @@ protected:
 
   void virtual_apply(TargetT& out_density, const TargetT& in_density) const override;
   void virtual_apply(TargetT& density) const override;
+  void virtual_apply_pointwise(TargetT& density, const int outer_index) const override;
 
 private:
   std::string filename;
@@ -134,6 +140,18 @@ private:
   float b2;
   float breakPoint;
 
+  //! convert a single value
+  inline float HU_to_mu(const float HU) const
+  {
+    if (HU < breakPoint)
+      {
+        const float mu = a1 + b1 * HU;
+        return (mu < 0.0f) ? 0.0f : mu;
+      }
+    else
+      return a2 + b2 * HU;
+  }
+
 #ifdef HAVE_JSON
   void get_record_from_json();
 #endif
@@ -0,0 +1,41 @@
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+/*!
+  \file
+  \ingroup IO
+  \brief Declaration of class stir::HDF5ImageInputFileFormat
+*/
+#ifndef __stir_IO_HDF5ImageInputFileFormat_h__
+#define __stir_IO_HDF5ImageInputFileFormat_h__
+
+#include "stir/IO/InputFileFormat.h"
+#include "stir/DiscretisedDensity.h"
+
+START_NAMESPACE_STIR
+
+//! Class for reading images in the STIR HDF5 file format
+/*! \ingroup IO
+  \see HDF5OutputFileFormat
+*/
+class HDF5ImageInputFileFormat : public InputFileFormat<DiscretisedDensity<3, float>>
+{
+public:
+  const std::string get_name() const override { return "STIR HDF5"; }
+
+  bool can_read(const FileSignature& signature, const std::string& filename) const override;
+  unique_ptr<data_type> read_from_file(std::istream& input) const override;
+  unique_ptr<data_type> read_from_file(const std::string& filename) const override;
+
+protected:
+  bool actual_can_read(const FileSignature& signature, std::istream& input) const override;
+};
+
+END_NAMESPACE_STIR
+
+#endif
@@ -0,0 +1,79 @@
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+/*!
+  \file
+  \ingroup IO
+  \brief Declaration of class stir::HDF5OutputFileFormat
+*/
+#ifndef __stir_IO_HDF5OutputFileFormat_H__
+#define __stir_IO_HDF5OutputFileFormat_H__
+
+#include "stir/IO/OutputFileFormat.h"
+#include "stir/RegisteredParsingObject.h"
+
+START_NAMESPACE_STIR
+
+template <int num_dimensions, typename elemT>
+class DiscretisedDensity;
+
+/*!
+  \ingroup IO
+  \brief Implementation of OutputFileFormat paradigm for the STIR HDF5 format
+
+  The image is written as a \c float dataset (indexed as [z][y][x]), chunked per plane and
+  compressed with the shuffle and deflate filters, together with its Interfile header
+  (see stir/IO/HDF5_utilities.h). Images can be read back with read_from_file().
+
+  Only \c float output is supported, and no scaling is applied.
+
+  \par Parsing
+  \verbatim
+  HDF5 Output File Format Parameters:=
+    ; deflate level between 0 (no compression) and 9 (slowest)
+    compression level := 1
+  End HDF5 Output File Format Parameters:=
+  \endverbatim
+ */
+class HDF5OutputFileFormat : public RegisteredParsingObject<HDF5OutputFileFormat,
+                                                            OutputFileFormat<DiscretisedDensity<3, float>>,
+                                                            OutputFileFormat<DiscretisedDensity<3, float>>>
+{
+private:
+  typedef RegisteredParsingObject<HDF5OutputFileFormat,
+                                  OutputFileFormat<DiscretisedDensity<3, float>>,
+                                  OutputFileFormat<DiscretisedDensity<3, float>>>
+      base_type;
+
+public:
+  //! Name which will be used when parsing an OutputFileFormat object
+  static const char* const registered_name;
+
+  HDF5OutputFileFormat(const NumericType& = NumericType::FLOAT, const ByteOrder& = ByteOrder::native);
+
+  NumericType set_type_of_numbers(const NumericType&, const bool warn = false) override;
+  ByteOrder set_byte_order(const ByteOrder&, const bool warn = false) override;
+  float set_scale_to_write_data(const float new_scale_to_write_data, const bool warn = false) override;
+
+  //! set the deflate level between 0 (no compression) and 9 (slowest)
+  void set_compression_level(const int);
+  int get_compression_level() const;
+
+protected:
+  int compression_level;
+
+  Succeeded actual_write_to_file(std::string& output_filename, const DiscretisedDensity<3, float>& density) const override;
+
+  void set_defaults() override;
+  void initialise_keymap() override;
+  bool post_processing() override;
+};
+
+END_NAMESPACE_STIR
+
+#endif
@@ -0,0 +1,68 @@
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+/*!
+  \file
+  \ingroup IO
+  \brief Declaration of utility functions for the STIR HDF5 file format
+
+  The STIR HDF5 format stores an Interfile header (as a string attribute of the root group),
+  together with the data in one or more chunked and compressed datasets. The Interfile header
+  is written and parsed with the usual Interfile functions, such that all meta-data supported
+  by Interfile is supported.
+
+  The HDF5 library is not thread-safe in general. All calls to the HDF5 library in STIR
+  (in ProjDataHDF5, ProjDataGEHDF5 and the HDF5 image input/output) are therefore made inside an
+  OpenMP critical section with the name \c STIR_HDF5. The functions below that take an
+  H5::H5File need to be called from inside this critical section, while is_STIR_HDF5_file() enters it
+  itself. (OpenMP critical sections with the same name cannot be nested.)
+*/
+#ifndef __stir_IO_HDF5_utilities_H__
+#define __stir_IO_HDF5_utilities_H__
+
+#include "stir/common.h"
+#include "H5Cpp.h"
+#include <string>
+#include <vector>
+
+START_NAMESPACE_STIR
+
+//! Checks if the file is a STIR HDF5 file containing data of the given type
+/*!
+  \ingroup IO
+  \param data_type is currently either \c "projection data" or \c "image"
+  Returns \c false if the file cannot be opened.
+  This function cannot be called inside the \c STIR_HDF5 critical section.
+*/
+bool is_STIR_HDF5_file(const std::string& filename, const std::string& data_type);
+
+//! Writes the root group attributes of a STIR HDF5 file
+/*! \ingroup IO */
+void write_STIR_HDF5_header(H5::H5File& file, const std::string& data_type, const std::string& interfile_header);
+
+//! Reads the Interfile header from a STIR HDF5 file
+/*! \ingroup IO
+  Calls error() if the file is not a STIR HDF5 file containing data of the given type.
+*/
+std::string read_STIR_HDF5_header(H5::H5File& file, const std::string& data_type);
+
+//! Constructs properties for a chunked and compressed dataset
+/*!
+  \ingroup IO
+  Data are compressed with the shuffle and deflate filters, which are lossless and always available
+  in the HDF5 library. The fill-value is set to 0, such that parts of the dataset that have not
+  been written are read as zeroes.
+
+  \param chunk_dims the size of a chunk in every dimension
+  \param compression_level the deflate (i.e. gzip) level between 0 (no compression) and 9
+*/
+H5::DSetCreatPropList create_STIR_HDF5_dataset_properties(const std::vector<hsize_t>& chunk_dims, const int compression_level);
+
+END_NAMESPACE_STIR
+
+#endif
@@ -103,6 +103,17 @@ VoxelsOnCartesianGrid<float>* read_interfile_image(std::istream& input, const st
 */
 VoxelsOnCartesianGrid<float>* read_interfile_image(const std::string& filename);
 
+//! This parses an Interfile image header and constructs an image with the corresponding geometry
+/*!
+  \ingroup InterfileIO
+  The data file is not opened, and all voxel values are zero. Image scaling factors in the header
+  are ignored. This is useful for file formats that embed an Interfile header.
+
+  \return 0 if parsing failed
+  \warning it is up to the caller to deallocate the object
+*/
+VoxelsOnCartesianGrid<float>* create_image_from_interfile_header(std::istream& input);
+
 /// Read dynamic image
 DynamicDiscretisedDensity* read_interfile_dynamic_image(std::istream& input, const std::string& directory_for_data);
 
@@ -148,6 +159,25 @@ Succeeded write_basic_interfile_image_header(const std::string& header_file_name
                                              const VectorWithOffset<unsigned long>& file_offsets,
                                              const std::vector<std::string>& data_type_descriptions = std::vector<std::string>());
 
+//! This outputs an Interfile header for an image to a stream.
+/*!
+  \ingroup InterfileIO
+  As the other version, but only writes the 'new-style' header to \a output_header, using
+  \a data_file_name_in_header as value for the <tt>name of data file</tt> keyword.
+  This is useful for file formats that embed an Interfile header.
+ */
+Succeeded write_basic_interfile_image_header(std::ostream& output_header,
+                                             const std::string& data_file_name_in_header,
+                                             const ExamInfo& exam_info,
+                                             const IndexRange<3>& index_range,
+                                             const CartesianCoordinate3D<float>& voxel_size,
+                                             const CartesianCoordinate3D<float>& origin,
+                                             const NumericType output_type,
+                                             const ByteOrder byte_order,
+                                             const VectorWithOffset<float>& scaling_factors,
+                                             const VectorWithOffset<unsigned long>& file_offsets,
+                                             const std::vector<std::string>& data_type_descriptions = std::vector<std::string>());
+
 //! a utility function that computes the file offsets of subsequent images
 /*!
    \ingroup InterfileIO
@@ -288,6 +318,17 @@ Succeeded write_basic_interfile_PDFS_header(const std::string& header_filename,
                                             const std::string& data_filename,
                                             const ProjDataFromStream& pdfs);
 
+//! This writes an Interfile header appropriate for the ProjDataFromStream object to a stream.
+/*!
+  \ingroup InterfileIO
+  \a data_file_name_in_header is used as value for the <tt>name of data file</tt> keyword.
+  This is useful for file formats that embed an Interfile header.
+ \return Succeeded::yes when succesful, Succeeded::no otherwise.
+*/
+Succeeded write_basic_interfile_PDFS_header(std::ostream& output_header,
+                                            const std::string& data_file_name_in_header,
+                                            const ProjDataFromStream& pdfs);
+
 //! This function writes an Interfile header for the pdfs object.
 /*!
   \ingroup InterfileIO
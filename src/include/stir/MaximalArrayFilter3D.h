@@ -34,8 +34,10 @@ class Coordinate3D;
   The minimum value for a 1D array of 2n+1 elements is defined as the minimum element
   of the sorted array.
 
-  For 3D images, the current filter works by extracting all neigbours (given by
-  the mask) to a 1D array, and getting the maximal of that array.
+  For 3D images, the filter is separable: for regular arrays, the current filter computes the
+  maximum along x, then y and z, using the van Herk/Gil-Werman algorithm (i.e. with a cost
+  independent of the mask size), parallelised with OpenMP. For other arrays, it extracts
+  all neighbours (given by the mask) to a 1D array, and takes the maximal of that array.
 
   This implementation of the maximal filter handles edges by taking the minimum of
   all available pixels. For instance, when a 3x3 mask is used, and the
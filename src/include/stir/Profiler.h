@@ -0,0 +1,183 @@
+/*!
+  \file
+  \ingroup buildblock
+  \brief Declaration of classes stir::Profiler and stir::ProfiledRegion, and the STIR_PROFILE_REGION
+  and STIR_PROFILE_COUNT macros
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+
+#ifndef __stir_Profiler_H__
+#define __stir_Profiler_H__
+
+#include "stir/common.h"
+#include <atomic>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+START_NAMESPACE_STIR
+
+/*!
+  \ingroup buildblock
+  \brief A lightweight profiler for named (and nested) regions of code
+
+  Regions are marked in the code with the STIR_PROFILE_REGION macro (or a ProfiledRegion object),
+  and counters with STIR_PROFILE_COUNT. The profiler is always compiled in, but is disabled by
+  default. When it is disabled, the cost of a region or counter is a single check of a flag.
+
+  Each thread keeps its own tree of regions (where the parent of a region is the region that was
+  active in the same thread when it was entered), with the number of calls and the total (wall-clock)
+  time. There is therefore no locking when entering or leaving a region. Note that regions entered in
+  an OpenMP (or other) worker thread therefore do not have a parent from the thread that started the
+  parallel section.
+
+  At the end, the results of all threads can be written as a text summary (where regions with the same
+  name and parents are combined over threads) or as a trace in the JSON format used by the Chrome
+  trace viewer (<tt>chrome://tracing</tt>) and Perfetto. Recording trace events is separately enabled
+  as it needs memory for every region that is entered. Only the first \c max_num_trace_events_per_thread
+  events in every thread are stored.
+
+  The profiler can be enabled with set_enabled() or by setting the environment variable
+  \c STIR_PROFILING to a value different from \c 0. In the latter case, the summary is written to
+  \c stderr at the end of the program. If the environment variable \c STIR_PROFILING_TRACE_FILE is set,
+  trace events are recorded as well, and written to that file at the end of the program.
+
+  \par Example
+  \code
+  Profiler::set_enabled(true);
+  {
+    STIR_PROFILE_REGION("my computation");
+    for (...)
+      {
+        STIR_PROFILE_REGION("my step");
+        STIR_PROFILE_COUNT("my counter", 1);
+      }
+  }
+  Profiler::write_summary(std::cout);
+  \endcode
+
+  \warning reset(), and the functions that get or write the results, should not be called while other
+  threads are entering or leaving regions.
+*/
+class Profiler
+{
+public:
+  //! Summary of a region, combined over all threads
+  struct RegionSummary
+  {
+    //! names of the enclosing regions and this one, separated by \c /
+    std::string path;
+    //! number of enclosing regions
+    int depth;
+    unsigned long num_calls;
+    //! total wall-clock time (in seconds) in this region
+    double total_time;
+    //! time (in seconds) in this region, but not in a sub-region
+    double self_time;
+    //! number of threads that entered this region
+    int num_threads;
+    //! maximum over threads of the total time (in seconds)
+    double max_thread_time;
+  };
+
+  //! Check if the profiler is enabled
+  static bool is_enabled()
+  {
+    return enabled_flag.load(std::memory_order_relaxed);
+  }
+  //! Enable or disable the profiler
+  /*! Regions that are active when this is called are not affected. */
+  static void set_enabled(const bool enabled);
+  //! Check if trace events are recorded
+  static bool is_trace_enabled();
+  //! Enable or disable recording of trace events (only used when the profiler is enabled)
+  static void set_trace_enabled(const bool enabled);
+  //! Set the maximum number of trace events that are stored for every thread (defaults to 1000000)
+  static void set_max_num_trace_events_per_thread(const std::size_t max_num_events);
+
+  //! Clear all timings, counters and trace events
+  static void reset();
+
+  //! Add \a value to the counter with name \a name for the current thread
+  /*! Normally called via STIR_PROFILE_COUNT. \a name has to stay valid until the end of the program
+      (i.e. it is normally a string literal). */
+  static void add_to_counter(const char* const name, const double value);
+
+  //! Get the summaries of all regions that were entered, in depth-first order
+  /*! Sub-regions are sorted in order of decreasing total time. */
+  static std::vector<RegionSummary> get_region_summaries();
+  //! Get the values of all counters, summed over all threads
+  static std::vector<std::pair<std::string, double>> get_counters();
+
+  //! Write a summary of the regions and counters
+  static void write_summary(std::ostream& s);
+  //! Write all trace events in Chrome trace (JSON) format
+  /*! Counters are written as "counter" events at the end of the trace. */
+  static void write_chrome_trace(std::ostream& s);
+  //! Write all trace events in Chrome trace (JSON) format to a file
+  static void write_chrome_trace(const std::string& filename);
+
+private:
+  friend class ProfiledRegion;
+  static void enter_region(const char* const name);
+  static void leave_region();
+
+  static std::atomic<bool> enabled_flag;
+};
+
+/*!
+  \ingroup buildblock
+  \brief Class that marks a region for the stir::Profiler from its construction to its destruction
+
+  Normally used via the STIR_PROFILE_REGION macro. The name has to stay valid until the end of the
+  program (i.e. it is normally a string literal).
+*/
+class ProfiledRegion
+{
+public:
+  explicit ProfiledRegion(const char* const name)
+      : active(Profiler::is_enabled())
+  {
+    if (active)
+      Profiler::enter_region(name);
+  }
+  ~ProfiledRegion()
+  {
+    if (active)
+      Profiler::leave_region();
+  }
+
+private:
+  const bool active;
+
+  ProfiledRegion(const ProfiledRegion&) = delete;
+  ProfiledRegion& operator=(const ProfiledRegion&) = delete;
+};
+
+END_NAMESPACE_STIR
+
+#define STIR_PROFILE_CONCATENATE_HELPER(a, b) a##b
+#define STIR_PROFILE_CONCATENATE(a, b) STIR_PROFILE_CONCATENATE_HELPER(a, b)
+
+//! Mark the rest of the current scope as a stir::Profiler region with name \a name
+/*! \ingroup buildblock */
+#define STIR_PROFILE_REGION(name) stir::ProfiledRegion STIR_PROFILE_CONCATENATE(stir_profiled_region_, __LINE__)(name)
+
+//! Add \a value to the stir::Profiler counter with name \a name (if the profiler is enabled)
+/*! \ingroup buildblock */
+#define STIR_PROFILE_COUNT(name, value)                                                                                          \
+  do                                                                                                                             \
+    {                                                                                                                            \
+      if (stir::Profiler::is_enabled())                                                                                          \
+        stir::Profiler::add_to_counter(name, value);                                                                             \
+    }                                                                                                                            \
+  while (0)
+
+#endif
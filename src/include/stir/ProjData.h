@@ -374,6 +374,8 @@ public:
   inline std::vector<int> get_original_view_nums() const;
 
   //! writes data to a file in Interfile format
+  /*! If \a filename has extension <tt>.h5</tt> (and STIR was built with HDF5), the
+    (compressed) STIR HDF5 format is used instead, see ProjDataHDF5. */
   Succeeded write_to_file(const std::string& filename) const;
 
   //! @name arithmetic operations
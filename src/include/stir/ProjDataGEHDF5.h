@@ -28,6 +28,7 @@
 #include "stir/ProjData.h"
 #include "stir/IO/GEHDF5Wrapper.h"
 #include "stir/Array.h"
+#include <list>
 
 START_NAMESPACE_STIR
 
@@ -41,14 +42,26 @@ namespace RDF_HDF5
   \ingroup GE
   \brief A class which reads projection data from a GE HDF5
   sinogram file.
+
+  Data are read from file when they are first needed, one view (i.e. one HDF5 dataset) at a
+  time. The (uncompressed) views are kept in a cache, from which the least recently used view
+  is removed when it exceeds its maximum size (see set_max_num_cached_views()).
 */
 class ProjDataGEHDF5 : public ProjData
 {
 public:
   explicit ProjDataGEHDF5(const std::string& input_filename);
 
+  //! Constructor using an existing wrapper
+  /*! As data are read on demand, \a input_hdf5_sptr should not be used to read other data afterwards. */
   explicit ProjDataGEHDF5(shared_ptr<GEHDF5Wrapper> input_hdf5_sptr);
 
+  //! Set the maximum number of views kept in memory
+  /*! The default is to keep all views, such that each view is read only once. */
+  void set_max_num_cached_views(const int max_num);
+  //! Get the maximum number of views kept in memory
+  int get_max_num_cached_views() const;
+
 private:
   //! called to get data from m_input_hdf5_sptr
   void initialise_from_wrapper();
@@ -78,12 +91,22 @@ private:
 
   void initialise_ax_pos_offset();
 
+  //! set up the (empty) cache of views
   void initialise_viewgram_buffer();
+  //! get the data for a view, reading it from file if it is not in the cache
+  /*! \param view_index uses 0-based indexing of the views in the file */
+  shared_ptr<const Array<3, unsigned char>> get_tof_data_for_view(const int view_index) const;
+  //! remove the least recently used views from the cache until its size is acceptable
+  void trim_viewgram_buffer() const;
   //! Handler of the HDF5 input data and header
   shared_ptr<GEHDF5Wrapper> m_input_hdf5_sptr;
 
   std::vector<int> segment_sequence;
-  std::vector<Array<3, unsigned char>> tof_data;
+  //! cache of views, indexed with the 0-based view index in the file (null if not read)
+  mutable std::vector<shared_ptr<const Array<3, unsigned char>>> tof_data;
+  //! indices of the views in the cache, the most recently used first
+  mutable std::list<int> cached_view_indices;
+  int max_num_cached_views;
 };
 
 } // namespace RDF_HDF5
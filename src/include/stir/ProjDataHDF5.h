@@ -0,0 +1,94 @@
+/*!
+
+  \file
+  \ingroup projdata
+  \brief Declaration of class stir::ProjDataHDF5
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+#ifndef __stir_ProjDataHDF5_H__
+#define __stir_ProjDataHDF5_H__
+
+#include "stir/ProjData.h"
+#include "H5Cpp.h"
+#include <string>
+
+START_NAMESPACE_STIR
+
+/*!
+  \ingroup projdata
+  \brief A class which reads/writes projection data from/to a (compressed) HDF5 file
+
+  The file contains the Interfile header for the projection data (see stir/IO/HDF5_utilities.h)
+  and one dataset per segment and TOF bin, with the data stored as \c float (in the same order as
+  in SegmentByView). Datasets are chunked per viewgram, such that get_viewgram() and set_viewgram()
+  only need to (de)compress a single chunk. Data are compressed with the shuffle and deflate filters,
+  which typically reduce the size of projection data considerably (e.g. randoms, scatter and
+  normalisation factors, or TOF data with many zeroes).
+
+  Reading or writing a sinogram needs to access all chunks of a segment and is therefore much
+  slower than reading or writing a viewgram. get_segment_by_view() and get_segment_by_sinogram()
+  read a whole dataset at once.
+
+  Calls to the HDF5 library are serialised, as it is not thread-safe in general (see stir/IO/HDF5_utilities.h).
+*/
+class ProjDataHDF5 : public ProjData
+{
+public:
+  //! the compression level used by default (fast compression)
+  static const int default_compression_level = 1;
+
+  //! Open an existing file
+  /*! \a open_mode should be either \c std::ios::in or <code>std::ios::in | std::ios::out</code>. */
+  explicit ProjDataHDF5(const std::string& filename, const std::ios::openmode open_mode = std::ios::in);
+
+  //! Create a new file, with all data set to 0
+  /*!
+    \param compression_level deflate level between 0 (no compression) and 9 (slowest)
+
+    \warning Any existing file with the same name will be overwritten without warning.
+  */
+  ProjDataHDF5(shared_ptr<const ExamInfo> const& exam_info_sptr,
+               shared_ptr<const ProjDataInfo> const& proj_data_info_sptr,
+               const std::string& filename,
+               const int compression_level = default_compression_level);
+
+  ~ProjDataHDF5() override;
+
+  Viewgram<float> get_viewgram(const int view_num,
+                               const int segment_num,
+                               const bool make_num_tangential_poss_odd = false,
+                               const int timing_pos = 0) const override;
+  Succeeded set_viewgram(const Viewgram<float>& v) override;
+  Sinogram<float> get_sinogram(const int ax_pos_num,
+                               const int segment_num,
+                               const bool make_num_tangential_poss_odd = false,
+                               const int timing_pos = 0) const override;
+  Succeeded set_sinogram(const Sinogram<float>& s) override;
+
+  SegmentBySinogram<float> get_segment_by_sinogram(const int segment_num, const int timing_pos = 0) const override;
+  SegmentByView<float> get_segment_by_view(const int segment_num, const int timing_pos = 0) const override;
+
+private:
+  H5::H5File file;
+
+  static std::string get_dataset_name(const int segment_num, const int timing_pos);
+  //! create all datasets (filled with zeroes)
+  void create_datasets(const int compression_level);
+  //! read/write a hyperslab of the dataset for a segment and TOF bin
+  /*! \a offset and \a count use 0-based indices for [view][axial_pos][tangential_pos] */
+  void
+  read_hyperslab(float* data, const int segment_num, const int timing_pos, const hsize_t* offset, const hsize_t* count) const;
+  Succeeded
+  write_hyperslab(const float* data, const int segment_num, const int timing_pos, const hsize_t* offset, const hsize_t* count);
+};
+
+END_NAMESPACE_STIR
+
+#endif
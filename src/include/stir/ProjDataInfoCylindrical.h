@@ -307,6 +307,15 @@ private:
   //! This member stores a table converting segment/axial_pos to ring1+ring2
   mutable VectorWithOffset<VectorWithOffset<int>> segment_axial_pos_to_ring1_plus_ring2;
 
+  struct SegmentAxialPos
+  {
+    int segment_num;
+    int axial_pos_num;
+  };
+  //! This member stores a table used by get_segment_axial_pos_num_for_ring_pair()
+  /*! Indexed as ring1*num_rings + ring2. Invalid ring pairs have a segment_num larger than get_max_segment_num(). */
+  mutable std::vector<SegmentAxialPos> ring_pair_to_segment_axial_pos;
+
   //! This function sets all of the above
   void initialise_ring_diff_arrays() const;
 
@@ -245,12 +245,17 @@ ProjDataInfoCylindrical::get_segment_axial_pos_num_for_ring_pair(int& segment_nu
   assert(0 <= ring2);
   assert(ring2 < get_scanner_ptr()->get_num_rings());
 
-  // KT 01/08/2002 swapped rings
-  if (get_segment_num_for_ring_difference(segment_num, ring2 - ring1) == Succeeded::no)
+  if (!sampling_corresponds_to_physical_rings)
     return Succeeded::no;
 
+  this->initialise_ring_diff_arrays_if_not_done_yet();
+
   // see initialise_ring_diff_arrays() for some info
-  ax_pos_num = (ring1 + ring2 - ax_pos_num_offset[segment_num]) * get_num_axial_poss_per_ring_inc(segment_num) / 2;
+  const SegmentAxialPos& entry = ring_pair_to_segment_axial_pos[ring1 * get_scanner_ptr()->get_num_rings() + ring2];
+  if (entry.segment_num > get_max_segment_num())
+    return Succeeded::no;
+  segment_num = entry.segment_num;
+  ax_pos_num = entry.axial_pos_num;
   return Succeeded::yes;
 }
 
@@ -26,6 +26,7 @@
 #include "stir/ProjDataInfoCylindrical.h"
 #include "stir/DetectionPositionPair.h"
 #include "stir/VectorWithOffset.h"
+#include "stir/DetectorPairLookupTables.h"
 #include "stir/CartesianCoordinate3D.h"
 
 START_NAMESPACE_STIR
@@ -131,6 +132,14 @@ public:
 
   std::string parameter_info() const override;
 
+  //! \name Functions that modify the tangential range of the projection data
+  /*! These call the base class version, and check if the detector-pair look-up tables cover the new range. */
+  //@{
+  void set_num_tangential_poss(const int num_tang_poss) override;
+  void set_min_tangential_pos_num(const int min_tang_poss) override;
+  void set_max_tangential_pos_num(const int max_tang_poss) override;
+  //@}
+
   //! \name Functions that convert between bins and detection positions
   //@{
   //! This gets view_num and tang_pos_num for a particular detector pair
@@ -170,7 +179,9 @@ public:
 
       \see get_view_tangential_pos_num_for_det_num_pair() for info and
       restrictions.
-      \warning Will call error() if certain conditions are not met.
+      \warning Will call error() if certain conditions are not met, e.g. when the
+      tangential range of this object is larger than supported. \a tang_pos_num itself
+      is only checked with assert() against the range of the tables.
    */
   inline void
   get_det_num_pair_for_view_tangential_pos_num(int& det1_num, int& det2_num, const int view_num, const int tang_pos_num) const;
@@ -288,34 +299,15 @@ private:
   //! get offset in psi for first detector (i.e. angle along the scanner ring)
   float get_psi_offset() const;
 
-  // used in get_view_tangential_pos_num_for_det_num_pair()
-  struct Det1Det2
-  {
-    int det1_num;
-    int det2_num;
-  };
-  mutable VectorWithOffset<VectorWithOffset<Det1Det2>> uncompressed_view_tangpos_to_det1det2;
-  mutable bool uncompressed_view_tangpos_to_det1det2_initialised;
-  //! build look-up table for get_view_tangential_pos_num_for_det_num_pair()
-  void initialise_uncompressed_view_tangpos_to_det1det2() const;
-
-  // used in get_view_tangential_pos_num_for_det_num_pair()
-  // we prestore a lookup-table in terms for unmashed view/tangpos
-  struct ViewTangPosSwap
-  {
-    int view_num;
-    int tang_pos_num;
-    bool swap_detectors;
-  };
-  mutable VectorWithOffset<VectorWithOffset<ViewTangPosSwap>> det1det2_to_uncompressed_view_tangpos;
-  mutable bool det1det2_to_uncompressed_view_tangpos_initialised;
-  //! build look-up table for get_view_tangential_pos_num_for_det_num_pair()
-  void initialise_det1det2_to_uncompressed_view_tangpos() const;
-
-  //! build look-up table unless already done before
-  inline void initialise_uncompressed_view_tangpos_to_det1det2_if_not_done_yet() const;
-  //! build look-up table unless already done before
-  inline void initialise_det1det2_to_uncompressed_view_tangpos_if_not_done_yet() const;
+  //! look-up tables used by get_view_tangential_pos_num_for_det_num_pair() etc, shared with all other objects
+  shared_ptr<const DetectorPairLookupTables> det_pair_tables_sptr;
+  //! \c true if det_pair_tables_sptr is set and covers the tangential range
+  /*! Kept up-to-date by check_det_pair_tables_range(), such that look-ups do not need a range check. */
+  bool det_pair_tables_cover_tangential_range = false;
+  //! set det_pair_tables_cover_tangential_range
+  void check_det_pair_tables_range();
+  //! call error() explaining why get_det_num_pair_for_view_tangential_pos_num() cannot be used
+  void error_det_pair_tables_do_not_cover_tangential_range() const;
 
   bool blindly_equals(const root_type* const) const override;
 };
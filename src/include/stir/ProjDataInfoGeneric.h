@@ -21,6 +21,7 @@
 #define __stir_ProjDataInfoGeneric_H__
 
 #include "stir/ProjDataInfoCylindrical.h"
+#include <vector>
 
 START_NAMESPACE_STIR
 
@@ -113,7 +114,72 @@ public:
 
   std::string parameter_info() const override;
 
+  //! \name Functions that modify the sizes of the projection data
+  /*! These call the base class version, and discard the LOR geometry cache (if any). */
+  //@{
+  void set_num_tangential_poss(const int num_tang_poss) override;
+  void set_num_axial_poss_per_segment(const VectorWithOffset<int>& num_axial_poss_per_segment) override;
+  void set_min_axial_pos_num(const int min_ax_pos_num, const int segment_num) override;
+  void set_max_axial_pos_num(const int max_ax_pos_num, const int segment_num) override;
+  void set_min_tangential_pos_num(const int min_tang_poss) override;
+  void set_max_tangential_pos_num(const int max_tang_poss) override;
+  void reduce_segment_range(const int min_segment_num, const int max_segment_num) override;
+  //@}
+
+  //! \name Precomputed LOR geometry
+  /*! By default, get_LOR(), get_phi(), get_m() etc compute the LOR from the coordinates
+    of the detectors every time they are called. Calling set_up_LOR_geometry_cache() computes
+    these for all bins (in parallel if OpenMP is enabled) and stores them in a look-up table,
+    such that these functions become a few array look-ups. Bins outside the range of the projection
+    data are still computed from the detector coordinates.
+
+    The table is stored in "structure-of-arrays" layout and uses 5 floats and 1 byte per bin. It is
+    shared between clones of this object. It is discarded when the number of
+    segments, axial or tangential positions are modified.
+
+    set_up_LOR_geometry_cache() is a \c const function, as the table does not change the
+    geometry, only how fast it is computed. It is for instance called by ProjMatrixByBin::set_up()
+    when its <tt>precompute LOR geometry</tt> keyword is set. It does nothing if the table exists already.
+
+    \warning The table is not updated by set_min_ring_difference() and set_max_ring_difference(),
+    as these are not virtual. Call clear_LOR_geometry_cache() and set_up_LOR_geometry_cache() again if you use them.
+    \warning When the scanner's detector map randomises detector positions, no table is
+    computed (as the LOR would be different for every call).
+    \warning set_up_LOR_geometry_cache() is not thread-safe with respect to other member functions.
+    It should be called during set-up, not while other threads are using the object.
+  */
+  //@{
+  void set_up_LOR_geometry_cache() const;
+  void clear_LOR_geometry_cache();
+  inline bool has_LOR_geometry_cache() const;
+  //@}
+
 private:
+  //! LOR geometry for all bins in structure-of-arrays layout
+  /*! For every bin, the index into the arrays is
+    \code
+    segment_offset[seg] + ((ax - min_ax(seg)) * num_views + (view - min_view)) * num_tang_poss + tang - min_tang
+    \endcode
+  */
+  struct LORGeometryCache
+  {
+    VectorWithOffset<std::size_t> segment_offset;
+    std::vector<float> z1;
+    std::vector<float> z2;
+    std::vector<float> phi;
+    std::vector<float> beta;
+    std::vector<float> radius;
+    std::vector<unsigned char> swapped;
+  };
+  mutable shared_ptr<const LORGeometryCache> LOR_geometry_cache_sptr;
+
+  //! find index in LOR_geometry_cache_sptr
+  /*! Returns \c false if there is no cache, or if the bin is outside the range of the projection data.
+      Callers then need to compute the LOR without the cache. */
+  inline bool get_LOR_geometry_cache_index(std::size_t& index, const Bin&) const;
+  //! compute LOR directly from the detection positions
+  void compute_LOR(LORInAxialAndNoArcCorrSinogramCoordinates<float>& lor, const Bin& bin) const;
+
   //! to be used in get LOR
   virtual void find_cartesian_coordinates_of_detection(CartesianCoordinate3D<float>& coord_1,
                                                        CartesianCoordinate3D<float>& coord_2,
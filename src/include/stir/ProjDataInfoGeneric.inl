@@ -41,10 +41,40 @@
 
 START_NAMESPACE_STIR
 
+//! find the index of a bin in the arrays of the LOR geometry cache
+bool
+ProjDataInfoGeneric::get_LOR_geometry_cache_index(std::size_t& index, const Bin& bin) const
+{
+  if (!LOR_geometry_cache_sptr)
+    return false;
+  if (bin.segment_num() < get_min_segment_num() || bin.segment_num() > get_max_segment_num()
+      || bin.axial_pos_num() < get_min_axial_pos_num(bin.segment_num())
+      || bin.axial_pos_num() > get_max_axial_pos_num(bin.segment_num()) || bin.view_num() < get_min_view_num()
+      || bin.view_num() > get_max_view_num() || bin.tangential_pos_num() < get_min_tangential_pos_num()
+      || bin.tangential_pos_num() > get_max_tangential_pos_num())
+    return false;
+  index = LOR_geometry_cache_sptr->segment_offset[bin.segment_num()]
+          + (static_cast<std::size_t>(bin.axial_pos_num() - get_min_axial_pos_num(bin.segment_num())) * get_num_views()
+             + (bin.view_num() - get_min_view_num()))
+                * get_num_tangential_poss()
+          + (bin.tangential_pos_num() - get_min_tangential_pos_num());
+  return true;
+}
+
+bool
+ProjDataInfoGeneric::has_LOR_geometry_cache() const
+{
+  return !is_null_ptr(LOR_geometry_cache_sptr);
+}
+
 //! find phi from correspoding lor
 float
 ProjDataInfoGeneric::get_phi(const Bin& bin) const
 {
+  std::size_t idx;
+  if (get_LOR_geometry_cache_index(idx, bin))
+    return LOR_geometry_cache_sptr->phi[idx];
+
   LORInAxialAndNoArcCorrSinogramCoordinates<float> lor;
   get_LOR(lor, bin);
   return lor.phi();
@@ -56,6 +86,10 @@ ProjDataInfoGeneric::get_phi(const Bin& bin) const
 float
 ProjDataInfoGeneric::get_m(const Bin& bin) const
 {
+  std::size_t idx;
+  if (get_LOR_geometry_cache_index(idx, bin))
+    return (LOR_geometry_cache_sptr->z1[idx] + LOR_geometry_cache_sptr->z2[idx]) / 2.F;
+
   LORInAxialAndNoArcCorrSinogramCoordinates<float> lor;
   get_LOR(lor, bin);
   return (static_cast<float>(lor.z1() + lor.z2())) / 2.F;
@@ -78,6 +112,10 @@ ProjDataInfoGeneric::get_t(const Bin& bin) const
 float
 ProjDataInfoGeneric::get_tantheta(const Bin& bin) const
 {
+  std::size_t idx;
+  if (get_LOR_geometry_cache_index(idx, bin))
+    return (LOR_geometry_cache_sptr->z2[idx] - LOR_geometry_cache_sptr->z1[idx]) / (2 * LOR_geometry_cache_sptr->radius[idx]);
+
   LORInAxialAndNoArcCorrSinogramCoordinates<float> lor;
   get_LOR(lor, bin);
 
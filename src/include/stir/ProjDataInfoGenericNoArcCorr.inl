@@ -26,57 +26,11 @@
 #include "stir/Succeeded.h"
 #include "stir/LORCoordinates.h"
 #include "stir/error.h"
+#include "stir/is_null_ptr.h"
 #include <math.h>
 
 START_NAMESPACE_STIR
 
-void
-ProjDataInfoGenericNoArcCorr::initialise_uncompressed_view_tangpos_to_det1det2_if_not_done_yet() const
-{
-  // for efficiency reasons, use "Double-Checked-Locking(DCL) pattern" with OpenMP atomic operation
-  // OpenMP v3.1 or later required
-  // thanks to yohjp:
-  // http://stackoverflow.com/questions/27975737/how-to-handle-cached-data-structures-with-multi-threading-e-g-openmp
-#if defined(STIR_OPENMP) && _OPENMP >= 201012
-  bool initialised;
-#  pragma omp atomic read
-  initialised = uncompressed_view_tangpos_to_det1det2_initialised;
-
-  if (!initialised)
-#endif
-    {
-#if defined(STIR_OPENMP)
-#  pragma omp critical(PROJDATAINFOCYLINDRICALNOARCCORR_VIEWTANGPOS_TO_DETS)
-#endif
-      {
-        if (!uncompressed_view_tangpos_to_det1det2_initialised)
-          initialise_uncompressed_view_tangpos_to_det1det2();
-      }
-    }
-}
-
-void
-ProjDataInfoGenericNoArcCorr::initialise_det1det2_to_uncompressed_view_tangpos_if_not_done_yet() const
-{
-  // as above
-#if defined(STIR_OPENMP) && _OPENMP >= 201012
-  bool initialised;
-#  pragma omp atomic read
-  initialised = det1det2_to_uncompressed_view_tangpos_initialised;
-
-  if (!initialised)
-#endif
-    {
-#if defined(STIR_OPENMP)
-#  pragma omp critical(PROJDATAINFOCYLINDRICALNOARCCORR_DETS_TO_VIEWTANGPOS)
-#endif
-      {
-        if (!det1det2_to_uncompressed_view_tangpos_initialised)
-          initialise_det1det2_to_uncompressed_view_tangpos();
-      }
-    }
-}
-
 /*! warning In cylindrical s is found from bin: sin(beta) = sin(tang_pos*angular_increment)
         In block it is calculated directly from corresponding lor
 */
@@ -95,10 +49,11 @@ ProjDataInfoGenericNoArcCorr::get_det_num_pair_for_view_tangential_pos_num(int&
                                                                            const int tang_pos_num) const
 {
   assert(get_view_mashing_factor() == 1);
-  this->initialise_uncompressed_view_tangpos_to_det1det2_if_not_done_yet();
+  // range of the tables was checked when the tangential range was set
+  if (!det_pair_tables_cover_tangential_range)
+    error_det_pair_tables_do_not_cover_tangential_range();
 
-  det1_num = uncompressed_view_tangpos_to_det1det2[view_num][tang_pos_num].det1_num;
-  det2_num = uncompressed_view_tangpos_to_det1det2[view_num][tang_pos_num].det2_num;
+  det_pair_tables_sptr->get_det_num_pair_for_view_tangential_pos_num(det1_num, det2_num, view_num, tang_pos_num);
 }
 
 bool
@@ -107,12 +62,12 @@ ProjDataInfoGenericNoArcCorr::get_view_tangential_pos_num_for_det_num_pair(int&
                                                                            const int det1_num,
                                                                            const int det2_num) const
 {
-  assert(det1_num != det2_num);
-  this->initialise_det1det2_to_uncompressed_view_tangpos_if_not_done_yet();
-
-  view_num = det1det2_to_uncompressed_view_tangpos[det1_num][det2_num].view_num / get_view_mashing_factor();
-  tang_pos_num = det1det2_to_uncompressed_view_tangpos[det1_num][det2_num].tang_pos_num;
-  return det1det2_to_uncompressed_view_tangpos[det1_num][det2_num].swap_detectors;
+  if (is_null_ptr(det_pair_tables_sptr))
+    error("Number of detectors per ring should be even but is %d", get_scanner_ptr()->get_num_detectors_per_ring());
+  const bool swap_detectors
+      = det_pair_tables_sptr->get_view_tangential_pos_num_for_det_num_pair(view_num, tang_pos_num, det1_num, det2_num);
+  view_num /= get_view_mashing_factor();
+  return swap_detectors;
 }
 
 Succeeded
@@ -121,6 +121,9 @@ void SSRB(const std::string& output_filename,
   direction, projectors are outputting "normalised" data, i.e. corresponding to the
   line integral).
 
+  Output sinograms are computed in parallel (if OpenMP is enabled), one output axial position
+  at a time (for all TOF bins). Every input sinogram is read only once, and whole input segments are
+  never held in memory. View mashing, tangential trimming and TOF mashing are all done in the same pass.
 
   \warning \a in_projdata has to be (at least) of type ProjDataInfoCylindrical
 
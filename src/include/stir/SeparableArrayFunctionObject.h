@@ -36,6 +36,12 @@ START_NAMESPACE_STIR
   index of the \c n -dimensional array.
   \see in_place_apply_array_functions_on_each_index()
 
+  For regular 3D arrays, the 1D operations are applied on blocks of lines at once (all lines along
+  z for a given y, and all lines in a plane for y and x), using per-thread scratch buffers.
+  Convolutions (ArrayFilter1DUsingConvolution and ArrayFilter1DUsingConvolutionSymmetricKernel)
+  are then computed for all lines in a block together, which allows vectorisation, and are
+  parallelised with OpenMP. Long kernels use a DFT when this is expected to be faster.
+  Other 1D function objects are applied line by line, without parallelisation.
  */
 template <int num_dimensions, typename elemT>
 class SeparableArrayFunctionObject : public ArrayFunctionObject_1ArgumentImplementation<num_dimensions, elemT>
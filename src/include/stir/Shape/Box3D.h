@@ -74,6 +74,8 @@ public:
 
   bool is_inside_shape(const CartesianCoordinate3D<float>& coord) const override;
 
+  Succeeded get_bounding_box(CartesianCoordinate3D<float>& min_coord, CartesianCoordinate3D<float>& max_coord) const override;
+
   Shape3D* clone() const override;
 
   //! Compare boxes
@@ -83,6 +85,8 @@ public:
   bool operator==(const Shape3D& shape) const override;
 
 protected:
+  bool is_inside_shape_in_shape_coords(const CartesianCoordinate3D<float>& r) const override;
+
   //! Length in x-direction if the shape is not rotated
   float length_x;
   //! Length in y-direction if the shape is not rotated
@@ -67,6 +67,8 @@ public:
 
   bool is_inside_shape(const CartesianCoordinate3D<float>& coord) const override;
 
+  Succeeded get_bounding_box(CartesianCoordinate3D<float>& min_coord, CartesianCoordinate3D<float>& max_coord) const override;
+
   Shape3D* clone() const override;
 
   //! Compare cylinders
@@ -94,6 +96,8 @@ public:
   void set_radii(const CartesianCoordinate3D<float>& new_radii);
 
 protected:
+  bool is_inside_shape_in_shape_coords(const CartesianCoordinate3D<float>& r) const override;
+
   //! Radii in 3 directions (before using the direction vectors)
   CartesianCoordinate3D<float> radii;
 
@@ -111,6 +111,8 @@ public:
 
   bool is_inside_shape(const CartesianCoordinate3D<float>& coord) const override;
 
+  Succeeded get_bounding_box(CartesianCoordinate3D<float>& min_coord, CartesianCoordinate3D<float>& max_coord) const override;
+
   inline float get_length() const
   {
     return length;
@@ -129,6 +131,8 @@ public:
   void set_radius_y(const float);
 
 protected:
+  bool is_inside_shape_in_shape_coords(const CartesianCoordinate3D<float>& r) const override;
+
   //! Length of the cylinder
   float length;
   //! Radius in x-direction if the shape is not rotated
@@ -29,6 +29,7 @@ START_NAMESPACE_STIR
 
 template <typename elemT>
 class VoxelsOnCartesianGrid;
+class Succeeded;
 
 /*!
   \ingroup Shape
@@ -144,9 +145,16 @@ public:
     \warning Shapes have to be larger than the voxel size for sensible results.
     For efficiency reasons, the current implementation of this function
     does a first pass through the image where is_inside_shape() is called
-    only for the centre of the voxels. After this, only edge voxels are
-    resampled. So, if a shape lies between the centre of all voxels,
+    only for the centre of the voxels. After this, only edge voxels (i.e. voxels
+    which have a neighbour with a different value in the first pass) are
+    resampled using get_voxel_weight(). So, if a shape lies between the centre of all voxels,
     it will not be sampled at all.
+
+    If get_bounding_box() succeeds, only voxels in the bounding box are considered (all others
+    are set to 0). In addition, the second pass only considers voxels near the range of
+    voxels that were found inside the shape in the first pass (per slice).
+    Both passes are parallelised over slices when OpenMP is enabled, so is_inside_shape()
+    and get_voxel_weight() need to be safe to call from multiple threads.
   \todo Get rid of restriction to allow only VoxelsOnCartesianGrid<float>
   (but that's rather hard)
   \todo Potentially this should fill a DiscretisedShape3D.
@@ -169,7 +177,14 @@ public:
   virtual float get_geometric_area() const;
 #endif
 
-  // TODO get_bounding_box() const;
+  //! Get a box (in absolute coordinates, in mm) that contains the whole shape
+  /*!
+    The box does not need to be tight, but no point outside the box can be inside the shape.
+    This is used by construct_volume() to restrict the voxels that are considered.
+
+    The default implementation returns Succeeded::no, meaning that the bounding box is unknown.
+  */
+  virtual Succeeded get_bounding_box(CartesianCoordinate3D<float>& min_coord, CartesianCoordinate3D<float>& max_coord) const;
 
   //! get the origin of the shape-coordinate system
   inline CartesianCoordinate3D<float> get_origin() const;
@@ -38,6 +38,9 @@ class Succeeded;
   Functions like \c is_inside_shape(coord) should compute the coordinate to be used
   in the calculation as <code>matrix_multiply(direction_vectors, coord-origin)</code>,
   or best practice is to call <code>transform_to_shape_coords(coords)</code>.
+  Derived classes should implement is_inside_shape_in_shape_coords(), which is used by
+  get_voxel_weight(). Its default implementation transforms the point back to
+  'real-world' coordinates and calls is_inside_shape(), which is slow.
 
   \todo A previous release had Euler angle code. However, it is currently disabled as
   there were bugs in it.
@@ -63,6 +66,15 @@ public:
   bool operator==(const Shape3D& s) const override;
   void scale(const CartesianCoordinate3D<float>& scale3D) override;
 
+  //! Determine (approximately) the intersection volume of a voxel with the shape.
+  /*! Gives the same result as Shape3D::get_voxel_weight() (up to rounding errors), but
+    computes the shape coordinates of the samples incrementally, avoiding a matrix multiplication
+    per sample.
+  */
+  float get_voxel_weight(const CartesianCoordinate3D<float>& voxel_centre,
+                         const CartesianCoordinate3D<float>& voxel_size,
+                         const CartesianCoordinate3D<int>& num_samples) const override;
+
   //! get direction vectors currently in use
   /*! Index offsets will always be 1 */
   const Array<2, float>& get_direction_vectors() const { return _directions; }
@@ -110,6 +122,21 @@ protected:
   //! Transform a 'real-world' coordinate to the coordinate system used by the shape
   CartesianCoordinate3D<float> transform_to_shape_coords(const CartesianCoordinate3D<float>&) const;
 
+  //! Transform a coordinate in the coordinate system used by the shape to a 'real-world' coordinate
+  CartesianCoordinate3D<float> transform_from_shape_coords(const CartesianCoordinate3D<float>&) const;
+
+  //! determine if a point (in the coordinate system used by the shape) is inside the shape or not
+  /*! The default implementation calls is_inside_shape() after transform_from_shape_coords(). */
+  virtual bool is_inside_shape_in_shape_coords(const CartesianCoordinate3D<float>& r) const;
+
+  //! Find the bounding box (in 'real-world' coordinates) of a shape that is inside a box in shape coordinates
+  /*! The box in shape coordinates is given by <code>|r[d]| <= half_lengths[d]</code>.
+    This is a convenience function for implementing get_bounding_box() in derived classes.
+  */
+  Succeeded get_bounding_box_of_shape_coords_box(CartesianCoordinate3D<float>& min_coord,
+                                                 CartesianCoordinate3D<float>& max_coord,
+                                                 const CartesianCoordinate3D<float>& half_lengths) const;
+
   //! sets defaults for parsing
   /*! sets direction vectors to the normal unit vectors. */
   void set_defaults() override;
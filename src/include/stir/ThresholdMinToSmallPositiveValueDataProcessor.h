@@ -2,6 +2,7 @@
 //
 /*
     Copyright (C) 2000- 2007, Hammersmith Imanet Ltd
+    Copyright (C) 2026, University College London
     This file is part of STIR.
 
     SPDX-License-Identifier: Apache-2.0
@@ -32,6 +33,9 @@ START_NAMESPACE_STIR
 
   Works by calling threshold_min_to_small_positive_value().
 
+  This is a point-wise data processor (see DataProcessor::is_pointwise()), but the threshold
+  is computed from the whole input data.
+
   As it is derived from RegisteredParsingObject, it implements all the
   necessary things to parse parameter files etc.
 
@@ -66,8 +70,15 @@ public:
   //! Construct by calling set_defaults()
   ThresholdMinToSmallPositiveValueDataProcessor();
 
+  //! Returns \c true
+  bool is_pointwise() const override;
+  //! Returns \c true, as the threshold depends on the minimum positive value in the data
+  bool pointwise_depends_on_whole_input() const override;
+
 private:
   int rim_truncation_image;
+  //! lower threshold, computed by virtual_prepare_pointwise()
+  float threshold;
 
   void set_defaults() override;
   void initialise_keymap() override;
@@ -76,6 +87,8 @@ private:
 
   void virtual_apply(DataT& out_data, const DataT& in_data) const override;
   void virtual_apply(DataT& data) const override;
+  void virtual_prepare_pointwise(const DataT& data) override;
+  void virtual_apply_pointwise(DataT& data, const int outer_index) const override;
 };
 
 END_NAMESPACE_STIR
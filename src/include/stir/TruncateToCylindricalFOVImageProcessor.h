@@ -2,6 +2,7 @@
 //
 /*
     Copyright (C) 2005- 2007, Hammersmith Imanet Ltd
+    Copyright (C) 2026, University College London
     This file is part of STIR.
 
     SPDX-License-Identifier: Apache-2.0
@@ -37,6 +38,8 @@ START_NAMESPACE_STIR
 
   The discretised densities that will be filtered are supposed to be on a
   Cartesian grid.
+
+  This is a point-wise data processor (see DataProcessor::is_pointwise()).
  */
 
 template <typename elemT>
@@ -63,6 +66,9 @@ public:
   void set_strictly_less_than_radius(const bool arg) { this->_strictly_less_than_radius = arg; }
   bool get_strictly_less_than_radius() const { return this->_strictly_less_than_radius; }
 
+  //! Returns \c true
+  bool is_pointwise() const override;
+
 private:
   bool _strictly_less_than_radius;
   int _truncate_rim;
@@ -74,6 +80,8 @@ private:
   // new
   void virtual_apply(DiscretisedDensity<3, elemT>& out_density, const DiscretisedDensity<3, elemT>& in_density) const override;
   void virtual_apply(DiscretisedDensity<3, elemT>& density) const override;
+  void virtual_prepare_pointwise(const DiscretisedDensity<3, elemT>& density) override;
+  void virtual_apply_pointwise(DiscretisedDensity<3, elemT>& density, const int z) const override;
 };
 
 END_NAMESPACE_STIR
@@ -17,7 +17,8 @@
   See STIR/LICENSE.txt for details
 */
 
-#include "stir/common.h"
+#include "stir/shared_ptr.h"
+#include <vector>
 
 START_NAMESPACE_STIR
 
@@ -72,4 +73,26 @@ void randoms_from_singles(ProjData& proj_data,
                           float coincidence_time_window = -1.F,
                           float radionuclide_halflife = -1.F);
 
+/*!
+  \ingroup singles_buildblock
+  \brief Estimate randoms from singles (RFS) for several time frames
+
+  \param[in,out] proj_datas
+     Projection data to store output, one for every time frame. The time frame is taken from the
+     (first) time frame in the ExamInfo of each element. All elements need to have the same ProjDataInfo.
+  \param[in] singles
+     Input value for RFS
+  \param[in] coincidence_time_window Scanner coincidence window (in secs). Deprecated.
+  \param[in] radionuclide_halflife half-life. Deprecated.
+
+  Computes the same as calling randoms_from_singles(ProjData&, const SinglesRates&, float, float) for every frame,
+  but the detector pairs contributing to every bin are only determined once for all frames
+  (see multiply_crystal_factors(const std::vector<shared_ptr<ProjData>>&, const std::vector<Array<2, float>>&, const std::vector<float>&)).
+  This is useful for dynamic acquisitions.
+*/
+void randoms_from_singles(const std::vector<shared_ptr<ProjData>>& proj_datas,
+                          const SinglesRates& singles,
+                          float coincidence_time_window = -1.F,
+                          float radionuclide_halflife = -1.F);
+
 END_NAMESPACE_STIR
@@ -0,0 +1,95 @@
+/*!
+  \file
+  \ingroup buildblock_detail
+  \brief Implementation of a convolution of many 1D lines at once, used by stir::SeparableArrayFunctionObject.
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+
+#ifndef __stir_detail_convolve_lines_H__
+#define __stir_detail_convolve_lines_H__
+
+#include "stir/BoundaryConditions.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace stir
+{
+namespace detail
+{
+
+/*! \ingroup buildblock_detail
+  \brief Convolution of \c n "lines" of length \c L with the same kernel
+
+  Computes
+  \code
+  out[i*L+l] = sum_j kernel[j] in[(i-j)*L+l]
+  \endcode
+  for \c i in \c [0,n), i.e. with the conventions of ArrayFilter1DUsingConvolution. \a kernel points
+  to the first element of the kernel, i.e. the one with index \c j_min (the kernel is defined
+  for \c j in \c [j_min,j_max]).
+  For \c L>1, this processes \c L independent lines at once. Elements of \a in outside the
+  range are taken to be 0 (for BoundaryConditions::zero) or equal to the nearest element
+  (for BoundaryConditions::constant).
+
+  The loop is organised per kernel element, such that for every \c j the inner loop
+  runs over contiguous elements of \a in and \a out, which allows the compiler to vectorise it.
+  \a out and \a in cannot overlap.
+*/
+template <class elemT>
+void
+convolve_lines(elemT* out,
+               const elemT* in,
+               const int n,
+               const int L,
+               const elemT* kernel,
+               const int j_min,
+               const int j_max,
+               const BoundaryConditions::BC bc)
+{
+  std::fill(out, out + static_cast<std::size_t>(n) * L, elemT(0));
+  for (int j = j_min; j <= j_max; ++j)
+    {
+      const elemT k = kernel[j - j_min];
+      // range of i where i-j is in [0,n)
+      const int i_start = std::max(0, j);
+      const int i_end = std::min(n, n + j);
+      if (i_start < i_end)
+        {
+          elemT* out_ptr = out + static_cast<std::size_t>(i_start) * L;
+          const elemT* in_ptr = in + static_cast<std::ptrdiff_t>(i_start - j) * L;
+          const std::size_t num_elems = static_cast<std::size_t>(i_end - i_start) * L;
+          for (std::size_t e = 0; e < num_elems; ++e)
+            out_ptr[e] += k * in_ptr[e];
+        }
+      if (bc == BoundaryConditions::constant)
+        {
+          // i-j<0: use the first line
+          for (int i = 0; i < std::min(n, j); ++i)
+            {
+              elemT* out_ptr = out + static_cast<std::size_t>(i) * L;
+              for (int l = 0; l < L; ++l)
+                out_ptr[l] += k * in[l];
+            }
+          // i-j>=n: use the last line
+          const elemT* last_line = in + static_cast<std::size_t>(n - 1) * L;
+          for (int i = std::max(0, n + j); i < n; ++i)
+            {
+              elemT* out_ptr = out + static_cast<std::size_t>(i) * L;
+              for (int l = 0; l < L; ++l)
+                out_ptr[l] += k * last_line[l];
+            }
+        }
+    }
+}
+
+} // namespace detail
+} // namespace stir
+
+#endif
@@ -0,0 +1,189 @@
+/*!
+  \file
+  \ingroup buildblock_detail
+  \brief Implementation of a fast separable minimum/maximum filter, used by stir::MinimalArrayFilter3D
+  and stir::MaximalArrayFilter3D.
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+
+#ifndef __stir_detail_extremum_filter_3d_H__
+#define __stir_detail_extremum_filter_3d_H__
+
+#include "stir/Array.h"
+#include "stir/Coordinate3D.h"
+#include <vector>
+#include <algorithm>
+
+namespace stir
+{
+namespace detail
+{
+
+/*! \ingroup buildblock_detail
+  \brief Running extremum over a window of size 2r+1 of \c n "lines" of length \c L
+
+  Computes
+  \code
+  out[i*L+l] = extremum over j in [i-r,i+r] of in[j*L+l]
+  \endcode
+  where the window is clipped at the edges (i.e. only existing elements are used),
+  and the extremum is \c std::min(a,b,compare) (i.e. the minimum for \c std::less and
+  the maximum for \c std::greater). For \c L>1, this processes \c L independent lines at once,
+  such that the inner loop is over contiguous elements.
+
+  This uses the van Herk/Gil-Werman algorithm, which needs 3 comparisons per element,
+  independent of the window size. \a g and \a h are scratch buffers (resized when necessary).
+
+  Clipping the window is handled by repeating the edge elements, which does not change the result of the extremum.
+*/
+template <class elemT, class Compare>
+void
+running_extremum(
+    elemT* out, const elemT* in, const int n, const int L, const int r, std::vector<elemT>& g, std::vector<elemT>& h, Compare compare)
+{
+  const int w = 2 * r + 1;
+  const int m = n + 2 * r;
+  g.resize(static_cast<std::size_t>(m) * L);
+  h.resize(static_cast<std::size_t>(m) * L);
+  // padded input
+  auto p = [&](const int j) { return in + static_cast<std::size_t>(std::min(std::max(j - r, 0), n - 1)) * L; };
+
+  // extremum from the start of every block of size w
+  for (int j = 0; j < m; ++j)
+    {
+      const elemT* pj = p(j);
+      elemT* gj = &g[static_cast<std::size_t>(j) * L];
+      if (j % w == 0)
+        std::copy(pj, pj + L, gj);
+      else
+        {
+          const elemT* gprev = gj - L;
+          for (int l = 0; l < L; ++l)
+            gj[l] = std::min(gprev[l], pj[l], compare);
+        }
+    }
+  // extremum up to the end of every block of size w
+  for (int j = m - 1; j >= 0; --j)
+    {
+      const elemT* pj = p(j);
+      elemT* hj = &h[static_cast<std::size_t>(j) * L];
+      if (j % w == w - 1 || j == m - 1)
+        std::copy(pj, pj + L, hj);
+      else
+        {
+          const elemT* hnext = hj + L;
+          for (int l = 0; l < L; ++l)
+            hj[l] = std::min(hnext[l], pj[l], compare);
+        }
+    }
+  // window [i-r, i+r] corresponds to [i, i+w-1] in the padded array
+  for (int i = 0; i < n; ++i)
+    {
+      const elemT* hi = &h[static_cast<std::size_t>(i) * L];
+      const elemT* gi = &g[static_cast<std::size_t>(i + w - 1) * L];
+      elemT* outi = out + static_cast<std::size_t>(i) * L;
+      for (int l = 0; l < L; ++l)
+        outi[l] = std::min(hi[l], gi[l], compare);
+    }
+}
+
+/*! \ingroup buildblock_detail
+  \brief Separable minimum/maximum filter over a box of size (2*mask_radius+1) for regular 3D arrays
+
+  The extremum over a (clipped) box is computed as the extremum along x, followed by
+  y and z. The x- and y-passes are parallelised over planes, the z-pass over y.
+  \a out_array needs to have the same (regular) index range as \a in_array.
+*/
+template <class elemT, class Compare>
+void
+separable_extremum_filter_3d(Array<3, elemT>& out_array,
+                             const Array<3, elemT>& in_array,
+                             const Coordinate3D<int>& mask_radius,
+                             Compare compare)
+{
+  assert(in_array.is_regular());
+  assert(out_array.get_index_range() == in_array.get_index_range());
+  if (in_array.size_all() == 0)
+    return;
+
+  const int min_z = in_array.get_min_index();
+  const int max_z = in_array.get_max_index();
+  const int min_y = in_array[min_z].get_min_index();
+  const int max_y = in_array[min_z].get_max_index();
+  const int min_x = in_array[min_z][min_y].get_min_index();
+  const int max_x = in_array[min_z][min_y].get_max_index();
+  const int nz = max_z - min_z + 1;
+  const int ny = max_y - min_y + 1;
+  const int nx = max_x - min_x + 1;
+
+  // x- and y-passes, plane by plane
+#ifdef STIR_OPENMP
+#  pragma omp parallel
+#endif
+  {
+    std::vector<elemT> plane(static_cast<std::size_t>(ny) * nx);
+    std::vector<elemT> filtered_plane(static_cast<std::size_t>(ny) * nx);
+    std::vector<elemT> g, h;
+#ifdef STIR_OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+    for (int z = min_z; z <= max_z; ++z)
+      {
+        for (int y = min_y; y <= max_y; ++y)
+          {
+            std::copy(in_array[z][y].begin(), in_array[z][y].end(), plane.begin() + static_cast<std::size_t>(y - min_y) * nx);
+            running_extremum(&filtered_plane[static_cast<std::size_t>(y - min_y) * nx],
+                             &plane[static_cast<std::size_t>(y - min_y) * nx],
+                             nx,
+                             1,
+                             mask_radius[3],
+                             g,
+                             h,
+                             compare);
+          }
+        running_extremum(&plane[0], &filtered_plane[0], ny, nx, mask_radius[2], g, h, compare);
+        for (int y = min_y; y <= max_y; ++y)
+          std::copy(plane.begin() + static_cast<std::size_t>(y - min_y) * nx,
+                    plane.begin() + static_cast<std::size_t>(y - min_y + 1) * nx,
+                    out_array[z][y].begin());
+      }
+  }
+
+  if (mask_radius[1] == 0)
+    return;
+
+  // z-pass, for every y
+#ifdef STIR_OPENMP
+#  pragma omp parallel
+#endif
+  {
+    std::vector<elemT> lines(static_cast<std::size_t>(nz) * nx);
+    std::vector<elemT> filtered_lines(static_cast<std::size_t>(nz) * nx);
+    std::vector<elemT> g, h;
+#ifdef STIR_OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+    for (int y = min_y; y <= max_y; ++y)
+      {
+        for (int z = min_z; z <= max_z; ++z)
+          std::copy(out_array[z][y].begin(), out_array[z][y].end(), lines.begin() + static_cast<std::size_t>(z - min_z) * nx);
+        running_extremum(&filtered_lines[0], &lines[0], nz, nx, mask_radius[1], g, h, compare);
+        for (int z = min_z; z <= max_z; ++z)
+          std::copy(filtered_lines.begin() + static_cast<std::size_t>(z - min_z) * nx,
+                    filtered_lines.begin() + static_cast<std::size_t>(z - min_z + 1) * nx,
+                    out_array[z][y].begin());
+      }
+  }
+}
+
+} // namespace detail
+} // namespace stir
+
+#endif
@@ -0,0 +1,91 @@
+/*!
+  \file
+  \ingroup evaluation
+
+  \brief Declaration of class stir::DiscretisedROIs
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+#ifndef __stir_evaluation_DiscretisedROIs__H__
+#define __stir_evaluation_DiscretisedROIs__H__
+
+#include "stir/evaluation/ROIValues.h"
+#include "stir/VectorWithOffset.h"
+#include "stir/CartesianCoordinate3D.h"
+#include "stir/IndexRange.h"
+#include "stir/shared_ptr.h"
+#include <vector>
+
+START_NAMESPACE_STIR
+
+template <int num_dimensions, typename elemT>
+class DiscretisedDensity;
+class Shape3D;
+
+/*! \ingroup evaluation
+  \brief A set of ROIs, discretised once, for computing ROI values in many images
+
+  All shapes are discretised on the grid of a template image (using Shape3D::construct_volume),
+  after which only the voxels with non-zero weight are stored (per plane). ROI values for all ROIs
+  can then be computed with a single pass over an image (with the same characteristics as the
+  template), parallelised over planes with OpenMP. This is much faster than calling
+  compute_ROI_values_per_plane() for every ROI and every image (e.g. every time frame).
+
+  The results are the same as those of compute_ROI_values_per_plane() (up to rounding).
+*/
+class DiscretisedROIs
+{
+public:
+  //! Discretise the shapes on the grid of \a template_image
+  /*! \a template_image has to be a VoxelsOnCartesianGrid. Its values are not used. */
+  DiscretisedROIs(const std::vector<shared_ptr<Shape3D>>& shapes,
+                  const DiscretisedDensity<3, float>& template_image,
+                  const CartesianCoordinate3D<int>& num_samples);
+
+  //! Use discretised shapes (i.e. weight images)
+  /*! All images need to have the same characteristics. */
+  explicit DiscretisedROIs(const std::vector<shared_ptr<const DiscretisedDensity<3, float>>>& discretised_shapes);
+
+  //! get the number of ROIs
+  int get_num_ROIs() const;
+
+  //! Compute ROI values per plane for all ROIs
+  /*! On return, \c values[roi_num][z] contains the values for plane \c z of ROI \c roi_num. */
+  void compute_ROI_values_per_plane(std::vector<VectorWithOffset<ROIValues>>& values,
+                                    const DiscretisedDensity<3, float>& image) const;
+
+  //! Compute total ROI values for all ROIs
+  /*! On return, \c values[roi_num] contains the values for ROI \c roi_num. */
+  void compute_total_ROI_values(std::vector<ROIValues>& values, const DiscretisedDensity<3, float>& image) const;
+
+private:
+  //! a voxel in a plane with its weight
+  struct WeightedVoxel
+  {
+    int y;
+    int x;
+    float weight;
+  };
+
+  //! characteristics of the template image, used for checking
+  IndexRange<3> index_range;
+  CartesianCoordinate3D<float> origin;
+  CartesianCoordinate3D<float> voxel_size;
+
+  //! voxels in every ROI, indexed as <code>voxels[roi_num][z]</code>
+  std::vector<VectorWithOffset<std::vector<WeightedVoxel>>> voxels;
+
+  void set_template(const DiscretisedDensity<3, float>&);
+  void add_ROI(const DiscretisedDensity<3, float>& discretised_shape);
+  void check_image(const DiscretisedDensity<3, float>&) const;
+};
+
+END_NAMESPACE_STIR
+
+#endif
@@ -41,6 +41,8 @@ class Shape3D;
     This can make fuzzy boundaries (when the \a num_samples argument is not (1,1,1), or when DiscretisedShape3D
     needs zooming). Mean and stddev are computed using weighted versions, taking this smoothness
     into account, while ROI_min and max are ignore those weights.
+
+    When computing values for many ROIs and/or images, DiscretisedROIs will be much faster.
 */
 //@{
 
@@ -18,6 +18,7 @@
 */
 
 #include "stir/numerics/BSplines.h"
+#include "stir/shared_ptr.h"
 
 START_NAMESPACE_STIR
 
@@ -29,6 +30,27 @@ class Sinogram;
 template <class elemT>
 class SegmentBySinogram;
 
+namespace detail_interpolate_projdata
+{
+struct BlocksTransaxialWeights;
+}
+
+//! Interpolation weights that can be reused between calls to interpolate_projdata()
+/*!
+  \ingroup projdata
+  For BlocksOnCylindrical scanners, the transaxial interpolation weights only depend on the geometry.
+  If the caller passes the same object to every call (e.g. in every scatter iteration), they are only
+  computed once. They are recomputed if the projection data characteristics change.
+
+  \warning The same object cannot be used by multiple threads at the same time.
+*/
+class InterpolateProjDataCache
+{
+public:
+  //! (only used by interpolate_blocks_on_cylindrical_projdata())
+  shared_ptr<const detail_interpolate_projdata::BlocksTransaxialWeights> blocks_transaxial_weights_sptr;
+};
+
 //! \brief Perform B-Splines Interpolation
 /*!
   \ingroup projdata
@@ -38,6 +60,7 @@ class SegmentBySinogram;
   \param[in] proj_data_in input data
   \param[in] spline_type determines which type of BSpline will be used
   \param[in] remove_interleaving
+  \param[in,out] cache_ptr if not null, interpolation weights are taken from and stored in this object
   The STIR implementation of interpolating 3D (for the moment) projdata is a generalisation that applies
   B-Splines Interpolation to projdata supposing that every dimension is a regular grid. For instance, for
   a 3D dataset, interpolating can produce a new expanded 3D dataset based on the given information
@@ -45,6 +68,11 @@ class SegmentBySinogram;
 
   See STIR documentation about B-Spline interpolation or scatter correction.
 
+  As the sampling is regular in every dimension, the B-spline weights are computed once per dimension
+  and applied as a tensor product. The output is computed in parallel over sinograms and views (if
+  OpenMP is enabled). For BlocksOnCylindrical scanners, the interpolation weights only depend on the
+  geometry, and can be reused between calls by passing an InterpolateProjDataCache.
+
   \todo This currently only works for direct sinograms (i.e. segment 0).
   \warning Because of the boundary conditions in the B-spline interpolation,
   strange results can occur if the output sinogram has a larger range than
@@ -54,13 +82,17 @@ class SegmentBySinogram;
 Succeeded interpolate_projdata(ProjData& proj_data_out,
                                const ProjData& proj_data_in,
                                const BSpline::BSplineType spline_type,
-                               const bool remove_interleaving = false);
+                               const bool remove_interleaving = false,
+                               InterpolateProjDataCache* cache_ptr = nullptr);
 Succeeded interpolate_projdata(ProjData& proj_data_out,
                                const ProjData& proj_data_in,
                                const BasicCoordinate<3, BSpline::BSplineType>& these_types,
-                               const bool remove_interleaving);
-Succeeded
-interpolate_blocks_on_cylindrical_projdata(ProjData& proj_data_out, const ProjData& proj_data_in, bool remove_interleaving);
+                               const bool remove_interleaving,
+                               InterpolateProjDataCache* cache_ptr = nullptr);
+Succeeded interpolate_blocks_on_cylindrical_projdata(ProjData& proj_data_out,
+                                                     const ProjData& proj_data_in,
+                                                     bool remove_interleaving,
+                                                     InterpolateProjDataCache* cache_ptr = nullptr);
 //@}
 
 END_NAMESPACE_STIR
@@ -52,6 +52,7 @@ public:
   inline Array<2, float> get_model_array() const;
   inline const VectorWithOffset<float> get_model_array_sum() const;
   inline VectorWithOffset<float> get_time_vector() const;
+  inline bool get_is_in_correct_scale() const;
   //!@}
   //! \name Functions to set parameters @{
   inline void set_model_array(const Array<2, float>& model_array);
@@ -105,6 +106,19 @@ public:
   inline void multiply_parametric_image_with_model(DynamicDiscretisedDensity& dynamic_image,
                                                    const ParametricVoxelsOnCartesianGrid& parametric_image) const;
 
+  //! multiply model-matrix with parametric image for a single frame (overwriting original content of \c frame_image)
+  /*! \c frame_image is set to zero if \a frame_num is not in the range of the model matrix. */
+  inline void multiply_parametric_image_with_model_for_frame(DiscretisedDensity<3, float>& frame_image,
+                                                             const ParametricVoxelsOnCartesianGrid& parametric_image,
+                                                             const unsigned int frame_num) const;
+  //! multiply (transpose) model-matrix with a single frame of the dynamic image and add result to original \c parametric_image
+  /*! Summing the result over all frames gives the same as multiply_dynamic_image_with_model_and_add_to_input(),
+      but without needing all frames at once. Nothing is added if \a frame_num is not in the range of the model matrix.
+  */
+  inline void multiply_frame_image_with_model_and_add_to_input(ParametricVoxelsOnCartesianGrid& parametric_image,
+                                                               const DiscretisedDensity<3, float>& frame_image,
+                                                               const unsigned int frame_num) const;
+
   inline void normalise_parametric_image_with_model_sum(ParametricVoxelsOnCartesianGrid& parametric_image_out,
                                                         const ParametricVoxelsOnCartesianGrid& parametric_image) const;
   //@}
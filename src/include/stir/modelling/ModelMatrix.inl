@@ -167,6 +167,13 @@ ModelMatrix<num_param>::set_is_in_correct_scale(const bool in_correct_scale)
   this->_in_correct_scale = in_correct_scale;
 }
 
+template <int num_param>
+bool
+ModelMatrix<num_param>::get_is_in_correct_scale() const
+{
+  return this->_in_correct_scale;
+}
+
 template <int num_param>
 void
 ModelMatrix<num_param>::uncalibrate(const float cal_factor)
@@ -333,6 +340,87 @@ ModelMatrix<num_param>::multiply_parametric_image_with_model(DynamicDiscretisedD
   this->multiply_parametric_image_with_model_and_add_to_input(dynamic_image, parametric_image);
 }
 
+template <int num_param>
+void
+ModelMatrix<num_param>::multiply_parametric_image_with_model_for_frame(DiscretisedDensity<3, float>& frame_image,
+                                                                       const ParametricVoxelsOnCartesianGrid& parametric_image,
+                                                                       const unsigned int frame_num_unsigned) const
+{
+  BasicCoordinate<2, int> model_array_min, model_array_max;
+  if (!(this->_model_array).get_regular_range(model_array_min, model_array_max))
+    error("Model array does not have a regular range");
+
+  assert(frame_image.size_all() == parametric_image.size_all());
+  assert(model_array_max[1] - model_array_min[1] + 1 == num_param);
+
+  const int frame_num = static_cast<int>(frame_num_unsigned);
+  if (frame_num < model_array_min[2] || frame_num > model_array_max[2])
+    {
+      frame_image.fill(0.F);
+      return;
+    }
+
+  const int min_k_index = frame_image.get_min_index();
+  const int max_k_index = frame_image.get_max_index();
+#ifdef STIR_OPENMP
+#  pragma omp parallel for
+#endif
+  for (int k = min_k_index; k <= max_k_index; ++k)
+    {
+      const int min_j_index = frame_image[k].get_min_index();
+      const int max_j_index = frame_image[k].get_max_index();
+      for (int j = min_j_index; j <= max_j_index; ++j)
+        {
+          const int min_i_index = frame_image[k][j].get_min_index();
+          const int max_i_index = frame_image[k][j].get_max_index();
+          for (int i = min_i_index; i <= max_i_index; ++i)
+            {
+              float sum_over_param = 0.F;
+              for (int param_num = model_array_min[1]; param_num <= model_array_max[1]; ++param_num)
+                sum_over_param += parametric_image[k][j][i][param_num] * this->_model_array[param_num][frame_num];
+              frame_image[k][j][i] = sum_over_param;
+            }
+        }
+    }
+}
+
+template <int num_param>
+void
+ModelMatrix<num_param>::multiply_frame_image_with_model_and_add_to_input(ParametricVoxelsOnCartesianGrid& parametric_image,
+                                                                         const DiscretisedDensity<3, float>& frame_image,
+                                                                         const unsigned int frame_num_unsigned) const
+{
+  BasicCoordinate<2, int> model_array_min, model_array_max;
+  if (!this->_model_array.get_regular_range(model_array_min, model_array_max))
+    error("Model array has not regular range");
+
+  assert(frame_image.size_all() == parametric_image.size_all());
+  assert(model_array_max[1] - model_array_min[1] + 1 == num_param);
+
+  const int frame_num = static_cast<int>(frame_num_unsigned);
+  if (frame_num < model_array_min[2] || frame_num > model_array_max[2])
+    return;
+
+  const int min_k_index = frame_image.get_min_index();
+  const int max_k_index = frame_image.get_max_index();
+#ifdef STIR_OPENMP
+#  pragma omp parallel for
+#endif
+  for (int k = min_k_index; k <= max_k_index; ++k)
+    {
+      const int min_j_index = frame_image[k].get_min_index();
+      const int max_j_index = frame_image[k].get_max_index();
+      for (int j = min_j_index; j <= max_j_index; ++j)
+        {
+          const int min_i_index = frame_image[k][j].get_min_index();
+          const int max_i_index = frame_image[k][j].get_max_index();
+          for (int i = min_i_index; i <= max_i_index; ++i)
+            for (int param_num = model_array_min[1]; param_num <= model_array_max[1]; ++param_num)
+              parametric_image[k][j][i][param_num] += this->_model_array[param_num][frame_num] * frame_image[k][j][i];
+        }
+    }
+}
+
 template <int num_param>
 void
 ModelMatrix<num_param>::normalise_parametric_image_with_model_sum(ParametricVoxelsOnCartesianGrid& parametric_image_out,
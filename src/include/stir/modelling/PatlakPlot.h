@@ -116,6 +116,22 @@ public:
   virtual void get_dynamic_image_from_parametric_image(DynamicDiscretisedDensity& dyn_image,
                                                        const ParametricVoxelsOnCartesianGrid& par_image) const;
 
+  //! Multiplies the parametric image with the model matrix to get the image for a single frame.
+  /*! This avoids constructing all frames of the dynamic image. \a scanner_default_bin_size is only used
+      when the model matrix still needs to be scaled (see get_dynamic_image_from_parametric_image()).
+   */
+  virtual void get_frame_image_from_parametric_image(DiscretisedDensity<3, float>& frame_image,
+                                                     const ParametricVoxelsOnCartesianGrid& par_image,
+                                                     const unsigned int frame_num,
+                                                     const float scanner_default_bin_size) const;
+  //! Multiplies the image of a single frame with the model gradient and add to original \c parametric_image
+  /*! Calling this for every frame is equivalent to multiply_dynamic_image_with_model_gradient_and_add_to_input().
+   */
+  virtual void multiply_frame_image_with_model_gradient_and_add_to_input(ParametricVoxelsOnCartesianGrid& parametric_image,
+                                                                         const DiscretisedDensity<3, float>& frame_image,
+                                                                         const unsigned int frame_num,
+                                                                         const float scanner_default_bin_size) const;
+
   //! This is the common method used to estimate the parametric images from the dynamic images.
   /*! \todo There is currently no check if the time frame definitions from \a dyn_image are
     the same as the ones encoded in the model.
@@ -140,6 +156,8 @@ public:
 
 private:
   void create_model_matrix(); //!< Creates model matrix from private members
+  //! Scales the model matrix according to the voxel size of \a image
+  void scale_model_matrix_if_necessary(const DiscretisedDensity<3, float>& image, const float scanner_default_bin_size) const;
   void initialise_keymap() override;
   bool post_processing() override;
   mutable ModelMatrix<2> _model_matrix;
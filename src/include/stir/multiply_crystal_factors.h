@@ -17,7 +17,8 @@
   See STIR/LICENSE.txt for details
 */
 
-#include "stir/common.h"
+#include "stir/shared_ptr.h"
+#include <vector>
 
 START_NAMESPACE_STIR
 
@@ -49,4 +50,19 @@ class Array;
 */
 void multiply_crystal_factors(ProjData& proj_data, const Array<2, float>& efficiencies, const float global_factor);
 
+/*!
+  \ingroup projdata
+
+  \brief Construct several proj-data as multiples of crystal efficiencies (or singles)
+
+  Equivalent to calling multiply_crystal_factors() for every element of \a proj_datas, but
+  the detector pairs contributing to every bin are only determined once. This is useful
+  for instance to estimate randoms from singles for all time frames of a dynamic acquisition.
+
+  All \a proj_datas need to have the same ProjDataInfo. The sizes of all arguments have to be equal.
+*/
+void multiply_crystal_factors(const std::vector<shared_ptr<ProjData>>& proj_datas,
+                              const std::vector<Array<2, float>>& efficiencies,
+                              const std::vector<float>& global_factors);
+
 END_NAMESPACE_STIR
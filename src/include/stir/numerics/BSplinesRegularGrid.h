@@ -54,7 +54,7 @@ class BSplinesRegularGrid
 {
 
 public:
-  // only there for tests
+  //! get the coefficients (used by tests and interpolate_projdata)
   Array<num_dimensions, out_elemT> get_coefficients() const { return this->_coeffs; }
 
   //! constructor given an array of samples and the spline type
@@ -41,6 +41,8 @@ template <typename elemT>
 class RelatedViewgrams;
 template <int num_dimensions, typename elemT>
 class DiscretisedDensity;
+template <int num_dimensions, typename elemT>
+class Array;
 
 #if 0
 //! scales an image and adds it to another
@@ -89,6 +91,10 @@ void truncate_rim(DiscretisedDensity<3, float>& image_input,
                   const int rim_truncation_image,
                   const bool strictly_less_than_radius = true);
 
+//! sets to zero voxels within rim_truncation_image of the FOV rim, for one plane of a (regular) image
+/*! Used by truncate_rim() for every plane. */
+void truncate_rim_in_plane(Array<2, float>& plane, const int rim_truncation_image, const bool strictly_less_than_radius = true);
+
 //! sets the first and last rim_truncation_sino bins at the 'edges' to zero
 void truncate_rim(SegmentByView<float>& seg, const int rim_truncation_sino);
 
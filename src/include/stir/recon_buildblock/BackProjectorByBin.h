@@ -30,6 +30,7 @@
 #include "stir/shared_ptr.h"
 #include "stir/Bin.h"
 #include "stir/recon_buildblock/ProjMatrixElemsForOneBin.h"
+#include <vector>
 
 START_NAMESPACE_STIR
 
@@ -173,6 +174,27 @@ protected:
                                    const int max_axial_pos_num,
                                    const int min_tangential_pos_num,
                                    const int max_tangential_pos_num);
+
+  //! back project the related viewgrams for all timing positions of a view/segment
+  /*! This is called by back_project(const ProjData&, int, int), with one element per timing
+      position (i.e. only one for non-TOF data). It does the same checks as
+      back_project(const RelatedViewgrams<float>&), and calls actual_back_project_all_timing_positions().
+  */
+  void back_project_all_timing_positions(const std::vector<RelatedViewgrams<float>>& viewgrams_for_all_timing_positions);
+
+  //! This actually does the back projection for all timing positions of a view/segment
+  /*! Derived classes can override this such that the geometric computations for an LOR
+      can be shared between TOF bins. They need to accumulate into get_output_image_for_current_thread().
+      The default implementation calls actual_back_project() for every element.
+  */
+  virtual void
+  actual_back_project_all_timing_positions(const std::vector<RelatedViewgrams<float>>& viewgrams_for_all_timing_positions);
+
+  //! get the image in which back projections should be accumulated by the current thread
+  /*! When using OpenMP, this is an image local to the thread (created when necessary), which is
+      added to the output in get_output(). */
+  DiscretisedDensity<3, float>& get_output_image_for_current_thread();
+
   //! check if the argument is the same as what was used for set_up()
   /*! calls error() if anything is wrong.
 
@@ -189,6 +211,10 @@ protected:
    */
   virtual void check(const ProjDataInfo& proj_data_info, const DiscretisedDensity<3, float>& density_info) const;
 
+  //! check that the projector is ready, and that the viewgrams are compatible with set_up() and the symmetries
+  /*! calls error() if anything is wrong. */
+  void check_related_viewgrams(const RelatedViewgrams<float>& viewgrams) const;
+
   bool _already_set_up;
 
   //! Clone of the density sptr set with set_up()
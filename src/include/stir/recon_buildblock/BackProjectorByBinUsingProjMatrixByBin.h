@@ -79,6 +79,12 @@ protected:
   // currently not exposed, but leaving this ine for the future
   void actual_back_project(DiscretisedDensity<3, float>& image, const Bin& bin);
 
+  //! LOR-major version for TOF data
+  /*! Gets the geometric row of every LOR only once (with the TOF kernels for all timing positions),
+      and uses it to back project all TOF bins. */
+  void actual_back_project_all_timing_positions(
+      const std::vector<RelatedViewgrams<float>>& viewgrams_for_all_timing_positions) override;
+
 private:
   void set_defaults() override;
   void initialise_keymap() override;
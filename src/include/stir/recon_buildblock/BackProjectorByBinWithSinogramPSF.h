@@ -0,0 +1,93 @@
+/*!
+  \file
+  \ingroup projection
+
+  \brief Declaration of class stir::BackProjectorByBinWithSinogramPSF
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+#ifndef __stir_recon_buildblock_BackProjectorByBinWithSinogramPSF__H__
+#define __stir_recon_buildblock_BackProjectorByBinWithSinogramPSF__H__
+
+#include "stir/RegisteredParsingObject.h"
+#include "stir/recon_buildblock/BackProjectorByBin.h"
+#include "stir/recon_buildblock/SinogramPSF.h"
+#include "stir/shared_ptr.h"
+
+START_NAMESPACE_STIR
+
+/*!
+  \ingroup projection
+  \brief A back projector that applies the transpose of a SinogramPSF before calling another back projector
+
+  This is the transpose of ForwardProjectorByBinWithSinogramPSF (when using the same parameters
+  and matched original projectors). The blurring is applied to a copy of every RelatedViewgrams
+  within the same (parallel) loop as the back projection. All kernels are computed in set_up().
+
+  \par Parsing
+  \verbatim
+  Sinogram PSF Back Projector Parameters:=
+    Original Back projector type := ...
+    tangential FWHM (in mm) := 0
+    tangential FWHM slope := 0
+    axial FWHM (in mm) := 0
+  End Sinogram PSF Back Projector Parameters:=
+  \endverbatim
+  \see SinogramPSF for the meaning of the parameters.
+*/
+class BackProjectorByBinWithSinogramPSF : public RegisteredParsingObject<BackProjectorByBinWithSinogramPSF, BackProjectorByBin>
+{
+public:
+  //! Name which will be used when parsing a BackProjectorByBinWithSinogramPSF object
+  static const char* const registered_name;
+
+  //! Default constructor (calls set_defaults())
+  BackProjectorByBinWithSinogramPSF();
+
+  BackProjectorByBinWithSinogramPSF(const shared_ptr<BackProjectorByBin>& original_back_projector_sptr, const SinogramPSF& psf);
+
+  //! Sets-up the original projector and computes the PSF kernels
+  void set_up(const shared_ptr<const ProjDataInfo>& proj_data_info_ptr,
+              const shared_ptr<const DiscretisedDensity<3, float>>& density_info_ptr // TODO should be Info only
+              ) override;
+
+  const DataSymmetriesForViewSegmentNumbers* get_symmetries_used() const override;
+
+  void start_accumulating_in_new_target() override;
+
+  //! Gets the output of the original back projector, and applies the post data processor (if any)
+  void get_output(DiscretisedDensity<3, float>&) const override;
+
+  BackProjectorByBin* get_original_back_projector_ptr() const;
+
+  BackProjectorByBinWithSinogramPSF* clone() const override;
+
+private:
+  shared_ptr<BackProjectorByBin> original_back_projector_sptr;
+  SinogramPSF psf;
+
+  // next are only used for parsing
+  float tangential_fwhm;
+  float tangential_fwhm_slope;
+  float axial_fwhm;
+
+  void actual_back_project(const RelatedViewgrams<float>&,
+                           const int min_axial_pos_num,
+                           const int max_axial_pos_num,
+                           const int min_tangential_pos_num,
+                           const int max_tangential_pos_num) override;
+
+  void set_defaults() override;
+  void initialise_keymap() override;
+  bool post_processing() override;
+};
+
+END_NAMESPACE_STIR
+
+#endif
@@ -24,6 +24,7 @@
 #include "stir/recon_buildblock/BinNormalisationWithCalibration.h"
 #include "stir/RegisteredParsingObject.h"
 #include "stir/ProjData.h"
+#include "stir/ProjDataInMemory.h"
 #include "stir/shared_ptr.h"
 #include "stir/ProjDataInfoCylindricalNoArcCorr.h"
 #include "stir/data/SinglesRates.h"
@@ -63,6 +64,11 @@ START_NAMESPACE_ECAT
   ; keyword that can be used to write the components to a separate text files for debugging
   ; files are written in the current directory and are called geom_out.txt etc.
   ; write_components_to_file := 0
+
+  ; keyword to compute all efficiencies once in set_up() and store them in memory.
+  ; This speeds up apply()/undo() and get_bin_efficiency() (e.g. for list-mode processing),
+  ; but uses as much memory as one (non-TOF) sinogram. Defaults to 0.
+  ; precompute_efficiencies := 0
   End Bin Normalisation From ECAT8:=
   \endverbatim
 
@@ -108,6 +114,30 @@ public:
   Succeeded set_up(const shared_ptr<const ExamInfo>& exam_info_sptr, const shared_ptr<const ProjDataInfo>&) override;
   float get_uncalibrated_bin_efficiency(const Bin& bin) const override;
 
+  // import all apply/undo methods from base-class (we'll override some below)
+  using base_type::apply;
+  using base_type::undo;
+
+  //! Normalise some data
+  /*! If efficiencies are precomputed, this uses the stored values, otherwise the base-class version. */
+  void apply(RelatedViewgrams<float>& viewgrams) const override;
+
+  //! Undo the normalisation of some data
+  /*! If efficiencies are precomputed, this uses the stored values, otherwise the base-class version. */
+  void undo(RelatedViewgrams<float>& viewgrams) const override;
+
+  //! Set if all efficiencies will be computed by set_up()
+  /*! The precomputed (uncalibrated) efficiencies are then used by get_uncalibrated_bin_efficiency(),
+      apply() and undo(). The table is computed for the time frame of the \c ExamInfo passed to set_up().
+      This only matters for dead-time factors (currently disabled), for which set_up() would have to be called
+      again for every frame. The calibration, decay and branching ratio factors are not stored in the table,
+      but are applied by every call, as without precomputing.
+
+      Calling this function means that set_up() has to be called again.
+  */
+  void set_precompute_efficiencies(const bool);
+  bool get_precompute_efficiencies() const;
+
   bool use_detector_efficiencies() const;
   bool use_dead_time() const;
   bool use_geometric_factors() const;
@@ -147,6 +177,10 @@ private:
   bool _use_crystal_interference_factors;
   bool _use_axial_effects_factors;
   bool _write_components_to_file;
+  bool _precompute_efficiencies;
+
+  //! uncalibrated efficiencies for every (non-TOF) bin, only allocated when precomputing
+  shared_ptr<ProjDataInMemory> uncalibrated_efficiencies_sptr;
 
   void read_norm_data(const string& filename);
   float get_dead_time_efficiency(const DetectionPosition<>& det_pos, const double start_time, const double end_time) const;
@@ -154,6 +188,10 @@ private:
   //! initialise sino_index and num_Siemens_sinograms
   void construct_sino_lookup_table();
   float find_axial_effects(int ring1, int ring2) const;
+  //! compute the uncalibrated efficiency from the components
+  float compute_uncalibrated_bin_efficiency(const Bin& bin) const;
+  //! fill uncalibrated_efficiencies_sptr
+  void precompute_uncalibrated_efficiencies();
   // parsing stuff
   void set_defaults() override;
   void initialise_keymap() override;
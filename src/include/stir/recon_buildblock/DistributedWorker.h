@@ -33,6 +33,7 @@
 START_NAMESPACE_STIR
 
 class ExamInfo;
+class BinNormalisation;
 
 /*!
   \ingroup distributable
@@ -52,6 +53,13 @@ class ExamInfo;
   enabled.  If so, the worker does not have to receive the related viewgrams, but just gets it from
   its saved viewgrams.
 
+  Alternatively, if the master has called stir::setup_distributable_computation_local_data(), the worker
+  reads the projection data (and the additive data and normalisation) itself, and only receives the
+  vs_num and timing position number.
+
+  At the end of the loop, the reductions of the output image and log-likelihood are started with
+  non-blocking MPI calls, and completed together.
+
   \todo The log_likelihood_ptr argument to the RPC function is currently always NULL.
   \todo Currently the only computation that is supported corresponds to the gradient computation.
   It would be trivial to add others.
@@ -64,7 +72,7 @@ private:
   bool zero_seg0_end_planes;
   shared_ptr<ProjectorByBinPair> proj_pair_sptr;
   shared_ptr<ExamInfo> exam_info_sptr;
-  shared_ptr<const ProjDataInfo> proj_data_info_sptr;
+  shared_ptr<ProjDataInfo> proj_data_info_sptr;
   shared_ptr<TargetT> target_sptr;
 
   int image_buffer_size; // to save the image_size
@@ -75,6 +83,11 @@ private:
   shared_ptr<ProjData> binwise_correction;
   shared_ptr<ProjData> mult_proj_data_sptr;
 
+  // data read by the worker itself
+  shared_ptr<ProjData> local_proj_data_sptr;
+  shared_ptr<ProjData> local_additive_proj_data_sptr;
+  shared_ptr<BinNormalisation> local_normalisation_sptr;
+
   int my_rank; // rank of the worker
 
 public:
@@ -112,6 +125,12 @@ protected:
 
   */
   void setup_distributable_computation();
+  /*!
+    \brief Read the data as specified by the master.
+
+    This is the worker-side of stir::setup_distributable_computation_local_data().
+  */
+  void setup_local_data();
   /*!
     \brief this does the actual computation corresponding to distributable_computation()
   */
@@ -33,6 +33,7 @@
 #include "stir/shared_ptr.h"
 #include "stir/Bin.h"
 #include "stir/recon_buildblock/ProjMatrixElemsForOneBin.h"
+#include <vector>
 
 START_NAMESPACE_STIR
 
@@ -148,6 +149,22 @@ protected:
                                       const int min_tangential_pos_num,
                                       const int max_tangential_pos_num);
 
+  //! project the volume into the related viewgrams for all timing positions of a view/segment
+  /*! This is called by forward_project(ProjData&, int, int, bool), with one element per timing
+      position (i.e. only one for non-TOF data). It does the same checks as
+      forward_project(RelatedViewgrams<float>&), and calls actual_forward_project_all_timing_positions().
+      Data already present in the viewgrams is overwritten.
+  */
+  void forward_project_all_timing_positions(std::vector<RelatedViewgrams<float>>& viewgrams_for_all_timing_positions);
+
+  //! This actually does the forward projection for all timing positions of a view/segment
+  /*! Derived classes can override this such that the geometric computations for an LOR
+      can be shared between TOF bins. The default implementation calls actual_forward_project() for every
+      element.
+  */
+  virtual void
+  actual_forward_project_all_timing_positions(std::vector<RelatedViewgrams<float>>& viewgrams_for_all_timing_positions);
+
 #if 0 // disabled as currently not used. needs to be written in the new style anyway
     //! This virtual function has to be implemented by the derived class.
     virtual void actual_forward_project(Bin&,
@@ -179,6 +196,10 @@ protected:
   void set_defaults() override;
   void initialise_keymap() override;
 
+  //! check that set_input() was called, and that the viewgrams are compatible with set_up() and the symmetries
+  /*! calls error() if anything is wrong. */
+  void check_related_viewgrams(const RelatedViewgrams<float>& viewgrams) const;
+
 protected:
   //! ProjDataInfo set by set_up()
   shared_ptr<const ProjDataInfo> _proj_data_info_sptr;
@@ -74,6 +74,12 @@ private:
                               const int min_tangential_pos_num,
                               const int max_tangential_pos_num) override;
 
+  //! LOR-major version for TOF data
+  /*! Gets the geometric row of every LOR only once (with the TOF kernels for all timing positions),
+      and uses it to compute the forward projection for all TOF bins. */
+  void
+  actual_forward_project_all_timing_positions(std::vector<RelatedViewgrams<float>>& viewgrams_for_all_timing_positions) override;
+
 #if 0 // disabled as currently not used. needs to be written in the new style anyway
   void actual_forward_project(Bin&, const DiscretisedDensity<3,float>&);
 #endif
@@ -0,0 +1,94 @@
+/*!
+  \file
+  \ingroup projection
+
+  \brief Declaration of class stir::ForwardProjectorByBinWithSinogramPSF
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+#ifndef __stir_recon_buildblock_ForwardProjectorByBinWithSinogramPSF__H__
+#define __stir_recon_buildblock_ForwardProjectorByBinWithSinogramPSF__H__
+
+#include "stir/RegisteredParsingObject.h"
+#include "stir/recon_buildblock/ForwardProjectorByBin.h"
+#include "stir/recon_buildblock/SinogramPSF.h"
+#include "stir/shared_ptr.h"
+
+START_NAMESPACE_STIR
+
+/*!
+  \ingroup projection
+  \brief A forward projector that blurs the output of another forward projector with a SinogramPSF
+
+  This provides resolution modelling in projection space. In contrast to
+  PresmoothingForwardProjectorByBin, there is no filtering of the whole image. Instead, the
+  blurring is applied to every RelatedViewgrams after it has been forward projected, i.e. within
+  the same (parallel) loop as the projection. All kernels are computed in set_up().
+
+  Use BackProjectorByBinWithSinogramPSF with the same parameters for a matched back projector.
+
+  \par Parsing
+  \verbatim
+  Sinogram PSF Forward Projector Parameters:=
+    Original Forward projector type := ...
+    tangential FWHM (in mm) := 0
+    tangential FWHM slope := 0
+    axial FWHM (in mm) := 0
+  End Sinogram PSF Forward Projector Parameters:=
+  \endverbatim
+  \see SinogramPSF for the meaning of the parameters.
+*/
+class ForwardProjectorByBinWithSinogramPSF
+    : public RegisteredParsingObject<ForwardProjectorByBinWithSinogramPSF, ForwardProjectorByBin>
+{
+public:
+  //! Name which will be used when parsing a ForwardProjectorByBinWithSinogramPSF object
+  static const char* const registered_name;
+
+  //! Default constructor (calls set_defaults())
+  ForwardProjectorByBinWithSinogramPSF();
+
+  ForwardProjectorByBinWithSinogramPSF(const shared_ptr<ForwardProjectorByBin>& original_forward_projector_sptr,
+                                       const SinogramPSF& psf);
+
+  //! Sets-up the original projector and computes the PSF kernels
+  void set_up(const shared_ptr<const ProjDataInfo>& proj_data_info_ptr,
+              const shared_ptr<const DiscretisedDensity<3, float>>& density_info_ptr // TODO should be Info only
+              ) override;
+
+  const DataSymmetriesForViewSegmentNumbers* get_symmetries_used() const override;
+
+  //! Sets the input of this projector and of the original projector
+  void set_input(const DiscretisedDensity<3, float>&) override;
+
+  ForwardProjectorByBin* get_original_forward_projector_ptr() const;
+
+private:
+  shared_ptr<ForwardProjectorByBin> original_forward_projector_sptr;
+  SinogramPSF psf;
+
+  // next are only used for parsing
+  float tangential_fwhm;
+  float tangential_fwhm_slope;
+  float axial_fwhm;
+
+  void actual_forward_project(RelatedViewgrams<float>&,
+                              const int min_axial_pos_num,
+                              const int max_axial_pos_num,
+                              const int min_tangential_pos_num,
+                              const int max_tangential_pos_num) override;
+
+  void set_defaults() override;
+  void initialise_keymap() override;
+  bool post_processing() override;
+};
+
+END_NAMESPACE_STIR
+
+#endif
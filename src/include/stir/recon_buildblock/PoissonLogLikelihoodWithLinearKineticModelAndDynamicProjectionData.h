@@ -156,8 +156,16 @@ protected:
   // Patlak Plot Parameters
   /*! the patlak plot pointer where all the parameters are stored */
   shared_ptr<PatlakPlot> _patlak_plot_sptr;
-  //! dynamic image template
-  DynamicDiscretisedDensity _dyn_image_template;
+  //! template for the image of a single frame
+  shared_ptr<const DiscretisedDensity<3, float>> _single_frame_image_template_sptr;
+  //! scanner used for the dynamic images
+  shared_ptr<Scanner> _scanner_sptr;
+
+  //! construct a dynamic image with all frames of the model
+  /*! Most computations work frame-by-frame to keep memory usage down, but some still need all frames at once. */
+  DynamicDiscretisedDensity construct_dyn_image_template() const;
+  //! set the time frame of \a frame_image to frame \a frame_num of the model
+  void set_exam_info_for_frame(DiscretisedDensity<3, float>& frame_image, const unsigned int frame_num) const;
 
   bool actual_subsets_are_approximately_balanced(std::string& warning_message) const override;
 
@@ -313,6 +313,27 @@ PoissonLogLikelihoodWithLinearKineticModelAndDynamicProjectionData<TargetT>::set
 /***************************************************************
   set_up()
 ***************************************************************/
+template <typename TargetT>
+DynamicDiscretisedDensity
+PoissonLogLikelihoodWithLinearKineticModelAndDynamicProjectionData<TargetT>::construct_dyn_image_template() const
+{
+  return DynamicDiscretisedDensity(this->_patlak_plot_sptr->get_time_frame_definitions(),
+                                   this->_dyn_proj_data_sptr->get_start_time_in_secs_since_1970(),
+                                   this->_scanner_sptr,
+                                   shared_ptr<DiscretisedDensity<3, float>>(this->_single_frame_image_template_sptr->get_empty_copy()));
+}
+
+template <typename TargetT>
+void
+PoissonLogLikelihoodWithLinearKineticModelAndDynamicProjectionData<TargetT>::set_exam_info_for_frame(
+    DiscretisedDensity<3, float>& frame_image, const unsigned int frame_num) const
+{
+  ExamInfo this_exam_info(frame_image.get_exam_info());
+  this_exam_info.set_time_frame_definitions(
+      TimeFrameDefinitions(this->_patlak_plot_sptr->get_time_frame_definitions(), frame_num));
+  frame_image.set_exam_info(this_exam_info);
+}
+
 template <typename TargetT>
 Succeeded
 PoissonLogLikelihoodWithLinearKineticModelAndDynamicProjectionData<TargetT>::set_up_before_sensitivity(
@@ -367,11 +388,8 @@ PoissonLogLikelihoodWithLinearKineticModelAndDynamicProjectionData<TargetT>::set
   {
     const shared_ptr<DiscretisedDensity<3, float>> density_template_sptr(
         (target_sptr->construct_single_density(1)).get_empty_copy());
-    const shared_ptr<Scanner> scanner_sptr(new Scanner(*proj_data_info_sptr->get_scanner_ptr()));
-    this->_dyn_image_template = DynamicDiscretisedDensity(this->_patlak_plot_sptr->get_time_frame_definitions(),
-                                                          this->_dyn_proj_data_sptr->get_start_time_in_secs_since_1970(),
-                                                          scanner_sptr,
-                                                          density_template_sptr);
+    this->_scanner_sptr.reset(new Scanner(*proj_data_info_sptr->get_scanner_ptr()));
+    this->_single_frame_image_template_sptr = density_template_sptr;
 
     // construct _single_frame_obj_funcs
     this->_single_frame_obj_funcs.resize(this->_patlak_plot_sptr->get_starting_frame(),
@@ -445,28 +463,29 @@ PoissonLogLikelihoodWithLinearKineticModelAndDynamicProjectionData<TargetT>::act
   if (subset_num < 0 || subset_num >= this->get_num_subsets())
     error("compute_sub_gradient_without_penalty subset_num out-of-range error");
 
-  DynamicDiscretisedDensity dyn_gradient = this->_dyn_image_template;
-  DynamicDiscretisedDensity dyn_image_estimate = this->_dyn_image_template;
-
-  for (unsigned int frame_num = this->_patlak_plot_sptr->get_starting_frame();
-       frame_num <= this->_patlak_plot_sptr->get_ending_frame();
-       ++frame_num)
-    std::fill(dyn_image_estimate[frame_num].begin_all(), dyn_image_estimate[frame_num].end_all(), 1.F);
-
-  this->_patlak_plot_sptr->get_dynamic_image_from_parametric_image(dyn_image_estimate, current_estimate);
+  // Generate the image of every frame on the fly and add its gradient straight into parametric space,
+  // such that only 2 single-frame images are needed, instead of 2 full dynamic images.
+  // Frames are handled sequentially, as they share the projectors (which are themselves parallelised).
+  const float scanner_default_bin_size = this->_scanner_sptr->get_default_bin_size();
+  const shared_ptr<DiscretisedDensity<3, float>> frame_estimate_sptr(this->_single_frame_image_template_sptr->get_empty_copy());
+  const shared_ptr<DiscretisedDensity<3, float>> frame_gradient_sptr(this->_single_frame_image_template_sptr->get_empty_copy());
 
-  // loop over single_frame and use model_matrix
+  std::fill(gradient.begin_all(), gradient.end_all(), 0.F);
   for (unsigned int frame_num = this->_patlak_plot_sptr->get_starting_frame();
        frame_num <= this->_patlak_plot_sptr->get_ending_frame();
        ++frame_num)
     {
-      std::fill(dyn_gradient[frame_num].begin_all(), dyn_gradient[frame_num].end_all(), 1.F);
+      this->set_exam_info_for_frame(*frame_estimate_sptr, frame_num);
+      this->set_exam_info_for_frame(*frame_gradient_sptr, frame_num);
+      this->_patlak_plot_sptr->get_frame_image_from_parametric_image(
+          *frame_estimate_sptr, current_estimate, frame_num, scanner_default_bin_size);
 
       this->_single_frame_obj_funcs[frame_num].actual_compute_subset_gradient_without_penalty(
-          dyn_gradient[frame_num], dyn_image_estimate[frame_num], subset_num, add_sensitivity);
-    }
+          *frame_gradient_sptr, *frame_estimate_sptr, subset_num, add_sensitivity);
 
-  this->_patlak_plot_sptr->multiply_dynamic_image_with_model_gradient(gradient, dyn_gradient);
+      this->_patlak_plot_sptr->multiply_frame_image_with_model_gradient_and_add_to_input(
+          gradient, *frame_gradient_sptr, frame_num, scanner_default_bin_size);
+    }
 }
 
 template <typename TargetT>
@@ -478,21 +497,18 @@ PoissonLogLikelihoodWithLinearKineticModelAndDynamicProjectionData<TargetT>::act
   assert(subset_num < this->num_subsets);
 
   double result = 0.;
-  DynamicDiscretisedDensity dyn_image_estimate = this->_dyn_image_template;
+  const float scanner_default_bin_size = this->_scanner_sptr->get_default_bin_size();
+  const shared_ptr<DiscretisedDensity<3, float>> frame_estimate_sptr(this->_single_frame_image_template_sptr->get_empty_copy());
 
-  // TODO why fill with 1?
-  for (unsigned int frame_num = this->_patlak_plot_sptr->get_starting_frame();
-       frame_num <= this->_patlak_plot_sptr->get_ending_frame();
-       ++frame_num)
-    std::fill(dyn_image_estimate[frame_num].begin_all(), dyn_image_estimate[frame_num].end_all(), 1.F);
-  this->_patlak_plot_sptr->get_dynamic_image_from_parametric_image(dyn_image_estimate, current_estimate);
-
-  // loop over single_frame
+  // loop over single_frame, generating the image of each frame on the fly
   for (unsigned int frame_num = this->_patlak_plot_sptr->get_starting_frame();
        frame_num <= this->_patlak_plot_sptr->get_ending_frame();
        ++frame_num)
     {
-      result += this->_single_frame_obj_funcs[frame_num].compute_objective_function_without_penalty(dyn_image_estimate[frame_num],
+      this->set_exam_info_for_frame(*frame_estimate_sptr, frame_num);
+      this->_patlak_plot_sptr->get_frame_image_from_parametric_image(
+          *frame_estimate_sptr, current_estimate, frame_num, scanner_default_bin_size);
+      result += this->_single_frame_obj_funcs[frame_num].compute_objective_function_without_penalty(*frame_estimate_sptr,
                                                                                                     subset_num);
     }
   return result;
@@ -503,18 +519,19 @@ void
 PoissonLogLikelihoodWithLinearKineticModelAndDynamicProjectionData<TargetT>::add_subset_sensitivity(TargetT& sensitivity,
                                                                                                     const int subset_num) const
 {
-  DynamicDiscretisedDensity dyn_sensitivity = this->_dyn_image_template;
+  const float scanner_default_bin_size = this->_scanner_sptr->get_default_bin_size();
 
   // loop over single_frame and use model_matrix
   for (unsigned int frame_num = this->_patlak_plot_sptr->get_starting_frame();
        frame_num <= this->_patlak_plot_sptr->get_ending_frame();
        ++frame_num)
     {
-      dyn_sensitivity[frame_num] = this->_single_frame_obj_funcs[frame_num].get_subset_sensitivity(subset_num);
-      //  add_subset_sensitivity(dyn_sensitivity[frame_num],subset_num);
+      this->_patlak_plot_sptr->multiply_frame_image_with_model_gradient_and_add_to_input(
+          sensitivity,
+          this->_single_frame_obj_funcs[frame_num].get_subset_sensitivity(subset_num),
+          frame_num,
+          scanner_default_bin_size);
     }
-
-  this->_patlak_plot_sptr->multiply_dynamic_image_with_model_gradient_and_add_to_input(sensitivity, dyn_sensitivity);
 }
 
 template <typename TargetT>
@@ -539,8 +556,8 @@ PoissonLogLikelihoodWithLinearKineticModelAndDynamicProjectionData<
   info(boost::format("INPUT max: (%1% , %2%)") % input.construct_single_density(1).find_max()
        % input.construct_single_density(2).find_max());
 #endif // NDEBUG
-  DynamicDiscretisedDensity dyn_input = this->_dyn_image_template;
-  DynamicDiscretisedDensity dyn_output = this->_dyn_image_template;
+  DynamicDiscretisedDensity dyn_input = this->construct_dyn_image_template();
+  DynamicDiscretisedDensity dyn_output = dyn_input;
   this->_patlak_plot_sptr->get_dynamic_image_from_parametric_image(dyn_input, input);
 
   VectorWithOffset<float> scale_factor(this->_patlak_plot_sptr->get_starting_frame(),
@@ -645,9 +662,9 @@ PoissonLogLikelihoodWithLinearKineticModelAndDynamicProjectionData<
   info(boost::format("INPUT max: (%1% , %2%)") % input.construct_single_density(1).find_max()
        % input.construct_single_density(2).find_max());
 #endif // NDEBUG
-  DynamicDiscretisedDensity dyn_input = this->_dyn_image_template;
-  DynamicDiscretisedDensity dyn_current_image_estimate = this->_dyn_image_template;
-  DynamicDiscretisedDensity dyn_output = this->_dyn_image_template;
+  DynamicDiscretisedDensity dyn_input = this->construct_dyn_image_template();
+  DynamicDiscretisedDensity dyn_current_image_estimate = dyn_input;
+  DynamicDiscretisedDensity dyn_output = dyn_input;
   this->_patlak_plot_sptr->get_dynamic_image_from_parametric_image(dyn_input, input);
   this->_patlak_plot_sptr->get_dynamic_image_from_parametric_image(dyn_current_image_estimate, current_image_estimate);
 
@@ -145,6 +145,8 @@ public:
   //#ifdef STIR_MPI
   //! enable/disable key for distributed caching
   bool distributed_cache_enabled;
+  //! enable/disable key for letting the slaves read the data themselves
+  bool distributed_data_reading_enabled;
   bool distributed_tests_enabled;
   bool message_timings_enabled;
   double message_timings_threshold;
@@ -388,6 +390,9 @@ private:
   void ensure_norm_is_set_up(bool for_original_data = true) const;
   //! convenience for ensure_norm_is_set_up(false)
   void ensure_norm_is_set_up_for_sensitivity() const;
+  //! helper function to call setup_distributable_computation_local_data() when enabled
+  /*! Has to be called after setup_distributable_computation() with the original projectors */
+  void setup_distributable_data_reading() const;
   //!@}
 #if 0
   void
@@ -397,6 +402,7 @@ private:
 
 #ifdef STIR_MPI
 // made available to be called from DistributedWorker object
+template <bool add_sensitivity>
 RPC_process_related_viewgrams_type RPC_process_related_viewgrams_gradient;
 RPC_process_related_viewgrams_type RPC_process_related_viewgrams_accumulate_loglikelihood;
 RPC_process_related_viewgrams_type RPC_process_related_viewgrams_sensitivity_computation;
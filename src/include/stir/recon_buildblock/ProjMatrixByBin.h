@@ -33,11 +33,13 @@
 #include "stir/shared_ptr.h"
 #include "stir/VectorWithOffset.h"
 #include "stir/TimedObject.h"
+#include "stir/Profiler.h"
 #include "stir/VoxelsOnCartesianGrid.h"
 #include "stir/numerics/FastErf.h"
 #include <cstdint>
 //#include <map>
 #include <unordered_map>
+#include <vector>
 #ifdef STIR_OPENMP
 #  include <omp.h>
 #endif
@@ -74,6 +76,10 @@ class Bin;
   The 2nd option allows to cache the whole matrix. This results in the fastest
   behaviour IF your system does not start swapping. The default choice caches
   only the 'basic' bins, and computes symmetry related bins from the 'basic' ones.
+
+  For TOF data, the cache stores the rows for every timing position, and in addition the
+  row without TOF kernel for every LOR (see get_proj_matrix_elems_for_one_bin_for_all_timing_positions()).
+  The latter needs about as much memory as the cache for the corresponding non-TOF data.
 */
 class ProjMatrixByBin : public RegisteredObject<ProjMatrixByBin>, public TimedObject
 {
@@ -109,6 +115,25 @@ public:
   calculate_proj_matrix_elems_for_one_bin.*/
   inline void get_proj_matrix_elems_for_one_bin(ProjMatrixElemsForOneBin&, const Bin&) const;
 
+  //! Get the geometric part of a row of the matrix, and the TOF kernel for all timing positions
+  /*!
+    The result is equivalent to calling get_proj_matrix_elems_for_one_bin() for every
+    timing position of \a bin (whose timing position is ignored), but it is much faster. The
+    geometric row is only computed (or taken from the cache) once, and as neighbouring TOF bins
+    share a boundary, only <tt>num_tof_bins+1</tt> erf values are computed per element.
+
+    On return, \a probabilities contains the row without the TOF kernel (with its bin set to
+    timing position 0), and
+    \code
+    tof_kernels[i*num_tof_bins + (timing_pos_num - min_tof_pos_num)]
+    \endcode
+    is the TOF kernel for element \c i of the row and \c timing_pos_num. For non-TOF data,
+    \a tof_kernels contains 1 for every element.
+  */
+  void get_proj_matrix_elems_for_one_bin_for_all_timing_positions(ProjMatrixElemsForOneBin& probabilities,
+                                                                   std::vector<float>& tof_kernels,
+                                                                   const Bin& bin) const;
+
 #if 0
   // TODO
   /*! \brief Facility to write the 'independent' part of the matrix to file.
@@ -135,6 +160,14 @@ public:
   bool is_cache_enabled() const;
   bool does_cache_store_only_basic_bins() const;
 
+  //! Precompute the LOR geometry of Generic projection data in set_up()
+  /*! If set, set_up() calls ProjDataInfoGeneric::set_up_LOR_geometry_cache() when the projection data
+      are of a Generic type (e.g. BlocksOnCylindrical). This uses memory (about 21 bytes per non-TOF bin),
+      but speeds up get_s(), get_phi() etc. Ignored for other types of projection data.
+  */
+  void set_precompute_LOR_geometry(const bool v = true);
+  bool get_precompute_LOR_geometry() const;
+
   // void reserve_num_elements_in_cache(const std::size_t);
   //! Remove all elements from the cache
   void clear_cache() const;
@@ -173,6 +206,8 @@ protected:
 
   bool cache_disabled;
   bool cache_stores_only_basic_bins;
+  //! see set_precompute_LOR_geometry()
+  bool precompute_LOR_geometry;
   //! If activated TOF reconstruction will be performed.
   bool tof_enabled;
 
@@ -181,8 +216,11 @@ protected:
    If it succeeds, it overwrites the ProjMatrixElemsForOneBin parameter and
    returns Succeeded::yes, otherwise it does not touch the ProjMatrixElemsForOneBin
    and returns Succeeded::false.
+
+   If \a use_geometric_cache is \c true, the cache of rows without TOF kernel is used
+   (only for TOF data).
   */
-  Succeeded get_cached_proj_matrix_elems_for_one_bin(ProjMatrixElemsForOneBin&) const;
+  Succeeded get_cached_proj_matrix_elems_for_one_bin(ProjMatrixElemsForOneBin&, const bool use_geometric_cache = false) const;
 
   //! We need a local copy of the discretised density in order to find the
   //! cartesian coordinates of each voxel.
@@ -192,7 +230,8 @@ protected:
   shared_ptr<const ProjDataInfo> proj_data_info_sptr;
 
   //! The method to store data in the cache.
-  void cache_proj_matrix_elems_for_one_bin(const ProjMatrixElemsForOneBin&) const;
+  /*! See get_cached_proj_matrix_elems_for_one_bin() for \a use_geometric_cache */
+  void cache_proj_matrix_elems_for_one_bin(const ProjMatrixElemsForOneBin&, const bool use_geometric_cache = false) const;
 
 private:
   typedef std::uint64_t CacheKey;
@@ -210,6 +249,11 @@ private:
 
   //! collection of  ProjMatrixElemsForOneBin (internal cache )
   mutable VectorWithOffset<VectorWithOffset<MapProjMatrixElemsForOneBin>> cache_collection;
+  //! collection of rows without TOF kernel (only used for TOF data, for timing position 0)
+  /*! These are used to compute the rows for every timing position, and by
+      get_proj_matrix_elems_for_one_bin_for_all_timing_positions(). They use the same locks
+      as \c cache_collection. */
+  mutable VectorWithOffset<VectorWithOffset<MapProjMatrixElemsForOneBin>> geometric_cache_collection;
 #ifdef STIR_OPENMP
   mutable VectorWithOffset<VectorWithOffset<omp_lock_t>> cache_locks;
 #endif
@@ -228,6 +272,22 @@ private:
   //! 1/(2*sigma_in_mm)
   float r_sqrt2_gauss_sigma;
 
+  //! Get a row of the matrix without TOF kernel (the timing position of the bin is ignored)
+  inline void get_geometric_proj_matrix_elems_for_one_bin(ProjMatrixElemsForOneBin&, const Bin&) const;
+
+  //! Get a row of the matrix via the cache, with or without TOF kernel
+  inline void get_proj_matrix_elems_for_one_bin_help(ProjMatrixElemsForOneBin&, const Bin&, const bool with_tof_kernel) const;
+
+  //! Compute the row for a basic bin (when it is not in the cache)
+  /*! With TOF kernel, the geometric row is obtained via get_geometric_proj_matrix_elems_for_one_bin(),
+      such that it is only computed once for all timing positions. */
+  inline void calculate_proj_matrix_elems_for_one_basic_bin(ProjMatrixElemsForOneBin&, const bool with_tof_kernel) const;
+
+  //! Find the middle of the LOR and the unit vector along it, as used for the TOF kernel
+  inline void get_tof_LOR_middle_and_direction(CartesianCoordinate3D<float>& middle,
+                                               CartesianCoordinate3D<float>& diff_unit_vector,
+                                               const Bin& bin) const;
+
   //! The function which actually applies the TOF kernel on the LOR.
   inline void apply_tof_kernel(ProjMatrixElemsForOneBin& probabilities) const;
 
@@ -46,9 +46,28 @@ ProjMatrixByBin::get_symmetries_sptr() const
 
 inline void
 ProjMatrixByBin::get_proj_matrix_elems_for_one_bin(ProjMatrixElemsForOneBin& probabilities, const Bin& bin) const
+{
+  get_proj_matrix_elems_for_one_bin_help(probabilities, bin, proj_data_info_sptr->is_tof_data() && this->tof_enabled);
+}
+
+inline void
+ProjMatrixByBin::get_geometric_proj_matrix_elems_for_one_bin(ProjMatrixElemsForOneBin& probabilities, const Bin& bin) const
+{
+  Bin non_tof_bin = bin;
+  non_tof_bin.timing_pos_num() = 0;
+  get_proj_matrix_elems_for_one_bin_help(probabilities, non_tof_bin, false);
+}
+
+inline void
+ProjMatrixByBin::get_proj_matrix_elems_for_one_bin_help(ProjMatrixElemsForOneBin& probabilities,
+                                                        const Bin& bin,
+                                                        const bool with_tof_kernel) const
 {
   // start_timers(); TODO, can't do this in a const member
 
+  // rows without TOF kernel are stored separately for TOF data
+  const bool use_geometric_cache = !with_tof_kernel && proj_data_info_sptr->is_tof_data() && this->tof_enabled;
+
   // set to empty
   probabilities.erase();
 
@@ -60,18 +79,11 @@ ProjMatrixByBin::get_proj_matrix_elems_for_one_bin(ProjMatrixElemsForOneBin& pro
 
       probabilities.set_bin(basic_bin);
       // check if basic bin is in cache
-      if (get_cached_proj_matrix_elems_for_one_bin(probabilities) == Succeeded::no)
+      if (get_cached_proj_matrix_elems_for_one_bin(probabilities, use_geometric_cache) == Succeeded::no)
         {
           // basic bin is not in cache, compute lor probabilities for the basic bin
-          calculate_proj_matrix_elems_for_one_bin(probabilities);
-#ifndef NDEBUG
-          probabilities.check_state();
-#endif
-          if (proj_data_info_sptr->is_tof_data() && this->tof_enabled)
-            { // Apply TOF kernel to basic bin
-              apply_tof_kernel(probabilities);
-            }
-          cache_proj_matrix_elems_for_one_bin(probabilities);
+          calculate_proj_matrix_elems_for_one_basic_bin(probabilities, with_tof_kernel);
+          cache_proj_matrix_elems_for_one_bin(probabilities, use_geometric_cache);
         }
 
       // now transform to original bin (inc. TOF)
@@ -81,7 +93,7 @@ ProjMatrixByBin::get_proj_matrix_elems_for_one_bin(ProjMatrixElemsForOneBin& pro
     { // !cache_stores_only_basic_bins
       probabilities.set_bin(bin);
       // if bin is in the cache, get the probabilities
-      if (get_cached_proj_matrix_elems_for_one_bin(probabilities) == Succeeded::no)
+      if (get_cached_proj_matrix_elems_for_one_bin(probabilities, use_geometric_cache) == Succeeded::no)
         {
           // bin probabilities not in the cache, check if basic bins are
           // find basic bin
@@ -90,41 +102,68 @@ ProjMatrixByBin::get_proj_matrix_elems_for_one_bin(ProjMatrixElemsForOneBin& pro
           probabilities.set_bin(basic_bin);
 
           // check if basic bin is in cache
-          if (get_cached_proj_matrix_elems_for_one_bin(probabilities) == Succeeded::no)
+          if (get_cached_proj_matrix_elems_for_one_bin(probabilities, use_geometric_cache) == Succeeded::no)
             {
               // basic bin is not in cache, compute lor probabilities for the basic bin
-              calculate_proj_matrix_elems_for_one_bin(probabilities);
-#ifndef NDEBUG
-              probabilities.check_state();
-#endif
-              if (proj_data_info_sptr->is_tof_data() && this->tof_enabled)
-                { // Apply TOF kernel to basic bin
-                  apply_tof_kernel(probabilities);
-                }
+              calculate_proj_matrix_elems_for_one_basic_bin(probabilities, with_tof_kernel);
             }
           // now transform basic bin probabilities into original bin probabilities
           symm_ptr->transform_proj_matrix_elems_for_one_bin(probabilities);
           // cache the probabilities for bin
-          cache_proj_matrix_elems_for_one_bin(probabilities);
+          cache_proj_matrix_elems_for_one_bin(probabilities, use_geometric_cache);
         }
     }
   // stop_timers(); TODO, can't do this in a const member
 }
 
-void
-ProjMatrixByBin::apply_tof_kernel(ProjMatrixElemsForOneBin& probabilities) const
+inline void
+ProjMatrixByBin::calculate_proj_matrix_elems_for_one_basic_bin(ProjMatrixElemsForOneBin& probabilities,
+                                                               const bool with_tof_kernel) const
 {
+  if (with_tof_kernel)
+    {
+      // The geometric part is the same for all timing positions, so we get it from the
+      // cache of rows without TOF kernel, and apply the TOF kernel to the basic bin.
+      const Bin basic_bin = probabilities.get_bin();
+      get_geometric_proj_matrix_elems_for_one_bin(probabilities, basic_bin);
+      probabilities.set_bin(basic_bin);
+      apply_tof_kernel(probabilities);
+    }
+  else
+    {
+      {
+        STIR_PROFILE_REGION("ProjMatrixByBin calculation");
+        calculate_proj_matrix_elems_for_one_bin(probabilities);
+      }
+#ifndef NDEBUG
+      probabilities.check_state();
+#endif
+    }
+}
 
+void
+ProjMatrixByBin::get_tof_LOR_middle_and_direction(CartesianCoordinate3D<float>& middle,
+                                                  CartesianCoordinate3D<float>& diff_unit_vector,
+                                                  const Bin& bin) const
+{
   LORInAxialAndNoArcCorrSinogramCoordinates<float> lor;
-  proj_data_info_sptr->get_LOR(lor, probabilities.get_bin());
+  proj_data_info_sptr->get_LOR(lor, bin);
   const LORAs2Points<float> lor2(lor);
   const CartesianCoordinate3D<float> point1 = lor2.p1();
   const CartesianCoordinate3D<float> point2 = lor2.p2();
 
   // The direction can be from 1 -> 2 depending on the bin sign.
-  const CartesianCoordinate3D<float> middle = (point1 + point2) * 0.5f;
+  middle = (point1 + point2) * 0.5f;
   const CartesianCoordinate3D<float> diff = point2 - middle;
-  const CartesianCoordinate3D<float> diff_unit_vector(diff / static_cast<float>(norm(diff)));
+  diff_unit_vector = diff / static_cast<float>(norm(diff));
+}
+
+void
+ProjMatrixByBin::apply_tof_kernel(ProjMatrixElemsForOneBin& probabilities) const
+{
+  CartesianCoordinate3D<float> middle;
+  CartesianCoordinate3D<float> diff_unit_vector;
+  get_tof_LOR_middle_and_direction(middle, diff_unit_vector, probabilities.get_bin());
 
   for (ProjMatrixElemsForOneBin::iterator element_ptr = probabilities.begin(); element_ptr != probabilities.end(); ++element_ptr)
     {
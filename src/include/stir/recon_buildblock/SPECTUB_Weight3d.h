@@ -66,36 +66,39 @@ void calc_vxprj(SPECTUB::angle_type* ang);
 
 void voxel_projection(SPECTUB::voxel_type* vox, float* eff, float lngcmd2, const SPECTUB::wmh_type& wmh);
 
-void fill_psf_no(SPECTUB::psf2da_type* psf,
-                 SPECTUB::psf1d_type* psf1d_h,
-                 const SPECTUB::voxel_type& vox,
-                 const angle_type* const ang,
-                 float szdx,
+// The fill_psf_* and calc_psf_bin functions return 0 on success, or an error number for error_weight3d()
+// (they do not call it themselves, as they are used inside parallel regions).
+
+int fill_psf_no(SPECTUB::psf2da_type* psf,
+                SPECTUB::psf1d_type* psf1d_h,
+                const SPECTUB::voxel_type& vox,
+                const angle_type* const ang,
+                float szdx,
+                const SPECTUB::wmh_type& wmh);
+
+int fill_psf_2d(SPECTUB::psf2da_type* psf,
+                SPECTUB::psf1d_type* psf1d_h,
+                const SPECTUB::voxel_type& vox,
+                SPECTUB::discrf_type const* const gaussdens,
+                float szdx,
+                const SPECTUB::wmh_type& wmh);
+
+int fill_psf_3d(SPECTUB::psf2da_type* psf,
+                SPECTUB::psf1d_type* psf1d_h,
+                SPECTUB::psf1d_type* psf1d_v,
+                const SPECTUB::voxel_type& vox,
+                SPECTUB::discrf_type const* const gaussdens,
+                float szdx,
+                float thdx,
+                float thcmd2,
+                const wmh_type& wmh);
+
+int calc_psf_bin(float center_psf,
+                 float binszcm,
+                 SPECTUB::discrf_type const* const vxprj,
+                 SPECTUB::psf1d_type* psf,
                  const SPECTUB::wmh_type& wmh);
 
-void fill_psf_2d(SPECTUB::psf2da_type* psf,
-                 SPECTUB::psf1d_type* psf1d_h,
-                 const SPECTUB::voxel_type& vox,
-                 SPECTUB::discrf_type const* const gaussdens,
-                 float szdx,
-                 const SPECTUB::wmh_type& wmh);
-
-void fill_psf_3d(SPECTUB::psf2da_type* psf,
-                 SPECTUB::psf1d_type* psf1d_h,
-                 SPECTUB::psf1d_type* psf1d_v,
-                 const SPECTUB::voxel_type& vox,
-                 SPECTUB::discrf_type const* const gaussdens,
-                 float szdx,
-                 float thdx,
-                 float thcmd2,
-                 const wmh_type& wmh);
-
-void calc_psf_bin(float center_psf,
-                  float binszcm,
-                  SPECTUB::discrf_type const* const vxprj,
-                  SPECTUB::psf1d_type* psf,
-                  const SPECTUB::wmh_type& wmh);
-
 //... attenuation...................................................
 
 // not used
@@ -103,7 +106,8 @@ void calc_psf_bin(float center_psf,
 
 // void size_attpth_full( psf2da_type *psf, voxel_type vox, volume_type vol, float *att, angle_type *ang );
 
-void
+// returns 0 on success, or an error number for error_weight3d()
+int
 calc_att_path(const bin_type& bin, const SPECTUB::voxel_type& vox, const SPECTUB::volume_type& vol, SPECTUB::attpth_type* attpth);
 
 float calc_att(const SPECTUB::attpth_type* const attpth, const float* const attmap, int islc, const SPECTUB::wmh_type& wmh);
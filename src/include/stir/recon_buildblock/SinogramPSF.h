@@ -0,0 +1,105 @@
+/*!
+  \file
+  \ingroup projection
+
+  \brief Declaration of class stir::SinogramPSF
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+#ifndef __stir_recon_buildblock_SinogramPSF__H__
+#define __stir_recon_buildblock_SinogramPSF__H__
+
+#include "stir/VectorWithOffset.h"
+
+START_NAMESPACE_STIR
+
+template <typename elemT>
+class Viewgram;
+class ProjDataInfo;
+
+/*!
+  \ingroup projection
+  \brief A separable Gaussian resolution model applied to viewgrams
+
+  The model consists of a tangential blurring (along \c s), followed by an axial blurring
+  (along the axial positions in a segment). The tangential FWHM can vary with the distance
+  of the LOR to the centre of the scanner:
+  \code
+  FWHM(s) = tangential_fwhm + tangential_fwhm_slope * |s|
+  \endcode
+  such that parallax effects can be modelled. The axial FWHM is constant. All kernels are
+  computed in set_up() (i.e. one kernel per tangential position, and one per segment), and
+  are normalised to 1. The tangential kernels are computed from the \c s coordinates of the
+  first view in segment 0.
+
+  apply_transpose() is the transpose of apply(), as needed for a matched back projector.
+  Both only use data within the given ranges (i.e. zero boundary conditions), and can be
+  called concurrently from multiple threads.
+*/
+class SinogramPSF
+{
+public:
+  //! Default constructor, results in a trivial PSF
+  SinogramPSF();
+  //! Constructor taking the FWHMs (in mm)
+  SinogramPSF(const float tangential_fwhm, const float axial_fwhm, const float tangential_fwhm_slope = 0.F);
+
+  //! Compute all kernels for the given projection data
+  void set_up(const ProjDataInfo& proj_data_info);
+
+  //! Returns true if the PSF does not modify the data
+  bool is_trivial() const;
+
+  //! Blur the viewgram in the given range
+  void apply(Viewgram<float>& viewgram,
+             const int min_axial_pos_num,
+             const int max_axial_pos_num,
+             const int min_tangential_pos_num,
+             const int max_tangential_pos_num) const;
+
+  //! Apply the transpose of the blurring to the viewgram in the given range
+  void apply_transpose(Viewgram<float>& viewgram,
+                       const int min_axial_pos_num,
+                       const int max_axial_pos_num,
+                       const int min_tangential_pos_num,
+                       const int max_tangential_pos_num) const;
+
+  //! \name get/set the FWHMs (in mm)
+  /*! The set_ functions require calling set_up() afterwards. */
+  //@{
+  float get_tangential_fwhm() const;
+  void set_tangential_fwhm(const float);
+  float get_tangential_fwhm_slope() const;
+  void set_tangential_fwhm_slope(const float);
+  float get_axial_fwhm() const;
+  void set_axial_fwhm(const float);
+  //@}
+
+private:
+  float tangential_fwhm;
+  float tangential_fwhm_slope;
+  float axial_fwhm;
+  bool _already_set_up;
+
+  //! kernels for every output tangential position \c t, index \c j refers to input tangential position \c t-j
+  VectorWithOffset<VectorWithOffset<float>> tangential_kernels;
+  //! (symmetric) kernels for every segment, index \c j refers to an offset in axial positions
+  VectorWithOffset<VectorWithOffset<float>> axial_kernels;
+
+  void check_set_up(const Viewgram<float>&) const;
+  void apply_axial(Viewgram<float>& viewgram,
+                   const int min_axial_pos_num,
+                   const int max_axial_pos_num,
+                   const int min_tangential_pos_num,
+                   const int max_tangential_pos_num) const;
+};
+
+END_NAMESPACE_STIR
+
+#endif
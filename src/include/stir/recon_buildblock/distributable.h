@@ -29,6 +29,7 @@
 #include "stir/shared_ptr.h"
 #include "stir/Bin.h"
 #include <vector>
+#include <string>
 
 START_NAMESPACE_STIR
 
@@ -41,6 +42,7 @@ class ProjData;
 class ProjDataInfo;
 class ExamInfo;
 class DataSymmetriesForViewSegmentNumbers;
+class ViewSegmentNumbers;
 class ForwardProjectorByBin;
 class BackProjectorByBin;
 class ProjectorByBinPair;
@@ -52,7 +54,9 @@ class ProjMatrixByBin;
 //!@{
 const int task_stop_processing = 0;
 const int task_setup_distributable_computation = 200;
-const int task_do_distributable_gradient_computation = 42;
+const int task_setup_distributable_local_data = 201;
+const int task_do_distributable_gradient_computation = 42; //!< gradient with \c add_sensitivity = \c true
+const int task_do_distributable_gradient_computation_without_adding_sensitivity = 45; //!< \c add_sensitivity = \c false
 const int task_do_distributable_loglikelihood_computation = 43;
 const int task_do_distributable_sensitivity_computation = 44;
 //!@}
@@ -73,6 +77,28 @@ void setup_distributable_computation(const shared_ptr<ProjectorByBinPair>& proj_
                                      const bool zero_seg0_end_planes,
                                      const bool distributed_cache_enabled);
 
+//! let the workers read the projection data themselves
+/*!
+    \ingroup distributable
+    Empty unless STIR_MPI is defined, in which case it sends the file names of the measured and
+    additive projection data and the normalisation (as registered name and parameters) to the
+    slaves (see stir::DistributedWorker), which then read them once. Subsequent calls to
+    distributable_computation() with the same \a proj_data_sptr (and the same additive data and normalisation,
+    or none) send only the view/segment and timing position numbers to the slaves, instead of the
+    (related) viewgrams. Otherwise, the viewgrams are sent as usual.
+
+    Has to be called after setup_distributable_computation(). An empty \a proj_data_filename
+    disables reading by the slaves, and an empty \a additive_proj_data_filename means that the additive data
+    are not available to the slaves.
+
+    \warning The files need to be accessible by all processes (e.g. on a shared file system).
+*/
+void setup_distributable_computation_local_data(const shared_ptr<ProjData>& proj_data_sptr,
+                                                const std::string& proj_data_filename,
+                                                const shared_ptr<ProjData>& additive_proj_data_sptr,
+                                                const std::string& additive_proj_data_filename,
+                                                const shared_ptr<BinNormalisation>& normalisation_sptr);
+
 //! clean-up after a sequence of computations
 /*! \ingroup distributable
       Empty unless STIR_MPI is defined, in which case it sends the "stop" task to
@@ -182,6 +208,28 @@ void distributable_computation(const shared_ptr<ForwardProjectorByBin>& forward_
                                int min_timing_pos_num,
                                int max_timing_pos_num);
 
+namespace detail
+{
+//! get the related viewgrams (and multiplicative and additive viewgrams) for one step of distributable_computation()
+/*! \ingroup distributable
+    Also used by stir::DistributedWorker when the slaves read the data themselves.
+    \see distributable_computation() for the meaning of the arguments
+*/
+void get_viewgrams_for_distributable_computation(shared_ptr<RelatedViewgrams<float>>& y,
+                                                 shared_ptr<RelatedViewgrams<float>>& additive_binwise_correction_viewgrams,
+                                                 shared_ptr<RelatedViewgrams<float>>& mult_viewgrams_sptr,
+                                                 const shared_ptr<ProjData>& proj_dat_ptr,
+                                                 const bool read_from_proj_dat,
+                                                 const bool zero_seg0_end_planes,
+                                                 const shared_ptr<ProjData>& binwise_correction,
+                                                 const shared_ptr<BinNormalisation>& normalisation_sptr,
+                                                 const double start_time_of_frame,
+                                                 const double end_time_of_frame,
+                                                 const shared_ptr<DataSymmetriesForViewSegmentNumbers>& symmetries_ptr,
+                                                 const ViewSegmentNumbers& view_segment_num,
+                                                 const int timing_pos_num);
+} // namespace detail
+
 /*!
   \brief This function essentially implements a loop over a cached listmode file
   \ingroup distributable
@@ -216,8 +264,11 @@ const int BINWISE_CORRECTION_TAG = 6;
 const int BINWISE_MULT_TAG = 66;
 const int REUSE_VIEWGRAM_TAG = 10;
 const int NEW_VIEWGRAM_TAG = 11;
+const int READ_VIEWGRAM_TAG = 12;
 const int USE_DOUBLE_ARG_TAG = 70;
 const int USE_OUTPUT_IMAGE_ARG_TAG = 71;
+const int USE_LOCAL_DATA_TAG = 72;
+const int LOCAL_DATA_FILENAME_TAG = 73;
 
 //!@}
 
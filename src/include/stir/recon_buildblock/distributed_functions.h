@@ -384,25 +384,15 @@ void receive_and_construct_viewgram(stir::Viewgram<float>*& viewgram,
 
 //-----------------------reduce operations-------------------------------------
 
-/*! \brief the function called by the master to reduce the output image
- * \param output_image_ptr the image pointer where the reduced image is saved
- * \param destination the process id where the output_image is reduced
- */
-void reduce_received_output_image(stir::DiscretisedDensity<3, float>* output_image_ptr, int destination);
-
-/*! \brief the function called by the slaves to reduce the output image
- * \param output_image_ptr the image pointer where the reduced image is saved
- * \param image_buffer_size the buffer size needed for the image
- * \param my_rank rank of the slave, only used for screen output
- * \param destination the process id where the output_image is reduced
+/*! \brief the function called by the master to reduce the results of a distributable computation
+ * \param output_image_ptr if not null, the image where the reduced image is saved
+ * \param log_likelihood_ptr if not null, where the reduced log-likelihood is saved
  *
- * The buffer size was calculated in \c receive_image_values_and_fill_image_ptr().
- * Alternatively it can be calculated by the image parameters.
+ * The log-likelihood, the rpc-time (if \c rpc_time is set) and the output image are reduced (in this order)
+ * with non-blocking reductions (\c MPI_Ireduce) that are all completed at the end. The slaves have to start
+ * the same reductions in the same order (see DistributedWorker).
  */
-void reduce_output_image(stir::shared_ptr<stir::DiscretisedDensity<3, float>>& output_image_ptr,
-                         int image_buffer_size,
-                         int my_rank,
-                         int destination);
+void reduce_received_results(stir::DiscretisedDensity<3, float>* output_image_ptr, double* log_likelihood_ptr);
 
 /*! \name Tag-names currently used by functions in the distributed namespace
  */
@@ -46,6 +46,7 @@ START_NAMESPACE_STIR
 template <class TargetT>
 class PostFiltering;
 class BinNormalisation;
+class InterpolateProjDataCache;
 
 //! A struct to hold the parameters for image masking.
 struct MaskingParameters
@@ -95,6 +96,9 @@ public:
   5. apply thresholds
   6. filter scale-factors in axial direction (independently for every segment)
   7. apply scale factors using scale_sinograms()
+
+  If \a interpolation_cache_ptr is not null, it is passed to interpolate_projdata(), such that interpolation
+  weights can be reused between calls (e.g. in every scatter iteration).
 */
   static void upsample_and_fit_scatter_estimate(ProjData& scaled_scatter_proj_data,
                                                 const ProjData& emission_proj_data,
@@ -105,7 +109,8 @@ public:
                                                 const float max_scale_factor,
                                                 const unsigned half_filter_width,
                                                 BSpline::BSplineType spline_type = BSpline::BSplineType::linear,
-                                                const bool remove_interleaving = true);
+                                                const bool remove_interleaving = true,
+                                                InterpolateProjDataCache* interpolation_cache_ptr = nullptr);
 
   //! Default constructor (calls set_defaults())
   ScatterEstimation();
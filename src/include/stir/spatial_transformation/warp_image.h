@@ -30,6 +30,18 @@ VoxelsOnCartesianGrid<float> warp_image(const shared_ptr<DiscretisedDensity<3, f
                                         const BSpline::BSplineType spline_type,
                                         const bool extend_borders);
 
+//! Warp an image and add the result to \a out_density
+/*! This gives the same result as adding the output of warp_image() to \a out_density,
+    but avoids allocating a temporary image. All images need to have the same
+    (regular) index range. \a density has to be a DiscretisedDensityOnCartesianGrid.
+*/
+void warp_and_accumulate_image(DiscretisedDensity<3, float>& out_density,
+                               const DiscretisedDensity<3, float>& density,
+                               const DiscretisedDensity<3, float>& motion_x,
+                               const DiscretisedDensity<3, float>& motion_y,
+                               const DiscretisedDensity<3, float>& motion_z,
+                               const BSpline::BSplineType spline_type);
+
 END_NAMESPACE_STIR
 
 #endif
@@ -44,6 +44,7 @@
 #include "stir/ViewSegmentNumbers.h"
 #include "stir/info.h"
 #include "stir/error.h"
+#include "stir/Profiler.h"
 
 #include "stir/modelling/ParametricDiscretisedDensity.h"
 #include "stir/modelling/KineticParameters.h"
@@ -388,8 +389,11 @@ OSMAPOSLReconstruction<TargetT>::update_estimate(TargetT& current_image_estimate
   const int subset_num = this->get_subset_num();
   info(boost::format("Now processing subset #: %1%") % subset_num);
 
-  this->compute_sub_gradient_without_penalty_plus_sensitivity(
-      *multiplicative_update_image_ptr, current_image_estimate, subset_num);
+  {
+    STIR_PROFILE_REGION("objective function gradient");
+    this->compute_sub_gradient_without_penalty_plus_sensitivity(
+        *multiplicative_update_image_ptr, current_image_estimate, subset_num);
+  }
 
   // divide by subset sensitivity
   {
@@ -410,7 +414,10 @@ OSMAPOSLReconstruction<TargetT>::update_estimate(TargetT& current_image_estimate
       {
         unique_ptr<TargetT> denominator_ptr(current_image_estimate.get_empty_copy());
 
-        this->objective_function_sptr->get_prior_ptr()->compute_gradient(*denominator_ptr, current_image_estimate);
+        {
+          STIR_PROFILE_REGION("prior gradient");
+          this->objective_function_sptr->get_prior_ptr()->compute_gradient(*denominator_ptr, current_image_estimate);
+        }
 
         typename TargetT::full_iterator denominator_iter = denominator_ptr->begin_all();
         const typename TargetT::full_iterator denominator_end = denominator_ptr->end_all();
@@ -470,6 +477,7 @@ OSMAPOSLReconstruction<TargetT>::update_estimate(TargetT& current_image_estimate
       && !(this->subiteration_num % this->inter_update_filter_interval))
     {
       info("Applying inter-update filter");
+      STIR_PROFILE_REGION("inter-update filter");
       this->inter_update_filter_ptr->apply(current_image_estimate);
     }
 
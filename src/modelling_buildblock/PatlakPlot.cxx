@@ -18,9 +18,9 @@
 */
 
 #include "stir/modelling/PatlakPlot.h"
-#include "stir/linear_regression.h"
 #include "stir/warning.h"
 #include "stir/error.h"
+#include <vector>
 
 START_NAMESPACE_STIR
 
@@ -159,89 +159,112 @@ PatlakPlot::set_up()
 }
 
 void
-PatlakPlot::apply_linear_regression(ParametricVoxelsOnCartesianGrid& par_image, const DynamicDiscretisedDensity& dyn_image) const
+PatlakPlot::scale_model_matrix_if_necessary(const DiscretisedDensity<3, float>& image, const float scanner_default_bin_size) const
 {
-  if (!this->_in_correct_scale)
-    {
+  if (this->_model_matrix.get_is_in_correct_scale())
+    return;
 #ifndef NDEBUG
-      this->_model_matrix.write_to_file("patlak_matrix_not_in_correct_scale.txt");
+  this->_model_matrix.write_to_file("patlak_matrix_not_in_correct_scale.txt");
 #endif // NDEBUG
-      const DiscretisedDensityOnCartesianGrid<3, float>* image_cartesian_ptr
-          = dynamic_cast<DiscretisedDensityOnCartesianGrid<3, float>*>(((dyn_image.get_densities())[0]).get());
-      const BasicCoordinate<3, float> this_grid_spacing = image_cartesian_ptr->get_grid_spacing();
-      if (dyn_image.get_scanner_default_bin_size() <= 0)
-        error("PatlakPlot: The dynamic image currently needs to know the Scanner's default_bin_size. Did you set the "
-              "'originating system'?");
-      this->_model_matrix.scale_model_matrix(this_grid_spacing[2] / dyn_image.get_scanner_default_bin_size());
+  const DiscretisedDensityOnCartesianGrid<3, float>* image_cartesian_ptr
+      = dynamic_cast<const DiscretisedDensityOnCartesianGrid<3, float>*>(&image);
+  const BasicCoordinate<3, float> this_grid_spacing = image_cartesian_ptr->get_grid_spacing();
+  if (scanner_default_bin_size <= 0)
+    error("PatlakPlot: The dynamic image currently needs to know the Scanner's default_bin_size. Did you set the "
+          "'originating system'?");
+  this->_model_matrix.scale_model_matrix(this_grid_spacing[2] / scanner_default_bin_size);
 #ifndef NDEBUG
-      this->_model_matrix.write_to_file("patlak_matrix_in_correct_scale.txt");
+  this->_model_matrix.write_to_file("patlak_matrix_in_correct_scale.txt");
 #endif // NDEBUG
-    }
+}
+
+void
+PatlakPlot::apply_linear_regression(ParametricVoxelsOnCartesianGrid& par_image, const DynamicDiscretisedDensity& dyn_image) const
+{
+  if (!this->_in_correct_scale)
+    this->scale_model_matrix_if_necessary(*(dyn_image.get_densities())[0], dyn_image.get_scanner_default_bin_size());
   //  const DynamicDiscretisedDensity & dyn_image=this->_dyn_image;
   // TODO check consistency of time-frame definitions
   const unsigned int num_frames = (this->_frame_defs).get_num_frames();
-  unsigned int frame_num;
-  unsigned int starting_frame = this->_starting_frame;
-  Array<2, float> patlak_model_array = this->_model_matrix.get_model_array();
-  VectorWithOffset<float> patlak_x(starting_frame - 1, num_frames - 1);
-  VectorWithOffset<float> patlak_y(starting_frame - 1, num_frames - 1);
-  VectorWithOffset<float> weights(starting_frame - 1, num_frames - 1);
+  const unsigned int starting_frame = this->_starting_frame;
+  const Array<2, float> patlak_model_array = this->_model_matrix.get_model_array();
 
   // Patlak Linear regression is applied to the data in the format:
   // C(t)/Cp(t)=Ki*\int{Cp(t)}/Cp(t)+Vb
   // therefore our "x" value for the regression is \int{Cp(t)}/Cp(t)  (which we know from the model)
+  // and our "y" value is C(t)/Cp(t). C(t) is the dynamic image value.
   //
   // NOTE: as we are working in time frames, and not discrete time points, Cp(t) is not a value of Cp at a given single time, t,
   // but instead
   //       it is the integral of Cp on that time frame , \int_{t_start}^{t_end} Cp(t) dt, for each time frame. The same happens
   //       with \int{Cp(t)} All this is handled in the PlasmaData class, and it's not visible here.
+  //
+  // As "x" and the weights (currently all 1) are the same for every voxel, the (weighted) least-squares solution
+  // is linear in the dynamic image values:
+  //    slope = sum_f slope_coeffs[f] C_f,  y_intersection = sum_f y_intersection_coeffs[f] C_f
+  // We compute these coefficients once (giving the same result as linear_regression), such that the fit
+  // for every voxel is only a weighted sum over frames.
+  VectorWithOffset<double> patlak_x(starting_frame, num_frames);
+  VectorWithOffset<double> weights(starting_frame, num_frames);
+  double sum_weights = 0.;
+  double sum_weights_x = 0.;
+  for (unsigned int frame_num = starting_frame; frame_num <= num_frames; ++frame_num)
+    {
+      patlak_x[frame_num] = static_cast<double>(patlak_model_array[1][frame_num]) / patlak_model_array[2][frame_num];
+      weights[frame_num] = 1.;
+      sum_weights += weights[frame_num];
+      sum_weights_x += weights[frame_num] * patlak_x[frame_num];
+    }
+  const double mean_x = sum_weights_x / sum_weights;
+  double sum_weights_dx_squared = 0.;
+  for (unsigned int frame_num = starting_frame; frame_num <= num_frames; ++frame_num)
+    sum_weights_dx_squared += weights[frame_num] * square(patlak_x[frame_num] - mean_x);
+  if (sum_weights_dx_squared <= 0.)
+    error("PatlakPlot::apply_linear_regression: need at least 2 frames with different Patlak x-values");
+
+  VectorWithOffset<double> slope_coeffs(starting_frame, num_frames);
+  VectorWithOffset<double> y_intersection_coeffs(starting_frame, num_frames);
   for (unsigned int frame_num = starting_frame; frame_num <= num_frames; ++frame_num)
     {
-      patlak_x[frame_num - 1] = patlak_model_array[1][frame_num] / patlak_model_array[2][frame_num];
-      weights[frame_num - 1] = 1;
+      const double cp = patlak_model_array[2][frame_num];
+      slope_coeffs[frame_num] = weights[frame_num] * (patlak_x[frame_num] - mean_x) / (sum_weights_dx_squared * cp);
+      y_intersection_coeffs[frame_num] = weights[frame_num] / (sum_weights * cp) - mean_x * slope_coeffs[frame_num];
+    }
+
+  // Do linear_regression for each voxel, accumulating over frames for a whole row at a time
+  const int min_k_index = dyn_image[1].get_min_index();
+  const int max_k_index = dyn_image[1].get_max_index();
+#ifdef STIR_OPENMP
+#  pragma omp parallel for
+#endif
+  for (int k = min_k_index; k <= max_k_index; ++k)
+    {
+      const int min_j_index = dyn_image[1][k].get_min_index();
+      const int max_j_index = dyn_image[1][k].get_max_index();
+      for (int j = min_j_index; j <= max_j_index; ++j)
+        {
+          const int min_i_index = dyn_image[1][k][j].get_min_index();
+          const int max_i_index = dyn_image[1][k][j].get_max_index();
+          std::vector<double> slopes(max_i_index - min_i_index + 1, 0.);
+          std::vector<double> y_intersections(max_i_index - min_i_index + 1, 0.);
+          for (unsigned int frame_num = starting_frame; frame_num <= num_frames; ++frame_num)
+            {
+              const Array<1, float>& row = dyn_image[frame_num][k][j];
+              const double slope_coeff = slope_coeffs[frame_num];
+              const double y_intersection_coeff = y_intersection_coeffs[frame_num];
+              for (int i = min_i_index; i <= max_i_index; ++i)
+                {
+                  slopes[i - min_i_index] += slope_coeff * row[i];
+                  y_intersections[i - min_i_index] += y_intersection_coeff * row[i];
+                }
+            }
+          for (int i = min_i_index; i <= max_i_index; ++i)
+            {
+              par_image[k][j][i][2] = static_cast<float>(y_intersections[i - min_i_index]);
+              par_image[k][j][i][1] = static_cast<float>(slopes[i - min_i_index]);
+            }
+        }
     }
-  { // Do linear_regression for each voxel // for k j i
-    float slope = 0.F;
-    float y_intersection = 0.F;
-    float variance_of_slope = 0.F;
-    float variance_of_y_intersection = 0.F;
-    float covariance_of_y_intersection_with_slope = 0.F;
-    float chi_square = 0.F;
-
-    const int min_k_index = dyn_image[1].get_min_index();
-    const int max_k_index = dyn_image[1].get_max_index();
-    for (int k = min_k_index; k <= max_k_index; ++k)
-      {
-        const int min_j_index = dyn_image[1][k].get_min_index();
-        const int max_j_index = dyn_image[1][k].get_max_index();
-        for (int j = min_j_index; j <= max_j_index; ++j)
-          {
-            const int min_i_index = dyn_image[1][k][j].get_min_index();
-            const int max_i_index = dyn_image[1][k][j].get_max_index();
-            for (int i = min_i_index; i <= max_i_index; ++i)
-              {
-                // Patlak Linear regression is applied to the data in the format:
-                // C(t)/Cp(t)=Ki*\int{Cp(t)}/Cp(t)+Vb
-                // therefore our "y" value for the regression is C(t)/Cp(t). C(t) is the dynamic image value.
-                // (remember, these are integrals over the time frame, not single values at discrete t)
-                for (frame_num = starting_frame; frame_num <= num_frames; ++frame_num)
-                  patlak_y[frame_num - 1] = dyn_image[frame_num][k][j][i] / patlak_model_array[2][frame_num];
-                // Apply the regression to this pixel
-                linear_regression(y_intersection,
-                                  slope,
-                                  chi_square,
-                                  variance_of_y_intersection,
-                                  variance_of_slope,
-                                  covariance_of_y_intersection_with_slope,
-                                  patlak_y,
-                                  patlak_x,
-                                  weights);
-                par_image[k][j][i][2] = y_intersection;
-                par_image[k][j][i][1] = slope;
-              }
-          }
-      }
-  }
 }
 
 void
@@ -249,21 +272,7 @@ PatlakPlot::multiply_dynamic_image_with_model_gradient(ParametricVoxelsOnCartesi
                                                        const DynamicDiscretisedDensity& dyn_image) const
 {
   if (!this->_in_correct_scale)
-    {
-#ifndef NDEBUG
-      this->_model_matrix.write_to_file("patlak_matrix_not_in_correct_scale.txt");
-#endif // NDEBUG
-      const DiscretisedDensityOnCartesianGrid<3, float>* image_cartesian_ptr
-          = dynamic_cast<DiscretisedDensityOnCartesianGrid<3, float>*>(((dyn_image.get_densities())[0]).get());
-      const BasicCoordinate<3, float> this_grid_spacing = image_cartesian_ptr->get_grid_spacing();
-      if (dyn_image.get_scanner_default_bin_size() <= 0)
-        error("PatlakPlot: The dynamic image currently needs to know the Scanner's default_bin_size. Did you set the "
-              "'originating system'?");
-      this->_model_matrix.scale_model_matrix(this_grid_spacing[2] / dyn_image.get_scanner_default_bin_size());
-#ifndef NDEBUG
-      this->_model_matrix.write_to_file("patlak_matrix_in_correct_scale.txt");
-#endif // NDEBUG
-    }
+    this->scale_model_matrix_if_necessary(*(dyn_image.get_densities())[0], dyn_image.get_scanner_default_bin_size());
   this->_model_matrix.multiply_dynamic_image_with_model(par_image, dyn_image);
 }
 
@@ -272,21 +281,7 @@ PatlakPlot::multiply_dynamic_image_with_model_gradient_and_add_to_input(Parametr
                                                                         const DynamicDiscretisedDensity& dyn_image) const
 {
   if (!this->_in_correct_scale)
-    {
-#ifndef NDEBUG
-      this->_model_matrix.write_to_file("patlak_matrix_not_in_correct_scale.txt");
-#endif // NDEBUG
-      const DiscretisedDensityOnCartesianGrid<3, float>* image_cartesian_ptr
-          = dynamic_cast<DiscretisedDensityOnCartesianGrid<3, float>*>(((dyn_image.get_densities())[0]).get());
-      const BasicCoordinate<3, float> this_grid_spacing = image_cartesian_ptr->get_grid_spacing();
-      if (dyn_image.get_scanner_default_bin_size() <= 0)
-        error("PatlakPlot: The dynamic image currently needs to know the Scanner's default_bin_size. Did you set the "
-              "'originating system'?");
-      this->_model_matrix.scale_model_matrix(this_grid_spacing[2] / dyn_image.get_scanner_default_bin_size());
-#ifndef NDEBUG
-      this->_model_matrix.write_to_file("patlak_matrix_in_correct_scale.txt");
-#endif // NDEBUG
-    }
+    this->scale_model_matrix_if_necessary(*(dyn_image.get_densities())[0], dyn_image.get_scanner_default_bin_size());
   this->_model_matrix.multiply_dynamic_image_with_model_and_add_to_input(par_image, dyn_image);
 }
 // Should be a virtual function declared in the KineticModels or better to the LinearModels
@@ -295,25 +290,35 @@ PatlakPlot::get_dynamic_image_from_parametric_image(DynamicDiscretisedDensity& d
                                                     const ParametricVoxelsOnCartesianGrid& par_image) const
 {
   if (!this->_in_correct_scale)
-    {
-#ifndef NDEBUG
-      this->_model_matrix.write_to_file("patlak_matrix_not_in_correct_scale.txt");
-#endif // NDEBUG
-      const DiscretisedDensityOnCartesianGrid<3, float>* image_cartesian_ptr
-          = dynamic_cast<DiscretisedDensityOnCartesianGrid<3, float>*>(((dyn_image.get_densities())[0]).get());
-      const BasicCoordinate<3, float> this_grid_spacing = image_cartesian_ptr->get_grid_spacing();
-      if (dyn_image.get_scanner_default_bin_size() <= 0)
-        error("PatlakPlot: The dynamic image currently needs to know the Scanner's default_bin_size. Did you set the "
-              "'originating system'?");
-      this->_model_matrix.scale_model_matrix(this_grid_spacing[2] / dyn_image.get_scanner_default_bin_size());
-#ifndef NDEBUG
-      this->_model_matrix.write_to_file("patlak_matrix_in_correct_scale.txt");
-#endif // NDEBUG
-    }
+    this->scale_model_matrix_if_necessary(*(dyn_image.get_densities())[0], dyn_image.get_scanner_default_bin_size());
 
   this->_model_matrix.multiply_parametric_image_with_model(dyn_image, par_image);
 }
 
+void
+PatlakPlot::get_frame_image_from_parametric_image(DiscretisedDensity<3, float>& frame_image,
+                                                  const ParametricVoxelsOnCartesianGrid& par_image,
+                                                  const unsigned int frame_num,
+                                                  const float scanner_default_bin_size) const
+{
+  if (!this->_in_correct_scale)
+    this->scale_model_matrix_if_necessary(frame_image, scanner_default_bin_size);
+
+  this->_model_matrix.multiply_parametric_image_with_model_for_frame(frame_image, par_image, frame_num);
+}
+
+void
+PatlakPlot::multiply_frame_image_with_model_gradient_and_add_to_input(ParametricVoxelsOnCartesianGrid& par_image,
+                                                                      const DiscretisedDensity<3, float>& frame_image,
+                                                                      const unsigned int frame_num,
+                                                                      const float scanner_default_bin_size) const
+{
+  if (!this->_in_correct_scale)
+    this->scale_model_matrix_if_necessary(frame_image, scanner_default_bin_size);
+
+  this->_model_matrix.multiply_frame_image_with_model_and_add_to_input(par_image, frame_image, frame_num);
+}
+
 unsigned int
 PatlakPlot::get_starting_frame() const
 {
@@ -31,6 +31,7 @@
 #include "stir/error.h"
 #include "stir/is_null_ptr.h"
 #include "stir/DataProcessor.h"
+#include "stir/Profiler.h"
 #include <vector>
 #ifdef STIR_OPENMP
 #  include "stir/is_null_ptr.h"
@@ -197,37 +198,76 @@ BackProjectorByBin::back_project(const ProjData& proj_data, int subset_num, int
                                              subset_num,
                                              num_subsets);
 
+  const int min_tof_pos_num = proj_data.get_proj_data_info_sptr()->get_min_tof_pos_num();
+  const int max_tof_pos_num = proj_data.get_proj_data_info_sptr()->get_max_tof_pos_num();
+  // Loop over view/segments only, and handle all TOF bins together (see back_project_all_timing_positions()).
+  // There is therefore no need to parallelise over TOF bins as well.
 #ifdef STIR_OPENMP
-#  if _OPENMP < 201107
-#    pragma omp parallel for shared(proj_data, symmetries_sptr) schedule(dynamic)
-#  else
-// OpenMP loop over both vs_nums_to_process and tof_pos_num
-#    pragma omp parallel for shared(proj_data, symmetries_sptr) schedule(dynamic) collapse(2)
-#  endif
+#  pragma omp parallel for shared(proj_data, symmetries_sptr) schedule(dynamic)
 #endif
   // note: older versions of openmp need an int as loop
   for (int i = 0; i < static_cast<int>(vs_nums_to_process.size()); ++i)
     {
-      for (int k = proj_data.get_proj_data_info_sptr()->get_min_tof_pos_num();
-           k <= proj_data.get_proj_data_info_sptr()->get_max_tof_pos_num();
-           ++k)
-        {
-          const ViewSegmentNumbers vs = vs_nums_to_process[i];
+      const ViewSegmentNumbers vs = vs_nums_to_process[i];
+      std::vector<RelatedViewgrams<float>> viewgrams_for_all_timing_positions;
+      viewgrams_for_all_timing_positions.reserve(max_tof_pos_num - min_tof_pos_num + 1);
 #ifdef STIR_OPENMP
-          RelatedViewgrams<float> viewgrams;
 #  pragma omp critical(BACKPROJECTORBYBIN_GETVIEWGRAMS)
-          viewgrams = proj_data.get_related_viewgrams(vs, symmetries_sptr, false, k);
-          info(boost::format("Processing view %1% of segment %2%, TOF bin %3%") % vs.view_num() % vs.segment_num() % k, 3);
-#else
-          const RelatedViewgrams<float> viewgrams = proj_data.get_related_viewgrams(vs, symmetries_sptr, false, k);
-          info(boost::format("Processing view %1% of segment %2%, TOF bin %3%") % vs.view_num() % vs.segment_num() % k, 3);
 #endif
+      {
+        for (int k = min_tof_pos_num; k <= max_tof_pos_num; ++k)
+          viewgrams_for_all_timing_positions.push_back(proj_data.get_related_viewgrams(vs, symmetries_sptr, false, k));
+      }
+      if (proj_data.get_proj_data_info_sptr()->is_tof_data())
+        info(boost::format("Processing view %1% of segment %2% for all TOF bins") % vs.view_num() % vs.segment_num(), 3);
+      else
+        info(boost::format("Processing view %1% of segment %2%") % vs.view_num() % vs.segment_num(), 3);
 
-          back_project(viewgrams);
-        }
+      back_project_all_timing_positions(viewgrams_for_all_timing_positions);
     }
 }
 
+void
+BackProjectorByBin::back_project_all_timing_positions(
+    const std::vector<RelatedViewgrams<float>>& viewgrams_for_all_timing_positions)
+{
+  if (viewgrams_for_all_timing_positions.empty() || viewgrams_for_all_timing_positions[0].get_num_viewgrams() == 0)
+    return;
+  // all elements are for the same view/segment, so checking the first one is enough
+  check_related_viewgrams(viewgrams_for_all_timing_positions[0]);
+  // make sure the image for this thread exists
+  get_output_image_for_current_thread();
+  STIR_PROFILE_REGION("back projection");
+  actual_back_project_all_timing_positions(viewgrams_for_all_timing_positions);
+}
+
+void
+BackProjectorByBin::actual_back_project_all_timing_positions(
+    const std::vector<RelatedViewgrams<float>>& viewgrams_for_all_timing_positions)
+{
+  for (std::vector<RelatedViewgrams<float>>::const_iterator iter = viewgrams_for_all_timing_positions.begin();
+       iter != viewgrams_for_all_timing_positions.end();
+       ++iter)
+    actual_back_project(*iter,
+                        iter->get_min_axial_pos_num(),
+                        iter->get_max_axial_pos_num(),
+                        iter->get_min_tangential_pos_num(),
+                        iter->get_max_tangential_pos_num());
+}
+
+DiscretisedDensity<3, float>&
+BackProjectorByBin::get_output_image_for_current_thread()
+{
+#ifdef STIR_OPENMP
+  const int thread_num = omp_get_thread_num();
+  if (is_null_ptr(_local_output_image_sptrs[thread_num]))
+    _local_output_image_sptrs[thread_num].reset(_density_sptr->get_empty_copy());
+  return *_local_output_image_sptrs[thread_num];
+#else
+  return *_density_sptr;
+#endif
+}
+
 void
 BackProjectorByBin::back_project(const RelatedViewgrams<float>& viewgrams)
 {
@@ -260,18 +300,24 @@ BackProjectorByBin::back_project(const RelatedViewgrams<float>& viewgrams,
   if (viewgrams.get_num_viewgrams() == 0)
     return;
 
+  check_related_viewgrams(viewgrams);
+
+  // make sure the image for this thread exists
+  get_output_image_for_current_thread();
+
+  STIR_PROFILE_REGION("back projection");
+  actual_back_project(viewgrams, min_axial_pos_num, max_axial_pos_num, min_tangential_pos_num, max_tangential_pos_num);
+}
+
+void
+BackProjectorByBin::check_related_viewgrams(const RelatedViewgrams<float>& viewgrams) const
+{
   if (!_density_sptr)
     error("You need to call start_accumulating_in_new_target() before back_project()");
 
   check(*viewgrams.get_proj_data_info_sptr());
 
-#ifdef STIR_OPENMP
-  const int thread_num = omp_get_thread_num();
-  if (is_null_ptr(_local_output_image_sptrs[thread_num]))
-    _local_output_image_sptrs[thread_num].reset(_density_sptr->get_empty_copy());
-#endif
-
-  // first check symmetries
+  // check symmetries
   {
     const ViewSegmentNumbers basic_vs = viewgrams.get_basic_view_segment_num();
 
@@ -288,8 +334,6 @@ BackProjectorByBin::back_project(const RelatedViewgrams<float>& viewgrams,
           error("BackProjectorByBin::back_project called with incorrect related_viewgrams. Problem with symmetries!\n");
       }
   }
-
-  actual_back_project(viewgrams, min_axial_pos_num, max_axial_pos_num, min_tangential_pos_num, max_tangential_pos_num);
 }
 
 void
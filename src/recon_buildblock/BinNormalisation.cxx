@@ -27,6 +27,7 @@
 #include "stir/is_null_ptr.h"
 #include "stir/Succeeded.h"
 #include "stir/error.h"
+#include "stir/Profiler.h"
 #include <boost/format.hpp>
 
 START_NAMESPACE_STIR
@@ -160,7 +161,10 @@ BinNormalisation::apply(ProjData& proj_data, shared_ptr<DataSymmetriesForViewSeg
             viewgrams = proj_data.get_related_viewgrams(vs, symmetries_sptr, false, k);
           }
 
-          this->apply(viewgrams);
+          {
+            STIR_PROFILE_REGION("normalisation");
+            this->apply(viewgrams);
+          }
 
 #ifdef STIR_OPENMP
 #  pragma omp critical(BINNORMALISATION_APPLY__VIEWGRAMS)
@@ -208,7 +212,10 @@ BinNormalisation::undo(ProjData& proj_data, shared_ptr<DataSymmetriesForViewSegm
             viewgrams = proj_data.get_related_viewgrams(vs, symmetries_sptr, false, k);
           }
 
-          this->undo(viewgrams);
+          {
+            STIR_PROFILE_REGION("normalisation");
+            this->undo(viewgrams);
+          }
 
 #ifdef STIR_OPENMP
 #  pragma omp critical(BINNORMALISATION_UNDO__VIEWGRAMS)
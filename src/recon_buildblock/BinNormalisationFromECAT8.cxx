@@ -143,6 +143,8 @@ BinNormalisationFromECAT8::set_defaults()
   this->_use_crystal_interference_factors = true;
   this->_use_axial_effects_factors = true;
   this->_write_components_to_file = false;
+  this->_precompute_efficiencies = false;
+  this->uncalibrated_efficiencies_sptr.reset();
 }
 
 void
@@ -161,6 +163,7 @@ BinNormalisationFromECAT8::initialise_keymap()
   this->parser.add_key("use_crystal_interference_factors", &this->_use_crystal_interference_factors);
   this->parser.add_key("use_axial_effects_factors", &this->_use_axial_effects_factors);
   this->parser.add_key("write_components_to_file", &this->_write_components_to_file);
+  this->parser.add_key("precompute_efficiencies", &this->_precompute_efficiencies);
   this->parser.add_stop_key("End Bin Normalisation From ECAT8");
 }
 
@@ -192,6 +195,7 @@ BinNormalisationFromECAT8::set_up(const shared_ptr<const ExamInfo>& exam_info_sp
                                   const shared_ptr<const ProjDataInfo>& proj_data_info_ptr_v)
 {
   base_type::set_up(exam_info_sptr_v, proj_data_info_ptr_v);
+  this->uncalibrated_efficiencies_sptr.reset();
 
   set_exam_info_sptr(exam_info_sptr_v);
   proj_data_info_ptr = proj_data_info_ptr_v;
@@ -223,9 +227,60 @@ BinNormalisationFromECAT8::set_up(const shared_ptr<const ExamInfo>& exam_info_sp
 
   this->mash = scanner_ptr->get_num_detectors_per_ring() / 2 / proj_data_info_ptr->get_num_views();
 
+  if (this->_precompute_efficiencies)
+    this->precompute_uncalibrated_efficiencies();
+
   return Succeeded::yes;
 }
 
+void
+BinNormalisationFromECAT8::set_precompute_efficiencies(const bool arg)
+{
+  this->_already_set_up = false;
+  this->_precompute_efficiencies = arg;
+}
+
+bool
+BinNormalisationFromECAT8::get_precompute_efficiencies() const
+{
+  return this->_precompute_efficiencies;
+}
+
+void
+BinNormalisationFromECAT8::precompute_uncalibrated_efficiencies()
+{
+  // efficiencies do not depend on TOF, so store them for non-TOF data only
+  shared_ptr<const ProjDataInfo> non_tof_proj_data_info_sptr(this->proj_data_info_ptr->create_non_tof_clone());
+  const ProjDataInfo& proj_data_info = *non_tof_proj_data_info_sptr;
+  this->uncalibrated_efficiencies_sptr = std::make_shared<ProjDataInMemory>(
+      this->get_exam_info_sptr(), non_tof_proj_data_info_sptr, /* do not initialise */ false);
+
+  for (int segment_num = proj_data_info.get_min_segment_num(); segment_num <= proj_data_info.get_max_segment_num();
+       ++segment_num)
+    {
+#ifdef STIR_OPENMP
+#  pragma omp parallel for schedule(dynamic)
+#endif
+      for (int view_num = proj_data_info.get_min_view_num(); view_num <= proj_data_info.get_max_view_num(); ++view_num)
+        {
+          Viewgram<float> viewgram = proj_data_info.get_empty_viewgram(view_num, segment_num);
+          Bin bin(segment_num, view_num, 0, 0);
+          for (bin.axial_pos_num() = viewgram.get_min_axial_pos_num(); bin.axial_pos_num() <= viewgram.get_max_axial_pos_num();
+               ++bin.axial_pos_num())
+            for (bin.tangential_pos_num() = viewgram.get_min_tangential_pos_num();
+                 bin.tangential_pos_num() <= viewgram.get_max_tangential_pos_num();
+                 ++bin.tangential_pos_num())
+              viewgram[bin.axial_pos_num()][bin.tangential_pos_num()] = this->compute_uncalibrated_bin_efficiency(bin);
+#ifdef STIR_OPENMP
+#  pragma omp critical(BINNORMALISATIONFROMECAT8_PRECOMPUTE)
+#endif
+          {
+            this->uncalibrated_efficiencies_sptr->set_viewgram(viewgram);
+          }
+        }
+    }
+}
+
 void
 BinNormalisationFromECAT8::read_norm_data(const string& filename)
 {
@@ -484,6 +539,57 @@ BinNormalisationFromECAT8::use_crystal_interference_factors() const
 
 float
 BinNormalisationFromECAT8::get_uncalibrated_bin_efficiency(const Bin& bin) const
+{
+  if (!is_null_ptr(this->uncalibrated_efficiencies_sptr))
+    {
+      Bin non_tof_bin(bin.segment_num(), bin.view_num(), bin.axial_pos_num(), bin.tangential_pos_num());
+      return this->uncalibrated_efficiencies_sptr->get_bin_value(non_tof_bin);
+    }
+  return this->compute_uncalibrated_bin_efficiency(bin);
+}
+
+void
+BinNormalisationFromECAT8::apply(RelatedViewgrams<float>& viewgrams) const
+{
+  if (is_null_ptr(this->uncalibrated_efficiencies_sptr))
+    {
+      base_type::apply(viewgrams);
+      return;
+    }
+  this->check(*viewgrams.get_proj_data_info_sptr());
+  const float calib_factor = this->get_calib_decay_branching_ratio_factor(Bin());
+  for (RelatedViewgrams<float>::iterator iter = viewgrams.begin(); iter != viewgrams.end(); ++iter)
+    {
+      const Viewgram<float> efficiencies
+          = this->uncalibrated_efficiencies_sptr->get_viewgram(iter->get_view_num(), iter->get_segment_num());
+      for (int a = iter->get_min_axial_pos_num(); a <= iter->get_max_axial_pos_num(); ++a)
+        for (int t = iter->get_min_tangential_pos_num(); t <= iter->get_max_tangential_pos_num(); ++t)
+          (*iter)[a][t] /= std::max(1.E-20F, efficiencies[a][t] / calib_factor);
+    }
+}
+
+void
+BinNormalisationFromECAT8::undo(RelatedViewgrams<float>& viewgrams) const
+{
+  if (is_null_ptr(this->uncalibrated_efficiencies_sptr))
+    {
+      base_type::undo(viewgrams);
+      return;
+    }
+  this->check(*viewgrams.get_proj_data_info_sptr());
+  const float calib_factor = this->get_calib_decay_branching_ratio_factor(Bin());
+  for (RelatedViewgrams<float>::iterator iter = viewgrams.begin(); iter != viewgrams.end(); ++iter)
+    {
+      const Viewgram<float> efficiencies
+          = this->uncalibrated_efficiencies_sptr->get_viewgram(iter->get_view_num(), iter->get_segment_num());
+      for (int a = iter->get_min_axial_pos_num(); a <= iter->get_max_axial_pos_num(); ++a)
+        for (int t = iter->get_min_tangential_pos_num(); t <= iter->get_max_tangential_pos_num(); ++t)
+          (*iter)[a][t] *= efficiencies[a][t] / calib_factor;
+    }
+}
+
+float
+BinNormalisationFromECAT8::compute_uncalibrated_bin_efficiency(const Bin& bin) const
 {
 
   float total_efficiency = 0;
@@ -36,7 +36,10 @@
 #include "stir/error.h"
 #include <boost/format.hpp>
 #include "stir/recon_buildblock/PoissonLogLikelihoodWithLinearModelForMeanAndProjData.h" // needed for RPC functions
+#include "stir/recon_buildblock/BinNormalisation.h"
 #include <exception>
+#include <sstream>
+#include <vector>
 
 #include "stir/recon_buildblock/distributable_main.h"
 
@@ -155,8 +158,17 @@ DistributedWorker<TargetT>::start()
             break;
           }
 
+          case task_setup_distributable_local_data: {
+            this->setup_local_data();
+            break;
+          }
+
           case task_do_distributable_gradient_computation: {
-            this->distributable_computation(RPC_process_related_viewgrams_gradient);
+            this->distributable_computation(RPC_process_related_viewgrams_gradient<true>);
+            break;
+          }
+          case task_do_distributable_gradient_computation_without_adding_sensitivity: {
+            this->distributable_computation(RPC_process_related_viewgrams_gradient<false>);
             break;
           }
           case task_do_distributable_loglikelihood_computation: {
@@ -229,8 +241,43 @@ DistributedWorker<TargetT>::setup_distributable_computation()
   this->proj_data_ptr.reset();
   this->binwise_correction.reset();
   this->mult_proj_data_sptr.reset();
+  // same for local data
+  this->local_proj_data_sptr.reset();
+  this->local_additive_proj_data_sptr.reset();
+  this->local_normalisation_sptr.reset();
 } // set_up
 
+template <typename TargetT>
+void
+DistributedWorker<TargetT>::setup_local_data()
+{
+  const std::string proj_data_filename = distributed::receive_string(LOCAL_DATA_FILENAME_TAG, 0);
+  this->local_proj_data_sptr = ProjData::read_from_file(proj_data_filename);
+  if (is_null_ptr(this->local_proj_data_sptr))
+    error(boost::format("Slave %1%: reading projection data %2% failed") % my_rank % proj_data_filename);
+
+  const std::string additive_proj_data_filename = distributed::receive_string(LOCAL_DATA_FILENAME_TAG, 0);
+  if (!additive_proj_data_filename.empty())
+    {
+      this->local_additive_proj_data_sptr = ProjData::read_from_file(additive_proj_data_filename);
+      if (is_null_ptr(this->local_additive_proj_data_sptr))
+        error(boost::format("Slave %1%: reading additive projection data %2% failed") % my_rank % additive_proj_data_filename);
+    }
+
+  // construct the normalisation in the same way as the projectors
+  const std::string registered_name_normalisation = distributed::receive_string(distributed::REGISTERED_NAME_TAG, 0);
+  const std::string parameter_info_normalisation = distributed::receive_string(distributed::PARAMETER_INFO_TAG, 0);
+  if (!registered_name_normalisation.empty())
+    {
+      std::istringstream parameter_info_stream(parameter_info_normalisation);
+      this->local_normalisation_sptr.reset(
+          RegisteredObject<BinNormalisation>::read_registered_object(&parameter_info_stream, registered_name_normalisation));
+      if (is_null_ptr(this->local_normalisation_sptr)
+          || this->local_normalisation_sptr->set_up(this->exam_info_sptr, this->proj_data_info_sptr) == Succeeded::no)
+        error(boost::format("Slave %1%: set-up of normalisation failed") % my_rank);
+    }
+}
+
 template <typename TargetT>
 void
 DistributedWorker<TargetT>::distributable_computation(RPC_process_related_viewgrams_type* RPC_process_related_viewgrams)
@@ -275,6 +322,16 @@ DistributedWorker<TargetT>::distributable_computation(RPC_process_related_viewgr
         // output_image_ptr->fill(0.F);
       }
 
+    // receive info on reading the data ourselves
+    int local_data_values[4];
+    status = distributed::receive_int_values(local_data_values, 4, USE_LOCAL_DATA_TAG);
+    const bool use_local_data = local_data_values[0] == 1;
+    const bool read_from_proj_dat = local_data_values[1] == 1;
+    const bool use_additive_proj_data = local_data_values[2] == 1;
+    const bool use_normalisation = local_data_values[3] == 1;
+    if (use_local_data && is_null_ptr(this->local_proj_data_sptr))
+      error(boost::format("Slave %1%: asked to read data, but no data were set-up") % my_rank);
+
     proj_pair_sptr->get_forward_projector_sptr()->set_input(*this->target_sptr);
     if (!is_null_ptr(output_image_ptr))
       proj_pair_sptr->get_back_projector_sptr()->start_accumulating_in_new_target();
@@ -282,10 +339,9 @@ DistributedWorker<TargetT>::distributable_computation(RPC_process_related_viewgr
     // loop to receive viewgrams until received END_ITERATION_TAG
     while (true)
       {
-        // TODO, get rid of pointers somehow
-        RelatedViewgrams<float>* viewgrams = NULL;
-        RelatedViewgrams<float>* additive_binwise_correction_viewgrams = NULL;
-        RelatedViewgrams<float>* mult_viewgrams_ptr = NULL;
+        shared_ptr<RelatedViewgrams<float>> viewgrams;
+        shared_ptr<RelatedViewgrams<float>> additive_binwise_correction_viewgrams;
+        shared_ptr<RelatedViewgrams<float>> mult_viewgrams_sptr;
         int count = 0, count2 = 0;
 
         // receive vs_num values
@@ -295,41 +351,68 @@ DistributedWorker<TargetT>::distributable_computation(RPC_process_related_viewgr
         /*check whether to
          *  - use a viewgram already received in previous iteration
          *  - receive a new viewgram
+         *  - read the viewgram ourselves
          *  - end the iteration
          */
         if (status.MPI_TAG == REUSE_VIEWGRAM_TAG) // use a viewgram already available
           {
-            viewgrams = new RelatedViewgrams<float>(proj_data_ptr->get_related_viewgrams(vs, symmetries_sptr));
+            viewgrams.reset(new RelatedViewgrams<float>(proj_data_ptr->get_related_viewgrams(vs, symmetries_sptr)));
             if (!is_null_ptr(binwise_correction))
-              additive_binwise_correction_viewgrams
-                  = new RelatedViewgrams<float>(binwise_correction->get_related_viewgrams(vs, symmetries_sptr));
+              additive_binwise_correction_viewgrams.reset(
+                  new RelatedViewgrams<float>(binwise_correction->get_related_viewgrams(vs, symmetries_sptr)));
             if (!is_null_ptr(mult_proj_data_sptr))
-              mult_viewgrams_ptr = new RelatedViewgrams<float>(mult_proj_data_sptr->get_related_viewgrams(vs, symmetries_sptr));
+              mult_viewgrams_sptr.reset(
+                  new RelatedViewgrams<float>(mult_proj_data_sptr->get_related_viewgrams(vs, symmetries_sptr)));
+          }
+        else if (status.MPI_TAG == READ_VIEWGRAM_TAG) // read the data ourselves
+          {
+            const int timing_pos_num = distributed::receive_int_value(0);
+            detail::get_viewgrams_for_distributable_computation(
+                viewgrams,
+                additive_binwise_correction_viewgrams,
+                mult_viewgrams_sptr,
+                this->local_proj_data_sptr,
+                read_from_proj_dat,
+                this->zero_seg0_end_planes,
+                use_additive_proj_data ? this->local_additive_proj_data_sptr : shared_ptr<ProjData>(),
+                use_normalisation ? this->local_normalisation_sptr : shared_ptr<BinNormalisation>(),
+                /* start_time_of_frame (unused) */ 0.,
+                /* end_time_of_frame (unused) */ 0.,
+                symmetries_sptr,
+                vs,
+                timing_pos_num);
           }
         else if (status.MPI_TAG == NEW_VIEWGRAM_TAG) // receive a message with a new viewgram
           {
+            // timing_pos_num (not used here, as the viewgrams are sent with their timing position)
+            distributed::receive_int_value(0);
 #ifndef NDEBUG
             // run test for related viewgrams
             if (distributed::test && my_rank == 1 && distributed::first_iteration == true)
               distributed::test_related_viewgrams_slave(proj_data_info_sptr, symmetries_sptr);
 #endif
+            RelatedViewgrams<float>* received_viewgrams_ptr = NULL;
             // receive info if additive_binwise_correction_viewgrams are NULL
             const bool add_bin_corr_viewgrams = distributed::receive_bool_value(BINWISE_CORRECTION_TAG, 0);
             if (add_bin_corr_viewgrams)
               {
                 distributed::receive_and_construct_related_viewgrams(
-                    additive_binwise_correction_viewgrams, proj_data_info_sptr, symmetries_sptr, 0);
+                    received_viewgrams_ptr, proj_data_info_sptr, symmetries_sptr, 0);
+                additive_binwise_correction_viewgrams.reset(received_viewgrams_ptr);
               }
 
             // receive info if mult_viewgrams_ptr are NULL
             const bool mult_viewgrams = distributed::receive_bool_value(BINWISE_MULT_TAG, 0);
             if (mult_viewgrams)
               {
-                distributed::receive_and_construct_related_viewgrams(mult_viewgrams_ptr, proj_data_info_sptr, symmetries_sptr, 0);
+                distributed::receive_and_construct_related_viewgrams(
+                    received_viewgrams_ptr, proj_data_info_sptr, symmetries_sptr, 0);
+                mult_viewgrams_sptr.reset(received_viewgrams_ptr);
               }
 
             // measured viewgrams
-            distributed::receive_and_construct_related_viewgrams(viewgrams, proj_data_info_sptr, symmetries_sptr, 0);
+            distributed::receive_and_construct_related_viewgrams(received_viewgrams_ptr, proj_data_info_sptr, symmetries_sptr, 0);
+            viewgrams.reset(received_viewgrams_ptr);
 
             // save Viewgrams to ProjDataInMemory object
             if (cache_enabled)
@@ -357,35 +440,45 @@ DistributedWorker<TargetT>::distributable_computation(RPC_process_related_viewgr
                       mult_proj_data_sptr.reset(
                           new ProjDataInMemory(this->exam_info_sptr, this->proj_data_info_sptr, /*init_with_0*/ false));
 
-                    if (mult_proj_data_sptr->set_related_viewgrams(*mult_viewgrams_ptr) == Succeeded::no)
+                    if (mult_proj_data_sptr->set_related_viewgrams(*mult_viewgrams_sptr) == Succeeded::no)
                       error("Slave %i: Storing mult_viewgrams_ptr failed!\n", my_rank);
                   }
               }
           }
         else if (status.MPI_TAG == END_ITERATION_TAG) // the iteration is completed --> send results
           {
-            // make reduction over computed output_images
             distributed::first_iteration = false;
+            /* Start the reductions with non-blocking calls, in the same order as
+               distributed::reduce_received_results() at the master. The reductions of the
+               log_likelihood and rpc-time proceed while we get the output_image from the back projector.
+            */
+            MPI_Request requests[3];
+            int num_requests = 0;
+            if (!is_null_ptr(log_likelihood_ptr))
+              MPI_Ireduce(log_likelihood_ptr, NULL, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD, &requests[num_requests++]);
+            double rpc_time = distributed::total_rpc_time;
+            if (distributed::rpc_time)
+              MPI_Ireduce(&rpc_time, NULL, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD, &requests[num_requests++]);
+            std::vector<float> output_buf;
             if (!is_null_ptr(output_image_ptr))
               {
                 proj_pair_sptr->get_back_projector_sptr()->get_output(*output_image_ptr);
-                distributed::reduce_output_image(output_image_ptr, image_buffer_size, my_rank, 0);
-              }
-            // and log_likelihood
-            if (!is_null_ptr(log_likelihood_ptr))
-              {
-                double buffer = 0.0;
-                MPI_Reduce(log_likelihood_ptr, &buffer, /*size*/ 1, MPI_DOUBLE, MPI_SUM, /*destination*/ 0, MPI_COMM_WORLD);
-                delete log_likelihood_ptr;
+                output_buf.assign(output_image_ptr->begin_all(), output_image_ptr->end_all());
+                MPI_Ireduce(output_buf.data(),
+                            NULL,
+                            static_cast<int>(output_buf.size()),
+                            MPI_FLOAT,
+                            MPI_SUM,
+                            0,
+                            MPI_COMM_WORLD,
+                            &requests[num_requests++]);
               }
+            MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
 
+            if (!is_null_ptr(log_likelihood_ptr))
+              delete log_likelihood_ptr;
             if (distributed::rpc_time)
-              {
-                double send = distributed::total_rpc_time;
-                double receive;
-                MPI_Reduce(&send, &receive, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-                distributed::total_rpc_time = 0.0;
-              }
+              distributed::total_rpc_time = 0.0;
             // get out of infinite while loop
             break;
           }
@@ -402,12 +495,12 @@ DistributedWorker<TargetT>::distributable_computation(RPC_process_related_viewgr
         // call the actual calculation
         RPC_process_related_viewgrams(this->proj_pair_sptr->get_forward_projector_sptr(),
                                       this->proj_pair_sptr->get_back_projector_sptr(),
-                                      viewgrams,
+                                      viewgrams.get(),
                                       count,
                                       count2,
                                       log_likelihood_ptr,
-                                      additive_binwise_correction_viewgrams,
-                                      mult_viewgrams_ptr);
+                                      additive_binwise_correction_viewgrams.get(),
+                                      mult_viewgrams_sptr.get());
 
         if (distributed::rpc_time)
           {
@@ -421,13 +514,6 @@ DistributedWorker<TargetT>::distributable_computation(RPC_process_related_viewgr
         int_values[1] = count2;
         // send count,count2 and ask for new work
         distributed::send_int_values(int_values, 2, AVAILABLE_NOTIFICATION_TAG, 0);
-
-        if (viewgrams != NULL)
-          delete viewgrams;
-        if (additive_binwise_correction_viewgrams != NULL)
-          delete additive_binwise_correction_viewgrams;
-        if (mult_viewgrams_ptr != NULL)
-          delete mult_viewgrams_ptr;
       }
     if (distributed::rpc_time)
       stir::info(boost::format("Slave %1% used %2% seconds for PRC-processing.") % my_rank % distributed::total_rpc_time_2);
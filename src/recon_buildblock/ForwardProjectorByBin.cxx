@@ -37,6 +37,7 @@
 #include "stir/warning.h"
 #include "stir/DataProcessor.h"
 #include "stir/is_null_ptr.h"
+#include "stir/Profiler.h"
 #include <boost/format.hpp>
 #include <iostream>
 
@@ -195,39 +196,63 @@ ForwardProjectorByBin::forward_project(ProjData& proj_data, int subset_num, int
                                              proj_data.get_max_segment_num(),
                                              subset_num,
                                              num_subsets);
+  const int min_tof_pos_num = proj_data.get_proj_data_info_sptr()->get_min_tof_pos_num();
+  const int max_tof_pos_num = proj_data.get_proj_data_info_sptr()->get_max_tof_pos_num();
+  // Loop over view/segments only, and handle all TOF bins together (see forward_project_all_timing_positions()).
+  // There is therefore no need to parallelise over TOF bins as well.
 #ifdef STIR_OPENMP
-#  if _OPENMP < 201107
-#    pragma omp parallel for shared(proj_data, symmetries_sptr) schedule(dynamic)
-#  else
-// OpenMP loop over both vs_nums_to_process and tof_pos_num
-#    pragma omp parallel for shared(proj_data, symmetries_sptr) schedule(dynamic) collapse(2)
-#  endif
+#  pragma omp parallel for shared(proj_data, symmetries_sptr) schedule(dynamic)
 #endif
   // note: older versions of openmp need an int as loop
   for (int i = 0; i < static_cast<int>(vs_nums_to_process.size()); ++i)
     {
-      for (int k = proj_data.get_proj_data_info_sptr()->get_min_tof_pos_num();
-           k <= proj_data.get_proj_data_info_sptr()->get_max_tof_pos_num();
-           ++k)
-        {
-          const ViewSegmentNumbers vs = vs_nums_to_process[i];
-          if (proj_data.get_proj_data_info_sptr()->is_tof_data())
-            info(boost::format("Processing view %1% of segment %2% of TOF bin %3%") % vs.view_num() % vs.segment_num() % k, 3);
-          else
-            info(boost::format("Processing view %1% of segment %2%") % vs.view_num() % vs.segment_num(), 3);
-          RelatedViewgrams<float> viewgrams = proj_data.get_empty_related_viewgrams(vs, symmetries_sptr, false, k);
-          forward_project(viewgrams);
+      const ViewSegmentNumbers vs = vs_nums_to_process[i];
+      if (proj_data.get_proj_data_info_sptr()->is_tof_data())
+        info(boost::format("Processing view %1% of segment %2% for all TOF bins") % vs.view_num() % vs.segment_num(), 3);
+      else
+        info(boost::format("Processing view %1% of segment %2%") % vs.view_num() % vs.segment_num(), 3);
+      std::vector<RelatedViewgrams<float>> viewgrams_for_all_timing_positions;
+      viewgrams_for_all_timing_positions.reserve(max_tof_pos_num - min_tof_pos_num + 1);
+      for (int k = min_tof_pos_num; k <= max_tof_pos_num; ++k)
+        viewgrams_for_all_timing_positions.push_back(proj_data.get_empty_related_viewgrams(vs, symmetries_sptr, false, k));
+      forward_project_all_timing_positions(viewgrams_for_all_timing_positions);
 #ifdef STIR_OPENMP
 #  pragma omp critical(FORWARDPROJ_SETVIEWGRAMS)
 #endif
-          {
-            if (!(proj_data.set_related_viewgrams(viewgrams) == Succeeded::yes))
-              error("Error set_related_viewgrams in forward projecting");
-          }
-        }
+      {
+        for (std::size_t k_idx = 0; k_idx < viewgrams_for_all_timing_positions.size(); ++k_idx)
+          if (!(proj_data.set_related_viewgrams(viewgrams_for_all_timing_positions[k_idx]) == Succeeded::yes))
+            error("Error set_related_viewgrams in forward projecting");
+      }
     }
 }
 
+void
+ForwardProjectorByBin::forward_project_all_timing_positions(
+    std::vector<RelatedViewgrams<float>>& viewgrams_for_all_timing_positions)
+{
+  if (viewgrams_for_all_timing_positions.empty() || viewgrams_for_all_timing_positions[0].get_num_viewgrams() == 0)
+    return;
+  // all elements are for the same view/segment, so checking the first one is enough
+  check_related_viewgrams(viewgrams_for_all_timing_positions[0]);
+  STIR_PROFILE_REGION("forward projection");
+  actual_forward_project_all_timing_positions(viewgrams_for_all_timing_positions);
+}
+
+void
+ForwardProjectorByBin::actual_forward_project_all_timing_positions(
+    std::vector<RelatedViewgrams<float>>& viewgrams_for_all_timing_positions)
+{
+  for (std::vector<RelatedViewgrams<float>>::iterator iter = viewgrams_for_all_timing_positions.begin();
+       iter != viewgrams_for_all_timing_positions.end();
+       ++iter)
+    actual_forward_project(*iter,
+                           iter->get_min_axial_pos_num(),
+                           iter->get_max_axial_pos_num(),
+                           iter->get_min_tangential_pos_num(),
+                           iter->get_max_tangential_pos_num());
+}
+
 void
 ForwardProjectorByBin::forward_project(RelatedViewgrams<float>& viewgrams)
 {
@@ -259,12 +284,20 @@ ForwardProjectorByBin::forward_project(RelatedViewgrams<float>& viewgrams,
 {
   if (viewgrams.get_num_viewgrams() == 0)
     return;
+  check_related_viewgrams(viewgrams);
+  STIR_PROFILE_REGION("forward projection");
+  actual_forward_project(viewgrams, min_axial_pos_num, max_axial_pos_num, min_tangential_pos_num, max_tangential_pos_num);
+}
+
+void
+ForwardProjectorByBin::check_related_viewgrams(const RelatedViewgrams<float>& viewgrams) const
+{
   if (!_density_sptr)
     error("You need to call set_input() forward_project()");
 
   check(*viewgrams.get_proj_data_info_sptr());
 
-  // first check symmetries
+  // check symmetries
   {
     const ViewSegmentNumbers basic_vs = viewgrams.get_basic_view_segment_num();
 
@@ -281,7 +314,6 @@ ForwardProjectorByBin::forward_project(RelatedViewgrams<float>& viewgrams,
           error("ForwardProjectByBin: forward_project called with incorrect related_viewgrams. Problem with symmetries!\n");
       }
   }
-  actual_forward_project(viewgrams, min_axial_pos_num, max_axial_pos_num, min_tangential_pos_num, max_tangential_pos_num);
 }
 
 void
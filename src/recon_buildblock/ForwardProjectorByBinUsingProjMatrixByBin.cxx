@@ -206,6 +206,58 @@ ForwardProjectorByBinUsingProjMatrixByBin::actual_forward_project(RelatedViewgra
     }
 }
 
+void
+ForwardProjectorByBinUsingProjMatrixByBin::actual_forward_project_all_timing_positions(
+    std::vector<RelatedViewgrams<float>>& viewgrams_for_all_timing_positions)
+{
+  if (viewgrams_for_all_timing_positions.size() <= 1)
+    {
+      // non-TOF, nothing to share
+      ForwardProjectorByBin::actual_forward_project_all_timing_positions(viewgrams_for_all_timing_positions);
+      return;
+    }
+
+  const DiscretisedDensity<3, float>& image = *this->_density_sptr;
+  const int min_z = image.get_min_index();
+  const int max_z = image.get_max_index();
+  const std::size_t num_tof_bins = viewgrams_for_all_timing_positions.size();
+  const RelatedViewgrams<float>& first_viewgrams = viewgrams_for_all_timing_positions[0];
+
+  ProjMatrixElemsForOneBin proj_matrix_row;
+  vector<float> tof_kernels;
+  vector<float> values(num_tof_bins);
+
+  for (int r = 0; r < first_viewgrams.get_num_viewgrams(); ++r)
+    {
+      const Viewgram<float>& first_viewgram = *(first_viewgrams.begin() + r);
+      const int view_num = first_viewgram.get_view_num();
+      const int segment_num = first_viewgram.get_segment_num();
+
+      for (int tang_pos = first_viewgram.get_min_tangential_pos_num(); tang_pos <= first_viewgram.get_max_tangential_pos_num();
+           ++tang_pos)
+        for (int ax_pos = first_viewgram.get_min_axial_pos_num(); ax_pos <= first_viewgram.get_max_axial_pos_num(); ++ax_pos)
+          {
+            const Bin bin(segment_num, view_num, ax_pos, tang_pos, 0, 0.f);
+            proj_matrix_ptr->get_proj_matrix_elems_for_one_bin_for_all_timing_positions(proj_matrix_row, tof_kernels, bin);
+            std::fill(values.begin(), values.end(), 0.F);
+            vector<float>::const_iterator kernel_iter = tof_kernels.begin();
+            for (ProjMatrixElemsForOneBin::const_iterator element_ptr = proj_matrix_row.begin();
+                 element_ptr != proj_matrix_row.end();
+                 ++element_ptr, kernel_iter += num_tof_bins)
+              {
+                const BasicCoordinate<3, int> coords = element_ptr->get_coords();
+                if (coords[1] < min_z || coords[1] > max_z)
+                  continue;
+                const float value = image[coords[1]][coords[2]][coords[3]] * element_ptr->get_value();
+                for (std::size_t k_idx = 0; k_idx < num_tof_bins; ++k_idx)
+                  values[k_idx] += value * kernel_iter[k_idx];
+              }
+            for (std::size_t k_idx = 0; k_idx < num_tof_bins; ++k_idx)
+              (*(viewgrams_for_all_timing_positions[k_idx].begin() + r))[ax_pos][tang_pos] = values[k_idx];
+          }
+    }
+}
+
 #if 0 // disabled as currently not used. needs to be written in the new style anyway
 void
 ForwardProjectorByBinUsingProjMatrixByBin::
@@ -0,0 +1,121 @@
+/*!
+  \file
+  \ingroup projection
+
+  \brief Implementation of class stir::ForwardProjectorByBinWithSinogramPSF
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+
+#include "stir/recon_buildblock/ForwardProjectorByBinWithSinogramPSF.h"
+#include "stir/RelatedViewgrams.h"
+#include "stir/DiscretisedDensity.h"
+#include "stir/is_null_ptr.h"
+#include "stir/warning.h"
+
+START_NAMESPACE_STIR
+const char* const ForwardProjectorByBinWithSinogramPSF::registered_name = "Sinogram PSF";
+
+void
+ForwardProjectorByBinWithSinogramPSF::set_defaults()
+{
+  original_forward_projector_sptr.reset();
+  tangential_fwhm = 0.F;
+  tangential_fwhm_slope = 0.F;
+  axial_fwhm = 0.F;
+}
+
+void
+ForwardProjectorByBinWithSinogramPSF::initialise_keymap()
+{
+  parser.add_start_key("Sinogram PSF Forward Projector Parameters");
+  parser.add_stop_key("End Sinogram PSF Forward Projector Parameters");
+  parser.add_parsing_key("Original Forward projector type", &original_forward_projector_sptr);
+  parser.add_key("tangential FWHM (in mm)", &tangential_fwhm);
+  parser.add_key("tangential FWHM slope", &tangential_fwhm_slope);
+  parser.add_key("axial FWHM (in mm)", &axial_fwhm);
+}
+
+bool
+ForwardProjectorByBinWithSinogramPSF::post_processing()
+{
+  if (is_null_ptr(original_forward_projector_sptr))
+    {
+      warning("Sinogram PSF Forward Projector: original forward projector needs to be set");
+      return true;
+    }
+  if (tangential_fwhm < 0 || tangential_fwhm_slope < 0 || axial_fwhm < 0)
+    {
+      warning("Sinogram PSF Forward Projector: FWHMs and slope need to be non-negative");
+      return true;
+    }
+  psf = SinogramPSF(tangential_fwhm, axial_fwhm, tangential_fwhm_slope);
+  return false;
+}
+
+ForwardProjectorByBinWithSinogramPSF::ForwardProjectorByBinWithSinogramPSF()
+{
+  set_defaults();
+}
+
+ForwardProjectorByBinWithSinogramPSF::ForwardProjectorByBinWithSinogramPSF(
+    const shared_ptr<ForwardProjectorByBin>& original_forward_projector_sptr, const SinogramPSF& psf)
+    : original_forward_projector_sptr(original_forward_projector_sptr),
+      psf(psf)
+{
+  tangential_fwhm = psf.get_tangential_fwhm();
+  tangential_fwhm_slope = psf.get_tangential_fwhm_slope();
+  axial_fwhm = psf.get_axial_fwhm();
+}
+
+ForwardProjectorByBin*
+ForwardProjectorByBinWithSinogramPSF::get_original_forward_projector_ptr() const
+{
+  return original_forward_projector_sptr.get();
+}
+
+void
+ForwardProjectorByBinWithSinogramPSF::set_up(const shared_ptr<const ProjDataInfo>& proj_data_info_ptr,
+                                             const shared_ptr<const DiscretisedDensity<3, float>>& image_info_ptr)
+{
+  ForwardProjectorByBin::set_up(proj_data_info_ptr, image_info_ptr);
+  original_forward_projector_sptr->set_up(proj_data_info_ptr, image_info_ptr);
+  psf.set_up(*proj_data_info_ptr);
+}
+
+const DataSymmetriesForViewSegmentNumbers*
+ForwardProjectorByBinWithSinogramPSF::get_symmetries_used() const
+{
+  return original_forward_projector_sptr->get_symmetries_used();
+}
+
+void
+ForwardProjectorByBinWithSinogramPSF::set_input(const DiscretisedDensity<3, float>& density)
+{
+  // this applies the pre data processor (if any)
+  ForwardProjectorByBin::set_input(density);
+  original_forward_projector_sptr->set_input(*this->_density_sptr);
+}
+
+void
+ForwardProjectorByBinWithSinogramPSF::actual_forward_project(RelatedViewgrams<float>& viewgrams,
+                                                             const int min_axial_pos_num,
+                                                             const int max_axial_pos_num,
+                                                             const int min_tangential_pos_num,
+                                                             const int max_tangential_pos_num)
+{
+  original_forward_projector_sptr->forward_project(
+      viewgrams, min_axial_pos_num, max_axial_pos_num, min_tangential_pos_num, max_tangential_pos_num);
+  if (psf.is_trivial())
+    return;
+  for (RelatedViewgrams<float>::iterator iter = viewgrams.begin(); iter != viewgrams.end(); ++iter)
+    psf.apply(*iter, min_axial_pos_num, max_axial_pos_num, min_tangential_pos_num, max_tangential_pos_num);
+}
+
+END_NAMESPACE_STIR
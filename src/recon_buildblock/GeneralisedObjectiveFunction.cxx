@@ -31,6 +31,7 @@
 #include "stir/info.h"
 #include "stir/warning.h"
 #include "stir/error.h"
+#include "stir/Profiler.h"
 using std::string;
 
 START_NAMESPACE_STIR
@@ -112,8 +113,8 @@ GeneralisedObjectiveFunction<TargetT>::compute_penalty(const TargetT& current_es
 {
   if (this->prior_is_zero())
     return 0.;
-  else
-    return this->prior_sptr->compute_value(current_estimate);
+  STIR_PROFILE_REGION("prior value");
+  return this->prior_sptr->compute_value(current_estimate);
 }
 
 template <typename TargetT>
@@ -139,6 +140,7 @@ GeneralisedObjectiveFunction<TargetT>::compute_sub_gradient(TargetT& gradient,
   this->compute_sub_gradient_without_penalty(gradient, current_estimate, subset_num);
   if (!this->prior_is_zero())
     {
+      STIR_PROFILE_REGION("prior gradient");
       shared_ptr<TargetT> prior_gradient_sptr(gradient.get_empty_copy());
       this->prior_sptr->compute_gradient(*prior_gradient_sptr, current_estimate);
 
@@ -189,6 +191,7 @@ GeneralisedObjectiveFunction<TargetT>::compute_gradient(TargetT& gradient, const
   this->compute_gradient_without_penalty(gradient, current_estimate);
   if (!this->prior_is_zero())
     {
+      STIR_PROFILE_REGION("prior gradient");
       shared_ptr<TargetT> prior_gradient_sptr(gradient.get_empty_copy());
       this->prior_sptr->compute_gradient(*prior_gradient_sptr, current_estimate);
 
@@ -291,6 +294,7 @@ GeneralisedObjectiveFunction<TargetT>::add_multiplication_with_approximate_sub_H
   if (!this->prior_is_zero())
     {
       // TODO used boost:scoped_ptr
+      STIR_PROFILE_REGION("prior Hessian");
       shared_ptr<TargetT> prior_output_sptr(output.get_empty_copy());
       this->prior_sptr->add_multiplication_with_approximate_Hessian(*prior_output_sptr, output);
 
@@ -393,6 +397,7 @@ GeneralisedObjectiveFunction<TargetT>::accumulate_sub_Hessian_times_input(Target
   if (!this->prior_is_zero())
     {
       // TODO used boost:scoped_ptr
+      STIR_PROFILE_REGION("prior Hessian");
       shared_ptr<TargetT> prior_output_sptr(output.get_empty_copy());
       this->prior_sptr->accumulate_Hessian_times_input(*prior_output_sptr, current_image_estimate, output);
 
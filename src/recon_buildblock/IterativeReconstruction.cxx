@@ -42,6 +42,7 @@
 #include "stir/info.h"
 #include "stir/warning.h"
 #include "stir/error.h"
+#include "stir/Profiler.h"
 
 using std::cerr;
 using std::endl;
@@ -414,7 +415,11 @@ IterativeReconstruction<TargetT>::reconstruct(shared_ptr<TargetT> const& target_
   for (subiteration_num = start_subiteration_num; subiteration_num <= num_subiterations && this->terminate_iterations == false;
        subiteration_num++)
     {
-      this->update_estimate(*target_data_sptr);
+      STIR_PROFILE_REGION("subiteration");
+      {
+        STIR_PROFILE_REGION("update estimate");
+        this->update_estimate(*target_data_sptr);
+      }
       this->end_of_iteration_processing(*target_data_sptr);
     }
 
@@ -431,6 +436,7 @@ template <typename TargetT>
 Succeeded
 IterativeReconstruction<TargetT>::set_up(shared_ptr<TargetT> const& target_data_sptr)
 {
+  STIR_PROFILE_REGION("reconstruction set-up");
   if (base_type::set_up(target_data_sptr) == Succeeded::no)
     return Succeeded::no;
 
@@ -538,6 +544,7 @@ IterativeReconstruction<TargetT>::end_of_iteration_processing(TargetT& current_e
       && (this->subiteration_num % this->report_objective_function_values_interval == 0
           || this->subiteration_num == this->num_subiterations))
     {
+      STIR_PROFILE_REGION("objective function values");
       /*std::*/ cerr << "Objective function values (before any additional filtering):\n"
                      << this->objective_function_sptr->get_objective_function_values_report(current_estimate);
     }
@@ -546,6 +553,7 @@ IterativeReconstruction<TargetT>::end_of_iteration_processing(TargetT& current_e
       && this->subiteration_num % this->inter_iteration_filter_interval == 0)
     {
       cerr << endl << "Applying inter-iteration filter" << endl;
+      STIR_PROFILE_REGION("inter-iteration filter");
       this->inter_iteration_filter_ptr->apply(current_estimate);
     }
 
@@ -556,7 +564,10 @@ IterativeReconstruction<TargetT>::end_of_iteration_processing(TargetT& current_e
   if (this->subiteration_num == this->num_subiterations && !is_null_ptr(this->post_filter_sptr))
     {
       cerr << endl << "Applying post-filter" << endl;
-      this->post_filter_sptr->apply(current_estimate);
+      {
+        STIR_PROFILE_REGION("post-filter");
+        this->post_filter_sptr->apply(current_estimate);
+      }
 
       cerr << "  min and max after post-filtering " << *std::min_element(current_estimate.begin_all(), current_estimate.end_all())
            << " " << *std::max_element(current_estimate.begin_all(), current_estimate.end_all()) << endl;
@@ -568,6 +579,7 @@ IterativeReconstruction<TargetT>::end_of_iteration_processing(TargetT& current_e
   if ((!(this->subiteration_num % this->save_interval) || this->subiteration_num == this->num_subiterations)
       && !this->_disable_output)
     {
+      STIR_PROFILE_REGION("write estimate");
       this->output_file_format_ptr->write_to_file(this->make_filename_prefix_subiteration_num(), current_estimate);
     }
 }
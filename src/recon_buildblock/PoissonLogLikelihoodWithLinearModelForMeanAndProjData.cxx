@@ -126,6 +126,7 @@ PoissonLogLikelihoodWithLinearModelForMeanAndProjData<TargetT>::set_defaults()
 #ifdef STIR_MPI
   // distributed stuff
   this->distributed_cache_enabled = false;
+  this->distributed_data_reading_enabled = false;
   this->distributed_tests_enabled = false;
   this->message_timings_enabled = false;
   this->message_timings_threshold = 0.1;
@@ -160,6 +161,7 @@ PoissonLogLikelihoodWithLinearModelForMeanAndProjData<TargetT>::initialise_keyma
 #ifdef STIR_MPI
   // distributed stuff
   this->parser.add_key("enable distributed caching", &distributed_cache_enabled);
+  this->parser.add_key("enable distributed data reading", &distributed_data_reading_enabled);
   this->parser.add_key("enable distributed tests", &distributed_tests_enabled);
   this->parser.add_key("enable message timings", &message_timings_enabled);
   this->parser.add_key("message timings threshold", &message_timings_threshold);
@@ -230,6 +232,14 @@ PoissonLogLikelihoodWithLinearModelForMeanAndProjData<TargetT>::post_processing(
   else
     info("Distributed caching is disabled. Will use standard distributed version without forced caching!");
 
+  if (this->distributed_data_reading_enabled == true)
+    {
+      if (this->distributed_cache_enabled == true)
+        warning("Distributed data reading cannot be combined with distributed caching, and will be ignored.");
+      else
+        info("Slaves will read the projection data themselves (when read from file)");
+    }
+
 #  ifndef NDEBUG
   // check tests enabled value
   if (this->distributed_tests_enabled == true)
@@ -400,6 +410,8 @@ PoissonLogLikelihoodWithLinearModelForMeanAndProjData<TargetT>::set_proj_data_sp
 {
   this->already_set_up = false;
   this->proj_data_sptr = arg;
+  // data no longer corresponds to the file
+  this->input_filename = "";
 }
 
 template <typename TargetT>
@@ -432,6 +444,8 @@ PoissonLogLikelihoodWithLinearModelForMeanAndProjData<TargetT>::set_additive_pro
 {
   this->already_set_up = false;
   this->additive_proj_data_sptr = dynamic_pointer_cast<ProjData>(arg);
+  // data no longer corresponds to the file
+  this->additive_projection_data_filename = "0";
 }
 
 template <typename TargetT>
@@ -472,6 +486,8 @@ PoissonLogLikelihoodWithLinearModelForMeanAndProjData<TargetT>::set_input_data(c
 {
   this->already_set_up = false;
   this->proj_data_sptr = dynamic_pointer_cast<ProjData>(arg);
+  // data no longer corresponds to the file
+  this->input_filename = "";
 }
 
 template <typename TargetT>
@@ -685,6 +701,26 @@ PoissonLogLikelihoodWithLinearModelForMeanAndProjData<TargetT>::set_up_before_se
   return Succeeded::yes;
 }
 
+template <typename TargetT>
+void
+PoissonLogLikelihoodWithLinearModelForMeanAndProjData<TargetT>::setup_distributable_data_reading() const
+{
+#ifdef STIR_MPI
+  if (!this->distributed_data_reading_enabled || this->distributed_cache_enabled)
+    return;
+  if (this->input_filename.empty())
+    {
+      warning("Distributed data reading is enabled, but the projection data were not read from file. "
+              "The master will send the data to the slaves instead.");
+      return;
+    }
+  const std::string additive_filename
+      = this->additive_projection_data_filename == "0" ? std::string() : this->additive_projection_data_filename;
+  setup_distributable_computation_local_data(
+      this->proj_data_sptr, this->input_filename, this->additive_proj_data_sptr, additive_filename, this->normalisation_sptr);
+#endif
+}
+
 /***************************************************************
   functions that compute the value/gradient of the objective function etc
 ***************************************************************/
@@ -708,6 +744,7 @@ PoissonLogLikelihoodWithLinearModelForMeanAndProjData<TargetT>::actual_compute_s
                                       distributed_cache_enabled);
       this->distributable_computation_already_setup = true;
       this->latest_setup_distributable_computation_was_with_orig_projectors = true;
+      this->setup_distributable_data_reading();
     }
   if (!this->distributable_computation_already_setup)
     error("PoissonLogLikelihoodWithLinearModelForMeanAndProjData internal error: setup_distributable_computation not called "
@@ -739,7 +776,7 @@ double
 PoissonLogLikelihoodWithLinearModelForMeanAndProjData<TargetT>::actual_compute_objective_function_without_penalty(
     const TargetT& current_estimate, const int subset_num)
 {
-  if (this->distributable_computation_already_setup || !this->latest_setup_distributable_computation_was_with_orig_projectors)
+  if (!this->distributable_computation_already_setup || !this->latest_setup_distributable_computation_was_with_orig_projectors)
     {
       // set TOF projectors to be used for the calculations
       setup_distributable_computation(this->projector_pair_ptr,
@@ -750,6 +787,7 @@ PoissonLogLikelihoodWithLinearModelForMeanAndProjData<TargetT>::actual_compute_o
                                       distributed_cache_enabled);
       this->distributable_computation_already_setup = true;
       this->latest_setup_distributable_computation_was_with_orig_projectors = true;
+      this->setup_distributable_data_reading();
     }
   if (!this->distributable_computation_already_setup)
     error("PoissonLogLikelihoodWithLinearModelForMeanAndProjData internal error: setup_distributable_computation not called "
@@ -850,6 +888,7 @@ PoissonLogLikelihoodWithLinearModelForMeanAndProjData<TargetT>::add_subset_sensi
                                       distributed_cache_enabled);
       this->distributable_computation_already_setup = true;
       this->latest_setup_distributable_computation_was_with_orig_projectors = true;
+      this->setup_distributable_data_reading();
     }
   else if (!this->sensitivity_uses_same_projector()
            && (!this->distributable_computation_already_setup
@@ -1215,7 +1254,7 @@ PoissonLogLikelihoodWithLinearModelForMeanAndProjData<TargetT>::actual_accumulat
 
 //! Call-back function for compute_gradient
 template <bool add_sensitivity>
-static RPC_process_related_viewgrams_type RPC_process_related_viewgrams_gradient;
+RPC_process_related_viewgrams_type RPC_process_related_viewgrams_gradient;
 
 //! Call-back function for accumulate_loglikelihood
 RPC_process_related_viewgrams_type RPC_process_related_viewgrams_accumulate_loglikelihood;
@@ -1459,6 +1498,12 @@ RPC_process_related_viewgrams_gradient(const shared_ptr<ForwardProjectorByBin>&
   back_projector_sptr->back_project(*measured_viewgrams_ptr);
 };
 
+#ifdef STIR_MPI
+// instantiate the call-backs that are used by the DistributedWorker
+template RPC_process_related_viewgrams_type RPC_process_related_viewgrams_gradient<true>;
+template RPC_process_related_viewgrams_type RPC_process_related_viewgrams_gradient<false>;
+#endif
+
 void
 RPC_process_related_viewgrams_accumulate_loglikelihood(const shared_ptr<ForwardProjectorByBin>& forward_projector_sptr,
                                                        const shared_ptr<BackProjectorByBin>& back_projector_sptr,
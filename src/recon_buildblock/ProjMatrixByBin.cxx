@@ -27,6 +27,8 @@
 #include "stir/recon_buildblock/ProjMatrixByBin.h"
 #include "stir/recon_buildblock/ProjMatrixElemsForOneBin.h"
 #include "stir/TOF_conversions.h"
+#include "stir/ProjDataInfoGeneric.h"
+#include "stir/Profiler.h"
 
 START_NAMESPACE_STIR
 
@@ -35,6 +37,7 @@ ProjMatrixByBin::set_defaults()
 {
   cache_disabled = false;
   cache_stores_only_basic_bins = true;
+  precompute_LOR_geometry = false;
   gauss_sigma_in_mm = 0.f;
   r_sqrt2_gauss_sigma = 0.f;
 }
@@ -44,6 +47,7 @@ ProjMatrixByBin::initialise_keymap()
 {
   parser.add_key("disable caching", &cache_disabled);
   parser.add_key("store_only_basic_bins_in_cache", &cache_stores_only_basic_bins);
+  parser.add_key("precompute LOR geometry", &precompute_LOR_geometry);
 }
 
 bool
@@ -92,6 +96,18 @@ ProjMatrixByBin::does_cache_store_only_basic_bins() const
   return cache_stores_only_basic_bins;
 }
 
+void
+ProjMatrixByBin::set_precompute_LOR_geometry(const bool v)
+{
+  precompute_LOR_geometry = v;
+}
+
+bool
+ProjMatrixByBin::get_precompute_LOR_geometry() const
+{
+  return precompute_LOR_geometry;
+}
+
 void
 ProjMatrixByBin::clear_cache() const
 {
@@ -105,6 +121,14 @@ ProjMatrixByBin::clear_cache() const
           this->cache_collection[i][j].clear();
         }
     }
+  for (int i = this->geometric_cache_collection.get_min_index(); i <= this->geometric_cache_collection.get_max_index(); ++i)
+    {
+      for (int j = this->geometric_cache_collection[i].get_min_index(); j <= this->geometric_cache_collection[i].get_max_index();
+           ++j)
+        {
+          this->geometric_cache_collection[i][j].clear();
+        }
+    }
 }
 
 /*
@@ -125,6 +149,12 @@ ProjMatrixByBin::set_up(const shared_ptr<const ProjDataInfo>& proj_data_info_spt
 {
   this->proj_data_info_sptr = proj_data_info_sptr_v;
   this->image_info_sptr.reset(dynamic_cast<const VoxelsOnCartesianGrid<float>*>(density_info_sptr_v->clone()));
+  if (this->precompute_LOR_geometry)
+    {
+      // note: the table is stored in the ProjDataInfo, so will be used by everyone sharing it
+      if (auto generic_proj_data_info_ptr = dynamic_cast<const ProjDataInfoGeneric*>(proj_data_info_sptr.get()))
+        generic_proj_data_info_ptr->set_up_LOR_geometry_cache();
+    }
   if (is_cache_enabled())
     {
       const int max_abs_tangential_pos_num
@@ -156,6 +186,9 @@ ProjMatrixByBin::set_up(const shared_ptr<const ProjDataInfo>& proj_data_info_spt
 
   this->cache_collection.recycle();
   this->cache_collection.resize(min_view_num, max_view_num);
+  this->geometric_cache_collection.recycle();
+  if (this->tof_enabled)
+    this->geometric_cache_collection.resize(min_view_num, max_view_num);
 #ifdef STIR_OPENMP
   this->cache_locks.recycle();
   this->cache_locks.resize(min_view_num, max_view_num);
@@ -164,6 +197,8 @@ ProjMatrixByBin::set_up(const shared_ptr<const ProjDataInfo>& proj_data_info_spt
   for (int view_num = min_view_num; view_num <= max_view_num; ++view_num)
     {
       this->cache_collection[view_num].resize(min_segment_num, max_segment_num);
+      if (this->tof_enabled)
+        this->geometric_cache_collection[view_num].resize(min_segment_num, max_segment_num);
 #ifdef STIR_OPENMP
       this->cache_locks[view_num].resize(min_segment_num, max_segment_num);
       for (int seg_num = min_segment_num; seg_num <= max_segment_num; ++seg_num)
@@ -199,7 +234,8 @@ ProjMatrixByBin::cache_key(const Bin& bin) const
 }
 
 void
-ProjMatrixByBin::cache_proj_matrix_elems_for_one_bin(const ProjMatrixElemsForOneBin& probabilities) const
+ProjMatrixByBin::cache_proj_matrix_elems_for_one_bin(const ProjMatrixElemsForOneBin& probabilities,
+                                                     const bool use_geometric_cache) const
 {
   if (cache_disabled)
     return;
@@ -210,7 +246,7 @@ ProjMatrixByBin::cache_proj_matrix_elems_for_one_bin(const ProjMatrixElemsForOne
 #ifdef STIR_OPENMP
   omp_set_lock(&this->cache_locks[bin.view_num()][bin.segment_num()]);
 #endif
-  cache_collection[bin.view_num()][bin.segment_num()].insert(
+  (use_geometric_cache ? geometric_cache_collection : cache_collection)[bin.view_num()][bin.segment_num()].insert(
       MapProjMatrixElemsForOneBin::value_type(cache_key(bin), probabilities));
 #ifdef STIR_OPENMP
   omp_unset_lock(&this->cache_locks[bin.view_num()][bin.segment_num()]);
@@ -218,7 +254,8 @@ ProjMatrixByBin::cache_proj_matrix_elems_for_one_bin(const ProjMatrixElemsForOne
 }
 
 Succeeded
-ProjMatrixByBin::get_cached_proj_matrix_elems_for_one_bin(ProjMatrixElemsForOneBin& probabilities) const
+ProjMatrixByBin::get_cached_proj_matrix_elems_for_one_bin(ProjMatrixElemsForOneBin& probabilities,
+                                                          const bool use_geometric_cache) const
 {
   if (cache_disabled)
     return Succeeded::no;
@@ -240,9 +277,11 @@ ProjMatrixByBin::get_cached_proj_matrix_elems_for_one_bin(ProjMatrixElemsForOneB
 #endif
 
   {
-    const_MapProjMatrixElemsForOneBinIterator pos = cache_collection[bin.view_num()][bin.segment_num()].find(cache_key(bin));
+    const MapProjMatrixElemsForOneBin& cache
+        = (use_geometric_cache ? geometric_cache_collection : cache_collection)[bin.view_num()][bin.segment_num()];
+    const_MapProjMatrixElemsForOneBinIterator pos = cache.find(cache_key(bin));
 
-    if (pos != cache_collection[bin.view_num()][bin.segment_num()].end())
+    if (pos != cache.end())
       {
         // cout << Key << " =========>> entry found in cache " <<  endl;
         probabilities = pos->second;
@@ -255,14 +294,74 @@ ProjMatrixByBin::get_cached_proj_matrix_elems_for_one_bin(ProjMatrixElemsForOneB
   omp_unset_lock(&this->cache_locks[bin.view_num()][bin.segment_num()]);
 #endif
   if (found)
-    return Succeeded::yes;
+    {
+      STIR_PROFILE_COUNT("ProjMatrixByBin cache hits", 1);
+      return Succeeded::yes;
+    }
   else
     {
       // cout << " This entry  is not in the cache :" << Key << endl;
+      STIR_PROFILE_COUNT("ProjMatrixByBin cache misses", 1);
       return Succeeded::no;
     }
 }
 
+void
+ProjMatrixByBin::get_proj_matrix_elems_for_one_bin_for_all_timing_positions(ProjMatrixElemsForOneBin& probabilities,
+                                                                              std::vector<float>& tof_kernels,
+                                                                              const Bin& bin) const
+{
+  Bin non_tof_bin = bin;
+  non_tof_bin.timing_pos_num() = 0;
+  get_geometric_proj_matrix_elems_for_one_bin(probabilities, non_tof_bin);
+
+  if (!(proj_data_info_sptr->is_tof_data() && this->tof_enabled))
+    {
+      tof_kernels.assign(probabilities.size(), 1.F);
+      return;
+    }
+
+  const int min_tof_pos_num = proj_data_info_sptr->get_min_tof_pos_num();
+  const int max_tof_pos_num = proj_data_info_sptr->get_max_tof_pos_num();
+  const std::size_t num_tof_bins = static_cast<std::size_t>(max_tof_pos_num - min_tof_pos_num + 1);
+  tof_kernels.resize(probabilities.size() * num_tof_bins);
+
+  // boundaries of all TOF bins (neighbouring bins share a boundary)
+  std::vector<float> boundaries(num_tof_bins + 1);
+  for (int k = min_tof_pos_num; k <= max_tof_pos_num; ++k)
+    boundaries[k - min_tof_pos_num] = proj_data_info_sptr->tof_bin_boundaries_mm[k].low_lim;
+  boundaries[num_tof_bins] = proj_data_info_sptr->tof_bin_boundaries_mm[max_tof_pos_num].high_lim;
+
+  CartesianCoordinate3D<float> middle;
+  CartesianCoordinate3D<float> diff_unit_vector;
+  get_tof_LOR_middle_and_direction(middle, diff_unit_vector, non_tof_bin);
+
+  std::vector<float> normalised_distances(num_tof_bins + 1);
+  std::vector<double> erf_values(num_tof_bins + 1);
+  std::vector<float>::iterator kernel_iter = tof_kernels.begin();
+  for (ProjMatrixElemsForOneBin::const_iterator element_ptr = probabilities.begin(); element_ptr != probabilities.end();
+       ++element_ptr)
+    {
+      const Coordinate3D<int> c(element_ptr->get_coords());
+      const float d2 = -inner_product(image_info_sptr->get_physical_coordinates_for_indices(c) - middle, diff_unit_vector);
+      for (std::size_t i = 0; i <= num_tof_bins; ++i)
+        {
+          normalised_distances[i] = (boundaries[i] - d2) * r_sqrt2_gauss_sigma;
+          erf_values[i] = erf_interpolation(normalised_distances[i]);
+        }
+      // same as get_tof_value(), but reusing the erf values
+      for (std::size_t i = 0; i < num_tof_bins; ++i, ++kernel_iter)
+        {
+          const float d1_n = normalised_distances[i];
+          const float d2_n = normalised_distances[i + 1];
+          if ((d1_n >= 4.f && d2_n >= 4.f) || (d1_n <= -4.f && d2_n <= -4.f))
+            *kernel_iter = 0.F;
+          else
+            *kernel_iter = static_cast<float>(0.5 * (erf_values[i + 1] - erf_values[i]));
+        }
+    }
+}
+
 // TODO
 
 //////////////////////////////////////////////////////////////////////////
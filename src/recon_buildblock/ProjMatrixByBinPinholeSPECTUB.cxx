@@ -435,19 +435,6 @@ ProjMatrixByBinPinholeSPECTUB::set_up(
 )
 {
 
-  ProjMatrixByBin::set_up(proj_data_info_ptr_v, density_info_ptr);
-
-#ifdef STIR_OPENMP
-  if (!this->keep_all_views_in_cache)
-    {
-      warning("Pinhole SPECTUB matrix can currently only use single-threaded code unless all views are kept. Setting num_threads "
-              "to 1.");
-      set_num_threads(1);
-    }
-#endif
-
-  std::stringstream info_stream;
-
   const VoxelsOnCartesianGrid<float>* image_info_ptr = dynamic_cast<const VoxelsOnCartesianGrid<float>*>(density_info_ptr.get());
 
   if (image_info_ptr == nullptr)
@@ -458,7 +445,8 @@ ProjMatrixByBinPinholeSPECTUB::set_up(
       if (this->densel_range == image_info_ptr->get_index_range() && this->voxel_size == image_info_ptr->get_voxel_size()
           && this->origin == image_info_ptr->get_origin() && *proj_data_info_ptr_v == *this->proj_data_info_ptr)
         {
-          // stored matrix should be compatible, so we can just reuse it
+          // stored matrix should be compatible, so we can just reuse it.
+          // Note that we check this before calling ProjMatrixByBin::set_up, as that clears the cache.
           return;
         }
       else
@@ -468,6 +456,19 @@ ProjMatrixByBinPinholeSPECTUB::set_up(
         }
     }
 
+  ProjMatrixByBin::set_up(proj_data_info_ptr_v, density_info_ptr);
+
+#ifdef STIR_OPENMP
+  if (!this->keep_all_views_in_cache)
+    {
+      warning("Pinhole SPECTUB matrix can currently only use single-threaded code unless all views are kept. Setting num_threads "
+              "to 1.");
+      set_num_threads(1);
+    }
+#endif
+
+  std::stringstream info_stream;
+
   this->proj_data_info_ptr = proj_data_info_ptr_v;
   symmetries_sptr.reset(new TrivialDataSymmetriesForBins(proj_data_info_ptr_v));
 
@@ -994,15 +995,17 @@ ProjMatrixByBinPinholeSPECTUB::calculate_proj_matrix_elems_for_one_bin(ProjMatri
 {
   const int view_num = lor.get_bin().view_num();
 
+  // all views share the same work arrays (wm etc), so computations cannot run concurrently
 #ifdef STIR_OPENMP
 #  pragma omp critical(PROJMATRIXBYBINUBONEVIEW)
 #endif
+  {
+    if (!this->keep_all_views_in_cache)
+      this->clear_cache();
 
-  if (!this->keep_all_views_in_cache)
-    this->clear_cache();
-
-  info(boost::format("Computing matrix elements for view %1%") % view_num, 2);
-  compute_one_subset(view_num);
+    info(boost::format("Computing matrix elements for view %1%") % view_num, 2);
+    compute_one_subset(view_num);
+  }
 
   lor.erase();
 }
@@ -217,16 +217,6 @@ ProjMatrixByBinSPECTUB::set_up(const shared_ptr<const ProjDataInfo>& proj_data_i
 )
 {
 
-  ProjMatrixByBin::set_up(proj_data_info_ptr_v, density_info_ptr);
-
-#ifdef STIR_OPENMP
-  if (!this->keep_all_views_in_cache)
-    {
-      warning("SPECTUB matrix can currently only use single-threaded code unless all views are kept. Setting num_threads to 1");
-      set_num_threads(1);
-    }
-#endif
-
   const VoxelsOnCartesianGrid<float>* image_info_ptr = dynamic_cast<const VoxelsOnCartesianGrid<float>*>(density_info_ptr.get());
 
   if (image_info_ptr == NULL)
@@ -237,7 +227,8 @@ ProjMatrixByBinSPECTUB::set_up(const shared_ptr<const ProjDataInfo>& proj_data_i
       if (this->densel_range == image_info_ptr->get_index_range() && this->voxel_size == image_info_ptr->get_voxel_size()
           && this->origin == image_info_ptr->get_origin() && *proj_data_info_ptr_v == *this->proj_data_info_ptr)
         {
-          // stored matrix should be compatible, so we can just reuse it
+          // stored matrix should be compatible, so we can just reuse it.
+          // Note that we check this before calling ProjMatrixByBin::set_up, as that clears the cache.
           return;
         }
       else
@@ -247,6 +238,16 @@ ProjMatrixByBinSPECTUB::set_up(const shared_ptr<const ProjDataInfo>& proj_data_i
         }
     }
 
+  ProjMatrixByBin::set_up(proj_data_info_ptr_v, density_info_ptr);
+
+#ifdef STIR_OPENMP
+  if (!this->keep_all_views_in_cache)
+    {
+      warning("SPECTUB matrix can currently only use single-threaded code unless all views are kept. Setting num_threads to 1");
+      set_num_threads(1);
+    }
+#endif
+
   this->proj_data_info_ptr = proj_data_info_ptr_v;
   symmetries_sptr.reset(new TrivialDataSymmetriesForBins(proj_data_info_ptr_v));
 
@@ -694,6 +695,19 @@ ProjMatrixByBinSPECTUB::set_up(const shared_ptr<const ProjDataInfo>& proj_data_i
   info(boost::format("Done estimating size of matrix. Execution (CPU) time %1% s ") % timer.value(), 2);
   // wm_SPECT ends here ---------------------------------------------------------------------------------------------
 
+  if (this->keep_all_views_in_cache && this->is_cache_enabled())
+    {
+      // compute all views now. wm_calculation is multi-threaded, but if we'd wait until
+      // calculate_proj_matrix_elems_for_one_bin, it would be called from inside a parallel region
+      // and only use a single thread.
+      for (int kOS = 0; kOS < prj.NOS; ++kOS)
+        {
+          compute_one_subset(kOS, Rrad);
+          subset_already_processed[kOS] = true;
+        }
+      info(boost::format("Done computing matrix. Execution (CPU) time %1% s ") % timer.value(), 2);
+    }
+
   this->already_setup = true;
 }
 
@@ -848,6 +862,10 @@ ProjMatrixByBinSPECTUB::compute_one_subset(const int kOS, const float* Rrad) con
 
   //... fill lor .........................
 
+  // note: cache_proj_matrix_elems_for_one_bin is thread-safe
+#ifdef STIR_OPENMP
+#  pragma omp parallel for schedule(dynamic)
+#endif
   for (int j = 0; j < this->wm.NbOS; j++)
     {
       ProjMatrixElemsForOneBin lor;
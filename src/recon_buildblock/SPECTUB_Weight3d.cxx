@@ -44,6 +44,23 @@ using std::cos;
 using std::atan;
 using std::floor;
 
+//==========================================================================
+//=== record_error_weight3d ================================================
+//==========================================================================
+
+// keep the first error number (used inside parallel regions, where error_weight3d() cannot be called)
+static void
+record_error_weight3d(int& error_num, const int nerr)
+{
+#ifdef STIR_OPENMP
+#  pragma omp critical(SPECTUB_WEIGHT3D_ERROR)
+#endif
+  {
+    if (error_num == 0)
+      error_num = nerr;
+  }
+}
+
 //==========================================================================
 //=== wm_calculation =======================================================
 //==========================================================================
@@ -65,71 +82,12 @@ wm_calculation(const int kOS,
                const wmh_type& wmh,
                const float* Rrad)
 {
-
-  float weight;
-  float coeff_att = (float)1.;
-  int jp;
-  float eff;
-
-  //... variables for geometric component ..............................................
-
-  psf1d_type psf1d_h, psf1d_v;
-
-  psf1d_h.maxszb = maxszb;
-  psf1d_h.val = new float[maxszb];
-  psf1d_h.ind = new int[maxszb];
-
-  if (wmh.do_psf_3d)
-    {
-      psf1d_v.maxszb = maxszb;
-      psf1d_v.val = new float[maxszb];
-      psf1d_v.ind = new int[maxszb];
-    }
-
-  psf2da_type psf;
-
-  psf.maxszb_h = maxszb;
-  if (wmh.do_psf_3d)
-    psf.maxszb_v = maxszb;
-  else
-    psf.maxszb_v = 1;
-  psf.maxszb_t = psf.maxszb_h * psf.maxszb_v;
-
-  psf.val = new float[psf.maxszb_t]; // allocation for PSF values
-  psf.ib = new int[psf.maxszb_t];    // allocation for PSF indices
-  psf.jb = new int[psf.maxszb_t];    // allocation for PSF indices
-
-  //... variables for attenuation component .............................................
-
-  attpth_type* attpth = 0; // initialise to avoid compiler warning
-  int sizeattpth = 1;      // initialise to avoid compiler warning
-
-  if (wmh.do_att || wmh.do_msk_att)
-    {
-
-      if (!wmh.do_full_att)
-        sizeattpth = 1;
-      else
-        sizeattpth = psf.maxszb_t;
-
-      attpth = new attpth_type[sizeattpth];
-      attpth[0].maxlng = vol.Ncol + vol.Nrow + vol.Nsli; // maximum length of an attenuation path
-
-      for (int i = 0; i < sizeattpth; i++)
-        {
-
-          attpth[i].dl = new float[attpth[0].maxlng];
-          attpth[i].iv = new int[attpth[0].maxlng];
-          attpth[i].maxlng = attpth[0].maxlng;
-        }
-    }
-
   //... to fill projection indices for STIR format .............................
 
   if (wm.do_save_STIR)
     {
 
-      jp = -1; // projection index (row index of the weight matrix )
+      int jp = -1; // projection index (row index of the weight matrix )
       int j1;
 
       for (int j = 0; j < prj.NangOS; j++)
@@ -150,201 +108,283 @@ wm_calculation(const int kOS,
                 }
             }
         }
+
+      //... fill image STIR indices ...........................
+
+      stir::InvertAxis invert;
+      for (int irow = 0; irow < vol.Nrow; irow++)
+        for (int icol = 0; icol < vol.Ncol; icol++)
+          for (int islc = vol.first_sl; islc < vol.last_sl; islc++)
+            {
+              const int iv = irow * vol.Ncol + icol + islc * vol.Npix;
+              wm.nx[iv] = (short int)invert.invert_axis_index(
+                  (icol - (int)floor(vol.Ncold2)), vol.Ncold2 * 2, "x"); // centered index for STIR format
+              wm.ny[iv] = (short int)(irow - (int)floor(vol.Nrowd2));    // centered index for STIR format
+              wm.nz[iv] = (short int)islc;                               // non-centered index for STIR format
+            }
     }
 
-  //=== LOOP1: IMAGE ROWS =======================================================================
+  // Every angle fills its own rows of the weight matrix (jp = k * prj.Nbp + ...), so we can compute
+  // angles in parallel without any locking. Elements within a row are still added in voxel order.
+  // Exceptions cannot leave a parallel region, so errors are recorded and reported after the loop.
+  int error_num = 0;
+#ifdef STIR_OPENMP
+#  pragma omp parallel firstprivate(vox, bin)
+#endif
+  {
+    float weight;
+    float coeff_att = (float)1.;
+    int jp;
+    float eff;
 
-  for (vox.irow = 0; vox.irow < vol.Nrow; vox.irow++)
-    {
+    //... variables for geometric component ..............................................
 
-      // cout << "weights: " << 100.*(vox.irow+1)/vol.Nrow << "%" << endl;
+    psf1d_type psf1d_h, psf1d_v;
 
-      vox.y = vol.y0 + vox.irow * vol.szcm; // y coordinate of the voxel (index 0->Nrow-1: irow)
+    psf1d_h.maxszb = maxszb;
+    psf1d_h.val = new float[maxszb];
+    psf1d_h.ind = new int[maxszb];
 
-      //=== LOOP2: IMAGE COLUMNS =================================================================
+    if (wmh.do_psf_3d)
+      {
+        psf1d_v.maxszb = maxszb;
+        psf1d_v.val = new float[maxszb];
+        psf1d_v.ind = new int[maxszb];
+      }
 
-      for (vox.icol = 0; vox.icol < vol.Ncol; vox.icol++)
-        {
+    psf2da_type psf;
 
-          vox.x = vol.x0 + vox.icol * vol.szcm;    // x coordinate of the voxel (index 0->Ncol-1: icol)
-          vox.ip = vox.irow * vol.Ncol + vox.icol; // in-plane index of the voxel considering the slice as an array
+    psf.maxszb_h = maxszb;
+    if (wmh.do_psf_3d)
+      psf.maxszb_v = maxszb;
+    else
+      psf.maxszb_v = 1;
+    psf.maxszb_t = psf.maxszb_h * psf.maxszb_v;
 
-          //... to apply mask .........................................
+    psf.val = new float[psf.maxszb_t]; // allocation for PSF values
+    psf.ib = new int[psf.maxszb_t];    // allocation for PSF indices
+    psf.jb = new int[psf.maxszb_t];    // allocation for PSF indices
 
-          if (wmh.do_msk)
-            {
+    //... variables for attenuation component .............................................
 
-              if (!msk_2d[vox.ip])
-                continue; // to skip voxel if it is outside the 2d_mask
-            }
+    attpth_type* attpth = 0; // initialise to avoid compiler warning
+    int sizeattpth = 1;      // initialise to avoid compiler warning
 
-          //=== LOOP3: ANGLES INTO SUBSETS ========================================================
+    if (wmh.do_att || wmh.do_msk_att)
+      {
 
-          for (int k = 0; k < prj.NangOS; k++)
-            {
+        if (!wmh.do_full_att)
+          sizeattpth = 1;
+        else
+          sizeattpth = psf.maxszb_t;
 
-              int ka = wmh.index[k]; // angle index of the current projection (considering the whole set of projections)
+        attpth = new attpth_type[sizeattpth];
+        attpth[0].maxlng = vol.Ncol + vol.Nrow + vol.Nsli; // maximum length of an attenuation path
 
-              //... perpendicular distance form voxel to detection plane ...........................
+        for (int i = 0; i < sizeattpth; i++)
+          {
 
-              vox.dv2dp = vox.x * ang[ka].sin - vox.y * ang[ka].cos + ang[ka].Rrad;
+            attpth[i].dl = new float[attpth[0].maxlng];
+            attpth[i].iv = new int[attpth[0].maxlng];
+            attpth[i].maxlng = attpth[0].maxlng;
+          }
+      }
 
-              if (vox.dv2dp <= 0.)
-                continue; // skipping voxel if it is beyond the detection plane (corner voxels)
+    //=== LOOP1: ANGLES INTO SUBSETS ========================================================
 
-              //... x coordinate in the rotated frame ..............................................
+#ifdef STIR_OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+    for (int k = 0; k < prj.NangOS; k++)
+      {
 
-              vox.x1 = vox.x * ang[ka].cos + vox.y * ang[ka].sin;
+        int ka = wmh.index[k]; // angle index of the current projection (considering the whole set of projections)
 
-              //... to project voxels onto the detection plane and to calculate other distances .....
+        //=== LOOP2: IMAGE ROWS =======================================================================
 
-              voxel_projection(&vox, &eff, prj.lngcmd2, wmh);
+        for (vox.irow = 0; vox.irow < vol.Nrow; vox.irow++)
+          {
 
-              //... setting PSF to zero	.........................................
+            vox.y = vol.y0 + vox.irow * vol.szcm; // y coordinate of the voxel (index 0->Nrow-1: irow)
 
-              //		for ( int i = 0 ; i < nel ; i++ ){
-              //
-              //			psf.val[ i ] = (float)0.;
-              //			psf.ib[ i ]  = psf.jb[ i ] = 0;
-              //		}
+            //=== LOOP3: IMAGE COLUMNS =================================================================
 
-              //... correction for PSF ..............................
+            for (vox.icol = 0; vox.icol < vol.Ncol; vox.icol++)
+              {
 
-              if (!wmh.do_psf)
-                fill_psf_no(&psf, &psf1d_h, vox, &ang[ka], bin.szdx, wmh);
+                vox.x = vol.x0 + vox.icol * vol.szcm;    // x coordinate of the voxel (index 0->Ncol-1: icol)
+                vox.ip = vox.irow * vol.Ncol + vox.icol; // in-plane index of the voxel considering the slice as an array
 
-              else
-                {
+                //... to apply mask .........................................
 
-                  if (wmh.do_psf_3d)
-                    fill_psf_3d(&psf, &psf1d_h, &psf1d_v, vox, gaussdens, bin.szdx, bin.thdx, bin.thcmd2, wmh);
+                if (wmh.do_msk)
+                  {
 
-                  else
-                    fill_psf_2d(&psf, &psf1d_h, vox, gaussdens, bin.szdx, wmh);
-                }
+                    if (!msk_2d[vox.ip])
+                      continue; // to skip voxel if it is outside the 2d_mask
+                  }
 
-              //... correction for attenuation .................................................
+                //... perpendicular distance form voxel to detection plane ...........................
 
-              if (wmh.do_att)
-                {
+                vox.dv2dp = vox.x * ang[ka].sin - vox.y * ang[ka].cos + ang[ka].Rrad;
 
-                  vox.z = (float)0.;
+                if (vox.dv2dp <= 0.)
+                  continue; // skipping voxel if it is beyond the detection plane (corner voxels)
 
-                  if (!wmh.do_full_att)
-                    { // simple correction for attenuation
+                //... x coordinate in the rotated frame ..............................................
 
-                      bin.x
-                          = ang[ka].xbin0
-                            + vox.xd0 * ang[ka].cos; // x coord of the projection of the center of the voxel in the detection line
-                      bin.y = ang[ka].ybin0 + vox.xd0 * ang[ka].sin;
-                      bin.z = (float)0.;
+                vox.x1 = vox.x * ang[ka].cos + vox.y * ang[ka].sin;
 
-                      calc_att_path(bin, vox, vol, &attpth[0]);
-                    }
-                  else
-                    { // full correction for attenuation
+                //... to project voxels onto the detection plane and to calculate other distances .....
 
-                      for (int i = 0; i < psf.Nib; i++)
-                        {
+                voxel_projection(&vox, &eff, prj.lngcmd2, wmh);
 
-                          bin.x = ang[ka].xbin0 + ang[ka].incx * ((float)psf.ib[i] + (float)0.5);
-                          bin.y = ang[ka].ybin0 + ang[ka].incy * ((float)psf.ib[i] + (float)0.5);
-                          bin.z = (float)psf.jb[i] * vox.thcm;
+                //... correction for PSF ..............................
 
-                          calc_att_path(bin, vox, vol, &attpth[i]);
-                        }
-                    }
-                }
+                int nerr;
+                if (!wmh.do_psf)
+                  nerr = fill_psf_no(&psf, &psf1d_h, vox, &ang[ka], bin.szdx, wmh);
 
-              //=== LOOP4: IMAGE SLICES ================================================================
+                else
+                  {
 
-              for (vox.islc = vol.first_sl; vox.islc < vol.last_sl; vox.islc++)
-                {
+                    if (wmh.do_psf_3d)
+                      nerr = fill_psf_3d(&psf, &psf1d_h, &psf1d_v, vox, gaussdens, bin.szdx, bin.thdx, bin.thcmd2, wmh);
 
-                  vox.iv = vox.ip + vox.islc * vol.Npix; // volume index of the voxel (volume as an array)
+                    else
+                      nerr = fill_psf_2d(&psf, &psf1d_h, vox, gaussdens, bin.szdx, wmh);
+                  }
 
-                  if (wmh.do_msk)
-                    {
-                      if (!msk_3d[vox.iv])
-                        continue;
-                    }
+                if (nerr != 0)
+                  {
+                    record_error_weight3d(error_num, nerr);
+                    continue;
+                  }
 
-                  if (wmh.do_att && !wmh.do_full_att)
-                    coeff_att = calc_att(&attpth[0], attmap, vox.islc, wmh);
+                //... correction for attenuation .................................................
 
-                  //... weight matrix values calculation .......................................
+                if (wmh.do_att)
+                  {
 
-                  for (int ie = 0; ie < psf.Nib; ie++)
-                    {
+                    vox.z = (float)0.;
 
-                      if (psf.ib[ie] < 0)
-                        continue;
-                      if (psf.ib[ie] >= prj.Nbin)
-                        continue;
+                    if (!wmh.do_full_att)
+                      { // simple correction for attenuation
 
-                      int ks = (vox.islc + psf.jb[ie]);
+                        bin.x = ang[ka].xbin0
+                                + vox.xd0 * ang[ka].cos; // x coord of the projection of the center of the voxel in the detection line
+                        bin.y = ang[ka].ybin0 + vox.xd0 * ang[ka].sin;
+                        bin.z = (float)0.;
 
-                      if (ks < 0)
-                        continue;
-                      if (ks >= vol.Nsli)
+                        nerr = calc_att_path(bin, vox, vol, &attpth[0]);
+                      }
+                    else
+                      { // full correction for attenuation
+
+                        for (int i = 0; i < psf.Nib && nerr == 0; i++)
+                          {
+
+                            bin.x = ang[ka].xbin0 + ang[ka].incx * ((float)psf.ib[i] + (float)0.5);
+                            bin.y = ang[ka].ybin0 + ang[ka].incy * ((float)psf.ib[i] + (float)0.5);
+                            bin.z = (float)psf.jb[i] * vox.thcm;
+
+                            nerr = calc_att_path(bin, vox, vol, &attpth[i]);
+                          }
+                      }
+
+                    if (nerr != 0)
+                      {
+                        record_error_weight3d(error_num, nerr);
                         continue;
+                      }
+                  }
 
-                      jp = k * prj.Nbp + ks * prj.Nbin + psf.ib[ie];
+                //=== LOOP4: IMAGE SLICES ================================================================
 
-                      if (wmh.do_full_att)
-                        coeff_att = calc_att(&attpth[ie], attmap, vox.islc, wmh);
+                for (vox.islc = vol.first_sl; vox.islc < vol.last_sl; vox.islc++)
+                  {
 
-                      weight = psf.val[ie] * eff * coeff_att;
+                    vox.iv = vox.ip + vox.islc * vol.Npix; // volume index of the voxel (volume as an array)
 
-                      //... fill image STIR indices ...........................
+                    if (wmh.do_msk)
+                      {
+                        if (!msk_3d[vox.iv])
+                          continue;
+                      }
 
-                      if (wm.do_save_STIR)
-                        {
-                          stir::InvertAxis invert;
-                          wm.nx[vox.iv] = (short int)invert.invert_axis_index(
-                              (vox.icol - (int)floor(vol.Ncold2)), vol.Ncold2 * 2, "x");  // centered index for STIR format
-                          wm.ny[vox.iv] = (short int)(vox.irow - (int)floor(vol.Nrowd2)); // centered index for STIR format
-                          wm.nz[vox.iv] = (short int)vox.islc;                            // non-centered index for STIR format
-                        }
+                    if (wmh.do_att && !wmh.do_full_att)
+                      coeff_att = calc_att(&attpth[0], attmap, vox.islc, wmh);
 
-                      //... fill wm values .....................
+                    //... weight matrix values calculation .......................................
 
-                      wm.col[jp][wm.ne[jp]] = vox.iv;
-                      wm.val[jp][wm.ne[jp]] = weight;
-                      wm.ne[jp]++;
+                    for (int ie = 0; ie < psf.Nib; ie++)
+                      {
 
-                      if (wm.ne[jp] >= NITEMS[jp])
-                        error_weight3d(45, "");
-                    }
-                } // end of LOOP4: image slices
-            }     // end of LOOP3: projection angle into subset
-        }         // end of LOOP2: image rows
-    }             // end of LOOP1: image cols
+                        if (psf.ib[ie] < 0)
+                          continue;
+                        if (psf.ib[ie] >= prj.Nbin)
+                          continue;
 
-  //... detele allocated memory ..............
+                        int ks = (vox.islc + psf.jb[ie]);
 
-  delete[] psf1d_h.val;
-  delete[] psf1d_h.ind;
+                        if (ks < 0)
+                          continue;
+                        if (ks >= vol.Nsli)
+                          continue;
 
-  if (wmh.do_psf_3d)
-    {
-      delete[] psf1d_v.val;
-      delete[] psf1d_v.ind;
-    }
+                        jp = k * prj.Nbp + ks * prj.Nbin + psf.ib[ie];
 
-  delete[] psf.val;
-  delete[] psf.ib;
-  delete[] psf.jb;
+                        if (wmh.do_full_att)
+                          coeff_att = calc_att(&attpth[ie], attmap, vox.islc, wmh);
 
-  if (wmh.do_att)
-    {
-      for (int i = 0; i < sizeattpth; i++)
-        {
-          delete[] attpth[i].dl;
-          delete[] attpth[i].iv;
-        }
-      delete[] attpth;
-    }
+                        weight = psf.val[ie] * eff * coeff_att;
+
+                        //... fill wm values .....................
+
+                        // NITEMS includes 1 spare element, see ProjMatrixByBinSPECTUB
+                        if (wm.ne[jp] + 1 >= NITEMS[jp])
+                          {
+                            record_error_weight3d(error_num, 45);
+                            continue;
+                          }
+
+                        wm.col[jp][wm.ne[jp]] = vox.iv;
+                        wm.val[jp][wm.ne[jp]] = weight;
+                        wm.ne[jp]++;
+                      }
+                  } // end of LOOP4: image slices
+              }     // end of LOOP3: image cols
+          }         // end of LOOP2: image rows
+      }             // end of LOOP1: projection angle into subset
+
+    //... detele allocated memory ..............
+
+    delete[] psf1d_h.val;
+    delete[] psf1d_h.ind;
+
+    if (wmh.do_psf_3d)
+      {
+        delete[] psf1d_v.val;
+        delete[] psf1d_v.ind;
+      }
+
+    delete[] psf.val;
+    delete[] psf.ib;
+    delete[] psf.jb;
+
+    if (wmh.do_att || wmh.do_msk_att)
+      {
+        for (int i = 0; i < sizeattpth; i++)
+          {
+            delete[] attpth[i].dl;
+            delete[] attpth[i].iv;
+          }
+        delete[] attpth;
+      }
+  } // end of parallel region
+
+  if (error_num != 0)
+    error_weight3d(error_num, "");
 }
 
 //=============================================================================
@@ -366,158 +406,171 @@ wm_size_estimation(int kOS,
                    const wmh_type& wmh,
                    const float* Rrad)
 {
-  int jp;
-  float eff;
+  // As in wm_calculation, every angle only touches its own rows, so angles can be handled in parallel.
+  int error_num = 0;
+#ifdef STIR_OPENMP
+#  pragma omp parallel firstprivate(vox, bin)
+#endif
+  {
+    int jp;
+    float eff;
 
-  //... variables for geometric component ..............................................
+    //... variables for geometric component ..............................................
 
-  psf1d_type psf1d_h, psf1d_v;
+    psf1d_type psf1d_h, psf1d_v;
 
-  psf1d_h.maxszb = maxszb;
-  psf1d_h.val = new float[maxszb];
-  psf1d_h.ind = new int[maxszb];
+    psf1d_h.maxszb = maxszb;
+    psf1d_h.val = new float[maxszb];
+    psf1d_h.ind = new int[maxszb];
 
-  if (wmh.do_psf_3d)
-    {
-      psf1d_v.maxszb = maxszb;
-      psf1d_v.val = new float[maxszb];
-      psf1d_v.ind = new int[maxszb];
-    }
+    if (wmh.do_psf_3d)
+      {
+        psf1d_v.maxszb = maxszb;
+        psf1d_v.val = new float[maxszb];
+        psf1d_v.ind = new int[maxszb];
+      }
 
-  psf2da_type psf;
+    psf2da_type psf;
 
-  psf.maxszb_h = maxszb;
-  if (wmh.do_psf_3d)
-    psf.maxszb_v = maxszb;
-  else
-    psf.maxszb_v = 1;
-  psf.maxszb_t = psf.maxszb_h * psf.maxszb_v;
+    psf.maxszb_h = maxszb;
+    if (wmh.do_psf_3d)
+      psf.maxszb_v = maxszb;
+    else
+      psf.maxszb_v = 1;
+    psf.maxszb_t = psf.maxszb_h * psf.maxszb_v;
 
-  psf.val = new float[psf.maxszb_t]; // allocation for PSF values
-  psf.ib = new int[psf.maxszb_t];    // allocation for PSF indices
-  psf.jb = new int[psf.maxszb_t];    // allocation for PSF indices
+    psf.val = new float[psf.maxszb_t]; // allocation for PSF values
+    psf.ib = new int[psf.maxszb_t];    // allocation for PSF indices
+    psf.jb = new int[psf.maxszb_t];    // allocation for PSF indices
 
-  //=== LOOP1: IMAGE ROWS =======================================================================
+    //=== LOOP1: ANGLES INTO SUBSETS ========================================================
 
-  for (vox.irow = 0; vox.irow < vol.Nrow; vox.irow++)
-    {
+#ifdef STIR_OPENMP
+#  pragma omp for schedule(dynamic)
+#endif
+    for (int k = 0; k < prj.NangOS; k++)
+      {
 
-      vox.y = vol.y0 + vox.irow * vol.szcm; // y coordinate of the voxel (index 0->Nrow-1: irow)
+        int ka = wmh.index[k]; // angle index of the current projection (considering the whole set of projections)
 
-      //=== LOOP2: IMAGE COLUMNS =================================================================
+        //=== LOOP2: IMAGE ROWS =======================================================================
 
-      for (vox.icol = 0; vox.icol < vol.Ncol; vox.icol++)
-        {
+        for (vox.irow = 0; vox.irow < vol.Nrow; vox.irow++)
+          {
 
-          vox.x = vol.x0 + vox.icol * vol.szcm;    // x coordinate of the voxel (index 0->Ncol-1: icol)
-          vox.ip = vox.irow * vol.Ncol + vox.icol; // in-plane index of the voxel considering the slice as an array
+            vox.y = vol.y0 + vox.irow * vol.szcm; // y coordinate of the voxel (index 0->Nrow-1: irow)
 
-          //... to apply mask .........................................
+            //=== LOOP3: IMAGE COLUMNS =================================================================
 
-          if (wmh.do_msk)
-            {
+            for (vox.icol = 0; vox.icol < vol.Ncol; vox.icol++)
+              {
 
-              if (!msk_2d[vox.ip])
-                continue; // to skip voxel if it is outside the 2d_mask
-            }
+                vox.x = vol.x0 + vox.icol * vol.szcm;    // x coordinate of the voxel (index 0->Ncol-1: icol)
+                vox.ip = vox.irow * vol.Ncol + vox.icol; // in-plane index of the voxel considering the slice as an array
 
-          //=== LOOP3: ANGLES INTO SUBSETS ========================================================
+                //... to apply mask .........................................
 
-          for (int k = 0; k < prj.NangOS; k++)
-            {
+                if (wmh.do_msk)
+                  {
 
-              int ka = wmh.index[k]; // angle index of the current projection (considering the whole set of projections)
+                    if (!msk_2d[vox.ip])
+                      continue; // to skip voxel if it is outside the 2d_mask
+                  }
 
-              //... perpendicular distance form voxel to detection plane ...........................
+                //... perpendicular distance form voxel to detection plane ...........................
 
-              vox.dv2dp = vox.x * ang[ka].sin - vox.y * ang[ka].cos + ang[ka].Rrad;
+                vox.dv2dp = vox.x * ang[ka].sin - vox.y * ang[ka].cos + ang[ka].Rrad;
 
-              if (vox.dv2dp <= 0.)
-                continue; // skipping voxel if it is beyond the detection plane (corner voxels)
+                if (vox.dv2dp <= 0.)
+                  continue; // skipping voxel if it is beyond the detection plane (corner voxels)
 
-              //... x coordinate in the rotated frame ..............................................
+                //... x coordinate in the rotated frame ..............................................
 
-              vox.x1 = vox.x * ang[ka].cos + vox.y * ang[ka].sin;
+                vox.x1 = vox.x * ang[ka].cos + vox.y * ang[ka].sin;
 
-              //... to project voxels onto the detection plane and to calculate other distances .....
+                //... to project voxels onto the detection plane and to calculate other distances .....
 
-              voxel_projection(&vox, &eff, prj.lngcmd2, wmh);
+                voxel_projection(&vox, &eff, prj.lngcmd2, wmh);
 
-              //... setting PSF to zero	.........................................
+                //... correction for PSF ..............................
 
-              //				for ( int i = 0 ; i < psf.maxszb ; i++ ){
-              //					psf.val[ i ] = (float) 0.;
-              //					psf.ib[ i ] = psf.jb[ i ] = 0;
-              //				}
+                int nerr;
+                if (!wmh.do_psf)
+                  nerr = fill_psf_no(&psf, &psf1d_h, vox, &ang[ka], bin.szdx, wmh);
 
-              //... correction for PSF ..............................
+                else
+                  {
 
-              if (!wmh.do_psf)
-                fill_psf_no(&psf, &psf1d_h, vox, &ang[ka], bin.szdx, wmh);
+                    if (wmh.do_psf_3d)
+                      nerr = fill_psf_3d(&psf, &psf1d_h, &psf1d_v, vox, gaussdens, bin.szdx, bin.thdx, bin.thcmd2, wmh);
 
-              else
-                {
+                    else
+                      nerr = fill_psf_2d(&psf, &psf1d_h, vox, gaussdens, bin.szdx, wmh);
+                  }
 
-                  if (wmh.do_psf_3d)
-                    fill_psf_3d(&psf, &psf1d_h, &psf1d_v, vox, gaussdens, bin.szdx, bin.thdx, bin.thcmd2, wmh);
+                if (nerr != 0)
+                  {
+                    record_error_weight3d(error_num, nerr);
+                    continue;
+                  }
 
-                  else
-                    fill_psf_2d(&psf, &psf1d_h, vox, gaussdens, bin.szdx, wmh);
-                }
+                //=== LOOP4: IMAGE SLICES ================================================================
 
-              //=== LOOP4: IMAGE SLICES ================================================================
+                for (vox.islc = vol.first_sl; vox.islc < vol.last_sl; vox.islc++)
+                  {
 
-              for (vox.islc = vol.first_sl; vox.islc < vol.last_sl; vox.islc++)
-                {
+                    vox.iv = vox.ip + vox.islc * vol.Npix; // volume index of the voxel (volume as an array)
 
-                  vox.iv = vox.ip + vox.islc * vol.Npix; // volume index of the voxel (volume as an array)
+                    if (wmh.do_msk)
+                      {
+                        if (!msk_3d[vox.iv])
+                          continue;
+                      }
 
-                  if (wmh.do_msk)
-                    {
-                      if (!msk_3d[vox.iv])
-                        continue;
-                    }
+                    //... weight matrix values calculation .......................................
 
-                  //... weight matrix values calculation .......................................
+                    for (int ie = 0; ie < psf.Nib; ie++)
+                      {
 
-                  for (int ie = 0; ie < psf.Nib; ie++)
-                    {
+                        if (psf.ib[ie] < 0)
+                          continue;
+                        if (psf.ib[ie] >= prj.Nbin)
+                          continue;
 
-                      if (psf.ib[ie] < 0)
-                        continue;
-                      if (psf.ib[ie] >= prj.Nbin)
-                        continue;
+                        int ks = (vox.islc + psf.jb[ie]);
 
-                      int ks = (vox.islc + psf.jb[ie]);
+                        if (ks < 0)
+                          continue;
+                        if (ks >= vol.Nsli)
+                          continue;
 
-                      if (ks < 0)
-                        continue;
-                      if (ks >= vol.Nsli)
-                        continue;
+                        jp = k * prj.Nbp + ks * prj.Nbin + psf.ib[ie];
 
-                      jp = k * prj.Nbp + ks * prj.Nbin + psf.ib[ie];
+                        NITEMS[jp]++;
+                      }
+                  }
+              } // end of LOOP3: image cols
+          }     // end of LOOP2: image rows
+      }         // end of LOOP1: projection angle into subset
 
-                      NITEMS[jp]++;
-                    }
-                }
-            } // end of LOOP3: projection angle into subset
-        }     // end of LOOP2: image rows
-    }         // end of LOOP1: image cols
+    //... detele allocated memory ..............
 
-  //... detele allocated memory ..............
+    delete[] psf1d_h.val;
+    delete[] psf1d_h.ind;
 
-  delete[] psf1d_h.val;
-  delete[] psf1d_h.ind;
+    if (wmh.do_psf_3d)
+      {
+        delete[] psf1d_v.val;
+        delete[] psf1d_v.ind;
+      }
 
-  if (wmh.do_psf_3d)
-    {
-      delete[] psf1d_v.val;
-      delete[] psf1d_v.ind;
-    }
+    delete[] psf.val;
+    delete[] psf.ib;
+    delete[] psf.jb;
+  } // end of parallel region
 
-  delete[] psf.val;
-  delete[] psf.ib;
-  delete[] psf.jb;
+  if (error_num != 0)
+    error_weight3d(error_num, "");
 }
 
 //==========================================================================
@@ -643,7 +696,7 @@ voxel_projection(voxel_type* vox, float* eff, float lngcmd2, const wmh_type& wmh
 //=== fill_psf_no ==========================================================
 //==========================================================================
 
-void
+int
 fill_psf_no(
     psf2da_type* psf, psf1d_type* psf1d_h, const voxel_type& vox, angle_type const* const ang, float szdx, const wmh_type& wmh)
 {
@@ -661,7 +714,8 @@ fill_psf_no(
   psf1d_h->lngcmd2 = psf1d_h->lngcm / (float)2.;
   psf1d_h->efres = ang->vxprj.res * psf1d_h->sgmcm; // to resize discretization resolution once applied sgmcm
 
-  calc_psf_bin(vox.xd0, wmh.prj.szcm, &ang->vxprj, psf1d_h, wmh);
+  if (const int nerr = calc_psf_bin(vox.xd0, wmh.prj.szcm, &ang->vxprj, psf1d_h, wmh))
+    return nerr;
 
   for (int ie = 0; ie < psf1d_h->Nib; ie++)
     {
@@ -671,13 +725,14 @@ fill_psf_no(
       psf->jb[ie] = 0;
     }
   psf->Nib = psf1d_h->Nib;
+  return 0;
 }
 
 //==========================================================================
 //=== fill_psf_2d ==========================================================
 //==========================================================================
 
-void
+int
 fill_psf_2d(psf2da_type* psf,
             psf1d_type* psf1d_h,
             const voxel_type& vox,
@@ -694,7 +749,8 @@ fill_psf_2d(psf2da_type* psf,
 
   psf1d_h->efres = gaussdens->res * psf1d_h->sgmcm;
 
-  calc_psf_bin(vox.xd0, wmh.prj.szcm, gaussdens, psf1d_h, wmh);
+  if (const int nerr = calc_psf_bin(vox.xd0, wmh.prj.szcm, gaussdens, psf1d_h, wmh))
+    return nerr;
 
   for (int ie = 0; ie < psf1d_h->Nib; ie++)
     {
@@ -704,13 +760,14 @@ fill_psf_2d(psf2da_type* psf,
       psf->jb[ie] = 0;
     }
   psf->Nib = psf1d_h->Nib;
+  return 0;
 }
 
 //==========================================================================
 //=== fill_psf_3d ==========================================================
 //==========================================================================
 
-void
+int
 fill_psf_3d(psf2da_type* psf,
             psf1d_type* psf1d_h,
             psf1d_type* psf1d_v,
@@ -739,7 +796,8 @@ fill_psf_3d(psf2da_type* psf,
 
   //... calculation of the horizontal component of psf ...................
 
-  calc_psf_bin(vox.xd0, wmh.prj.szcm, gaussdens, psf1d_h, wmh);
+  if (const int nerr = calc_psf_bin(vox.xd0, wmh.prj.szcm, gaussdens, psf1d_h, wmh))
+    return nerr;
 
   //... vertical component ..............................
 
@@ -758,7 +816,8 @@ fill_psf_3d(psf2da_type* psf,
 
   //... calculation of the vertical component of psf ....................
 
-  calc_psf_bin(thcmd2, wmh.prj.thcm, gaussdens, psf1d_v, wmh);
+  if (const int nerr = calc_psf_bin(thcmd2, wmh.prj.thcm, gaussdens, psf1d_v, wmh))
+    return nerr;
 
   //... mixing and setting PSF area to 1 (to correct for tail truncation of Gaussian function) .....
 
@@ -797,13 +856,14 @@ fill_psf_3d(psf2da_type* psf,
 
   for (int i = 0; i < ip; i++)
     psf->val[i] /= area;
+  return 0;
 }
 
 //==========================================================================
 //=== calc_psf_bin =========================================================
 //==========================================================================
 
-void
+int
 calc_psf_bin(float center_psf, float binszcm, discrf_type const* const vxprj, psf1d_type* psf, const SPECTUB::wmh_type& wmh)
 {
   float weight, preval;
@@ -866,17 +926,18 @@ calc_psf_bin(float center_psf, float binszcm, discrf_type const* const vxprj, ps
     }
 
   if (ip >= psf->maxszb)
-    error_weight3d(47, "");
+    return 47;
   for (int i = 0; i < ip; i++)
     psf->val[i] /= area;
   psf->Nib = ip;
+  return 0;
 }
 
 //=============================================================================
 //=== cal_att_path ============================================================
 //=============================================================================
 
-void
+int
 calc_att_path(const bin_type& bin, const voxel_type& vox, const volume_type& vol, attpth_type* attpth)
 {
   float dx, dy, dz;
@@ -968,14 +1029,14 @@ calc_att_path(const bin_type& bin, const voxel_type& vox, const volume_type& vol
         {
 
           attpth->lng = ni;
-          return;
+          return 0;
         }
 
       else
         {
 
           if (ni >= attpth->maxlng)
-            error_weight3d(49, "");
+            return 49;
 
           attpth->iv[ni] = iv;
 
@@ -1003,7 +1064,7 @@ calc_att_path(const bin_type& bin, const voxel_type& vox, const volume_type& vol
               dz = (next_z - vox.z) / (uz + EPSILON);
               break;
             default:
-              error_weight3d(40, "");
+              return 40;
             }
           ni++;
         }
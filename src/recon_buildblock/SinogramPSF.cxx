@@ -0,0 +1,303 @@
+/*!
+  \file
+  \ingroup projection
+
+  \brief Implementation of class stir::SinogramPSF
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+
+#include "stir/recon_buildblock/SinogramPSF.h"
+#include "stir/ProjDataInfo.h"
+#include "stir/Viewgram.h"
+#include "stir/Bin.h"
+#include "stir/detail/convolve_lines.h"
+#include "stir/error.h"
+#include <boost/format.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+START_NAMESPACE_STIR
+
+//! kernels are truncated where the Gaussian is smaller than this fraction of its maximum
+static const double kernel_truncation_level = 1.E-3;
+
+//! returns the distance (in units of the standard deviation) where the kernels are truncated
+static double
+truncation_distance_in_sigmas()
+{
+  return std::sqrt(-2 * std::log(kernel_truncation_level));
+}
+
+static double
+fwhm_to_sigma(const double fwhm)
+{
+  return fwhm / std::sqrt(8 * std::log(2.));
+}
+
+SinogramPSF::SinogramPSF()
+    : tangential_fwhm(0.F),
+      tangential_fwhm_slope(0.F),
+      axial_fwhm(0.F),
+      _already_set_up(false)
+{}
+
+SinogramPSF::SinogramPSF(const float tangential_fwhm, const float axial_fwhm, const float tangential_fwhm_slope)
+    : tangential_fwhm(tangential_fwhm),
+      tangential_fwhm_slope(tangential_fwhm_slope),
+      axial_fwhm(axial_fwhm),
+      _already_set_up(false)
+{}
+
+float
+SinogramPSF::get_tangential_fwhm() const
+{
+  return tangential_fwhm;
+}
+
+void
+SinogramPSF::set_tangential_fwhm(const float v)
+{
+  tangential_fwhm = v;
+  _already_set_up = false;
+}
+
+float
+SinogramPSF::get_tangential_fwhm_slope() const
+{
+  return tangential_fwhm_slope;
+}
+
+void
+SinogramPSF::set_tangential_fwhm_slope(const float v)
+{
+  tangential_fwhm_slope = v;
+  _already_set_up = false;
+}
+
+float
+SinogramPSF::get_axial_fwhm() const
+{
+  return axial_fwhm;
+}
+
+void
+SinogramPSF::set_axial_fwhm(const float v)
+{
+  axial_fwhm = v;
+  _already_set_up = false;
+}
+
+bool
+SinogramPSF::is_trivial() const
+{
+  return tangential_fwhm <= 0 && tangential_fwhm_slope <= 0 && axial_fwhm <= 0;
+}
+
+void
+SinogramPSF::set_up(const ProjDataInfo& proj_data_info)
+{
+  if (tangential_fwhm < 0 || axial_fwhm < 0 || tangential_fwhm_slope < 0)
+    error("SinogramPSF: FWHMs and slope need to be non-negative");
+
+  const int min_tang_pos_num = proj_data_info.get_min_tangential_pos_num();
+  const int max_tang_pos_num = proj_data_info.get_max_tangential_pos_num();
+  const int view_num = proj_data_info.get_min_view_num();
+
+  tangential_kernels = VectorWithOffset<VectorWithOffset<float>>();
+  if (tangential_fwhm > 0 || tangential_fwhm_slope > 0)
+    {
+      tangential_kernels.grow(min_tang_pos_num, max_tang_pos_num);
+      VectorWithOffset<float> s(min_tang_pos_num, max_tang_pos_num);
+      VectorWithOffset<float> sampling_in_s(min_tang_pos_num, max_tang_pos_num);
+      for (int t = min_tang_pos_num; t <= max_tang_pos_num; ++t)
+        {
+          const Bin bin(0, view_num, 0, t);
+          s[t] = proj_data_info.get_s(bin);
+          sampling_in_s[t] = proj_data_info.get_sampling_in_s(bin);
+        }
+
+      for (int t = min_tang_pos_num; t <= max_tang_pos_num; ++t)
+        {
+          VectorWithOffset<float>& kernel = tangential_kernels[t];
+          const double sigma = fwhm_to_sigma(tangential_fwhm + tangential_fwhm_slope * std::fabs(s[t]));
+          if (sigma <= 0)
+            {
+              kernel.grow(0, 0);
+              kernel[0] = 1.F;
+              continue;
+            }
+          const double max_distance = sigma * truncation_distance_in_sigmas();
+          // find range of input tangential positions t-j in the kernel
+          int j_min = 0;
+          int j_max = 0;
+          for (int in_t = min_tang_pos_num; in_t <= max_tang_pos_num; ++in_t)
+            if (std::fabs(s[t] - s[in_t]) <= max_distance)
+              {
+                j_min = std::min(j_min, t - in_t);
+                j_max = std::max(j_max, t - in_t);
+              }
+          kernel.grow(j_min, j_max);
+          double sum = 0.;
+          for (int j = j_min; j <= j_max; ++j)
+            {
+              const double distance = s[t] - s[t - j];
+              const double value = std::exp(-distance * distance / (2 * sigma * sigma)) * sampling_in_s[t - j];
+              kernel[j] = static_cast<float>(value);
+              sum += value;
+            }
+          for (int j = kernel.get_min_index(); j <= kernel.get_max_index(); ++j)
+            kernel[j] = static_cast<float>(kernel[j] / sum);
+        }
+    }
+
+  axial_kernels = VectorWithOffset<VectorWithOffset<float>>();
+  if (axial_fwhm > 0)
+    {
+      axial_kernels.grow(proj_data_info.get_min_segment_num(), proj_data_info.get_max_segment_num());
+      const double sigma = fwhm_to_sigma(axial_fwhm);
+      for (int segment_num = proj_data_info.get_min_segment_num(); segment_num <= proj_data_info.get_max_segment_num();
+           ++segment_num)
+        {
+          const Bin bin(segment_num, view_num, proj_data_info.get_min_axial_pos_num(segment_num), 0);
+          const double sampling_in_m = proj_data_info.get_sampling_in_m(bin);
+          if (sampling_in_m <= 0)
+            error(boost::format("SinogramPSF: cannot handle axial sampling %1% in segment %2%") % sampling_in_m % segment_num);
+          const int half_length = static_cast<int>(std::floor(sigma * truncation_distance_in_sigmas() / sampling_in_m));
+          VectorWithOffset<float>& kernel = axial_kernels[segment_num];
+          kernel.grow(-half_length, half_length);
+          double sum = 0.;
+          for (int j = -half_length; j <= half_length; ++j)
+            {
+              const double distance = j * sampling_in_m;
+              const double value = std::exp(-distance * distance / (2 * sigma * sigma));
+              kernel[j] = static_cast<float>(value);
+              sum += value;
+            }
+          for (int j = kernel.get_min_index(); j <= kernel.get_max_index(); ++j)
+            kernel[j] = static_cast<float>(kernel[j] / sum);
+        }
+    }
+  _already_set_up = true;
+}
+
+void
+SinogramPSF::check_set_up(const Viewgram<float>& viewgram) const
+{
+  if (!_already_set_up)
+    error("SinogramPSF: set_up() needs to be called first");
+  if (tangential_kernels.get_length() > 0
+      && (viewgram.get_min_tangential_pos_num() < tangential_kernels.get_min_index()
+          || viewgram.get_max_tangential_pos_num() > tangential_kernels.get_max_index()))
+    error("SinogramPSF: tangential range of viewgram does not correspond to set_up()");
+  if (axial_kernels.get_length() > 0
+      && (viewgram.get_segment_num() < axial_kernels.get_min_index() || viewgram.get_segment_num() > axial_kernels.get_max_index()))
+    error("SinogramPSF: segment of viewgram does not correspond to set_up()");
+}
+
+void
+SinogramPSF::apply_axial(Viewgram<float>& viewgram,
+                         const int min_axial_pos_num,
+                         const int max_axial_pos_num,
+                         const int min_tangential_pos_num,
+                         const int max_tangential_pos_num) const
+{
+  if (axial_kernels.get_length() == 0)
+    return;
+  const VectorWithOffset<float>& kernel = axial_kernels[viewgram.get_segment_num()];
+  if (kernel.get_length() <= 1)
+    return;
+  const int num_axial_poss = max_axial_pos_num - min_axial_pos_num + 1;
+  const int num_tang_poss = max_tangential_pos_num - min_tangential_pos_num + 1;
+  if (num_axial_poss <= 0 || num_tang_poss <= 0)
+    return;
+
+  std::vector<float> lines(static_cast<std::size_t>(num_axial_poss) * num_tang_poss);
+  std::vector<float> filtered_lines(lines.size());
+  for (int a = min_axial_pos_num; a <= max_axial_pos_num; ++a)
+    std::copy(viewgram[a].begin() + (min_tangential_pos_num - viewgram.get_min_tangential_pos_num()),
+              viewgram[a].begin() + (max_tangential_pos_num + 1 - viewgram.get_min_tangential_pos_num()),
+              lines.begin() + static_cast<std::size_t>(a - min_axial_pos_num) * num_tang_poss);
+  detail::convolve_lines(&filtered_lines[0],
+                         &lines[0],
+                         num_axial_poss,
+                         num_tang_poss,
+                         &*kernel.begin(),
+                         kernel.get_min_index(),
+                         kernel.get_max_index(),
+                         BoundaryConditions::zero);
+  for (int a = min_axial_pos_num; a <= max_axial_pos_num; ++a)
+    std::copy(filtered_lines.begin() + static_cast<std::size_t>(a - min_axial_pos_num) * num_tang_poss,
+              filtered_lines.begin() + static_cast<std::size_t>(a - min_axial_pos_num + 1) * num_tang_poss,
+              viewgram[a].begin() + (min_tangential_pos_num - viewgram.get_min_tangential_pos_num()));
+}
+
+void
+SinogramPSF::apply(Viewgram<float>& viewgram,
+                   const int min_axial_pos_num,
+                   const int max_axial_pos_num,
+                   const int min_tangential_pos_num,
+                   const int max_tangential_pos_num) const
+{
+  check_set_up(viewgram);
+  if (tangential_kernels.get_length() > 0)
+    {
+      VectorWithOffset<float> new_row(min_tangential_pos_num, max_tangential_pos_num);
+      for (int a = min_axial_pos_num; a <= max_axial_pos_num; ++a)
+        {
+          const Array<1, float>& row = viewgram[a];
+          for (int t = min_tangential_pos_num; t <= max_tangential_pos_num; ++t)
+            {
+              const VectorWithOffset<float>& kernel = tangential_kernels[t];
+              float sum = 0.F;
+              for (int j = std::max(kernel.get_min_index(), t - max_tangential_pos_num);
+                   j <= std::min(kernel.get_max_index(), t - min_tangential_pos_num);
+                   ++j)
+                sum += kernel[j] * row[t - j];
+              new_row[t] = sum;
+            }
+          std::copy(new_row.begin(), new_row.end(), viewgram[a].begin() + (min_tangential_pos_num - row.get_min_index()));
+        }
+    }
+  apply_axial(viewgram, min_axial_pos_num, max_axial_pos_num, min_tangential_pos_num, max_tangential_pos_num);
+}
+
+void
+SinogramPSF::apply_transpose(Viewgram<float>& viewgram,
+                             const int min_axial_pos_num,
+                             const int max_axial_pos_num,
+                             const int min_tangential_pos_num,
+                             const int max_tangential_pos_num) const
+{
+  check_set_up(viewgram);
+  // the axial kernels are symmetric, so the transpose is the same operation
+  apply_axial(viewgram, min_axial_pos_num, max_axial_pos_num, min_tangential_pos_num, max_tangential_pos_num);
+  if (tangential_kernels.get_length() > 0)
+    {
+      VectorWithOffset<float> new_row(min_tangential_pos_num, max_tangential_pos_num);
+      for (int a = min_axial_pos_num; a <= max_axial_pos_num; ++a)
+        {
+          const Array<1, float>& row = viewgram[a];
+          new_row.fill(0.F);
+          for (int t = min_tangential_pos_num; t <= max_tangential_pos_num; ++t)
+            {
+              const VectorWithOffset<float>& kernel = tangential_kernels[t];
+              const float value = row[t];
+              for (int j = std::max(kernel.get_min_index(), t - max_tangential_pos_num);
+                   j <= std::min(kernel.get_max_index(), t - min_tangential_pos_num);
+                   ++j)
+                new_row[t - j] += kernel[j] * value;
+            }
+          std::copy(new_row.begin(), new_row.end(), viewgram[a].begin() + (min_tangential_pos_num - row.get_min_index()));
+        }
+    }
+}
+
+END_NAMESPACE_STIR
@@ -44,6 +44,7 @@
 #include "stir/ViewSegmentNumbers.h"
 #include "stir/CPUTimer.h"
 #include "stir/HighResWallClockTimer.h"
+#include "stir/Profiler.h"
 #include "stir/recon_buildblock/ForwardProjectorByBin.h"
 #include "stir/recon_buildblock/BackProjectorByBin.h"
 #include "stir/recon_buildblock/BinNormalisation.h"
@@ -74,6 +75,13 @@
 
 START_NAMESPACE_STIR
 
+#ifdef STIR_MPI
+// data that the slaves have read themselves (see setup_distributable_computation_local_data())
+static shared_ptr<ProjData> local_proj_data_sptr;
+static shared_ptr<ProjData> local_additive_proj_data_sptr;
+static shared_ptr<BinNormalisation> local_normalisation_sptr;
+#endif
+
 /* WARNING: the sequence of steps here has to match what is on the receiving end
    in DistributedWorker */
 void
@@ -92,6 +100,10 @@ setup_distributable_computation(const shared_ptr<ProjectorByBinPair>& proj_pair_
 
 #ifdef STIR_MPI
   distributed::first_iteration = true;
+  // the slaves forget about their local data as well
+  local_proj_data_sptr.reset();
+  local_additive_proj_data_sptr.reset();
+  local_normalisation_sptr.reset();
 
   // broadcast type of computation (currently only 1 available)
   distributed::send_int_value(task_setup_distributable_computation, -1);
@@ -128,6 +140,48 @@ setup_distributable_computation(const shared_ptr<ProjectorByBinPair>& proj_pair_
 #endif // STIR_MPI
 }
 
+void
+setup_distributable_computation_local_data(const shared_ptr<ProjData>& proj_data_sptr,
+                                           const std::string& proj_data_filename,
+                                           const shared_ptr<ProjData>& additive_proj_data_sptr,
+                                           const std::string& additive_proj_data_filename,
+                                           const shared_ptr<BinNormalisation>& normalisation_sptr)
+{
+#ifdef STIR_MPI
+  local_proj_data_sptr.reset();
+  local_additive_proj_data_sptr.reset();
+  local_normalisation_sptr.reset();
+  if (proj_data_filename.empty() || is_null_ptr(proj_data_sptr))
+    return;
+
+  distributed::send_int_value(task_setup_distributable_local_data, -1);
+
+  distributed::send_string(proj_data_filename, LOCAL_DATA_FILENAME_TAG, -1);
+  local_proj_data_sptr = proj_data_sptr;
+
+  if (!is_null_ptr(additive_proj_data_sptr) && !additive_proj_data_filename.empty())
+    {
+      distributed::send_string(additive_proj_data_filename, LOCAL_DATA_FILENAME_TAG, -1);
+      local_additive_proj_data_sptr = additive_proj_data_sptr;
+    }
+  else
+    distributed::send_string("", LOCAL_DATA_FILENAME_TAG, -1);
+
+  // send normalisation in the same way as the projectors
+  if (!is_null_ptr(normalisation_sptr) && !normalisation_sptr->is_trivial())
+    {
+      distributed::send_string(normalisation_sptr->get_registered_name(), distributed::REGISTERED_NAME_TAG, -1);
+      distributed::send_string(normalisation_sptr->parameter_info(), distributed::PARAMETER_INFO_TAG, -1);
+      local_normalisation_sptr = normalisation_sptr;
+    }
+  else
+    {
+      distributed::send_string("", distributed::REGISTERED_NAME_TAG, -1);
+      distributed::send_string("", distributed::PARAMETER_INFO_TAG, -1);
+    }
+#endif // STIR_MPI
+}
+
 void
 end_distributable_computation()
 {
@@ -159,20 +213,20 @@ zero_end_sinograms(ViewgramsPtr viewgrams_ptr)
     }
 }
 
-static void
-get_viewgrams(shared_ptr<RelatedViewgrams<float>>& y,
-              shared_ptr<RelatedViewgrams<float>>& additive_binwise_correction_viewgrams,
-              shared_ptr<RelatedViewgrams<float>>& mult_viewgrams_sptr,
-              const shared_ptr<ProjData>& proj_dat_ptr,
-              const bool read_from_proj_dat,
-              const bool zero_seg0_end_planes,
-              const shared_ptr<ProjData>& binwise_correction,
-              const shared_ptr<BinNormalisation>& normalisation_sptr,
-              const double start_time_of_frame,
-              const double end_time_of_frame,
-              const shared_ptr<DataSymmetriesForViewSegmentNumbers>& symmetries_ptr,
-              const ViewSegmentNumbers& view_segment_num,
-              const int timing_pos_num)
+void
+detail::get_viewgrams_for_distributable_computation(shared_ptr<RelatedViewgrams<float>>& y,
+                                                    shared_ptr<RelatedViewgrams<float>>& additive_binwise_correction_viewgrams,
+                                                    shared_ptr<RelatedViewgrams<float>>& mult_viewgrams_sptr,
+                                                    const shared_ptr<ProjData>& proj_dat_ptr,
+                                                    const bool read_from_proj_dat,
+                                                    const bool zero_seg0_end_planes,
+                                                    const shared_ptr<ProjData>& binwise_correction,
+                                                    const shared_ptr<BinNormalisation>& normalisation_sptr,
+                                                    const double start_time_of_frame,
+                                                    const double end_time_of_frame,
+                                                    const shared_ptr<DataSymmetriesForViewSegmentNumbers>& symmetries_ptr,
+                                                    const ViewSegmentNumbers& view_segment_num,
+                                                    const int timing_pos_num)
 {
   if (!is_null_ptr(binwise_correction))
     {
@@ -206,7 +260,10 @@ get_viewgrams(shared_ptr<RelatedViewgrams<float>>& y,
 #ifdef STIR_OPENMP
 #  pragma omp critical(MULT)
 #endif
-      normalisation_sptr->undo(*mult_viewgrams_sptr);
+      {
+        STIR_PROFILE_REGION("normalisation");
+        normalisation_sptr->undo(*mult_viewgrams_sptr);
+      }
     }
   else if (zero_seg0_end_planes)
     {
@@ -298,8 +355,10 @@ distributable_computation(const shared_ptr<ForwardProjectorByBin>& forward_proje
   int task_id;
   if (RPC_process_related_viewgrams == &RPC_process_related_viewgrams_accumulate_loglikelihood)
     task_id = task_do_distributable_loglikelihood_computation;
-  else if (RPC_process_related_viewgrams == &RPC_process_related_viewgrams_gradient)
+  else if (RPC_process_related_viewgrams == &RPC_process_related_viewgrams_gradient<true>)
     task_id = task_do_distributable_gradient_computation;
+  else if (RPC_process_related_viewgrams == &RPC_process_related_viewgrams_gradient<false>)
+    task_id = task_do_distributable_gradient_computation_without_adding_sensitivity;
   else if (RPC_process_related_viewgrams == &RPC_process_related_viewgrams_sensitivity_computation)
     task_id = task_do_distributable_sensitivity_computation;
   /* else if (RPC_process_related_viewgrams == &
@@ -367,8 +426,25 @@ distributable_computation(const shared_ptr<ForwardProjectorByBin>& forward_proje
   // send if output_image_ptr is valid and so needs to be accumulated
   distributed::send_bool_value(!is_null_ptr(output_image_ptr), USE_OUTPUT_IMAGE_ARG_TAG, -1);
 
+  // check if the slaves can read the data themselves, and tell them what to read
+  const bool use_normalisation = !is_null_ptr(normalisation_sptr) && !normalisation_sptr->is_trivial();
+  const bool use_local_data = !is_null_ptr(local_proj_data_sptr) && proj_dat_ptr == local_proj_data_sptr
+                              && (is_null_ptr(binwise_correction) || binwise_correction == local_additive_proj_data_sptr)
+                              && (!use_normalisation || normalisation_sptr == local_normalisation_sptr);
+  {
+    int local_data_values[4];
+    local_data_values[0] = use_local_data ? 1 : 0;
+    local_data_values[1] = read_from_proj_dat ? 1 : 0;
+    local_data_values[2] = is_null_ptr(binwise_correction) ? 0 : 1;
+    local_data_values[3] = use_normalisation ? 1 : 0;
+    distributed::send_int_values(local_data_values, 4, USE_LOCAL_DATA_TAG, -1);
+  }
+  if (use_local_data)
+    info("distributable_computation: slaves will read the data themselves", 2);
+
 #endif
 
+  STIR_PROFILE_REGION("distributable computation");
   CPUTimer CPU_timer;
   CPU_timer.start();
   HighResWallClockTimer wall_clock_timer;
@@ -447,23 +523,35 @@ distributable_computation(const shared_ptr<ForwardProjectorByBin>& forward_proje
             shared_ptr<RelatedViewgrams<float>> additive_binwise_correction_viewgrams;
             shared_ptr<RelatedViewgrams<float>> mult_viewgrams_sptr;
 
-            get_viewgrams(y,
-                          additive_binwise_correction_viewgrams,
-                          mult_viewgrams_sptr,
-                          proj_dat_ptr,
-                          read_from_proj_dat,
-                          zero_seg0_end_planes,
-                          binwise_correction,
-                          normalisation_sptr,
-                          start_time_of_frame,
-                          end_time_of_frame,
-                          symmetries_ptr,
-                          view_segment_num,
-                          timing_pos_num);
+#ifdef STIR_MPI
+            if (!use_local_data)
+#endif
+              detail::get_viewgrams_for_distributable_computation(y,
+                                                                  additive_binwise_correction_viewgrams,
+                                                                  mult_viewgrams_sptr,
+                                                                  proj_dat_ptr,
+                                                                  read_from_proj_dat,
+                                                                  zero_seg0_end_planes,
+                                                                  binwise_correction,
+                                                                  normalisation_sptr,
+                                                                  start_time_of_frame,
+                                                                  end_time_of_frame,
+                                                                  symmetries_ptr,
+                                                                  view_segment_num,
+                                                                  timing_pos_num);
 #ifdef STIR_MPI
 
-            // send viewgrams, the slave will immediatelly start calculation
-            send_viewgrams(y, additive_binwise_correction_viewgrams, mult_viewgrams_sptr, next_receiver);
+            if (use_local_data)
+              {
+                // only send the numbers, the slave will read the data and immediately start calculation
+                distributed::send_view_segment_numbers(view_segment_num, READ_VIEWGRAM_TAG, next_receiver);
+                distributed::send_int_value(timing_pos_num, next_receiver);
+              }
+            else
+              {
+                // send viewgrams, the slave will immediatelly start calculation
+                send_viewgrams(y, additive_binwise_correction_viewgrams, mult_viewgrams_sptr, next_receiver);
+              }
             working_slaves_count++;
             sent_count++;
 
@@ -558,28 +646,8 @@ distributable_computation(const shared_ptr<ForwardProjectorByBin>& forward_proje
   int_values[1] = 4; // values are ignored
   distributed::send_int_values(int_values, 2, END_ITERATION_TAG, -1);
 
-  // reduce output image
-  if (!is_null_ptr(output_image_ptr))
-    distributed::reduce_received_output_image(output_image_ptr, 0);
-  // and log_likelihood
-  if (!is_null_ptr(log_likelihood_ptr))
-    {
-      double buffer = 0.0;
-      MPI_Reduce(&buffer, log_likelihood_ptr, /*size*/ 1, MPI_DOUBLE, MPI_SUM, /*destination*/ 0, MPI_COMM_WORLD);
-    }
-
-  // reduce timed rpc-value
-  if (distributed::rpc_time)
-    {
-      printf("Master: Reducing timer value\n");
-      double send = 0;
-      double receive;
-      MPI_Reduce(&send, &receive, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-      distributed::total_rpc_time += (receive / (distributed::num_processors - 1));
-
-      printf("Average time used by slaves for RPC processing: %f secs\n", distributed::total_rpc_time);
-      distributed::total_rpc_time_slaves += receive;
-    }
+  // reduce log_likelihood, timed rpc-value and output image
+  distributed::reduce_received_results(output_image_ptr, log_likelihood_ptr);
 
 #endif
   {
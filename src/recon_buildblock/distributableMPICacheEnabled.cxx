@@ -218,6 +218,11 @@ distributable_computation_cache_enabled(const shared_ptr<ForwardProjectorByBin>&
   distributed::send_image_estimate(input_image_ptr, -1);
   // send if output_image_ptr is valid and so needs to be accumulated
   distributed::send_bool_value(!is_null_ptr(output_image_ptr), USE_OUTPUT_IMAGE_ARG_TAG, -1);
+  // the slaves never read the data themselves in the caching case
+  {
+    int local_data_values[4] = { 0, 0, 0, 0 };
+    distributed::send_int_values(local_data_values, 4, USE_LOCAL_DATA_TAG, -1);
+  }
 
   assert(min_segment_num <= max_segment_num);
   assert(min_timing_pos_num <= max_timing_pos_num);
@@ -348,28 +353,8 @@ distributable_computation_cache_enabled(const shared_ptr<ForwardProjectorByBin>&
   // send end_iteration notification
   distributed::send_int_values(int_values, 2, END_ITERATION_TAG, -1);
 
-  // reduce output image
-  if (!is_null_ptr(output_image_ptr))
-    distributed::reduce_received_output_image(output_image_ptr, 0);
-  // and log_likelihood
-  if (!is_null_ptr(log_likelihood_ptr))
-    {
-      double buffer = 0.0;
-      MPI_Reduce(&buffer, log_likelihood_ptr, /*size*/ 1, MPI_DOUBLE, MPI_SUM, /*destination*/ 0, MPI_COMM_WORLD);
-    }
-
-  // reduce timed rpc-value
-  if (distributed::rpc_time)
-    {
-      printf("Master: Reducing timer value\n");
-      double send = 0;
-      double receive;
-      MPI_Reduce(&send, &receive, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-      distributed::total_rpc_time += (receive / (distributed::num_processors - 1));
-
-      printf("Average time used by slaves for RPC processing: %f secs\n", distributed::total_rpc_time);
-      distributed::total_rpc_time_slaves += receive;
-    }
+  // reduce log_likelihood, timed rpc-value and output image
+  distributed::reduce_received_results(output_image_ptr, log_likelihood_ptr);
 }
 
 END_NAMESPACE_STIR
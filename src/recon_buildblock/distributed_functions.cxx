@@ -31,6 +31,9 @@
 #include "stir/error.h"
 #include "stir/warning.h"
 #include <boost/shared_array.hpp>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
 
 using std::ios;
 
@@ -811,7 +814,7 @@ receive_and_construct_exam_and_proj_data_info_ptr(stir::shared_ptr<stir::ExamInf
       stir::error("Error receiving projection data info. Text does not seem to be in Interfile format");
     }
   projector_info_ptr_stream.seekg(offset);
-  exam_info_sptr = hdr.get_exam_info_sptr();
+  exam_info_sptr.reset(new stir::ExamInfo(hdr.get_exam_info()));
   if (hdr.get_exam_info().imaging_modality.get_modality() == stir::ImagingModality::NM)
     {
       stir::InterfilePDFSHeaderSPECT hdr;
@@ -825,7 +828,7 @@ receive_and_construct_exam_and_proj_data_info_ptr(stir::shared_ptr<stir::ExamInf
       if (!hdr.parse(projector_info_ptr_stream))
         stir::error("Error receiving projection data info. Text does not seem to be in Interfile format");
 
-      proj_data_info_sptr = stir::shared_ptr<stir::ProjDataInfo>(hdr.data_info_ptr->clone());
+      proj_data_info_sptr = stir::shared_ptr<stir::ProjDataInfo>(hdr.data_info_sptr->clone());
     }
 }
 
@@ -905,23 +908,8 @@ receive_and_construct_viewgram(stir::Viewgram<float>*& viewgram_ptr,
 //--------------------------------------Reduce Operations-------------------------------------
 
 void
-reduce_received_output_image(stir::DiscretisedDensity<3, float>* output_image_ptr, int destination)
+reduce_received_results(stir::DiscretisedDensity<3, float>* output_image_ptr, double* log_likelihood_ptr)
 {
-#ifdef STIR_MPI_TIMINGS
-  stir::HighResWallClockTimer fulltimer;
-  fulltimer.reset();
-  fulltimer.start();
-#endif
-  float* output_buf = new float[image_buffer_size];
-  float* image_buf = new float[image_buffer_size];
-
-  // initialize output_buffer to zero.
-  // contributions from all slaves will be added into it
-  // KTXXXfor (int i=0; i<image_buffer_size;i++) output_buf[i]=0.0;
-  for (int i = 0; i < image_buffer_size; i++)
-    image_buf[i] = 0.0;
-
-    // receive output image values
 #ifdef STIR_MPI_TIMINGS
   if (test_send_receive_times)
     {
@@ -929,63 +917,48 @@ reduce_received_output_image(stir::DiscretisedDensity<3, float>* output_image_pt
       t.start();
     }
 #endif
-
-  MPI_Reduce(image_buf, output_buf, image_buffer_size, MPI_FLOAT, MPI_SUM, destination, MPI_COMM_WORLD);
-  delete[] image_buf;
+  // start all reductions, the master contributes zeroes (using MPI_IN_PLACE)
+  MPI_Request requests[3];
+  int num_requests = 0;
+  if (log_likelihood_ptr != 0)
+    {
+      *log_likelihood_ptr = 0.;
+      MPI_Ireduce(MPI_IN_PLACE, log_likelihood_ptr, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD, &requests[num_requests++]);
+    }
+  double rpc_time_sum = 0.;
+  if (rpc_time)
+    MPI_Ireduce(MPI_IN_PLACE, &rpc_time_sum, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD, &requests[num_requests++]);
+  std::vector<float> output_buf;
+  if (output_image_ptr != 0)
+    {
+      output_buf.resize(output_image_ptr->size_all(), 0.F);
+      MPI_Ireduce(MPI_IN_PLACE,
+                  output_buf.data(),
+                  static_cast<int>(output_buf.size()),
+                  MPI_FLOAT,
+                  MPI_SUM,
+                  0,
+                  MPI_COMM_WORLD,
+                  &requests[num_requests++]);
+    }
+  MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
 
 #ifdef STIR_MPI_TIMINGS
   if (test_send_receive_times)
     t.stop();
   if (test_send_receive_times && t.value() > min_threshold)
-    std::cout << "Master: reduced output_image after " << t.value() << " seconds" << std::endl;
+    std::cout << "Master: reduced results after " << t.value() << " seconds" << std::endl;
 #endif
 
-  std::cout << "Master: output_image reduced.\n";
+  if (output_image_ptr != 0)
+    std::copy(output_buf.begin(), output_buf.end(), output_image_ptr->begin_all());
 
-  // get input_image from 1-demnsional array
-  std::copy(output_buf, output_buf + image_buffer_size, output_image_ptr->begin_all());
-  delete[] output_buf;
-#ifdef STIR_MPI_TIMINGS
-  fulltimer.stop();
-  if (test_send_receive_times /*&& fulltimer.value()>min_threshold*/)
-    std::cout << "Master: reduced output_image total after " << fulltimer.value() << " seconds" << std::endl;
-#endif
-}
-
-void
-reduce_output_image(stir::shared_ptr<stir::DiscretisedDensity<3, float>>& output_image_ptr,
-                    int image_buffer_size,
-                    int my_rank_ignored,
-                    int destination)
-{
-  float* output_buf = new float[image_buffer_size];
-  float* image_buf = new float[image_buffer_size];
-
-  // serialize input_image into 1-demnsional array
-  // KTXXXstd::copy(output_image_ptr->begin_all(), output_image_ptr->end_all(), output_buf);
-  std::copy(output_image_ptr->begin_all(), output_image_ptr->end_all(), image_buf);
-
-  // reduction of output_image at master
-#ifdef STIR_MPI_TIMINGS
-  if (test_send_receive_times)
+  if (rpc_time)
     {
-      t.reset();
-      t.start();
+      total_rpc_time += (rpc_time_sum / (num_processors - 1));
+      printf("Average time used by slaves for RPC processing: %f secs\n", total_rpc_time);
+      total_rpc_time_slaves += rpc_time_sum;
     }
-#endif
-
-  MPI_Reduce(image_buf, output_buf, image_buffer_size, MPI_FLOAT, MPI_SUM, destination, MPI_COMM_WORLD);
-  delete[] image_buf;
-
-#ifdef STIR_MPI_TIMINGS
-  if (test_send_receive_times)
-    t.stop();
-  int my_rank = 0;
-  MPI_Comm_rank(MPI_COMM_WORLD, &my_rank); /*Gets the rank of the Processor*/
-  if (test_send_receive_times && t.value() > min_threshold)
-    std::cout << "Slave " << my_rank << ": reduced output_image after " << t.value() << " seconds" << std::endl;
-#endif
-  delete[] output_buf;
 }
 
 } // namespace distributed
@@ -38,6 +38,8 @@
 #include "stir/recon_buildblock/BackProjectorByBinUsingInterpolation.h"
 #include "stir/recon_buildblock/PresmoothingForwardProjectorByBin.h"
 #include "stir/recon_buildblock/PostsmoothingBackProjectorByBin.h"
+#include "stir/recon_buildblock/ForwardProjectorByBinWithSinogramPSF.h"
+#include "stir/recon_buildblock/BackProjectorByBinWithSinogramPSF.h"
 
 #include "stir/recon_buildblock/ProjectorByBinPairUsingProjMatrixByBin.h"
 #include "stir/recon_buildblock/ProjectorByBinPairUsingSeparateProjectors.h"
@@ -111,10 +113,12 @@ static ProjMatrixByBinPinholeSPECTUB::RegisterIt dummy15;
 static ForwardProjectorByBinUsingProjMatrixByBin::RegisterIt dummy31;
 static ForwardProjectorByBinUsingRayTracing::RegisterIt dummy32;
 static PostsmoothingBackProjectorByBin::RegisterIt dummy33;
+static ForwardProjectorByBinWithSinogramPSF::RegisterIt dummy34;
 
 static BackProjectorByBinUsingProjMatrixByBin::RegisterIt dummy51;
 static BackProjectorByBinUsingInterpolation::RegisterIt dummy52;
 static PresmoothingForwardProjectorByBin::RegisterIt dummy53;
+static BackProjectorByBinWithSinogramPSF::RegisterIt dummy54;
 
 static ProjectorByBinPairUsingProjMatrixByBin::RegisterIt dummy71;
 static ProjectorByBinPairUsingSeparateProjectors::RegisterIt dummy72;
@@ -0,0 +1,226 @@
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+/*!
+  \file
+  \ingroup recontest
+
+  \brief Test program for stir::ForwardProjectorByBinWithSinogramPSF and stir::BackProjectorByBinWithSinogramPSF
+*/
+
+#include "stir/RunTests.h"
+#include "stir/ProjDataInMemory.h"
+#include "stir/ProjDataInfo.h"
+#include "stir/ExamInfo.h"
+#include "stir/Scanner.h"
+#include "stir/VoxelsOnCartesianGrid.h"
+#include "stir/SegmentByView.h"
+#include "stir/recon_buildblock/ProjMatrixByBinUsingRayTracing.h"
+#include "stir/recon_buildblock/ForwardProjectorByBinUsingProjMatrixByBin.h"
+#include "stir/recon_buildblock/BackProjectorByBinUsingProjMatrixByBin.h"
+#include "stir/recon_buildblock/ForwardProjectorByBinWithSinogramPSF.h"
+#include "stir/recon_buildblock/BackProjectorByBinWithSinogramPSF.h"
+#include <boost/random/uniform_01.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <sstream>
+#include <iostream>
+
+START_NAMESPACE_STIR
+
+/*!
+  \ingroup recontest
+  \brief Test class for the projectors with a sinogram PSF
+
+  Checks that a trivial PSF does not change the projections, that the blurring preserves counts
+  (for an object in the centre of the FOV), that the back projector is the transpose of the
+  forward projector, and that the projectors can be parsed.
+*/
+class SinogramPSFProjectorsTests : public RunTests
+{
+public:
+  void run_tests() override;
+
+private:
+  shared_ptr<const ProjDataInfo> proj_data_info_sptr;
+  shared_ptr<ExamInfo> exam_info_sptr;
+  shared_ptr<VoxelsOnCartesianGrid<float>> image_sptr;
+  shared_ptr<ProjMatrixByBin> proj_matrix_sptr;
+
+  //! compute inner product of 2 ProjData
+  static double inner_product(const ProjData& p1, const ProjData& p2);
+
+  void run_tests_for_trivial_psf();
+  void run_tests_for_count_preservation();
+  void run_tests_for_transpose();
+  void run_tests_for_parsing();
+};
+
+double
+SinogramPSFProjectorsTests::inner_product(const ProjData& p1, const ProjData& p2)
+{
+  double sum = 0.;
+  for (int seg_num = p1.get_min_segment_num(); seg_num <= p1.get_max_segment_num(); ++seg_num)
+    {
+      const SegmentByView<float> s1 = p1.get_segment_by_view(seg_num);
+      const SegmentByView<float> s2 = p2.get_segment_by_view(seg_num);
+      for (SegmentByView<float>::const_full_iterator iter1 = s1.begin_all(), iter2 = s2.begin_all(); iter1 != s1.end_all();
+           ++iter1, ++iter2)
+        sum += static_cast<double>(*iter1) * (*iter2);
+    }
+  return sum;
+}
+
+void
+SinogramPSFProjectorsTests::run_tests_for_trivial_psf()
+{
+  std::cerr << "Tests with a trivial PSF\n";
+  shared_ptr<ForwardProjectorByBin> fwd_sptr(new ForwardProjectorByBinUsingProjMatrixByBin(proj_matrix_sptr));
+  ForwardProjectorByBinWithSinogramPSF psf_fwd(fwd_sptr, SinogramPSF());
+  psf_fwd.set_up(proj_data_info_sptr, image_sptr);
+
+  ProjDataInMemory proj_data(exam_info_sptr, proj_data_info_sptr);
+  ProjDataInMemory psf_proj_data(exam_info_sptr, proj_data_info_sptr);
+  fwd_sptr->forward_project(proj_data, *image_sptr);
+  psf_fwd.forward_project(psf_proj_data, *image_sptr);
+  set_tolerance(proj_data.find_max() * 1E-5);
+  check_if_equal(proj_data.get_segment_by_view(0), psf_proj_data.get_segment_by_view(0), "forward projection with trivial PSF");
+}
+
+void
+SinogramPSFProjectorsTests::run_tests_for_count_preservation()
+{
+  std::cerr << "Tests for count preservation\n";
+  // a small object in the centre
+  VoxelsOnCartesianGrid<float> small_image(*image_sptr->get_empty_copy());
+  for (int z = small_image.get_min_z() + 2; z <= small_image.get_max_z() - 2; ++z)
+    for (int y = -2; y <= 2; ++y)
+      for (int x = -2; x <= 2; ++x)
+        small_image[z][y][x] = 1.F;
+
+  shared_ptr<ForwardProjectorByBin> fwd_sptr(new ForwardProjectorByBinUsingProjMatrixByBin(proj_matrix_sptr));
+  ForwardProjectorByBinWithSinogramPSF psf_fwd(fwd_sptr, SinogramPSF(8.F, 6.F, .02F));
+  psf_fwd.set_up(proj_data_info_sptr, image_sptr);
+
+  ProjDataInMemory proj_data(exam_info_sptr, proj_data_info_sptr);
+  ProjDataInMemory psf_proj_data(exam_info_sptr, proj_data_info_sptr);
+  fwd_sptr->forward_project(proj_data, small_image);
+  psf_fwd.forward_project(psf_proj_data, small_image);
+  // only check segment 0 and tangential blurring, as the axial blurring "leaks" out of the other segments
+  const SegmentByView<float> segment = proj_data.get_segment_by_view(0);
+  const SegmentByView<float> psf_segment = psf_proj_data.get_segment_by_view(0);
+  check(psf_segment.find_max() < segment.find_max() * .99F, "PSF should reduce the maximum");
+  set_tolerance(.01);
+  check_if_equal(psf_segment.sum() / segment.sum(), 1.F, "PSF should preserve counts");
+}
+
+void
+SinogramPSFProjectorsTests::run_tests_for_transpose()
+{
+  std::cerr << "Tests for transpose\n";
+  const SinogramPSF psf(5.F, 7.F, .05F);
+  shared_ptr<ForwardProjectorByBin> fwd_sptr(new ForwardProjectorByBinUsingProjMatrixByBin(proj_matrix_sptr));
+  shared_ptr<BackProjectorByBin> back_sptr(new BackProjectorByBinUsingProjMatrixByBin(proj_matrix_sptr));
+  ForwardProjectorByBinWithSinogramPSF psf_fwd(fwd_sptr, psf);
+  BackProjectorByBinWithSinogramPSF psf_back(back_sptr, psf);
+  psf_fwd.set_up(proj_data_info_sptr, image_sptr);
+  psf_back.set_up(proj_data_info_sptr, image_sptr);
+
+  // fill with random numbers between 0 and 1, using a reproducible seed
+  boost::mt19937 generator(boost::uint32_t(42));
+  boost::uniform_01<boost::mt19937> random01(generator);
+  VoxelsOnCartesianGrid<float> image(*image_sptr->get_empty_copy());
+  for (VoxelsOnCartesianGrid<float>::full_iterator iter = image.begin_all(); iter != image.end_all(); ++iter)
+    *iter = static_cast<float>(random01());
+  ProjDataInMemory proj_data(exam_info_sptr, proj_data_info_sptr);
+  for (int seg_num = proj_data.get_min_segment_num(); seg_num <= proj_data.get_max_segment_num(); ++seg_num)
+    {
+      SegmentByView<float> segment = proj_data.get_empty_segment_by_view(seg_num);
+      for (SegmentByView<float>::full_iterator iter = segment.begin_all(); iter != segment.end_all(); ++iter)
+        *iter = static_cast<float>(random01());
+      proj_data.set_segment(segment);
+    }
+
+  ProjDataInMemory fwd_proj_data(exam_info_sptr, proj_data_info_sptr);
+  psf_fwd.forward_project(fwd_proj_data, image);
+  VoxelsOnCartesianGrid<float> back_image(*image_sptr->get_empty_copy());
+  psf_back.back_project(back_image, proj_data);
+
+  const double fwd_inner_product = inner_product(fwd_proj_data, proj_data);
+  double back_inner_product = 0.;
+  for (VoxelsOnCartesianGrid<float>::const_full_iterator iter1 = image.begin_all_const(), iter2 = back_image.begin_all_const();
+       iter1 != image.end_all_const();
+       ++iter1, ++iter2)
+    back_inner_product += static_cast<double>(*iter1) * (*iter2);
+  set_tolerance(1E-4);
+  check_if_equal(back_inner_product / fwd_inner_product, 1., "<PSF forward x, y> == <x, PSF back y>");
+}
+
+void
+SinogramPSFProjectorsTests::run_tests_for_parsing()
+{
+  std::cerr << "Tests for parsing\n";
+  std::stringstream parameterstream;
+  parameterstream << "Sinogram PSF Forward Projector Parameters:=\n"
+                  << "Original Forward projector type := Matrix\n"
+                  << "  Forward Projector Using Matrix Parameters :=\n"
+                  << "    Matrix type := Ray Tracing\n"
+                  << "    Ray tracing matrix parameters :=\n"
+                  << "    End Ray tracing matrix parameters :=\n"
+                  << "  End Forward Projector Using Matrix Parameters :=\n"
+                  << "tangential FWHM (in mm) := 5\n"
+                  << "tangential FWHM slope := .05\n"
+                  << "axial FWHM (in mm) := 7\n"
+                  << "End Sinogram PSF Forward Projector Parameters:=\n";
+  ForwardProjectorByBinWithSinogramPSF parsed_fwd;
+  check(parsed_fwd.parse(parameterstream), "parsing forward projector");
+  parsed_fwd.set_up(proj_data_info_sptr, image_sptr);
+
+  shared_ptr<ForwardProjectorByBin> fwd_sptr(new ForwardProjectorByBinUsingProjMatrixByBin(proj_matrix_sptr));
+  ForwardProjectorByBinWithSinogramPSF psf_fwd(fwd_sptr, SinogramPSF(5.F, 7.F, .05F));
+  psf_fwd.set_up(proj_data_info_sptr, image_sptr);
+
+  ProjDataInMemory proj_data(exam_info_sptr, proj_data_info_sptr);
+  ProjDataInMemory parsed_proj_data(exam_info_sptr, proj_data_info_sptr);
+  psf_fwd.forward_project(proj_data, *image_sptr);
+  parsed_fwd.forward_project(parsed_proj_data, *image_sptr);
+  set_tolerance(proj_data.find_max() * 1E-5);
+  check_if_equal(proj_data.get_segment_by_view(1), parsed_proj_data.get_segment_by_view(1), "forward projection with parsed PSF");
+}
+
+void
+SinogramPSFProjectorsTests::run_tests()
+{
+  shared_ptr<Scanner> scanner_sptr(new Scanner(Scanner::E953));
+  scanner_sptr->set_num_rings(5);
+  proj_data_info_sptr.reset(ProjDataInfo::ProjDataInfoCTI(scanner_sptr,
+                                                          /*span=*/1,
+                                                          /*max_delta=*/2,
+                                                          /*num_views=*/16,
+                                                          /*num_tang_poss=*/64));
+  exam_info_sptr.reset(new ExamInfo(ImagingModality::PT));
+  image_sptr.reset(new VoxelsOnCartesianGrid<float>(exam_info_sptr, *proj_data_info_sptr, 1.F));
+  image_sptr->fill(1.F);
+  proj_matrix_sptr.reset(new ProjMatrixByBinUsingRayTracing());
+
+  run_tests_for_trivial_psf();
+  run_tests_for_count_preservation();
+  run_tests_for_transpose();
+  run_tests_for_parsing();
+}
+
+END_NAMESPACE_STIR
+
+USING_NAMESPACE_STIR
+
+int
+main()
+{
+  SinogramPSFProjectorsTests tests;
+  tests.run_tests();
+  return tests.main_return_value();
+}
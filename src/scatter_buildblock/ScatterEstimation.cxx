@@ -24,6 +24,7 @@
 #include "stir/ProjDataInterfile.h"
 #include "stir/ProjDataInMemory.h"
 #include "stir/inverse_SSRB.h"
+#include "stir/interpolate_projdata.h"
 #include "stir/ExamInfo.h"
 #include "stir/ProjDataInfo.h"
 #include "stir/ProjDataInfoCylindricalNoArcCorr.h"
@@ -858,6 +859,8 @@ ScatterEstimation::process_data()
   float local_max_scale_value = 0.5f;
 
   stir::BSpline::BSplineType spline_type = stir::BSpline::linear;
+  // the scatter estimate is interpolated with the same geometry in every iteration
+  InterpolateProjDataCache interpolation_cache;
 
   // This has been set to 2D or 3D in the set_up()
   shared_ptr<ProjData> unscaled_est_projdata_sptr(
@@ -978,7 +981,8 @@ ScatterEstimation::process_data()
                                         local_max_scale_value,
                                         this->half_filter_width,
                                         spline_type,
-                                        true);
+                                        true,
+                                        &interpolation_cache);
 
       if (this->run_debug_mode)
         {
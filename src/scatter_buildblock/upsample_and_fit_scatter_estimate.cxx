@@ -51,7 +51,8 @@ ScatterEstimation::upsample_and_fit_scatter_estimate(ProjData& scaled_scatter_pr
                                                      const float max_scale_factor,
                                                      const unsigned half_filter_width,
                                                      BSpline::BSplineType spline_type,
-                                                     const bool remove_interleaving)
+                                                     const bool remove_interleaving,
+                                                     InterpolateProjDataCache* interpolation_cache_ptr)
 {
   info("upsample_and_fit_scatter_estimate: Interpolating scatter estimate to size of emission data");
 
@@ -70,7 +71,8 @@ ScatterEstimation::upsample_and_fit_scatter_estimate(ProjData& scaled_scatter_pr
         actual_remove_interleaving = false;
       }
 
-    interpolate_projdata(interpolated_direct_scatter, scatter_proj_data, spline_type, actual_remove_interleaving);
+    interpolate_projdata(
+        interpolated_direct_scatter, scatter_proj_data, spline_type, actual_remove_interleaving, interpolation_cache_ptr);
   }
 
   // now call inverse_SSRB, and normalise/scale if we need to
@@ -171,12 +171,20 @@ void
 GatedSpatialTransformation::accumulate_warp_image(DiscretisedDensity<3, float>& new_reference_image,
                                                   const GatedDiscretisedDensity& gated_image) const
 {
-  GatedDiscretisedDensity new_gated_image(gated_image);
-  new_gated_image.fill_with_zero();
-  this->warp_image(new_gated_image, gated_image);
+  if (!this->_spatial_transformations_are_stored)
+    error("The transformation fields haven't been set properly yet.\n");
+  assert(gated_image.get_time_gate_definitions().get_num_gates()
+         == this->_spatial_transformation_x.get_time_gate_definitions().get_num_gates());
+  // warp every gate straight into the output, avoiding a temporary gated image.
+  // Gates are handled sequentially, as the warping is itself parallelised over planes.
   //! todo This is not implemented as sum (or should it be the average?)
   for (unsigned int gate_num = 1; gate_num <= gated_image.get_time_gate_definitions().get_num_gates(); ++gate_num)
-    new_reference_image += new_gated_image[gate_num];
+    stir::warp_and_accumulate_image(new_reference_image,
+                                    *(gated_image.get_densities())[gate_num - 1],
+                                    *(this->_spatial_transformation_x.get_densities())[gate_num - 1],
+                                    *(this->_spatial_transformation_y.get_densities())[gate_num - 1],
+                                    *(this->_spatial_transformation_z.get_densities())[gate_num - 1],
+                                    BSpline::linear);
   //	new_reference_image /= gated_image.get_time_gate_definitions().get_num_gates();
 }
 
@@ -20,6 +20,72 @@
 START_NAMESPACE_STIR
 // using namespace BSpline;
 
+//! warp \a density into (or add it to) \a out_density, which needs to have the same (regular) index range
+static void
+warp_image_help(DiscretisedDensity<3, float>& out_density,
+                const DiscretisedDensity<3, float>& density,
+                const DiscretisedDensity<3, float>& motion_x,
+                const DiscretisedDensity<3, float>& motion_y,
+                const DiscretisedDensity<3, float>& motion_z,
+                const BSpline::BSplineType spline_type,
+                const bool accumulate)
+{
+  const DiscretisedDensityOnCartesianGrid<3, float>* density_cartesian_ptr
+      = dynamic_cast<const DiscretisedDensityOnCartesianGrid<3, float>*>(&density);
+  if (!density_cartesian_ptr)
+    error("warp_image: image needs to be on a Cartesian grid.\n");
+  const BasicCoordinate<3, float> grid_spacing = density_cartesian_ptr->get_grid_spacing();
+  const BSpline::BSplinesRegularGrid<3, float> density_interpolation(density, spline_type);
+
+  BasicCoordinate<3, int> min;
+  BasicCoordinate<3, int> max;
+  const IndexRange<3> range = density.get_index_range();
+  if (!range.get_regular_range(min, max))
+    error("image is not in regular grid.\n");
+  if (out_density.get_index_range() != range || motion_x.get_index_range() != range || motion_y.get_index_range() != range
+      || motion_z.get_index_range() != range)
+    error("warp_image: image and motion fields need to have the same index range.\n");
+
+  // The B-spline coefficients are only read from here on, so planes can be warped independently.
+  // We work per x-row to avoid repeated multi-dimensional indexing of the motion fields.
+#ifdef STIR_OPENMP
+#  pragma omp parallel for schedule(dynamic)
+#endif
+  for (int z = min[1]; z <= max[1]; ++z)
+    {
+      BasicCoordinate<3, double> d;
+      for (int y = min[2]; y <= max[2]; ++y)
+        {
+          const Array<1, float>& motion_x_row = motion_x[z][y];
+          const Array<1, float>& motion_y_row = motion_y[z][y];
+          const Array<1, float>& motion_z_row = motion_z[z][y];
+          Array<1, float>& out_row = out_density[z][y];
+          for (int x = min[3]; x <= max[3]; ++x)
+            {
+              // for the IRTK version I had c-l, but for Christian's it seems to work as c+l
+              d[1] = static_cast<double>(z) + static_cast<double>(motion_z_row[x] / grid_spacing[1]);
+              d[2] = static_cast<double>(y) + static_cast<double>(motion_y_row[x] / grid_spacing[2]);
+              d[3] = static_cast<double>(x) + static_cast<double>(motion_x_row[x] / grid_spacing[3]);
+              // Temporary fix such that when radioactivity comes from outside is set to 0.
+              // To fix this properly we need to modify the B-Splines interpolation method by changing the periodicity
+              // extrapolation. I'm not considering the last plane if linear because it's going to use extrapolated data. I
+              // haven't implemented anything for higher order
+              if ((d[1] <= static_cast<double>(min[1])) || (d[1] >= static_cast<double>(max[1]))
+                  || (d[2] <= static_cast<double>(min[2])) || (d[2] >= static_cast<double>(max[2]))
+                  || (d[3] <= static_cast<double>(min[3])) || (d[3] >= static_cast<double>(max[3])))
+                {
+                  if (!accumulate)
+                    out_row[x] = 0.F;
+                }
+              else if (accumulate)
+                out_row[x] += density_interpolation(d);
+              else
+                out_row[x] = density_interpolation(d);
+            }
+        }
+    }
+}
+
 VoxelsOnCartesianGrid<float>
 warp_image(const shared_ptr<DiscretisedDensity<3, float>>& density_sptr,
            const shared_ptr<DiscretisedDensity<3, float>>& motion_x_sptr,
@@ -32,7 +98,6 @@ warp_image(const shared_ptr<DiscretisedDensity<3, float>>& density_sptr,
       = dynamic_cast<DiscretisedDensityOnCartesianGrid<3, float>*>(density_sptr.get());
   const BasicCoordinate<3, float> grid_spacing = density_cartesian_sptr->get_grid_spacing();
   const CartesianCoordinate3D<float> origin = density_cartesian_sptr->get_origin();
-  const BSpline::BSplinesRegularGrid<3, float> density_interpolation(*density_sptr, spline_type);
 
   BasicCoordinate<3, int> min;
   BasicCoordinate<3, int> max;
@@ -54,31 +119,19 @@ warp_image(const shared_ptr<DiscretisedDensity<3, float>>& density_sptr,
   const IndexRange<3> out_range(out_min, out_max);
   VoxelsOnCartesianGrid<float> out_density(out_range, origin, grid_spacing);
 
-  BasicCoordinate<3, int> c;
-  BasicCoordinate<3, double> d, l;
-  for (c[1] = min[1]; c[1] <= max[1]; ++c[1])
-    for (c[2] = min[2]; c[2] <= max[2]; ++c[2])
-      for (c[3] = min[3]; c[3] <= max[3]; ++c[3])
-        {
-          l[1] = static_cast<double>((*motion_z_sptr)[c] / grid_spacing[1]);
-          l[2] = static_cast<double>((*motion_y_sptr)[c] / grid_spacing[2]);
-          l[3] = static_cast<double>((*motion_x_sptr)[c] / grid_spacing[3]);
-          d[1] = static_cast<double>(c[1]) + l[1]; // for the IRTK version I had c-l, but for Christian's it seems to work as c+l
-          d[2] = static_cast<double>(c[2]) + l[2];
-          d[3] = static_cast<double>(c[3]) + l[3];
-          // Temporary fix such that when radioactivity comes from outside is set to 0.
-          // To fix this properly we need to modify the B-Splines interpolation method by changing the periodicity extrapolation.
-          if ((d[1] <= static_cast<double>(min[1])) || (d[1] >= static_cast<double>(max[1]))
-              || // I'm not considering the last plane if linear
-              (d[2] <= static_cast<double>(min[2])) || (d[2] >= static_cast<double>(max[2]))
-              || // because it's going to use extrapolated data
-              (d[3] <= static_cast<double>(min[3]))
-              || (d[3] >= static_cast<double>(max[3]))) // I haven't implemented anything for higher order
-            out_density[c] = 0.F;
-          else
-            out_density[c] = density_interpolation(d);
-        }
+  warp_image_help(out_density, *density_sptr, *motion_x_sptr, *motion_y_sptr, *motion_z_sptr, spline_type, false);
   return out_density;
 }
 
+void
+warp_and_accumulate_image(DiscretisedDensity<3, float>& out_density,
+                          const DiscretisedDensity<3, float>& density,
+                          const DiscretisedDensity<3, float>& motion_x,
+                          const DiscretisedDensity<3, float>& motion_y,
+                          const DiscretisedDensity<3, float>& motion_z,
+                          const BSpline::BSplineType spline_type)
+{
+  warp_image_help(out_density, density, motion_x, motion_y, motion_z, spline_type, true);
+}
+
 END_NAMESPACE_STIR
@@ -1,6 +1,6 @@
 /*
     Copyright (C) 2011-07-01 - 2012, Kris Thielemans
-    Copyright (C) 2013, 2014, 2015, 2018 - 2023 University College London
+    Copyright (C) 2013, 2014, 2015, 2018 - 2023, 2026 University College London
     Copyright (C) 2022 National Physical Laboratory
     Copyright (C) 2022 Positrigo
     This file is part of STIR.
@@ -713,6 +713,133 @@ namespace std {
     return new SwigPyForwardIteratorClosed_T<OutIter>(current, begin, end, seq);
   }
 
+  // create a numpy array that shares its memory with a STIR object.
+  // owner is the Python object that has to be kept alive as long as the numpy array exists
+  // (normally the SWIG proxy of the STIR object).
+  template <int num_dimensions>
+  PyObject* numpy_view_from_data(float* data_ptr, const stir::BasicCoordinate<num_dimensions, int>& sizes, PyObject* owner)
+  {
+    npy_intp dims[num_dimensions];
+    for (int d=1; d<=num_dimensions; ++d)
+      dims[d-1] = sizes[d];
+    if (data_ptr == 0)
+      {
+        // empty array: nothing to share (numpy would otherwise allocate its own memory)
+        PyObject* np = PyArray_SimpleNew(num_dimensions, dims, NPY_FLOAT32);
+        if (np == NULL)
+          throw std::runtime_error("Error creating numpy array");
+        return np;
+      }
+    PyObject* np = PyArray_SimpleNewFromData(num_dimensions, dims, NPY_FLOAT32, data_ptr);
+    if (np == NULL)
+      throw std::runtime_error("Error creating numpy array");
+    // PyArray_SetBaseObject steals the reference (also on failure)
+    Py_INCREF(owner);
+    if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(np), owner) != 0)
+      {
+        Py_DECREF(np);
+        throw std::runtime_error("Error setting base object of numpy array");
+      }
+    return np;
+  }
+
+  template <int num_dimensions>
+  PyObject* numpy_view_of_Array(stir::Array<num_dimensions, float>& array, PyObject* owner)
+  {
+    stir::BasicCoordinate<num_dimensions, int> minind, maxind;
+    if (!array.get_regular_range(minind, maxind))
+      throw std::range_error("as_numpy_view called on irregular array");
+    const stir::BasicCoordinate<num_dimensions, int> sizes = maxind - minind + 1;
+    if (array.size_all() == 0)
+      return numpy_view_from_data(static_cast<float*>(0), sizes, owner);
+    if (!array.is_contiguous())
+      throw std::runtime_error("as_numpy_view called on non-contiguous array. Use stirextra.to_numpy() instead.");
+    float* data_ptr = array.get_full_data_ptr();
+    // the pointer stays valid until the array is resized
+    array.release_full_data_ptr();
+    return numpy_view_from_data(data_ptr, sizes, owner);
+  }
+
+  // a 4D numpy view of the projection data, using the same order as projdata_to_4D
+  inline PyObject* numpy_view_of_ProjDataInMemory(stir::ProjDataInMemory& proj_data, PyObject* owner)
+  {
+    stir::BasicCoordinate<4, int> sizes;
+    sizes[1] = proj_data.get_num_tof_poss();
+    sizes[2] = proj_data.get_num_non_tof_sinograms();
+    sizes[3] = proj_data.get_num_views();
+    sizes[4] = proj_data.get_num_tangential_poss();
+    if (proj_data.size_all() == 0)
+      return numpy_view_from_data(static_cast<float*>(0), sizes, owner);
+    float* data_ptr = proj_data.get_data_ptr();
+    proj_data.release_data_ptr();
+    return numpy_view_from_data(data_ptr, sizes, owner);
+  }
+
+  // releases the reference to a numpy array when the last STIR object using its memory is deleted
+  struct numpy_array_releaser
+  {
+    PyObject* np;
+    void operator()(float*) const
+    {
+      // STIR objects could be deleted while the GIL is not held
+      PyGILState_STATE state = PyGILState_Ensure();
+      Py_DECREF(np);
+      PyGILState_Release(state);
+    }
+  };
+
+  // create a STIR Array that shares its memory with a numpy array
+  template <int num_dimensions>
+  stir::Array<num_dimensions, float>* Array_from_numpy_view(PyObject* const arg)
+  {
+    if (!PyArray_Check(arg))
+      throw std::invalid_argument("from_numpy_view needs a numpy array");
+    PyArrayObject* np = reinterpret_cast<PyArrayObject*>(arg);
+    if (PyArray_NDIM(np) != num_dimensions)
+      throw std::invalid_argument(
+          boost::str(boost::format("from_numpy_view needs a numpy array of dimension %1%, but it has dimension %2%")
+                     % num_dimensions % PyArray_NDIM(np)));
+    if (PyArray_TYPE(np) != NPY_FLOAT32 || !PyArray_ISCARRAY(np) || PyArray_ISBYTESWAPPED(np))
+      throw std::invalid_argument("from_numpy_view needs a C-contiguous, aligned and writeable numpy array of type float32. "
+                                  "Use numpy.ascontiguousarray(array, dtype=numpy.float32) first.");
+    stir::BasicCoordinate<num_dimensions, int> sizes;
+    for (int d=1; d<=num_dimensions; ++d)
+      sizes[d] = static_cast<int>(PyArray_DIM(np, d-1));
+    Py_INCREF(arg);
+    numpy_array_releaser releaser;
+    releaser.np = arg;
+    shared_ptr<float[]> data_sptr(static_cast<float*>(PyArray_DATA(np)), releaser);
+    return new stir::Array<num_dimensions, float>(stir::IndexRange<num_dimensions>(sizes), data_sptr);
+  }
+
+  // fill a STIR object from a numpy array, converting to a C-contiguous float32 array first if necessary.
+  // returns false if arg is not a numpy array
+  template <class T>
+  bool fill_from_numpy(T& stir_object, PyObject* const arg)
+  {
+    if (!PyArray_Check(arg))
+      return false;
+    // this does not create a copy if the layout and type are already fine.
+    // FORCECAST is needed to allow conversion from e.g. float64
+    PyArrayObject* np = reinterpret_cast<PyArrayObject*>(
+        PyArray_FROMANY(arg, NPY_FLOAT32, 0, 0, NPY_ARRAY_IN_ARRAY | NPY_ARRAY_FORCECAST));
+    if (np == NULL)
+      {
+        PyErr_Clear();
+        throw std::invalid_argument("fill() could not convert the numpy array to float32");
+      }
+    const std::size_t size = static_cast<std::size_t>(PyArray_SIZE(np));
+    if (size != static_cast<std::size_t>(stir_object.size_all()))
+      {
+        Py_DECREF(np);
+        throw std::runtime_error("fill() called with a numpy array of incorrect size, "
+                                 "it needs to have the same number of elements");
+      }
+    const float* data_ptr = static_cast<const float*>(PyArray_DATA(np));
+    stir::fill_from(stir_object, data_ptr, data_ptr + size);
+    Py_DECREF(np);
+    return true;
+  }
 
 #endif
   static Array<4,float> create_array_for_proj_data(const ProjData& proj_data)
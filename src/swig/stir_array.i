@@ -1,6 +1,6 @@
 /*
     Copyright (C) 2011-07-01 - 2012, Kris Thielemans
-    Copyright (C) 2013, 2014, 2015, 2018 - 2022 University College London
+    Copyright (C) 2013, 2014, 2015, 2018 - 2022, 2026 University College London
     This file is part of STIR.
 
     SPDX-License-Identifier: Apache-2.0
@@ -143,10 +143,14 @@ namespace stir
       return swigstir::tuple_from_coord(sizes);
     }
 
-    %feature("autodoc", "fill from a Python iterator, e.g. array.fill(numpyarray.flat)") fill;
+    %feature("autodoc", "fill from a numpy array or a Python iterator, e.g. array.fill(numpyarray) or array.fill(numpyarray.flat)") fill;
     void fill(PyObject* const arg)
     {
-      if (PyIter_Check(arg))
+      if (swigstir::fill_from_numpy(*$self, arg))
+      {
+	// done, without using an iterator
+      }
+      else if (PyIter_Check(arg))
       {
 	swigstir::fill_Array_from_Python_iterator($self, arg);
       }
@@ -202,6 +206,53 @@ namespace stir
      { swigstir::fill_Array_from_matlab(*$self, pm, false /*do not resize */); }
    }
 #endif
+#ifdef SWIGPYTHON
+  // zero-copy conversions between numpy arrays and STIR arrays (of floats).
+  // These are added for every dimension, as the %extend Array above does not work for 1D arrays.
+  %define %ADD_numpy_views(num_dimensions)
+  %newobject Array<num_dimensions,float>::from_numpy_view;
+  %extend Array<num_dimensions,float> {
+    %feature("autodoc", "return a numpy array that shares its memory with this array (and keeps it alive). Do not resize the array while the numpy array is in use.") as_numpy_view;
+    PyObject* as_numpy_view(PyObject **PYTHON_SELF)
+    {
+      return swigstir::numpy_view_of_Array(*$self, *PYTHON_SELF);
+    }
+    %feature("autodoc", "create an array that shares its memory with a C-contiguous numpy array of type float32 (indices start from 0)") from_numpy_view;
+    static Array<num_dimensions,float>* from_numpy_view(PyObject* const arg)
+    {
+      return swigstir::Array_from_numpy_view<num_dimensions>(arg);
+    }
+  }
+  %enddef
+
+  // numpy.asarray() support (no copy)
+  %define %ADD_numpy_array_interface(TYPE)
+  %extend TYPE {
+    %pythoncode %{
+def __array__(self, dtype=None, copy=None):
+    """numpy array interface, such that numpy.asarray() returns a view without copying the data"""
+    a = self.as_numpy_view()
+    if dtype is not None and a.dtype != dtype:
+        if copy is False:
+            raise ValueError("cannot convert STIR data to dtype %s without a copy" % dtype)
+        return a.astype(dtype)
+    return a.copy() if copy else a
+    %}
+  }
+  %enddef
+
+  %ADD_numpy_views(1);
+  %ADD_numpy_views(2);
+  %ADD_numpy_views(3);
+  %ADD_numpy_views(4);
+#if !defined(SWIGPYTHON_BUILTIN)
+  %ADD_numpy_array_interface(%arg(Array<1,float>));
+  %ADD_numpy_array_interface(%arg(Array<2,float>));
+  %ADD_numpy_array_interface(%arg(Array<3,float>));
+  %ADD_numpy_array_interface(%arg(Array<4,float>));
+#endif
+#endif
+
   // TODO next line doesn't give anything useful as SWIG doesn't recognise that 
   // the return value is an array. So, we get a wrapped object that we cannot handle
   //%ADD_indexaccess(int,Array::value_type, Array);
@@ -154,10 +154,14 @@ namespace stir {
       return array;
     }
 
-    %feature("autodoc", "fill from a Python iterator, e.g. proj_data.fill(numpyarray.flat)") fill;
+    %feature("autodoc", "fill from a numpy array or a Python iterator, e.g. proj_data.fill(numpyarray) or proj_data.fill(numpyarray.flat)") fill;
     void fill(PyObject* const arg)
     {
-      if (PyIter_Check(arg))
+      if (swigstir::fill_from_numpy(*$self, arg))
+      {
+        // done, without intermediate Array
+      }
+      else if (PyIter_Check(arg))
       {
         // TODO avoid need for copy to Array
         Array<4,float> array = swigstir::create_array_for_proj_data(*$self);
@@ -195,10 +199,14 @@ namespace stir {
 %extend ProjDataInMemory
   {
 #ifdef SWIGPYTHON
-    %feature("autodoc", "fill from a Python iterator, e.g. proj_data.fill(numpyarray.flat)") fill;
+    %feature("autodoc", "fill from a numpy array or a Python iterator, e.g. proj_data.fill(numpyarray) or proj_data.fill(numpyarray.flat)") fill;
     void fill(PyObject* const arg)
     {
-      if (PyIter_Check(arg))
+      if (swigstir::fill_from_numpy(*$self, arg))
+      {
+        // done, without intermediate Array
+      }
+      else if (PyIter_Check(arg))
       {
         Array<4,float> array = swigstir::create_array_for_proj_data(*$self);
 	swigstir::fill_Array_from_Python_iterator(&array, arg);
@@ -213,6 +221,12 @@ namespace stir {
       } 
     }
 
+    %feature("autodoc", "return a 4D numpy array (TOF, sinogram, view, tangential position) that shares its memory with the projection data (and keeps it alive)") as_numpy_view;
+    PyObject* as_numpy_view(PyObject **PYTHON_SELF)
+    {
+      return swigstir::numpy_view_of_ProjDataInMemory(*$self, *PYTHON_SELF);
+    }
+
 #elif defined(SWIGMATLAB)
     void fill(const mxArray *pm)
     { 
@@ -223,6 +237,9 @@ namespace stir {
 #endif
   }
 
+#if defined(SWIGPYTHON) && !defined(SWIGPYTHON_BUILTIN)
+  %ADD_numpy_array_interface(ProjDataInMemory);
+#endif
 }
 
 %include "stir/ProjDataFromStream.h"
@@ -1,6 +1,6 @@
 # A simple module with a few python functions to make it easier to work with STIR
 # Copyright (C) 2012 Kris Thielemans
-# Copyright (C) 2013 University College London
+# Copyright (C) 2013, 2026 University College London
 
 # This file is part of STIR.
 #
@@ -61,7 +61,14 @@ def get_physical_coordinates_for_grid(image):
 def to_numpy(stirdata):
     """
     return the data in a STIR image or other Array as a numpy array
+
+    This returns a copy. Use stirdata.as_numpy_view() or numpy.asarray(stirdata) to share memory instead.
     """
+    # fast path for contiguous arrays and ProjDataInMemory
+    try:
+        return numpy.array(stirdata.as_numpy_view())
+    except (AttributeError, RuntimeError):
+        pass
     # construct a numpy array using the "flat" STIR iterator
     try:
         npstirdata=numpy.fromiter(stirdata.flat(), dtype=numpy.float32);
@@ -4,7 +4,7 @@
 #     py.test test_numpy.py
 
 
-#    Copyright (C) 2013, 2015 University College London
+#    Copyright (C) 2013, 2015, 2026 University College London
 #    This file is part of STIR.
 #
 #    SPDX-License-Identifier: Apache-2.0
@@ -13,6 +13,7 @@
 
 from stir import *
 import stirextra
+import numpy
 # for Python2 and itertools.zip->zip (as in Python 3) 
 try:
     import itertools.izip as zip
@@ -79,3 +80,86 @@ def test_ProjData():
     seg0=stirextra.to_numpy(projdata.get_segment_by_sinogram(0))
     assert(seg0.max() == 2)
 
+def test_Array3D_numpy_view():
+    minind=Int3BasicCoordinate((3,3,5));
+    a=FloatArray3D(IndexRange3D(minind, Int3BasicCoordinate((9,8,7))))
+    a.fill(2);
+    view=a.as_numpy_view()
+    assert view.shape==(7,6,3)
+    assert view.dtype==numpy.float32
+    # view shares memory with the STIR array
+    view[1,2,0]=5
+    ind=Int3BasicCoordinate((4,5,5));
+    assert a[ind]==5
+    np=numpy.asarray(a)
+    np[0,0,0]=3
+    assert a[minind]==3
+    # view keeps the STIR array alive
+    del a
+    assert view[1,2,0]==5
+
+def test_FloatVoxelsOnCartesianGrid_numpy_view():
+    origin=FloatCartesianCoordinate3D(0,1,6)
+    gridspacing=FloatCartesianCoordinate3D(1,1,2)
+    minind=Int3BasicCoordinate((-1,2,-3))
+    indrange=IndexRange3D(minind,Int3BasicCoordinate((3,6,1)))
+    image=FloatVoxelsOnCartesianGrid(indrange, origin,gridspacing)
+    image.fill(2)
+    view=image.as_numpy_view()
+    assert view.shape==(5,5,5)
+    assert view.dtype==numpy.float32
+    assert view.max()==2
+    # view shares memory with the image
+    view[1,2,3]=7
+    assert image[Int3BasicCoordinate((0,4,0))]==7
+    image[minind]=5
+    assert view[0,0,0]==5
+    np=numpy.asarray(image)
+    np*=2
+    assert image[minind]==10
+    assert numpy.array_equal(stirextra.to_numpy(image), view)
+    # fill converts to float32 if necessary
+    image.fill(numpy.ones((5,5,5)))
+    assert view.sum()==125
+    # view keeps the image alive
+    del image
+    assert view[1,2,3]==1
+
+def test_Array3D_fill_from_numpy():
+    a=FloatArray3D(IndexRange3D(Int3BasicCoordinate((1,3,-1)), Int3BasicCoordinate((3,9,5))))
+    np=numpy.arange(a.size_all(), dtype=numpy.float64).reshape((3,7,7))
+    a.fill(np)
+    assert numpy.array_equal(stirextra.to_numpy(a), np.astype(numpy.float32))
+    try:
+        a.fill(numpy.zeros(3))
+        assert False, "fill with wrong size should fail"
+    except RuntimeError:
+        pass
+
+def test_Array3D_from_numpy_view():
+    np=numpy.zeros((4,5,6), dtype=numpy.float32)
+    a=FloatArray3D.from_numpy_view(np)
+    assert a.size_all()==np.size
+    # STIR array shares memory with the numpy array
+    np[1,2,3]=7
+    assert a[Int3BasicCoordinate((1,2,3))]==7
+    a[Int3BasicCoordinate((0,0,1))]=2
+    assert np[0,0,1]==2
+    # STIR array keeps the numpy array alive
+    del np
+    assert a[Int3BasicCoordinate((1,2,3))]==7
+
+def test_ProjDataInMemory_numpy_view():
+    s=Scanner.get_scanner_from_name("ECAT 962")
+    projdatainfo=ProjDataInfo.construct_proj_data_info(s,3,9,8,6)
+    projdata=ProjDataInMemory(ExamInfo(), projdatainfo)
+    view=projdata.as_numpy_view()
+    assert view.shape==(projdatainfo.get_num_tof_poss(),
+                        projdatainfo.get_num_non_tof_sinograms(),
+                        projdatainfo.get_num_views(),
+                        projdatainfo.get_num_tangential_poss())
+    view+=3
+    seg0=stirextra.to_numpy(projdata.get_segment_by_sinogram(0))
+    assert seg0.min()==3
+    projdata.fill(numpy.ones(view.shape))
+    assert view.max()==1
@@ -23,7 +23,12 @@
 #include "stir/modelling/PlasmaData.h"
 #include "stir/modelling/ParametricDiscretisedDensity.h"
 #include "stir/TimeFrameDefinitions.h"
+#include "stir/DynamicDiscretisedDensity.h"
+#include "stir/VoxelsOnCartesianGrid.h"
+#include "stir/IndexRange3D.h"
+#include "stir/Scanner.h"
 #include "stir/utilities.h"
+#include "stir/linear_regression.h"
 #include <boost/shared_array.hpp>
 
 START_NAMESPACE_STIR
@@ -231,6 +236,89 @@ modellingTests::run_tests()
                        stir_model_array[2][frame_num],
                        "Check _model_array-2nd column in ModelMatrix");
       }
+
+    std::cerr << "\nTesting frame-by-frame multiplications with the Model Matrix..." << std::endl;
+    {
+      const shared_ptr<VoxelsOnCartesianGrid<float>> frame_image_sptr(new VoxelsOnCartesianGrid<float>(
+          IndexRange3D(0, 1, -2, 2, -3, 3), CartesianCoordinate3D<float>(0.F, 0.F, 0.F), CartesianCoordinate3D<float>(2.F, 2.F, 2.F)));
+      ParametricVoxelsOnCartesianGrid parametric_image(*frame_image_sptr);
+      {
+        float value = 1.F;
+        for (ParametricVoxelsOnCartesianGrid::full_iterator iter = parametric_image.begin_all(); iter != parametric_image.end_all();
+             ++iter, value += .5F)
+          *iter = value;
+      }
+      DynamicDiscretisedDensity dynamic_image(time_frame_def, 0., shared_ptr<Scanner>(new Scanner(Scanner::E966)), frame_image_sptr);
+      stir_model_matrix.multiply_parametric_image_with_model(dynamic_image, parametric_image);
+      ParametricVoxelsOnCartesianGrid parametric_image_via_frames(*frame_image_sptr);
+      std::fill(parametric_image_via_frames.begin_all(), parametric_image_via_frames.end_all(), 0.F);
+      for (unsigned int frame_num = 1; frame_num <= time_frame_def.get_num_frames(); ++frame_num)
+        {
+          stir_model_matrix.multiply_parametric_image_with_model_for_frame(*frame_image_sptr, parametric_image, frame_num);
+          check_if_equal(dynamic_image[frame_num], *frame_image_sptr, "Check multiply_parametric_image_with_model_for_frame");
+          stir_model_matrix.multiply_frame_image_with_model_and_add_to_input(
+              parametric_image_via_frames, dynamic_image[frame_num], frame_num);
+        }
+      stir_model_matrix.multiply_dynamic_image_with_model(parametric_image, dynamic_image);
+      for (int param_num = 1; param_num <= 2; ++param_num)
+        check_if_equal(parametric_image.construct_single_density(param_num),
+                       parametric_image_via_frames.construct_single_density(param_num),
+                       "Check multiply_frame_image_with_model_and_add_to_input");
+    }
+
+    std::cerr << "\nTesting the Patlak linear regression..." << std::endl;
+    {
+      const shared_ptr<VoxelsOnCartesianGrid<float>> frame_image_sptr(new VoxelsOnCartesianGrid<float>(
+          IndexRange3D(0, 1, -2, 2, -3, 3), CartesianCoordinate3D<float>(0.F, 0.F, 0.F), CartesianCoordinate3D<float>(2.F, 2.F, 2.F)));
+      ParametricVoxelsOnCartesianGrid parametric_image(*frame_image_sptr);
+      {
+        int c = 0;
+        for (ParametricVoxelsOnCartesianGrid::full_iterator iter = parametric_image.begin_all(); iter != parametric_image.end_all();
+             ++iter, ++c)
+          *iter = 1.F + (c % 7) * .3F;
+      }
+      DynamicDiscretisedDensity dynamic_image(time_frame_def, 0., shared_ptr<Scanner>(new Scanner(Scanner::E966)), frame_image_sptr);
+      patlak_plot.get_dynamic_image_from_parametric_image(dynamic_image, parametric_image);
+      // add some variation such that the fit is not exact
+      {
+        int c = 0;
+        for (unsigned int frame_num = starting_frame; frame_num <= time_frame_def.get_num_frames(); ++frame_num)
+          for (auto iter = dynamic_image[frame_num].begin_all(); iter != dynamic_image[frame_num].end_all(); ++iter, ++c)
+            *iter *= 1.F + ((c % 5) - 2) * .01F;
+      }
+      ParametricVoxelsOnCartesianGrid fitted_parametric_image(*frame_image_sptr);
+      patlak_plot.apply_linear_regression(fitted_parametric_image, dynamic_image);
+
+      // compare with linear_regression for every voxel
+      const Array<2, float> model_array = patlak_plot.get_model_matrix().get_model_array();
+      VectorWithOffset<float> patlak_x(starting_frame, time_frame_def.get_num_frames());
+      VectorWithOffset<float> patlak_y(starting_frame, time_frame_def.get_num_frames());
+      VectorWithOffset<float> weights(starting_frame, time_frame_def.get_num_frames());
+      for (unsigned int frame_num = starting_frame; frame_num <= time_frame_def.get_num_frames(); ++frame_num)
+        {
+          patlak_x[frame_num] = model_array[1][frame_num] / model_array[2][frame_num];
+          weights[frame_num] = 1.F;
+        }
+      for (int k = fitted_parametric_image.get_min_index(); k <= fitted_parametric_image.get_max_index(); ++k)
+        for (int j = fitted_parametric_image[k].get_min_index(); j <= fitted_parametric_image[k].get_max_index(); ++j)
+          for (int i = fitted_parametric_image[k][j].get_min_index(); i <= fitted_parametric_image[k][j].get_max_index(); ++i)
+            {
+              for (unsigned int frame_num = starting_frame; frame_num <= time_frame_def.get_num_frames(); ++frame_num)
+                patlak_y[frame_num] = dynamic_image[frame_num][k][j][i] / model_array[2][frame_num];
+              double slope, y_intersection, chi_square, variance_of_slope, variance_of_y_intersection, covariance;
+              linear_regression(y_intersection,
+                                slope,
+                                chi_square,
+                                variance_of_y_intersection,
+                                variance_of_slope,
+                                covariance,
+                                patlak_y,
+                                patlak_x,
+                                weights);
+              check_if_equal(static_cast<float>(slope), fitted_parametric_image[k][j][i][1], "Check Patlak slope");
+              check_if_equal(static_cast<float>(y_intersection), fitted_parametric_image[k][j][i][2], "Check Patlak intercept");
+            }
+    }
   }
 }
 
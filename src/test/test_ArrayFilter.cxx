@@ -25,6 +25,12 @@
 #include "stir/ArrayFilter2DUsingConvolution.h"
 #include "stir/IndexRange2D.h"
 #include "stir/ArrayFilter3DUsingConvolution.h"
+#include "stir/SeparableArrayFunctionObject.h"
+#include "stir/ArrayFunction.h"
+#include "stir/MedianArrayFilter3D.h"
+#include "stir/MinimalArrayFilter3D.h"
+#include "stir/MaximalArrayFilter3D.h"
+#include "stir/Coordinate3D.h"
 #include "stir/IndexRange3D.h"
 #include "stir/Succeeded.h"
 #include "stir/modulo.h"
@@ -33,6 +39,7 @@
 #include "stir/stream.h" //XXX
 #include <iostream>
 #include <algorithm>
+#include <vector>
 #include <boost/static_assert.hpp>
 
 #ifdef DO_TIMINGS
@@ -52,6 +59,14 @@ public:
   void run_tests() override;
 
 private:
+  //! compare median, minimal and maximal filters with a straightforward implementation
+  void test_rank_filters(const Array<3, float>& test, const Coordinate3D<int>& mask_radius);
+
+  //! compare SeparableArrayFunctionObject with applying the 1D filters line by line
+  void test_separable_filter(const VectorWithOffset<shared_ptr<ArrayFunctionObject<1, float>>>& filters,
+                             const Array<3, float>& test,
+                             const char* const str);
+
   template <int num_dimensions>
   void compare_results_1arg(const ArrayFunctionObject<num_dimensions, float>& filter1,
                             const ArrayFunctionObject<num_dimensions, float>& filter2,
@@ -155,6 +170,70 @@ private:
       }
   }
 };
+void
+ArrayFilterTests::test_rank_filters(const Array<3, float>& test, const Coordinate3D<int>& mask_radius)
+{
+  Array<3, float> median(test.get_index_range());
+  Array<3, float> minimum(test.get_index_range());
+  Array<3, float> maximum(test.get_index_range());
+  for (int z = test.get_min_index(); z <= test.get_max_index(); ++z)
+    for (int y = test[z].get_min_index(); y <= test[z].get_max_index(); ++y)
+      for (int x = test[z][y].get_min_index(); x <= test[z][y].get_max_index(); ++x)
+        {
+          std::vector<float> neighbours;
+          for (int in_z = std::max(z - mask_radius[1], test.get_min_index());
+               in_z <= std::min(z + mask_radius[1], test.get_max_index());
+               ++in_z)
+            for (int in_y = std::max(y - mask_radius[2], test[in_z].get_min_index());
+                 in_y <= std::min(y + mask_radius[2], test[in_z].get_max_index());
+                 ++in_y)
+              for (int in_x = std::max(x - mask_radius[3], test[in_z][in_y].get_min_index());
+                   in_x <= std::min(x + mask_radius[3], test[in_z][in_y].get_max_index());
+                   ++in_x)
+                neighbours.push_back(test[in_z][in_y][in_x]);
+          std::sort(neighbours.begin(), neighbours.end());
+          const std::size_t n = neighbours.size();
+          median[z][y][x] = n % 2 == 1 ? neighbours[n / 2] : (neighbours[n / 2 - 1] + neighbours[n / 2]) / 2;
+          minimum[z][y][x] = neighbours.front();
+          maximum[z][y][x] = neighbours.back();
+        }
+
+  MedianArrayFilter3D<float> median_filter(mask_radius);
+  MinimalArrayFilter3D<float> minimal_filter(mask_radius);
+  MaximalArrayFilter3D<float> maximal_filter(mask_radius);
+  Array<3, float> out(test.get_index_range());
+  median_filter(out, test);
+  check_if_equal(out, median, "median filter");
+  minimal_filter(out, test);
+  check_if_equal(out, minimum, "minimal filter");
+  maximal_filter(out, test);
+  check_if_equal(out, maximum, "maximal filter");
+  // in-place versions
+  out = test;
+  median_filter(out);
+  check_if_equal(out, median, "median filter (in-place)");
+  out = test;
+  minimal_filter(out);
+  check_if_equal(out, minimum, "minimal filter (in-place)");
+}
+
+void
+ArrayFilterTests::test_separable_filter(const VectorWithOffset<shared_ptr<ArrayFunctionObject<1, float>>>& filters,
+                                        const Array<3, float>& test,
+                                        const char* const str)
+{
+  Array<3, float> reference(test);
+  in_place_apply_array_functions_on_each_index(reference, filters.begin(), filters.end());
+
+  const SeparableArrayFunctionObject<3, float> separable_filter(filters);
+  Array<3, float> out(test);
+  separable_filter(out);
+  check_if_equal(out, reference, std::string("separable filter (in-place) ") + str);
+  out.fill(0.F);
+  separable_filter(out, test);
+  check_if_equal(out, reference, std::string("separable filter ") + str);
+}
+
 void
 ArrayFilterTests::run_tests()
 {
@@ -423,6 +502,78 @@ ArrayFilterTests::run_tests()
       compare_results_1arg(DFT_filter, conv_filter, test_pos_offset);
     }
   }
+
+  std::cerr << "\nTesting SeparableArrayFunctionObject\n";
+  {
+    Array<3, float> test(IndexRange3D(-2, 5, 1, 11, -3, 196));
+    // initialise to some arbitrary values
+    {
+      int i = 0;
+      for (Array<3, float>::full_iterator iter = test.begin_all(); iter != test.end_all(); ++i, ++iter)
+        *iter = static_cast<float>((i * 37) % 23) - 5.F;
+    }
+    VectorWithOffset<float> kernel(-1, 2);
+    kernel[-1] = 1;
+    kernel[0] = 2;
+    kernel[1] = 3;
+    kernel[2] = .5;
+    VectorWithOffset<float> shift_kernel(1, 1);
+    shift_kernel[1] = 1;
+    VectorWithOffset<float> half_kernel(0, 2);
+    half_kernel[0] = .5F;
+    half_kernel[1] = .2F;
+    half_kernel[2] = .05F;
+    // long kernel, such that the DFT is used
+    VectorWithOffset<float> long_kernel(-100, 100);
+    for (int i = -100; i <= 100; ++i)
+      long_kernel[i] = 1.F / (1 + i * i / 100.F) + i / 1000.F;
+    set_tolerance(.001F);
+
+    VectorWithOffset<shared_ptr<ArrayFunctionObject<1, float>>> filters(3);
+    filters[0].reset(new ArrayFilter1DUsingConvolution<float>(kernel));
+    filters[1].reset(new ArrayFilter1DUsingConvolution<float>(kernel, BoundaryConditions::constant));
+    filters[2].reset(new ArrayFilter1DUsingConvolutionSymmetricKernel<float>(half_kernel));
+    test_separable_filter(filters, test, "convolutions");
+
+    filters[0].reset(new ArrayFilter1DUsingConvolution<float>(shift_kernel, BoundaryConditions::constant));
+    filters[1].reset(new ArrayFilter1DUsingConvolution<float>());
+    filters[2].reset(new ArrayFilter1DUsingConvolution<float>(long_kernel));
+    test_separable_filter(filters, test, "long kernel");
+
+    {
+      // a 1D filter that is not a convolution
+      Array<1, float> kernel_for_DFT(0, 31);
+      kernel_for_DFT[0] = 2.F;
+      kernel_for_DFT[1] = 1.F;
+      kernel_for_DFT[31] = .5F;
+      filters[0].reset(new ArrayFilterUsingRealDFTWithPadding<1, float>(kernel_for_DFT));
+      filters[1].reset(new ArrayFilter1DUsingConvolutionSymmetricKernel<float>(half_kernel));
+      filters[2].reset(new ArrayFilter1DUsingConvolution<float>(kernel));
+      test_separable_filter(filters, test, "non-convolution");
+    }
+  }
+
+  std::cerr << "\nTesting 3D median, minimal and maximal filters\n";
+  {
+    set_tolerance(.001F);
+    Array<3, float> test(IndexRange3D(-2, 4, 1, 9, -3, 8));
+    // some arbitrary values, with duplicates
+    {
+      int i = 0;
+      for (Array<3, float>::full_iterator iter = test.begin_all(); iter != test.end_all(); ++i, ++iter)
+        *iter = static_cast<float>((i * 37) % 23) - 5.F;
+    }
+    test_rank_filters(test, Coordinate3D<int>(1, 1, 1));
+    test_rank_filters(test, Coordinate3D<int>(2, 1, 3));
+    test_rank_filters(test, Coordinate3D<int>(0, 2, 0));
+    test_rank_filters(test, Coordinate3D<int>(3, 0, 7));
+
+    // irregular array
+    Array<3, float> irregular_test(test);
+    irregular_test[0][3].resize(-1, 5);
+    irregular_test[1].resize(IndexRange2D(2, 7, -3, 8));
+    test_rank_filters(irregular_test, Coordinate3D<int>(1, 2, 1));
+  }
 }
 
 END_NAMESPACE_STIR
@@ -0,0 +1,243 @@
+/*!
+
+  \file
+  \ingroup test
+
+  \brief Test program for stir::ecat::BinNormalisationFromECAT8
+
+  Writes a synthetic mMR normalisation file and checks that the results with and without
+  precomputed efficiencies are identical.
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+
+#include "stir/recon_buildblock/BinNormalisationFromECAT8.h"
+#include "stir/ProjDataInfo.h"
+#include "stir/ProjDataInMemory.h"
+#include "stir/ExamInfo.h"
+#include "stir/TimeFrameDefinitions.h"
+#include "stir/Scanner.h"
+#include "stir/Bin.h"
+#include "stir/IndexRange2D.h"
+#include "stir/IO/write_data.h"
+#include "stir/RunTests.h"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+START_NAMESPACE_STIR
+
+/*!
+  \ingroup test
+  \brief Test class for BinNormalisationFromECAT8
+
+  Compares get_uncalibrated_bin_efficiency(), apply() and undo() with and without
+  precomputed efficiencies.
+*/
+class BinNormalisationFromECAT8Tests : public RunTests
+{
+public:
+  void run_tests() override;
+
+protected:
+  //! write a norm file with (non-trivial) components for the mMR, return the name of the header
+  std::string write_norm_file();
+  void run_tests_for_norm_file(const std::string& norm_filename);
+
+  static const char* const norm_header_filename;
+  static const char* const norm_data_filename;
+};
+
+const char* const BinNormalisationFromECAT8Tests::norm_header_filename = "test_BinNormalisationFromECAT8.n.hdr";
+const char* const BinNormalisationFromECAT8Tests::norm_data_filename = "test_BinNormalisationFromECAT8.n";
+
+std::string
+BinNormalisationFromECAT8Tests::write_norm_file()
+{
+  const std::string header_filename = norm_header_filename;
+  const std::string data_filename = norm_data_filename;
+
+  const Scanner scanner(Scanner::Siemens_mMR);
+  const int num_rings = scanner.get_num_rings();
+  const int num_detectors_per_ring = scanner.get_num_detectors_per_ring();
+  const int num_bins = scanner.get_max_num_non_arccorrected_bins();
+  const int num_crystals_per_block = scanner.get_num_transaxial_crystals_per_block();
+  // span 11, max ring difference 60
+  const std::vector<int> segment_table{ 127, 115, 115, 93, 93, 71, 71, 49, 49, 27, 27 };
+  int num_sinograms = 0;
+  for (auto s : segment_table)
+    num_sinograms += s;
+
+  Array<2, float> geometric_factors(IndexRange2D(2 * num_rings - 1, num_bins));
+  Array<2, float> crystal_interference_factors(IndexRange2D(num_bins, num_crystals_per_block));
+  Array<2, float> efficiency_factors(IndexRange2D(num_rings, num_detectors_per_ring));
+  Array<1, float> axial_effects(num_sinograms);
+  {
+    int c = 0;
+    for (auto iter = geometric_factors.begin_all(); iter != geometric_factors.end_all(); ++iter, ++c)
+      *iter = 1.F + (c % 7) * .05F;
+    for (auto iter = crystal_interference_factors.begin_all(); iter != crystal_interference_factors.end_all(); ++iter, ++c)
+      *iter = 1.F + (c % 5) * .03F;
+    for (auto iter = efficiency_factors.begin_all(); iter != efficiency_factors.end_all(); ++iter, ++c)
+      *iter = 1.F + (c % 13) * .02F;
+    for (auto iter = axial_effects.begin_all(); iter != axial_effects.end_all(); ++iter, ++c)
+      *iter = 1.F + (c % 3) * .1F;
+  }
+
+  std::vector<std::streamoff> offsets(1, 0);
+  {
+    std::ofstream data(data_filename.c_str(), std::ios::out | std::ios::binary);
+    write_data(data, geometric_factors, ByteOrder::little_endian);
+    offsets.push_back(data.tellp());
+    write_data(data, crystal_interference_factors, ByteOrder::little_endian);
+    offsets.push_back(data.tellp());
+    write_data(data, efficiency_factors, ByteOrder::little_endian);
+    offsets.push_back(data.tellp());
+    write_data(data, axial_effects, ByteOrder::little_endian);
+    if (!data)
+      error("Error writing " + data_filename);
+  }
+
+  std::ofstream header(header_filename.c_str());
+  header << "!INTERFILE:=\n"
+         << "!originating system:=2008\n"
+         << "!name of data file:=" << data_filename << '\n'
+         << "image data byte order:=LITTLEENDIAN\n"
+         << "!PET data type:=normalization\n"
+         << "number format:=float\n"
+         << "!number of bytes per pixel:=4\n"
+         << "%number of normalization components:=4\n"
+         << "%matrix size [1]:={" << num_bins << ',' << 2 * num_rings - 1 << "}\n"
+         << "%matrix size [2]:={" << num_crystals_per_block << ',' << num_bins << "}\n"
+         << "%matrix size [3]:={" << num_detectors_per_ring << ',' << num_rings << "}\n"
+         << "%matrix size [4]:={" << num_sinograms << "}\n";
+  for (std::size_t i = 0; i < offsets.size(); ++i)
+    header << "data offset in bytes [" << i + 1 << "]:=" << offsets[i] << '\n';
+  header << "%axial compression:=11\n"
+         << "%maximum ring difference:=60\n"
+         << "number of rings:=" << num_rings << '\n'
+         << "%number of segments:=" << segment_table.size() << '\n'
+         << "%segment table:={";
+  for (std::size_t i = 0; i < segment_table.size(); ++i)
+    header << (i == 0 ? "" : ",") << segment_table[i];
+  header << "}\n"
+         << "%TOF mashing factor:=1\n"
+         << "END OF INTERFILE :=\n";
+  if (!header)
+    error("Error writing " + header_filename);
+
+  return header_filename;
+}
+
+void
+BinNormalisationFromECAT8Tests::run_tests()
+{
+  run_tests_for_norm_file(write_norm_file());
+  std::remove(norm_header_filename);
+  std::remove(norm_data_filename);
+}
+
+void
+BinNormalisationFromECAT8Tests::run_tests_for_norm_file(const std::string& norm_filename)
+{
+  shared_ptr<Scanner> scanner_sptr(new Scanner(Scanner::Siemens_mMR));
+  // use span 11 (as the norm file), but only segment 0, view mashing and fewer tangential positions to keep this fast
+  shared_ptr<const ProjDataInfo> proj_data_info_sptr(
+      ProjDataInfo::construct_proj_data_info(scanner_sptr,
+                                             /*span*/ 11,
+                                             /*max_delta*/ 5,
+                                             /*views*/ scanner_sptr->get_num_detectors_per_ring() / 8,
+                                             /*tang_pos*/ 64,
+                                             /*arc_corrected*/ false));
+  auto exam_info_sptr = std::make_shared<ExamInfo>(ImagingModality::PT);
+  exam_info_sptr->set_time_frame_definitions(TimeFrameDefinitions(std::vector<std::pair<double, double>>{ { 0., 100. } }));
+
+  ecat::BinNormalisationFromECAT8 norm(norm_filename);
+  ecat::BinNormalisationFromECAT8 precomputed_norm(norm_filename);
+  precomputed_norm.set_precompute_efficiencies(true);
+  check(!norm.get_precompute_efficiencies(), "precompute_efficiencies should default to false");
+  check(precomputed_norm.get_precompute_efficiencies(), "set_precompute_efficiencies");
+  if (!check(norm.set_up(exam_info_sptr, proj_data_info_sptr) == Succeeded::yes, "set_up without precomputing")
+      || !check(precomputed_norm.set_up(exam_info_sptr, proj_data_info_sptr) == Succeeded::yes, "set_up with precomputing"))
+    return;
+
+  std::cerr << "Comparing efficiencies\n";
+  {
+    Bin bin;
+    for (bin.segment_num() = proj_data_info_sptr->get_min_segment_num();
+         bin.segment_num() <= proj_data_info_sptr->get_max_segment_num();
+         ++bin.segment_num())
+      for (bin.view_num() = proj_data_info_sptr->get_min_view_num(); bin.view_num() <= proj_data_info_sptr->get_max_view_num();
+           ++bin.view_num())
+        for (bin.axial_pos_num() = proj_data_info_sptr->get_min_axial_pos_num(bin.segment_num());
+             bin.axial_pos_num() <= proj_data_info_sptr->get_max_axial_pos_num(bin.segment_num());
+             ++bin.axial_pos_num())
+          for (bin.tangential_pos_num() = proj_data_info_sptr->get_min_tangential_pos_num();
+               bin.tangential_pos_num() <= proj_data_info_sptr->get_max_tangential_pos_num();
+               ++bin.tangential_pos_num())
+            if (!check_if_equal(precomputed_norm.get_uncalibrated_bin_efficiency(bin),
+                                norm.get_uncalibrated_bin_efficiency(bin),
+                                "get_uncalibrated_bin_efficiency with and without precomputing"))
+              {
+                std::cerr << "segment " << bin.segment_num() << ", view " << bin.view_num() << ", axial position "
+                          << bin.axial_pos_num() << ", tangential position " << bin.tangential_pos_num() << '\n';
+                return;
+              }
+  }
+
+  std::cerr << "Comparing apply() and undo()\n";
+  {
+    ProjDataInMemory data(exam_info_sptr, proj_data_info_sptr);
+    {
+      int c = 0;
+      for (auto iter = data.begin(); iter != data.end(); ++iter, ++c)
+        *iter = 1.F + (c % 11);
+    }
+    ProjDataInMemory data_precomputed(data);
+    norm.apply(data);
+    precomputed_norm.apply(data_precomputed);
+    check(data.find_max() > 0.F, "apply() should give non-zero data");
+    check_if_equal(data_precomputed, data, "apply() with and without precomputing");
+
+    data.fill(1.F);
+    data_precomputed.fill(1.F);
+    norm.undo(data);
+    precomputed_norm.undo(data_precomputed);
+    check_if_equal(data_precomputed, data, "undo() with and without precomputing");
+  }
+
+  // calling set_up again (e.g. for another time frame) should give the same efficiencies
+  std::cerr << "Checking set_up() for a different frame\n";
+  {
+    auto exam_info2_sptr = std::make_shared<ExamInfo>(*exam_info_sptr);
+    exam_info2_sptr->set_time_frame_definitions(
+        TimeFrameDefinitions(std::vector<std::pair<double, double>>{ { 100., 400. } }));
+    if (!check(precomputed_norm.set_up(exam_info2_sptr, proj_data_info_sptr) == Succeeded::yes, "second set_up"))
+      return;
+    const Bin bin(0, 3, 10, 5);
+    check_if_equal(precomputed_norm.get_uncalibrated_bin_efficiency(bin),
+                   norm.get_uncalibrated_bin_efficiency(bin),
+                   "get_uncalibrated_bin_efficiency after second set_up");
+  }
+}
+
+END_NAMESPACE_STIR
+
+USING_NAMESPACE_STIR
+
+int
+main()
+{
+  BinNormalisationFromECAT8Tests tests;
+  tests.run_tests();
+  return tests.main_return_value();
+}
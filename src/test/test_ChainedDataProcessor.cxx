@@ -0,0 +1,139 @@
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+/*!
+  \file
+  \ingroup test
+  \ingroup DataProcessor
+
+  \brief Test program for stir::ChainedDataProcessor
+*/
+
+#include "stir/ChainedDataProcessor.h"
+#include "stir/TruncateToCylindricalFOVImageProcessor.h"
+#include "stir/ThresholdMinToSmallPositiveValueDataProcessor.h"
+#include "stir/HUToMuImageProcessor.h"
+#include "stir/SeparableGaussianImageFilter.h"
+#include "stir/VoxelsOnCartesianGrid.h"
+#include "stir/IndexRange3D.h"
+#include "stir/find_STIR_config.h"
+#include "stir/RunTests.h"
+#include "stir/unique_ptr.h"
+#include <iostream>
+#include <vector>
+
+START_NAMESPACE_STIR
+
+/*!
+  \ingroup test
+  \brief Test class for ChainedDataProcessor
+
+  Checks that a (nested) chain with point-wise and other data processors gives the same result
+  as applying the data processors one after the other, for the in-place and 2-argument versions
+  of apply().
+*/
+class ChainedDataProcessorTests : public RunTests
+{
+public:
+  void run_tests() override;
+
+private:
+  typedef DiscretisedDensity<3, float> target_type;
+  typedef std::vector<shared_ptr<DataProcessor<target_type>>> processors_type;
+
+  //! construct a chain from \a processors (nested as ChainedDataProcessor only takes 2 processors)
+  static shared_ptr<DataProcessor<target_type>> make_chain(const processors_type& processors);
+  void run_tests_for_processors(const processors_type& processors, const target_type& image, const std::string& str);
+};
+
+shared_ptr<DataProcessor<DiscretisedDensity<3, float>>>
+ChainedDataProcessorTests::make_chain(const processors_type& processors)
+{
+  shared_ptr<DataProcessor<target_type>> chain_sptr(processors.back());
+  for (auto iter = processors.rbegin() + 1; iter != processors.rend(); ++iter)
+    chain_sptr.reset(new ChainedDataProcessor<target_type>(*iter, chain_sptr));
+  return chain_sptr;
+}
+
+void
+ChainedDataProcessorTests::run_tests_for_processors(const processors_type& processors,
+                                                    const target_type& image,
+                                                    const std::string& str)
+{
+  std::cerr << "\t" << str << "\n";
+  unique_ptr<target_type> reference_sptr(image.clone());
+  for (const auto& processor_sptr : processors)
+    processor_sptr->apply(*reference_sptr);
+
+  const shared_ptr<DataProcessor<target_type>> chain_sptr = make_chain(processors);
+  {
+    unique_ptr<target_type> result_sptr(image.clone());
+    check(chain_sptr->apply(*result_sptr) == Succeeded::yes, str + ": in-place apply");
+    check_if_equal(*reference_sptr, *result_sptr, str + ": in-place apply should give same result as sequential");
+  }
+  {
+    unique_ptr<target_type> result_sptr(image.get_empty_copy());
+    check(chain_sptr->apply(*result_sptr, image) == Succeeded::yes, str + ": 2-argument apply");
+    check_if_equal(*reference_sptr, *result_sptr, str + ": 2-argument apply should give same result as sequential");
+  }
+}
+
+void
+ChainedDataProcessorTests::run_tests()
+{
+  std::cerr << "Tests for ChainedDataProcessor\n";
+
+  VoxelsOnCartesianGrid<float> image(IndexRange3D(0, 6, -10, 10, -9, 10),
+                                     CartesianCoordinate3D<float>(0.F, 0.F, 0.F),
+                                     CartesianCoordinate3D<float>(3.F, 2.F, 2.F));
+  {
+    // fill with some values, including negative ones
+    int i = 0;
+    for (auto iter = image.begin_all(); iter != image.end_all(); ++iter, ++i)
+      *iter = static_cast<float>((i * 37) % 201 - 50);
+  }
+
+  shared_ptr<TruncateToCylindricalFOVImageProcessor<float>> truncate_sptr(new TruncateToCylindricalFOVImageProcessor<float>);
+  shared_ptr<TruncateToCylindricalFOVImageProcessor<float>> truncate_rim_sptr(new TruncateToCylindricalFOVImageProcessor<float>);
+  truncate_rim_sptr->set_truncate_rim(2);
+  truncate_rim_sptr->set_strictly_less_than_radius(false);
+  shared_ptr<DataProcessor<target_type>> threshold_sptr(new ThresholdMinToSmallPositiveValueDataProcessor<target_type>);
+  shared_ptr<HUToMuImageProcessor<target_type>> HU_to_mu_sptr(new HUToMuImageProcessor<target_type>);
+#ifdef HAVE_JSON
+  HU_to_mu_sptr->set_slope_filename(find_STIR_config_file("ct_slopes.json"));
+#else
+  HU_to_mu_sptr->set_slope(.096F, .096F, 9.6e-5F, 5.1e-5F, 0.F);
+#endif
+  shared_ptr<SeparableGaussianImageFilter<float>> gaussian_sptr(new SeparableGaussianImageFilter<float>);
+  gaussian_sptr->set_fwhms(make_coordinate(4.F, 5.F, 5.F));
+
+  check(truncate_sptr->is_pointwise(), "TruncateToCylindricalFOVImageProcessor should be point-wise");
+  check(threshold_sptr->is_pointwise(), "ThresholdMinToSmallPositiveValueDataProcessor should be point-wise");
+  check(HU_to_mu_sptr->is_pointwise(), "HUToMuImageProcessor should be point-wise");
+  check(!gaussian_sptr->is_pointwise(), "SeparableGaussianImageFilter should not be point-wise");
+
+  run_tests_for_processors({ truncate_sptr, HU_to_mu_sptr }, image, "2 point-wise processors");
+  run_tests_for_processors({ HU_to_mu_sptr, truncate_rim_sptr, threshold_sptr, truncate_sptr, gaussian_sptr, HU_to_mu_sptr },
+                           image,
+                           "point-wise processors, one depending on the whole input, followed by a filter");
+  run_tests_for_processors({ gaussian_sptr, truncate_sptr, threshold_sptr }, image, "filter followed by point-wise processors");
+  run_tests_for_processors(
+      { threshold_sptr, gaussian_sptr, truncate_rim_sptr }, image, "filter in between point-wise processors");
+}
+
+END_NAMESPACE_STIR
+
+USING_NAMESPACE_STIR
+
+int
+main()
+{
+  ChainedDataProcessorTests tests;
+  tests.run_tests();
+  return tests.main_return_value();
+}
@@ -0,0 +1,183 @@
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+/*!
+  \file
+  \ingroup test
+  \ingroup buildblock
+
+  \brief Test program for stir::Profiler
+*/
+
+#include "stir/Profiler.h"
+#include "stir/RunTests.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+START_NAMESPACE_STIR
+
+/*!
+  \ingroup test
+  \brief Test class for Profiler
+
+  Checks the number of calls and nesting of regions, counters, the Chrome trace output,
+  and that nothing is recorded when the profiler is disabled.
+*/
+class ProfilerTests : public RunTests
+{
+public:
+  void run_tests() override;
+
+private:
+  //! find the summary for a path, returns a summary with \c num_calls 0 if not found
+  static Profiler::RegionSummary find_summary(const std::string& path);
+  static std::size_t count_occurrences(const std::string& str, const std::string& sub_str);
+};
+
+Profiler::RegionSummary
+ProfilerTests::find_summary(const std::string& path)
+{
+  for (const auto& summary : Profiler::get_region_summaries())
+    if (summary.path == path)
+      return summary;
+  Profiler::RegionSummary summary;
+  summary.path = path;
+  summary.depth = -1;
+  summary.num_calls = 0;
+  summary.total_time = summary.self_time = summary.max_thread_time = 0;
+  summary.num_threads = 0;
+  return summary;
+}
+
+std::size_t
+ProfilerTests::count_occurrences(const std::string& str, const std::string& sub_str)
+{
+  std::size_t count = 0;
+  for (std::size_t pos = str.find(sub_str); pos != std::string::npos; pos = str.find(sub_str, pos + sub_str.size()))
+    ++count;
+  return count;
+}
+
+void
+ProfilerTests::run_tests()
+{
+  std::cerr << "Tests for Profiler\n";
+  Profiler::set_enabled(true);
+  Profiler::set_trace_enabled(true);
+  Profiler::reset();
+
+  volatile double sum = 0;
+  for (int i = 0; i < 3; ++i)
+    {
+      STIR_PROFILE_REGION("outer");
+      for (int j = 0; j < 2; ++j)
+        {
+          STIR_PROFILE_REGION("inner");
+          STIR_PROFILE_COUNT("test counter", 1);
+          for (int k = 0; k < 10000; ++k)
+            sum = sum + k;
+        }
+    }
+  {
+    STIR_PROFILE_REGION("with \"quote\"");
+  }
+
+  const int num_parallel_iterations = 16;
+  {
+    STIR_PROFILE_REGION("parallel");
+#ifdef STIR_OPENMP
+#  pragma omp parallel for
+#endif
+    for (int i = 0; i < num_parallel_iterations; ++i)
+      {
+        STIR_PROFILE_REGION("work");
+        STIR_PROFILE_COUNT("work counter", 0.5);
+      }
+  }
+
+  Profiler::set_enabled(false);
+  {
+    STIR_PROFILE_REGION("disabled");
+    STIR_PROFILE_COUNT("test counter", 1);
+  }
+
+  {
+    const Profiler::RegionSummary outer = find_summary("outer");
+    const Profiler::RegionSummary inner = find_summary("outer/inner");
+    check_if_equal(outer.num_calls, 3UL, "number of calls of outer region");
+    check_if_equal(outer.depth, 0, "depth of outer region");
+    check_if_equal(inner.num_calls, 6UL, "number of calls of inner region");
+    check_if_equal(inner.depth, 1, "depth of inner region");
+    check_if_equal(find_summary("inner").num_calls, 0UL, "inner region should only occur in outer region");
+    check(inner.total_time <= outer.total_time, "total time of inner region should be less than of outer region");
+    check(outer.self_time <= outer.total_time, "self time of outer region should be less than its total time");
+    check_if_equal(find_summary("disabled").num_calls, 0UL, "regions should not be recorded when disabled");
+  }
+  {
+    // "work" regions are either nested in "parallel" (for the thread that entered "parallel") or not
+    unsigned long num_work_calls = 0;
+    for (const auto& summary : Profiler::get_region_summaries())
+      if (summary.path == "work" || summary.path == "parallel/work")
+        num_work_calls += summary.num_calls;
+    check_if_equal(num_work_calls, static_cast<unsigned long>(num_parallel_iterations), "number of calls of work region");
+  }
+  {
+    bool found_test_counter = false;
+    bool found_work_counter = false;
+    for (const auto& counter : Profiler::get_counters())
+      {
+        if (counter.first == "test counter")
+          {
+            found_test_counter = true;
+            check_if_equal(counter.second, 6., "value of test counter");
+          }
+        if (counter.first == "work counter")
+          {
+            found_work_counter = true;
+            check_if_equal(counter.second, num_parallel_iterations * 0.5, "value of work counter (summed over threads)");
+          }
+      }
+    check(found_test_counter, "test counter should be present");
+    check(found_work_counter, "work counter should be present");
+  }
+  {
+    std::ostringstream trace;
+    Profiler::write_chrome_trace(trace);
+    const std::string trace_str = trace.str();
+    check(trace_str.find("{\"traceEvents\":[") == 0, "trace should start with traceEvents");
+    check_if_equal(count_occurrences(trace_str, "\"name\":\"inner\""), std::size_t(6), "number of inner trace events");
+    check_if_equal(count_occurrences(trace_str, "\"name\":\"with \\\"quote\\\"\""), std::size_t(1), "escaping in trace");
+    check_if_equal(count_occurrences(trace_str, "\"name\":\"test counter\",\"cat\":\"stir\",\"ph\":\"C\""),
+                   std::size_t(1),
+                   "counter in trace");
+  }
+  {
+    std::ostringstream summary;
+    Profiler::write_summary(summary);
+    check(summary.str().find("  inner") != std::string::npos, "summary should contain indented inner region");
+    check(summary.str().find("test counter") != std::string::npos, "summary should contain counter");
+  }
+
+  Profiler::reset();
+  check(Profiler::get_region_summaries().empty(), "no regions after reset");
+  check(Profiler::get_counters().empty(), "no counters after reset");
+  Profiler::set_trace_enabled(false);
+}
+
+END_NAMESPACE_STIR
+
+USING_NAMESPACE_STIR
+
+int
+main()
+{
+  ProfilerTests tests;
+  tests.run_tests();
+  return tests.main_return_value();
+}
@@ -37,6 +37,7 @@
 #include "stir/Shape/DiscretisedShape3D.h"
 #include "stir/evaluation/ROIValues.h"
 #include "stir/evaluation/compute_ROI_values.h"
+#include "stir/evaluation/DiscretisedROIs.h"
 #include "stir/IndexRange.h"
 #include "stir/RunTests.h"
 #include "stir/is_null_ptr.h"
@@ -47,12 +48,15 @@
 #  include "stir/display.h"
 #endif
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <string>
 
 START_NAMESPACE_STIR
 
 /*!
   \ingroup test
-  \brief Test class for compute_ROI_values and Shape3D hierarchy
+  \brief Test class for compute_ROI_values, DiscretisedROIs and Shape3D hierarchy
 
   Visual tests can be enabled by setting the compiler define test_ROIs_DISPLAY.
 
@@ -80,14 +84,123 @@ private:
                            VoxelsOnCartesianGrid<float>& image,
                            const bool do_rotated_ROI_test = true,
                            const bool do_separate_translate_test = true);
+
+  //! Compare Shape3D::construct_volume with sub-sampling with a computation for every voxel
+  /*! Also checks that there are no voxels with non-zero values outside the bounding box. */
+  void run_tests_construct_volume(const Shape3D& shape, const VoxelsOnCartesianGrid<float>& template_image);
+
+  //! Compare DiscretisedROIs with compute_ROI_values_per_plane for a few shapes
+  void run_tests_DiscretisedROIs(const VoxelsOnCartesianGrid<float>& template_image);
 };
 
+void
+ROITests::run_tests_construct_volume(const Shape3D& shape, const VoxelsOnCartesianGrid<float>& template_image)
+{
+  const CartesianCoordinate3D<int> num_samples(3, 4, 2);
+  VoxelsOnCartesianGrid<float> image(template_image);
+  image.fill(1.F);
+  shape.construct_volume(image, num_samples);
+
+  const CartesianCoordinate3D<float> voxel_size = image.get_voxel_size();
+  CartesianCoordinate3D<float> min_coord, max_coord;
+  const bool has_bounding_box = shape.get_bounding_box(min_coord, max_coord) == Succeeded::yes;
+  float max_diff = 0.F;
+  bool inside_bounding_box = true;
+  for (int z = image.get_min_z(); z <= image.get_max_z(); ++z)
+    for (int y = image.get_min_y(); y <= image.get_max_y(); ++y)
+      for (int x = image.get_min_x(); x <= image.get_max_x(); ++x)
+        {
+          const CartesianCoordinate3D<float> voxel_centre
+              = CartesianCoordinate3D<float>(static_cast<float>(z), static_cast<float>(y), static_cast<float>(x)) * voxel_size
+                + image.get_origin();
+          // use the (slow) base-class implementation as reference
+          const float weight = shape.Shape3D::get_voxel_weight(voxel_centre, voxel_size, num_samples);
+          max_diff = std::max(max_diff, std::fabs(weight - image[z][y][x]));
+          if (has_bounding_box && image[z][y][x] != 0)
+            for (int d = 1; d <= 3; ++d)
+              if (voxel_centre[d] + voxel_size[d] / 2 < min_coord[d] || voxel_centre[d] - voxel_size[d] / 2 > max_coord[d])
+                inside_bounding_box = false;
+        }
+  // the incremental computation of the sample positions can differ by rounding errors, which can
+  // change the result for a sample on the edge of the shape
+  const float tolerance = 1.5F / (num_samples.z() * num_samples.y() * num_samples.x());
+  check(max_diff <= tolerance,
+        "construct_volume with sub-sampling vs. get_voxel_weight (max difference " + std::to_string(max_diff) + ")");
+  check(inside_bounding_box, "construct_volume: all non-zero voxels should be inside the bounding box");
+}
+
+void
+ROITests::run_tests_DiscretisedROIs(const VoxelsOnCartesianGrid<float>& template_image)
+{
+  std::cerr << "\tTests with DiscretisedROIs.\n";
+  const CartesianCoordinate3D<float> grid_spacing = template_image.get_grid_spacing();
+  const float centre_z = (template_image.get_min_index() + template_image.get_max_index()) / 2 * grid_spacing.z();
+  std::vector<shared_ptr<Shape3D>> shapes;
+  shapes.push_back(shared_ptr<Shape3D>(new Ellipsoid(CartesianCoordinate3D<float>(25.F, 40.F, 60.F),
+                                                     CartesianCoordinate3D<float>(centre_z, 10.F, -20.F))));
+  shapes.push_back(shared_ptr<Shape3D>(new EllipsoidalCylinder(50.F, 30.F, 45.F, CartesianCoordinate3D<float>(centre_z, -20.F, 30.F))));
+  shapes.push_back(shared_ptr<Shape3D>(new Box3D(40.F, 50.F, 30.F, CartesianCoordinate3D<float>(centre_z + 10, 30.F, 0.F))));
+  const CartesianCoordinate3D<int> num_samples(2, 2, 2);
+
+  const DiscretisedROIs ROIs(shapes, template_image, num_samples);
+  check_if_equal(ROIs.get_num_ROIs(), 3, "DiscretisedROIs: number of ROIs");
+
+  // construct an image with non-constant values
+  VoxelsOnCartesianGrid<float> image(template_image);
+  for (int z = image.get_min_z(); z <= image.get_max_z(); ++z)
+    for (int y = image.get_min_y(); y <= image.get_max_y(); ++y)
+      for (int x = image.get_min_x(); x <= image.get_max_x(); ++x)
+        image[z][y][x] = static_cast<float>(1 + z + (y * x) % 7);
+
+  std::vector<VectorWithOffset<ROIValues>> values;
+  ROIs.compute_ROI_values_per_plane(values, image);
+  std::vector<ROIValues> total_values;
+  ROIs.compute_total_ROI_values(total_values, image);
+  for (std::size_t roi_num = 0; roi_num < shapes.size(); ++roi_num)
+    {
+      VectorWithOffset<ROIValues> org_values;
+      compute_ROI_values_per_plane(org_values, image, *shapes[roi_num], num_samples);
+      for (int z = image.get_min_z(); z <= image.get_max_z(); ++z)
+        {
+          check_if_equal(values[roi_num][z].get_roi_volume(), org_values[z].get_roi_volume(), "DiscretisedROIs: volume");
+          check_if_equal(values[roi_num][z].get_mean(), org_values[z].get_mean(), "DiscretisedROIs: mean");
+          check_if_equal(values[roi_num][z].get_stddev(), org_values[z].get_stddev(), "DiscretisedROIs: stddev");
+          check_if_equal(values[roi_num][z].get_min(), org_values[z].get_min(), "DiscretisedROIs: min");
+          check_if_equal(values[roi_num][z].get_max(), org_values[z].get_max(), "DiscretisedROIs: max");
+        }
+      const ROIValues org_total_values = compute_total_ROI_values(image, *shapes[roi_num], num_samples);
+      check_if_equal(total_values[roi_num].get_mean(), org_total_values.get_mean(), "DiscretisedROIs: total mean");
+      check_if_equal(total_values[roi_num].get_stddev(), org_total_values.get_stddev(), "DiscretisedROIs: total stddev");
+    }
+
+  // construct from discretised shapes
+  {
+    std::vector<shared_ptr<const DiscretisedDensity<3, float>>> discretised_shapes;
+    for (std::size_t roi_num = 0; roi_num < shapes.size(); ++roi_num)
+      {
+        shared_ptr<VoxelsOnCartesianGrid<float>> discretised_shape_sptr(template_image.get_empty_voxels_on_cartesian_grid());
+        shapes[roi_num]->construct_volume(*discretised_shape_sptr, num_samples);
+        discretised_shapes.push_back(discretised_shape_sptr);
+      }
+    const DiscretisedROIs ROIs_from_images(discretised_shapes);
+    std::vector<ROIValues> total_values_from_images;
+    ROIs_from_images.compute_total_ROI_values(total_values_from_images, image);
+    for (std::size_t roi_num = 0; roi_num < shapes.size(); ++roi_num)
+      check_if_equal(total_values_from_images[roi_num].get_mean(),
+                     total_values[roi_num].get_mean(),
+                     "DiscretisedROIs: total mean when using discretised shapes");
+  }
+}
+
 void
 ROITests::run_tests_one_shape(Shape3D& shape,
                               VoxelsOnCartesianGrid<float>& image,
                               const bool do_rotated_ROI_test,
                               const bool do_separate_translate_test)
 {
+  if (dynamic_cast<DiscretisedShape3D const*>(&shape) == 0)
+    this->run_tests_construct_volume(shape, image);
+
   shape.construct_volume(image, Coordinate3D<int>(1, 1, 1));
 
   if (dynamic_cast<DiscretisedShape3D const*>(&shape) != 0)
@@ -217,6 +330,7 @@ ROITests::run_tests_one_shape(Shape3D& shape,
       const float total_scale = 1 / determinant(direction_vectors);
       shared_ptr<Shape3DWithOrientation> new_shape_sptr(dynamic_cast<Shape3DWithOrientation*>(shape.clone()));
       check(new_shape_sptr->set_direction_vectors(direction_vectors) == Succeeded::yes, "set_direction_vectors");
+      this->run_tests_construct_volume(*new_shape_sptr, image);
       // std::cerr << new_shape_sptr->parameter_info();
 
       const ROIValues ROI_values = compute_total_ROI_values(image, *new_shape_sptr, Coordinate3D<int>(1, 1, 1));
@@ -373,6 +487,8 @@ ROITests::run_tests()
       this->run_tests_one_shape(discretised_shape, image, false, false);
     }
   }
+  image.set_origin(origin);
+  this->run_tests_DiscretisedROIs(image);
 }
 
 END_NAMESPACE_STIR
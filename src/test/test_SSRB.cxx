@@ -0,0 +1,130 @@
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+/*!
+  \file
+  \ingroup test
+  \ingroup projdata
+
+  \brief Test program for stir::SSRB
+*/
+
+#include "stir/SSRB.h"
+#include "stir/ProjDataInMemory.h"
+#include "stir/ProjDataInfo.h"
+#include "stir/ExamInfo.h"
+#include "stir/Scanner.h"
+#include "stir/SegmentBySinogram.h"
+#include "stir/RunTests.h"
+#include <boost/random/uniform_01.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <iostream>
+
+START_NAMESPACE_STIR
+
+/*!
+  \ingroup test
+  \brief Test class for SSRB
+
+  Checks that without normalisation all counts end up in the output, and that with
+  normalisation uniform input data results in uniform output data, for non-TOF and TOF data
+  (with view mashing and TOF mashing).
+*/
+class SSRBTests : public RunTests
+{
+public:
+  void run_tests() override;
+
+private:
+  void run_tests_for_proj_data_info(const shared_ptr<const ProjDataInfo>& in_proj_data_info_sptr,
+                                    const int num_segments_to_combine,
+                                    const int num_views_to_combine,
+                                    const int num_tof_bins_to_combine);
+};
+
+void
+SSRBTests::run_tests_for_proj_data_info(const shared_ptr<const ProjDataInfo>& in_proj_data_info_sptr,
+                                        const int num_segments_to_combine,
+                                        const int num_views_to_combine,
+                                        const int num_tof_bins_to_combine)
+{
+  shared_ptr<ExamInfo> exam_info_sptr(new ExamInfo(ImagingModality::PT));
+  shared_ptr<const ProjDataInfo> out_proj_data_info_sptr(SSRB(*in_proj_data_info_sptr,
+                                                              num_segments_to_combine,
+                                                              num_views_to_combine,
+                                                              /*num_tang_poss_to_trim*/ 0,
+                                                              /*max_in_segment_num_to_process*/ -1,
+                                                              num_tof_bins_to_combine));
+  ProjDataInMemory in_proj_data(exam_info_sptr, in_proj_data_info_sptr);
+  ProjDataInMemory out_proj_data(exam_info_sptr, out_proj_data_info_sptr);
+
+  {
+    // fill with random numbers between 0 and 1, using a reproducible seed
+    boost::mt19937 generator(boost::uint32_t(42));
+    boost::uniform_01<boost::mt19937> random01(generator);
+    for (ProjDataInMemory::iterator iter = in_proj_data.begin(); iter != in_proj_data.end(); ++iter)
+      *iter = static_cast<float>(random01());
+
+    SSRB(out_proj_data, in_proj_data, /*do_normalisation*/ false);
+    set_tolerance(1E-4);
+    check_if_equal(out_proj_data.sum() / in_proj_data.sum(), 1., "SSRB without normalisation should preserve counts");
+  }
+  {
+    in_proj_data.fill(1.F);
+    SSRB(out_proj_data, in_proj_data, /*do_normalisation*/ true);
+    // we do not normalise for the number of TOF bins
+    check_if_equal(out_proj_data.find_min(), static_cast<float>(num_tof_bins_to_combine), "SSRB with normalisation (min)");
+    check_if_equal(out_proj_data.find_max(), static_cast<float>(num_tof_bins_to_combine), "SSRB with normalisation (max)");
+  }
+}
+
+void
+SSRBTests::run_tests()
+{
+  std::cerr << "\n--------------------------------non-TOF tests\n";
+  {
+    shared_ptr<Scanner> scanner_sptr(new Scanner(Scanner::E953));
+    scanner_sptr->set_num_rings(5);
+    shared_ptr<const ProjDataInfo> proj_data_info_sptr(ProjDataInfo::ProjDataInfoCTI(scanner_sptr,
+                                                                                     /*span*/ 1,
+                                                                                     /*max_delta*/ 4,
+                                                                                     /*views*/ 32,
+                                                                                     /*tang_pos*/ 64,
+                                                                                     /*arc_corrected*/ true));
+    run_tests_for_proj_data_info(proj_data_info_sptr, 3, 1, 1);
+    run_tests_for_proj_data_info(proj_data_info_sptr, 9, 4, 1);
+  }
+
+  std::cerr << "\n--------------------------------TOF tests\n";
+  {
+    shared_ptr<Scanner> scanner_sptr(new Scanner(Scanner::Discovery690));
+    scanner_sptr->set_num_rings(4);
+    shared_ptr<const ProjDataInfo> proj_data_info_sptr(
+        ProjDataInfo::construct_proj_data_info(scanner_sptr,
+                                               /*span*/ 1,
+                                               /*max_delta*/ 3,
+                                               /*views*/ scanner_sptr->get_num_detectors_per_ring() / 8,
+                                               /*tang_pos*/ 22,
+                                               /*arc_corrected*/ false,
+                                               /* Tof_mashing */ 11));
+    run_tests_for_proj_data_info(proj_data_info_sptr, 7, 2, 1);
+    run_tests_for_proj_data_info(proj_data_info_sptr, 7, 1, proj_data_info_sptr->get_num_tof_poss());
+  }
+}
+
+END_NAMESPACE_STIR
+
+USING_NAMESPACE_STIR
+
+int
+main()
+{
+  SSRBTests tests;
+  tests.run_tests();
+  return tests.main_return_value();
+}
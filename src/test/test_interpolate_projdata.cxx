@@ -314,6 +314,18 @@ InterpolationTests::scatter_interpolation_test_blocks()
   // interpolate the downsampled proj data to the original scanner size and fill in oblique sinograms
   auto interpolated_direct_proj_data = ProjDataInMemory(proj_data);
   interpolate_projdata(interpolated_direct_proj_data, downsampled_model_sino, BSpline::linear, false);
+  {
+    // check that reusing the interpolation weights gives the same result
+    InterpolateProjDataCache cache;
+    auto interpolated_with_cache = ProjDataInMemory(proj_data);
+    for (int i = 0; i < 2; ++i)
+      {
+        interpolate_projdata(interpolated_with_cache, downsampled_model_sino, BSpline::linear, false, &cache);
+        check_if_equal(interpolated_direct_proj_data.get_segment_by_sinogram(0),
+                       interpolated_with_cache.get_segment_by_sinogram(0),
+                       "interpolate_projdata with cached weights");
+      }
+  }
   auto interpolated_proj_data = ProjDataInMemory(proj_data);
   inverse_SSRB(interpolated_proj_data, interpolated_direct_proj_data);
 
@@ -22,6 +22,10 @@
 
 #include "stir/ProjDataInMemory.h"
 #include "stir/ProjDataInterfile.h"
+#ifdef HAVE_HDF5
+#  include "stir/ProjDataHDF5.h"
+#  include "stir/SegmentByView.h"
+#endif
 #include "stir/ExamInfo.h"
 #include "stir/ProjDataInfo.h"
 #include "stir/ProjDataInfoCylindricalArcCorr.h"
@@ -471,6 +475,29 @@ ProjDataTests::run_tests()
     ProjDataInterfile proj_data_interfile(
         exam_info_sptr, proj_data_info_sptr, "test_proj_data.hs", std::ios::in | std::ios::out | std::ios::trunc);
     run_tests_on_proj_data(proj_data_interfile);
+
+#ifdef HAVE_HDF5
+    std::cerr << "\n-----------------Repeating tests but now with HDF5 input\n";
+    {
+      ProjDataHDF5 proj_data_hdf5(exam_info_sptr, proj_data_info_sptr, "test_proj_data.h5");
+      run_tests_on_proj_data(proj_data_hdf5);
+    }
+
+    std::cerr << "\ntest write_to_file and read_from_file with HDF5\n";
+    {
+      std::iota(proj_data_in_memory.begin(), proj_data_in_memory.end(), 0.F);
+      check(proj_data_in_memory.write_to_file("test_proj_data_write.h5") == Succeeded::yes, "test write_to_file for HDF5");
+      shared_ptr<ProjData> proj_data_sptr = ProjData::read_from_file("test_proj_data_write.h5");
+      check(dynamic_cast<ProjDataHDF5*>(proj_data_sptr.get()) != 0, "test read_from_file returns ProjDataHDF5");
+      check(*proj_data_sptr->get_proj_data_info_sptr() == *proj_data_info_sptr, "test read_from_file for HDF5: ProjDataInfo");
+      for (int timing_pos_num = proj_data_sptr->get_min_tof_pos_num(); timing_pos_num <= proj_data_sptr->get_max_tof_pos_num();
+           ++timing_pos_num)
+        for (int seg = proj_data_sptr->get_min_segment_num(); seg <= proj_data_sptr->get_max_segment_num(); ++seg)
+          check_if_equal(proj_data_sptr->get_segment_by_view(seg, timing_pos_num),
+                         proj_data_in_memory.get_segment_by_view(seg, timing_pos_num),
+                         "test read_from_file for HDF5: data");
+    }
+#endif
   }
 }
 END_NAMESPACE_STIR
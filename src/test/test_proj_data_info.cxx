@@ -38,6 +38,7 @@
 #include "stir/Bin.h"
 #include "stir/LORCoordinates.h"
 #include "stir/round.h"
+#include "stir/stream.h"
 #include "stir/num_threads.h"
 #include <iostream>
 #include <iomanip>
@@ -107,6 +108,7 @@ protected:
   void run_coordinate_test_for_realistic_scanner();
   void run_Blocks_DOI_test();
   void run_lor_get_s_test();
+  void run_LOR_geometry_cache_test();
 };
 
 /*! The following is a function to allow a projdata_info blocksONCylindrical to be created from the scanner.
@@ -584,6 +586,77 @@ ProjDataInfoTests::run_Blocks_DOI_test()
   std::cerr << "-- CPU Time " << timer.value() << '\n';
 }
 
+/*!
+  The following tests that the precomputed LOR geometry of a Generic ProjDataInfo gives
+  the same results as computing it on the fly.
+*/
+void
+ProjDataInfoTests::run_LOR_geometry_cache_test()
+{
+  auto scannerBlocks_ptr = std::make_shared<Scanner>(Scanner::SAFIRDualRingPrototype);
+  scannerBlocks_ptr->set_scanner_geometry("BlocksOnCylindrical");
+  scannerBlocks_ptr->set_up();
+
+  auto proj_data_info_sptr = set_blocks_projdata_info<ProjDataInfoBlocksOnCylindricalNoArcCorr>(scannerBlocks_ptr);
+  shared_ptr<ProjDataInfoBlocksOnCylindricalNoArcCorr> cached_proj_data_info_sptr(
+      dynamic_cast<ProjDataInfoBlocksOnCylindricalNoArcCorr*>(proj_data_info_sptr->clone()));
+  check(!cached_proj_data_info_sptr->has_LOR_geometry_cache(), "LOR geometry cache should not be present by default");
+  // note: set-up works on a const object, such that it can be used with shared_ptr<const ProjDataInfo>
+  static_cast<const ProjDataInfoGeneric&>(*cached_proj_data_info_sptr).set_up_LOR_geometry_cache();
+  check(cached_proj_data_info_sptr->has_LOR_geometry_cache(), "LOR geometry cache should be present after set-up");
+  shared_ptr<ProjDataInfo> cloned_proj_data_info_sptr(cached_proj_data_info_sptr->clone());
+
+  set_tolerance(10E-4);
+  Bin bin;
+  LORInAxialAndNoArcCorrSinogramCoordinates<float> lor, cached_lor, cloned_lor;
+  for (bin.segment_num() = proj_data_info_sptr->get_min_segment_num();
+       bin.segment_num() <= proj_data_info_sptr->get_max_segment_num();
+       ++bin.segment_num())
+    for (bin.axial_pos_num() = proj_data_info_sptr->get_min_axial_pos_num(bin.segment_num());
+         bin.axial_pos_num() <= proj_data_info_sptr->get_max_axial_pos_num(bin.segment_num());
+         ++bin.axial_pos_num())
+      for (bin.view_num() = proj_data_info_sptr->get_min_view_num(); bin.view_num() <= proj_data_info_sptr->get_max_view_num();
+           ++bin.view_num())
+        for (bin.tangential_pos_num() = proj_data_info_sptr->get_min_tangential_pos_num();
+             bin.tangential_pos_num() <= proj_data_info_sptr->get_max_tangential_pos_num();
+             ++bin.tangential_pos_num())
+          {
+            proj_data_info_sptr->get_LOR(lor, bin);
+            cached_proj_data_info_sptr->get_LOR(cached_lor, bin);
+            cloned_proj_data_info_sptr->get_LOR(cloned_lor, bin);
+            if (!check_if_equal(lor.z1(), cached_lor.z1(), "LOR geometry cache: z1")
+                || !check_if_equal(lor.z2(), cached_lor.z2(), "LOR geometry cache: z2")
+                || !check_if_equal(lor.phi(), cached_lor.phi(), "LOR geometry cache: phi")
+                || !check_if_equal(lor.beta(), cached_lor.beta(), "LOR geometry cache: beta")
+                || !check_if_equal(lor.is_swapped(), cached_lor.is_swapped(), "LOR geometry cache: swapped")
+                || !check_if_equal(lor.s(), cloned_lor.s(), "LOR geometry cache: s of clone")
+                || !check_if_equal(proj_data_info_sptr->get_s(bin), cached_proj_data_info_sptr->get_s(bin), "get_s")
+                || !check_if_equal(proj_data_info_sptr->get_m(bin), cached_proj_data_info_sptr->get_m(bin), "get_m")
+                || !check_if_equal(proj_data_info_sptr->get_phi(bin), cached_proj_data_info_sptr->get_phi(bin), "get_phi")
+                || !check_if_equal(
+                    proj_data_info_sptr->get_tantheta(bin), cached_proj_data_info_sptr->get_tantheta(bin), "get_tantheta"))
+              {
+                std::cerr << "Problem at " << bin << '\n';
+                return;
+              }
+          }
+
+  {
+    // bins outside the range of the projection data are not in the cache, but should still work
+    const Bin out_of_range_bin(0, 0, 0, proj_data_info_sptr->get_max_tangential_pos_num() + 1);
+    proj_data_info_sptr->get_LOR(lor, out_of_range_bin);
+    cached_proj_data_info_sptr->get_LOR(cached_lor, out_of_range_bin);
+    check_if_equal(lor.z1(), cached_lor.z1(), "LOR geometry cache: z1 for bin outside the range");
+    check_if_equal(lor.phi(), cached_lor.phi(), "LOR geometry cache: phi for bin outside the range");
+    check_if_equal(proj_data_info_sptr->get_m(out_of_range_bin),
+                   cached_proj_data_info_sptr->get_m(out_of_range_bin),
+                   "get_m for bin outside the range");
+  }
+
+  cached_proj_data_info_sptr->reduce_segment_range(0, 0);
+  check(!cached_proj_data_info_sptr->has_LOR_geometry_cache(), "LOR geometry cache should be cleared by reduce_segment_range");
+}
+
 /*!
   The following tests the consistency of coordinates obtained with a cilindrical scanner
   and those of a blocks on cylindrical scanner. For this test, a scanner with 4 rings, 2
@@ -1025,6 +1098,8 @@ ProjDataInfoCylindricalArcCorrTests::run_tests()
 
   std::cerr << "-------- Testing DOI for blocks --------\n";
   run_Blocks_DOI_test();
+  std::cerr << "-------- Testing LOR geometry cache for blocks --------\n";
+  run_LOR_geometry_cache_test();
   std::cerr << "-------- Testing coordinates --------\n";
   run_lor_get_s_test();
   run_coordinate_test();
@@ -1240,6 +1315,30 @@ ProjDataInfoCylindricalNoArcCorrTests::run_tests()
                                                               /*arc_corrected*/ false,
                                                               /*tof_mashing*/ 5);
   test_proj_data_info(dynamic_cast<ProjDataInfoCylindricalNoArcCorr&>(*proj_data_info_ptr));
+
+  cerr << "\nTests with a tangential range that is larger than supported by the detector-pair look-up tables\n\n";
+  {
+    const auto wide_proj_data_info_sptr
+        = std::dynamic_pointer_cast<ProjDataInfoCylindricalNoArcCorr>(proj_data_info_ptr->create_non_tof_clone());
+    const int num_detectors = wide_proj_data_info_sptr->get_scanner_ptr()->get_num_detectors_per_ring();
+    wide_proj_data_info_sptr->set_max_tangential_pos_num(num_detectors / 2 + 1);
+    const Bin bin(0, 0, 0, 0);
+    std::vector<DetectionPositionPair<>> dps;
+    bool exception_thrown = false;
+    try
+      {
+        wide_proj_data_info_sptr->get_all_det_pos_pairs_for_bin(dps, bin);
+      }
+    catch (...)
+      {
+        exception_thrown = true;
+      }
+    check(exception_thrown, "get_all_det_pos_pairs_for_bin should call error() when the tangential range is too large");
+    // going back to a supported range has to make the look-up work again
+    wide_proj_data_info_sptr->set_max_tangential_pos_num(num_detectors / 2);
+    wide_proj_data_info_sptr->get_all_det_pos_pairs_for_bin(dps, bin);
+    check(!dps.empty(), "get_all_det_pos_pairs_for_bin after restoring the tangential range");
+  }
 }
 
 void
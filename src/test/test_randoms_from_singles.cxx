@@ -0,0 +1,200 @@
+/*!
+
+  \file
+  \ingroup test
+
+  \brief Test program for stir::randoms_from_singles and stir::multiply_crystal_factors
+*/
+/*
+    Copyright (C) 2026, University College London
+    This file is part of STIR.
+
+    SPDX-License-Identifier: Apache-2.0
+
+    See STIR/LICENSE.txt for details
+*/
+
+#include "stir/data/randoms_from_singles.h"
+#include "stir/data/SinglesRates.h"
+#include "stir/multiply_crystal_factors.h"
+#include "stir/ProjDataInfo.h"
+#include "stir/ProjDataInMemory.h"
+#include "stir/ExamInfo.h"
+#include "stir/TimeFrameDefinitions.h"
+#include "stir/Scanner.h"
+#include "stir/Sinogram.h"
+#include "stir/IndexRange2D.h"
+#include "stir/RunTests.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+START_NAMESPACE_STIR
+
+//! Singles that are constant in time, but different for every singles unit
+class TestSinglesRates : public SinglesRates
+{
+public:
+  explicit TestSinglesRates(const shared_ptr<Scanner>& scanner_sptr_v) { this->scanner_sptr = scanner_sptr_v; }
+
+  std::string get_registered_name() const override { return "TestSinglesRates"; }
+
+  float get_singles(const int singles_bin_index, const double start_time, const double end_time) const override
+  {
+    return static_cast<float>((1000. + 10. * (singles_bin_index % 17)) * (end_time - start_time));
+  }
+};
+
+/*!
+  \ingroup test
+  \brief Test class for randoms_from_singles() and multiply_crystal_factors()
+
+  Checks that the versions for several time frames give the same result as calling
+  the single-frame version for every frame, and that TOF data are consistent with non-TOF data.
+*/
+class RandomsFromSinglesTests : public RunTests
+{
+public:
+  void run_tests() override;
+
+protected:
+  void test_multiple_frames(const shared_ptr<const ProjDataInfo>& proj_data_info_sptr);
+  void test_tof_consistency(const shared_ptr<const ProjDataInfo>& tof_proj_data_info_sptr);
+
+  static shared_ptr<ExamInfo> create_exam_info_for_frame(const double start_time, const double end_time);
+
+  static const float coincidence_time_window;
+  static const float halflife;
+};
+
+const float RandomsFromSinglesTests::coincidence_time_window = 4.E-9F;
+const float RandomsFromSinglesTests::halflife = 6586.F;
+
+shared_ptr<ExamInfo>
+RandomsFromSinglesTests::create_exam_info_for_frame(const double start_time, const double end_time)
+{
+  auto exam_info_sptr = std::make_shared<ExamInfo>(ImagingModality::PT);
+  std::vector<std::pair<double, double>> frame_times(1, std::make_pair(start_time, end_time));
+  exam_info_sptr->set_time_frame_definitions(TimeFrameDefinitions(frame_times));
+  return exam_info_sptr;
+}
+
+void
+RandomsFromSinglesTests::test_multiple_frames(const shared_ptr<const ProjDataInfo>& proj_data_info_sptr)
+{
+  const shared_ptr<Scanner> scanner_sptr(new Scanner(*proj_data_info_sptr->get_scanner_ptr()));
+  const TestSinglesRates singles(scanner_sptr);
+
+  const std::vector<std::pair<double, double>> frames{ { 0., 60. }, { 60., 180. }, { 200., 500. } };
+
+  std::vector<shared_ptr<ProjData>> proj_datas;
+  for (const auto& frame : frames)
+    proj_datas.push_back(std::make_shared<ProjDataInMemory>(create_exam_info_for_frame(frame.first, frame.second),
+                                                            proj_data_info_sptr));
+  randoms_from_singles(proj_datas, singles, coincidence_time_window, halflife);
+
+  for (std::size_t frame_num = 0; frame_num < frames.size(); ++frame_num)
+    {
+      ProjDataInMemory single_frame_randoms(create_exam_info_for_frame(frames[frame_num].first, frames[frame_num].second),
+                                            proj_data_info_sptr);
+      randoms_from_singles(single_frame_randoms, singles, coincidence_time_window, halflife);
+      check(single_frame_randoms.find_max() > 0.F, "randoms_from_singles should give non-zero randoms");
+      check_if_equal(dynamic_cast<const ProjDataInMemory&>(*proj_datas[frame_num]),
+                     single_frame_randoms,
+                     "randoms_from_singles for several frames should be equal to single-frame version");
+    }
+}
+
+void
+RandomsFromSinglesTests::test_tof_consistency(const shared_ptr<const ProjDataInfo>& tof_proj_data_info_sptr)
+{
+  const shared_ptr<const ProjDataInfo> non_tof_proj_data_info_sptr(tof_proj_data_info_sptr->create_non_tof_clone());
+  const auto exam_info_sptr = create_exam_info_for_frame(0., 100.);
+  Array<2, float> crystal_factors(IndexRange2D(tof_proj_data_info_sptr->get_scanner_ptr()->get_num_rings(),
+                                               tof_proj_data_info_sptr->get_scanner_ptr()->get_num_detectors_per_ring()));
+  {
+    int c = 0;
+    for (auto iter = crystal_factors.begin_all(); iter != crystal_factors.end_all(); ++iter, ++c)
+      *iter = 1.F + (c % 13) * .1F;
+  }
+  ProjDataInMemory tof_proj_data(exam_info_sptr, tof_proj_data_info_sptr);
+  ProjDataInMemory non_tof_proj_data(exam_info_sptr, non_tof_proj_data_info_sptr);
+  multiply_crystal_factors(tof_proj_data, crystal_factors, 2.F);
+  multiply_crystal_factors(non_tof_proj_data, crystal_factors, 2.F);
+
+  // sum over all TOF bins should be equal to the non-TOF data for every sinogram (in every segment)
+  for (int segment_num = tof_proj_data.get_min_segment_num(); segment_num <= tof_proj_data.get_max_segment_num(); ++segment_num)
+    for (int axial_pos_num = tof_proj_data.get_min_axial_pos_num(segment_num);
+         axial_pos_num <= tof_proj_data.get_max_axial_pos_num(segment_num);
+         ++axial_pos_num)
+      {
+        Sinogram<float> sum_over_tof = non_tof_proj_data.get_sinogram(axial_pos_num, segment_num);
+        sum_over_tof.fill(0.F);
+        for (int timing_pos_num = tof_proj_data.get_min_tof_pos_num(); timing_pos_num <= tof_proj_data.get_max_tof_pos_num();
+             ++timing_pos_num)
+          sum_over_tof += tof_proj_data.get_sinogram(axial_pos_num, segment_num, false, timing_pos_num);
+        if (!check_if_equal(sum_over_tof,
+                            non_tof_proj_data.get_sinogram(axial_pos_num, segment_num),
+                            "multiply_crystal_factors: sum over TOF bins should be equal to non-TOF"))
+          {
+            std::cerr << "segment " << segment_num << ", axial position " << axial_pos_num << '\n';
+            return;
+          }
+      }
+
+  // same for the version for several outputs
+  std::vector<shared_ptr<ProjData>> proj_datas{ std::make_shared<ProjDataInMemory>(exam_info_sptr, tof_proj_data_info_sptr),
+                                                std::make_shared<ProjDataInMemory>(exam_info_sptr, tof_proj_data_info_sptr) };
+  multiply_crystal_factors(proj_datas, std::vector<Array<2, float>>{ crystal_factors, crystal_factors }, { 2.F, 4.F });
+  check_if_equal(dynamic_cast<const ProjDataInMemory&>(*proj_datas[0]),
+                 tof_proj_data,
+                 "multiply_crystal_factors for several outputs should be equal to single-output version");
+  tof_proj_data *= 2.F;
+  check_if_equal(dynamic_cast<const ProjDataInMemory&>(*proj_datas[1]),
+                 tof_proj_data,
+                 "multiply_crystal_factors for several outputs should use the global factor of each output");
+}
+
+void
+RandomsFromSinglesTests::run_tests()
+{
+  {
+    std::cerr << "\n-------- Testing ECAT 953 (non-TOF) --------\n";
+    shared_ptr<Scanner> scanner_sptr(new Scanner(Scanner::E953));
+    shared_ptr<const ProjDataInfo> proj_data_info_sptr(
+        ProjDataInfo::construct_proj_data_info(scanner_sptr,
+                                               /*span*/ 1,
+                                               /*max_delta*/ 2,
+                                               /*views*/ scanner_sptr->get_num_detectors_per_ring() / 2,
+                                               /*tang_pos*/ 32,
+                                               /*arc_corrected*/ false));
+    test_multiple_frames(proj_data_info_sptr);
+  }
+  {
+    std::cerr << "\n-------- Testing GE Signa PET/MR (TOF) --------\n";
+    shared_ptr<Scanner> scanner_sptr(new Scanner(Scanner::PETMR_Signa));
+    shared_ptr<const ProjDataInfo> proj_data_info_sptr(
+        ProjDataInfo::construct_proj_data_info(scanner_sptr,
+                                               /*span*/ 1,
+                                               /*max_delta*/ 1,
+                                               /*views*/ scanner_sptr->get_num_detectors_per_ring() / 2,
+                                               /*tang_pos*/ 16,
+                                               /*arc_corrected*/ false,
+                                               /*tof_mash_factor*/ 39));
+    test_multiple_frames(proj_data_info_sptr);
+    test_tof_consistency(proj_data_info_sptr);
+  }
+}
+
+END_NAMESPACE_STIR
+
+USING_NAMESPACE_STIR
+
+int
+main()
+{
+  RandomsFromSinglesTests tests;
+  tests.run_tests();
+  return tests.main_return_value();
+}
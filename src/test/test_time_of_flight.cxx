@@ -30,6 +30,10 @@
 #include "stir/recon_buildblock/ProjMatrixElemsForOneBin.h"
 #include "stir/ViewSegmentNumbers.h"
 #include "stir/RelatedViewgrams.h"
+#include "stir/ProjDataInMemory.h"
+#include "stir/ExamInfo.h"
+#include "stir/SegmentByView.h"
+#include "stir/DataSymmetriesForViewSegmentNumbers.h"
 //#include "stir/geometry/line_distances.h"
 #include "stir/Succeeded.h"
 #include "stir/shared_ptr.h"
@@ -42,6 +46,8 @@
 #include "stir/info.h"
 #include "stir/warning.h"
 #include <cmath>
+#include <string>
+#include <vector>
 
 START_NAMESPACE_STIR
 
@@ -92,6 +98,14 @@ private:
   //! of the TOF bins is equal to the non-TOF LOR.
   void test_tof_kernel_application(bool export_to_file);
 
+  //! Checks that ProjMatrixByBin::get_proj_matrix_elems_for_one_bin_for_all_timing_positions()
+  //! gives the same result as getting the row for every timing position.
+  void test_tof_kernels_for_all_timing_positions();
+
+  //! Checks that the (LOR-major) TOF projection of ProjData gives the same result
+  //! as projecting every TOF bin separately.
+  void test_projectors_for_all_timing_positions();
+
   //! Exports the nonTOF LOR to a file indicated by the current_id value
   //! in the filename.
   void export_lor(ProjMatrixElemsForOneBin& probabilities,
@@ -164,6 +178,8 @@ TOF_Tests::run_tests()
 
   // Switch to true in order to export the LORs at files in the current directory
   test_tof_kernel_application(false);
+  test_tof_kernels_for_all_timing_positions();
+  test_projectors_for_all_timing_positions();
 }
 
 void
@@ -460,6 +476,123 @@ TOF_Tests::test_tof_kernel_application(bool print_to_file)
   std::cerr << std::endl;
 }
 
+void
+TOF_Tests::test_tof_kernels_for_all_timing_positions()
+{
+  const int min_tof_pos_num = test_proj_data_info_sptr->get_min_tof_pos_num();
+  const int num_tof_bins = test_proj_data_info_sptr->get_num_tof_poss();
+  // a few bins, including ones related to a basic bin by symmetries
+  std::vector<Bin> bins;
+  bins.push_back(Bin(0, 0, 0, 0));
+  bins.push_back(Bin(1, 7, 3, 20));
+  bins.push_back(Bin(-2, test_proj_data_info_sptr->get_max_view_num() - 3, 10, -31));
+
+  ProjMatrixElemsForOneBin geometric_row;
+  std::vector<float> tof_kernels;
+  for (std::vector<Bin>::const_iterator bin_iter = bins.begin(); bin_iter != bins.end(); ++bin_iter)
+    {
+      test_proj_matrix_sptr->get_proj_matrix_elems_for_one_bin_for_all_timing_positions(geometric_row, tof_kernels, *bin_iter);
+      check_if_equal(tof_kernels.size(), geometric_row.size() * num_tof_bins, "size of TOF kernels for all timing positions");
+      for (int timing_pos_num = min_tof_pos_num; timing_pos_num <= test_proj_data_info_sptr->get_max_tof_pos_num();
+           ++timing_pos_num)
+        {
+          Bin bin = *bin_iter;
+          bin.timing_pos_num() = timing_pos_num;
+          ProjMatrixElemsForOneBin row;
+          test_proj_matrix_sptr->get_proj_matrix_elems_for_one_bin(row, bin);
+          if (!check_if_equal(row.size(), geometric_row.size(), "number of elements for TOF bin"))
+            return;
+          ProjMatrixElemsForOneBin::const_iterator element_ptr = row.begin();
+          ProjMatrixElemsForOneBin::const_iterator geometric_element_ptr = geometric_row.begin();
+          std::size_t i = 0;
+          bool all_equal = true;
+          for (; element_ptr != row.end(); ++element_ptr, ++geometric_element_ptr, ++i)
+            {
+              const float value
+                  = geometric_element_ptr->get_value() * tof_kernels[i * num_tof_bins + (timing_pos_num - min_tof_pos_num)];
+              all_equal = all_equal && element_ptr->get_coords() == geometric_element_ptr->get_coords()
+                          && std::fabs(element_ptr->get_value() - value) <= 1.E-4F * geometric_element_ptr->get_value();
+            }
+          check(all_equal,
+                "TOF row for all timing positions should be the same as for individual ones (timing position "
+                    + std::to_string(timing_pos_num) + ")");
+        }
+    }
+}
+
+void
+TOF_Tests::test_projectors_for_all_timing_positions()
+{
+  // use a smaller scanner to keep execution time down
+  shared_ptr<Scanner> scanner_sptr(new Scanner(*test_scanner_sptr));
+  scanner_sptr->set_num_rings(3);
+  shared_ptr<ProjDataInfo> proj_data_info_sptr(ProjDataInfo::ProjDataInfoCTI(scanner_sptr,
+                                                                           1,
+                                                                           1,
+                                                                           scanner_sptr->get_num_detectors_per_ring() / 16,
+                                                                           101,
+                                                                           /* arc_correction*/ false));
+  proj_data_info_sptr->set_tof_mash_factor(39);
+  shared_ptr<ExamInfo> exam_info_sptr(new ExamInfo(ImagingModality::PT));
+  shared_ptr<VoxelsOnCartesianGrid<float>> image_sptr(new VoxelsOnCartesianGrid<float>(exam_info_sptr, *proj_data_info_sptr));
+  // a non-uniform image
+  for (int z = image_sptr->get_min_z(); z <= image_sptr->get_max_z(); ++z)
+    for (int y = image_sptr->get_min_y(); y <= image_sptr->get_max_y(); ++y)
+      for (int x = image_sptr->get_min_x(); x <= image_sptr->get_max_x(); ++x)
+        (*image_sptr)[z][y][x] = 1.F + .1F * ((x * 3 + y * 5 + z * 7) % 11);
+
+  shared_ptr<ProjMatrixByBinUsingRayTracing> proj_matrix_sptr(new ProjMatrixByBinUsingRayTracing());
+  ForwardProjectorByBinUsingProjMatrixByBin forward_projector(proj_matrix_sptr);
+  BackProjectorByBinUsingProjMatrixByBin back_projector(proj_matrix_sptr);
+  forward_projector.set_up(proj_data_info_sptr, image_sptr);
+  back_projector.set_up(proj_data_info_sptr, image_sptr);
+  shared_ptr<DataSymmetriesForViewSegmentNumbers> symmetries_sptr(forward_projector.get_symmetries_used()->clone());
+
+  // forward projection of all TOF bins together
+  ProjDataInMemory proj_data(exam_info_sptr, proj_data_info_sptr);
+  forward_projector.forward_project(proj_data, *image_sptr);
+  // forward projection of every TOF bin separately
+  ProjDataInMemory ref_proj_data(exam_info_sptr, proj_data_info_sptr);
+  for (int seg_num = proj_data.get_min_segment_num(); seg_num <= proj_data.get_max_segment_num(); ++seg_num)
+    for (int view_num = proj_data.get_min_view_num(); view_num <= proj_data.get_max_view_num(); ++view_num)
+      {
+        const ViewSegmentNumbers vs(view_num, seg_num);
+        if (!symmetries_sptr->is_basic(vs))
+          continue;
+        for (int k = proj_data.get_min_tof_pos_num(); k <= proj_data.get_max_tof_pos_num(); ++k)
+          {
+            RelatedViewgrams<float> viewgrams = ref_proj_data.get_empty_related_viewgrams(vs, symmetries_sptr, false, k);
+            forward_projector.forward_project(viewgrams);
+            ref_proj_data.set_related_viewgrams(viewgrams);
+          }
+      }
+  set_tolerance(ref_proj_data.find_max() * 1.E-4);
+  for (int seg_num = proj_data.get_min_segment_num(); seg_num <= proj_data.get_max_segment_num(); ++seg_num)
+    for (int k = proj_data.get_min_tof_pos_num(); k <= proj_data.get_max_tof_pos_num(); ++k)
+      check_if_equal(ref_proj_data.get_segment_by_view(seg_num, k),
+                     proj_data.get_segment_by_view(seg_num, k),
+                     "forward projection of all TOF bins together");
+
+  // back projection of all TOF bins together
+  VoxelsOnCartesianGrid<float> back_image(*image_sptr->get_empty_copy());
+  back_projector.back_project(back_image, proj_data);
+  // back projection of every TOF bin separately
+  VoxelsOnCartesianGrid<float> ref_back_image(*image_sptr->get_empty_copy());
+  back_projector.start_accumulating_in_new_target();
+  for (int seg_num = proj_data.get_min_segment_num(); seg_num <= proj_data.get_max_segment_num(); ++seg_num)
+    for (int view_num = proj_data.get_min_view_num(); view_num <= proj_data.get_max_view_num(); ++view_num)
+      {
+        const ViewSegmentNumbers vs(view_num, seg_num);
+        if (!symmetries_sptr->is_basic(vs))
+          continue;
+        for (int k = proj_data.get_min_tof_pos_num(); k <= proj_data.get_max_tof_pos_num(); ++k)
+          back_projector.back_project(proj_data.get_related_viewgrams(vs, symmetries_sptr, false, k));
+      }
+  back_projector.get_output(ref_back_image);
+  set_tolerance(ref_back_image.find_max() * 1.E-4);
+  check_if_equal(ref_back_image, back_image, "back projection of all TOF bins together");
+}
+
 void
 TOF_Tests::export_lor(ProjMatrixElemsForOneBin& probabilities,
                       const CartesianCoordinate3D<float>& point1,
@@ -91,6 +91,13 @@ warp_imageTests::run_tests()
     check_if_equal(new_image[indices], 0.F, "testing warped image at original location");
     check_if_equal(new_image[new_indices], 1.F, "testing warped image at new location");
   }
+  {
+    VoxelsOnCartesianGrid<float> accumulated(image);
+    warp_and_accumulate_image(accumulated, image, motion_x, motion_y, motion_z, BSpline::BSplineType(1));
+    accumulated -= image;
+    accumulated -= new_image;
+    check_if_zero(accumulated, "testing warp_and_accumulate_image is equal to adding the warped image");
+  }
   std::cerr << "Tests for class GatedSpatialTransformation::warp_image etc" << std::endl;
   const shared_ptr<VoxelsOnCartesianGrid<float>> new_image_sptr(new_image.clone());
   GatedDiscretisedDensity gated_image(image_sptr, 2);
@@ -174,6 +181,29 @@ warp_imageTests::run_tests()
     check_if_equal(
         accumulated_image[new_indices], 0.F, "testing the accumulated image at the location where the non-zero point had moved");
   }
+  {
+    // the gated versions of warp_image should be consistent with accumulate_warp_image
+    GatedDiscretisedDensity warped_gated_image(gated_image);
+    mvtest.warp_image(warped_gated_image, gated_image);
+    VoxelsOnCartesianGrid<float> sum_of_gates(range, origin, grid_spacing);
+    for (unsigned int gate_num = 1; gate_num <= gate_defs.get_num_gates(); ++gate_num)
+      {
+        check_if_equal(warped_gated_image.get_density(gate_num)[indices], 1.F, "testing warped gated image at original location");
+        sum_of_gates += warped_gated_image.get_density(gate_num);
+      }
+    check_if_equal(sum_of_gates, accumulated_image, "testing sum of warped gates is equal to accumulate_warp_image");
+
+    GatedDiscretisedDensity gated_from_reference(gated_image);
+    mvtest.warp_image(gated_from_reference, image);
+    check_if_equal(gated_from_reference.get_density(1), image, "testing warping reference image to 1st gate (no motion)");
+    check_if_equal(gated_from_reference.get_density(2), warp_image(image_sptr,
+                                                                   reverse_motion2_x_sptr,
+                                                                   reverse_motion2_y_sptr,
+                                                                   reverse_motion2_z_sptr,
+                                                                   BSpline::BSplineType(1),
+                                                                   0),
+                   "testing warping reference image to 2nd gate");
+  }
 }
 END_NAMESPACE_STIR
 
@@ -46,7 +46,8 @@ main(int argc, char** argv)
     {
       cerr << "Usage: " << argv[0] << " out_filename GE_RDF_filename [template_projdata]\n"
            << "The template is used for size- and time-frame-info, but actual counts are ignored.\n"
-           << "If no template is specified, we will use the normal GE sizes and the time frame information of the RDF.\n";
+           << "If no template is specified, we will use the normal GE sizes and the time frame information of the RDF.\n"
+           << "If there is more than 1 time frame, output filenames will be out_filename_f#g1d0b0.\n";
       return EXIT_FAILURE;
     }
 
@@ -76,10 +77,27 @@ main(int argc, char** argv)
       || exam_info_sptr->get_time_frame_definitions().get_duration(1) < .0001)
     error("Missing time-frame information in \"" + template_filename + '\"');
 
-  ProjDataInterfile proj_data(exam_info_sptr, proj_data_info_sptr->create_shared_clone(), output_file_name);
-
   GE::RDF_HDF5::SinglesRatesFromGEHDF5 singles(input_filename);
 
-  randoms_from_singles(proj_data, singles);
+  const TimeFrameDefinitions& frame_defs = exam_info_sptr->get_time_frame_definitions();
+  if (frame_defs.get_num_time_frames() == 1)
+    {
+      ProjDataInterfile proj_data(exam_info_sptr, proj_data_info_sptr->create_shared_clone(), output_file_name);
+      randoms_from_singles(proj_data, singles);
+    }
+  else
+    {
+      // construct all frames at once
+      std::vector<shared_ptr<ProjData>> proj_datas;
+      for (unsigned int frame_num = 1; frame_num <= frame_defs.get_num_time_frames(); ++frame_num)
+        {
+          auto frame_exam_info_sptr = std::make_shared<ExamInfo>(*exam_info_sptr);
+          frame_exam_info_sptr->set_time_frame_definitions(TimeFrameDefinitions(frame_defs, frame_num));
+          const std::string frame_output_file_name = output_file_name + "_f" + std::to_string(frame_num) + "g1d0b0";
+          proj_datas.push_back(
+              std::make_shared<ProjDataInterfile>(frame_exam_info_sptr, proj_data_info_sptr, frame_output_file_name));
+        }
+      randoms_from_singles(proj_datas, singles);
+    }
   return EXIT_SUCCESS;
 }
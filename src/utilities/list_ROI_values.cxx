@@ -41,7 +41,7 @@
   \author Kris Thielemans
 */
 #include "stir/utilities.h"
-#include "stir/evaluation/compute_ROI_values.h"
+#include "stir/evaluation/DiscretisedROIs.h"
 #include "stir/Shape/DiscretisedShape3D.h"
 #include "stir/VoxelsOnCartesianGrid.h"
 #include "stir/DataProcessor.h"
@@ -248,20 +248,27 @@ main(int argc, char* argv[])
     out << std::setw(15) << "Volume";
   out << '\n';
   {
-    std::vector<shared_ptr<Shape3D>>::const_iterator current_shape_iter = parameters.shape_ptrs.begin();
-    std::vector<std::string>::const_iterator current_name_iter = parameters.shape_names.begin();
-    for (; current_shape_iter != parameters.shape_ptrs.end(); ++current_shape_iter, ++current_name_iter)
+    // discretise all ROIs once, and compute values for all of them in a single pass over the image
+    const DiscretisedROIs ROIs(parameters.shape_ptrs, *image_ptr, parameters.num_samples);
+    std::vector<VectorWithOffset<ROIValues>> values_per_plane;
+    std::vector<ROIValues> total_values;
+    if (by_plane)
+      ROIs.compute_ROI_values_per_plane(values_per_plane, *image_ptr);
+    else
+      ROIs.compute_total_ROI_values(total_values, *image_ptr);
+
+    for (std::size_t roi_num = 0; roi_num < parameters.shape_names.size(); ++roi_num)
       {
+        const std::string& current_name = parameters.shape_names[roi_num];
         if (by_plane)
           {
-            VectorWithOffset<ROIValues> values;
-            compute_ROI_values_per_plane(values, *image_ptr, **current_shape_iter, parameters.num_samples);
+            const VectorWithOffset<ROIValues>& values = values_per_plane[roi_num];
 
             for (int i = min_plane_number; i <= max_plane_number; i++)
               {
                 if (do_filename)
                   out << std::setw(15) << input_file;
-                out << std::setw(15) << *current_name_iter << std::setw(10) << i + 1 << std::setw(15) << values[i].get_mean()
+                out << std::setw(15) << current_name << std::setw(10) << i + 1 << std::setw(15) << values[i].get_mean()
                     << std::setw(15) << values[i].get_stddev();
                 if (do_max)
                   out << std::setw(15) << values[i].get_max();
@@ -276,12 +283,10 @@ main(int argc, char* argv[])
           }
         if (!by_plane)
           {
-            ROIValues values;
-            values = compute_total_ROI_values(*image_ptr, **current_shape_iter, parameters.num_samples);
+            const ROIValues& values = total_values[roi_num];
             if (do_filename)
               out << std::setw(15) << input_file;
-            out << std::setw(15) << *current_name_iter << std::setw(15) << values.get_mean() << std::setw(15)
-                << values.get_stddev();
+            out << std::setw(15) << current_name << std::setw(15) << values.get_mean() << std::setw(15) << values.get_stddev();
             if (do_max)
               out << std::setw(15) << values.get_max();
             if (do_min)
@@ -292,14 +297,6 @@ main(int argc, char* argv[])
               out << std::setw(15) << values.get_roi_volume();
             out << '\n';
           }
-#if 0
-    for (VectorWithOffset<ROIValues>::const_iterator iter = values.begin();
-         iter != values.end();
-         iter++)
-      {
-        std::cout << iter->report();
-      }
-#endif
       }
   }
 
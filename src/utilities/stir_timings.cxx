@@ -1,5 +1,5 @@
 /*
-    Copyright (C) 2023, 2024 University College London
+    Copyright (C) 2023, 2024, 2026 University College London
     This file is part of STIR.
 
     SPDX-License-Identifier: Apache-2.0
@@ -20,6 +20,10 @@
 
   Run the utility without any arguments to get a help message.
   If you want to know what is actually timed, you will have to look at the source code.
+
+  Instead of a template, the utility can construct a synthetic template (and a phantom) of a
+  given size, such that timings can be compared between machines and STIR versions. It can also
+  loop over a number of OpenMP threads, and write all results (including throughput) to a JSON file.
 */
 
 #include "stir/KeyParser.h"
@@ -29,6 +33,12 @@
 #include "stir/VoxelsOnCartesianGrid.h"
 #include "stir/IO/read_from_file.h"
 #include "stir/IO/write_to_file.h"
+#include "stir/Scanner.h"
+#include "stir/ProjDataInfoCylindricalNoArcCorr.h"
+#include "stir/ProjDataInfoGenericNoArcCorr.h"
+#include "stir/DetectionPositionPair.h"
+#include "stir/Bin.h"
+#include "stir/Succeeded.h"
 #ifndef MINI_STIR
 #  include "stir/recon_buildblock/ProjectorByBinPairUsingProjMatrixByBin.h"
 #endif
@@ -39,6 +49,12 @@
 #  include "stir/recon_buildblock/ProjMatrixByBinUsingRayTracing.h"
 #  include "stir/recon_buildblock/PoissonLogLikelihoodWithLinearModelForMeanAndProjData.h"
 #  include "stir/recon_buildblock/RelativeDifferencePrior.h"
+#  include "stir/recon_buildblock/QuadraticPrior.h"
+#  include "stir/recon_buildblock/BinNormalisationFromProjData.h"
+#  include "stir/analytic/FBP2D/FBP2DReconstruction.h"
+#  include "stir/scatter/SingleScatterSimulation.h"
+#  include "stir/Shape/EllipsoidalCylinder.h"
+#  include "stir/Shape/Ellipsoid.h"
 #  ifdef STIR_WITH_CUDA
 #    include "stir/recon_buildblock/CUDA/CudaRelativeDifferencePrior.h"
 #  endif
@@ -50,22 +66,41 @@
 #include "stir/num_threads.h"
 #include "stir/Verbosity.h"
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <cstdlib>
 #include <iomanip>
 #include <chrono>
 #include <thread>
+#include <random>
+#include <cmath>
 
 static void
 print_usage_and_exit()
 {
-  std::cerr << "\nUsage:\nstir_timings [--name some_string] [--threads num_threads] [--runs num_runs]\\\n"
+  std::cerr << "\nUsage:\nstir_timings [--name some_string] [--threads num_threads[,num_threads...]] [--runs num_runs]\\\n"
             << "\t[--skip-BB 1] [--skip-PP 1] [--skip-PMRT 1] [--skip-priors 1]\\\n"
+            << "\t[--skip-LM 1] [--skip-FBP 1] [--skip-scatter 1] [--skip-norm 1]\\\n"
             << "\t[--projector_par_filename parfile]\\\n"
             << "\t[--image image_filename]\\\n"
-            << "\t--template-projdata template_proj_data_filename\n\n"
-            << "skip BB: basic building blocks; PP: Parallelproj; PMRT: ray-tracing matrix; priors: prior timing\n\n"
+            << "\t[--json json_output_filename]\\\n"
+            << "\t{--template-projdata template_proj_data_filename | --synthetic small|medium|large [--TOF 1] [--blocks 1]}\n\n"
+            << "skip BB: basic building blocks; PP: Parallelproj; PMRT: ray-tracing matrix; priors: prior timing\n"
+            << "     LM: histogramming of (list-mode) events; FBP: FBP2D; scatter: single scatter simulation;\n"
+            << "     norm: normalisation\n\n"
+            << "--synthetic constructs the template (and a phantom) instead of reading it:\n"
+            << "   small:  8 rings, max ring difference 3, view mashing 4\n"
+            << "   medium: 16 rings, max ring difference 7, view mashing 2\n"
+            << "   large:  all rings and ring differences, no mashing (needs several GB of memory)\n"
+            << "The scanner is the E962, the Discovery 690 for --TOF 1 (with a TOF mashing factor of 11),\n"
+            << "or the SAFIR dual-ring prototype for --blocks 1 (with BlocksOnCylindrical geometry, all rings\n"
+            << "and no mashing).\n\n"
+            << "Note that PMRT (with caching) needs a lot of memory for BlocksOnCylindrical scanners.\n"
+            << "When a list of numbers of threads is given, all timings are repeated for each of them.\n\n"
             << "Timings are reported to stdout as:\n"
-            << "name\ttiming_name\tCPU_time_in_ms\twall-clock_time_in_ms\n";
+            << "name\ttiming_name\tCPU_time_in_ms\twall-clock_time_in_ms\tnum_threads\tthroughput\n"
+            << "where throughput is given in voxels/s, bins/s or events/s (or - when not relevant).\n"
+            << "The JSON file contains the same information, and the configuration.\n";
   std::cerr << "\nExample projector-pair par-file (the following corresponds to the PMRT configuration normally used)\n"
             << "projector pair parameters:=\n"
             << "   type := Matrix\n"
@@ -82,20 +117,106 @@ print_usage_and_exit()
 
 START_NAMESPACE_STIR
 
+//! Construct a template for the synthetic benchmarks
+/*! \a size has to be \c small, \c medium or \c large. See print_usage_and_exit() for what this means.
+    Data are not allocated. */
+static shared_ptr<ProjData>
+construct_synthetic_template(const std::string& size, const bool TOF, const bool blocks)
+{
+  if (TOF && blocks)
+    error("stir_timings: synthetic TOF data is currently not supported for BlocksOnCylindrical scanners");
+
+  shared_ptr<Scanner> scanner_sptr(
+      new Scanner(blocks ? Scanner::SAFIRDualRingPrototype : (TOF ? Scanner::Discovery690 : Scanner::E962)));
+  int num_rings = scanner_sptr->get_num_rings();
+  int max_ring_diff = num_rings - 1;
+  int view_mashing = 1;
+  if (size == "small")
+    {
+      num_rings = std::min(num_rings, 8);
+      max_ring_diff = 3;
+      view_mashing = 4;
+    }
+  else if (size == "medium")
+    {
+      num_rings = std::min(num_rings, 16);
+      max_ring_diff = 7;
+      view_mashing = 2;
+    }
+  else if (size != "large")
+    error("stir_timings: --synthetic should be small, medium or large, but is " + size);
+
+  // the geometry of BlocksOnCylindrical scanners is determined by the blocks, so we keep all rings.
+  // View mashing is not supported for these scanners either.
+  if (blocks)
+    view_mashing = 1;
+  else
+    scanner_sptr->set_num_rings(num_rings);
+  max_ring_diff = std::min(max_ring_diff, scanner_sptr->get_num_rings() - 1);
+  // needed for the scatter simulation
+  if (!scanner_sptr->has_energy_information())
+    {
+      scanner_sptr->set_reference_energy(511);
+      scanner_sptr->set_energy_resolution(0.34F);
+    }
+  scanner_sptr->set_up();
+
+  shared_ptr<ProjDataInfo> proj_data_info_sptr(
+      ProjDataInfo::construct_proj_data_info(scanner_sptr,
+                                             /*span*/ 1,
+                                             max_ring_diff,
+                                             scanner_sptr->get_num_detectors_per_ring() / 2 / view_mashing,
+                                             scanner_sptr->get_max_num_non_arccorrected_bins(),
+                                             /* arc_corrected*/ false,
+                                             /* tof_mashing*/ TOF ? 11 : 0));
+  auto exam_info_sptr = std::make_shared<ExamInfo>(ImagingModality::PT);
+  exam_info_sptr->set_low_energy_thres(450);
+  exam_info_sptr->set_high_energy_thres(650);
+  return std::make_shared<ProjDataInMemory>(exam_info_sptr, proj_data_info_sptr, /* initialise*/ false);
+}
+
 class Timings : public TimedObject
 {
   typedef void (Timings::*TimedFunction)();
 
 public:
+  //! Result of a single timing, as written to the JSON file
+  struct Result
+  {
+    int num_threads;
+    std::string item;
+    unsigned runs;
+    double CPU_time_in_ms;
+    double wall_clock_time_in_ms;
+    //! number of voxels, bins or events processed per second (or 0 if not relevant)
+    double throughput;
+    std::string throughput_unit;
+  };
+
   //! Use as prefix for all output
   std::string name;
+  //! description of the template (only for output)
+  std::string template_description;
   // variables that select timings
-  bool skip_BB;     //! skip basic building blocks
-  bool skip_PMRT;   //! skip ProjMatrixByBinUsingRayTracing
-  bool skip_PP;     //! skip Parallelproj
-  bool skip_priors; //! skip GeneralisedPrior
+  bool skip_BB;      //! skip basic building blocks
+  bool skip_PMRT;    //! skip ProjMatrixByBinUsingRayTracing
+  bool skip_PP;      //! skip Parallelproj
+  bool skip_priors;  //! skip GeneralisedPrior
+  bool skip_LM;      //! skip histogramming of events
+  bool skip_FBP;     //! skip FBP2DReconstruction
+  bool skip_scatter; //! skip SingleScatterSimulation
+  bool skip_norm;    //! skip BinNormalisationFromProjData
+  //! if true, the image is replaced by a phantom (otherwise it is uniform)
+  bool use_phantom;
+  //! number of threads used (only for output)
+  int num_threads;
+  //! all results up to now
+  std::vector<Result> results;
   // variables used for running timings
+  shared_ptr<VoxelsOnCartesianGrid<float>> input_image_sptr;
   shared_ptr<VoxelsOnCartesianGrid<float>> image_sptr;
+  //! a cylinder with a hot ellipsoid, used for the priors and scatter simulation
+  shared_ptr<VoxelsOnCartesianGrid<float>> phantom_sptr;
   shared_ptr<ProjData> output_proj_data_sptr;
   shared_ptr<ProjDataInMemory> mem_proj_data_sptr;
   shared_ptr<ProjDataInMemory> mem_proj_data_sptr2;
@@ -104,6 +225,7 @@ public:
   shared_ptr<ProjectorByBinPair> projectors_sptr;
 #ifndef MINI_STIR
   shared_ptr<ProjectorByBinPairUsingProjMatrixByBin> pmrt_projectors_sptr;
+  shared_ptr<ProjectorByBinPairUsingProjMatrixByBin> pmrt_no_cache_projectors_sptr;
 #endif
 #ifdef STIR_WITH_Parallelproj_PROJECTOR
   shared_ptr<ProjectorByBinPairUsingParallelproj> parallelproj_projectors_sptr;
@@ -115,21 +237,52 @@ public:
   shared_ptr<PoissonLogLikelihoodWithLinearModelForMeanAndProjData<DiscretisedDensity<3, float>>> objective_function_sptr;
 
   shared_ptr<GeneralisedPrior<DiscretisedDensity<3, float>>> prior_sptr;
+  shared_ptr<BinNormalisation> normalisation_sptr;
+  shared_ptr<SingleScatterSimulation> scatter_simulation_sptr;
 #endif
+  //! detection position pairs used for histogramming
+  std::vector<DetectionPositionPair<>> det_pos_pairs;
+
   // basic methods
   Timings(const std::string& image_filename, const std::string& template_proj_data_filename)
+      : skip_BB(false),
+        skip_PMRT(false),
+        skip_PP(false),
+        skip_priors(false),
+        skip_LM(false),
+        skip_FBP(false),
+        skip_scatter(false),
+        skip_norm(false),
+        use_phantom(false),
+        num_threads(get_default_num_threads())
   {
     if (!image_filename.empty())
-      this->image_sptr = read_from_file<VoxelsOnCartesianGrid<float>>(image_filename);
+      this->input_image_sptr = read_from_file<VoxelsOnCartesianGrid<float>>(image_filename);
 
     if (!template_proj_data_filename.empty())
       this->template_proj_data_sptr = ProjData::read_from_file(template_proj_data_filename);
   }
 
-  void run_it(TimedFunction f, const std::string& item, const unsigned runs = 1);
+  //! time \a runs calls of \a f, where every call processes \a work voxels, bins or events (as given by \a unit)
+  void run_it(TimedFunction f,
+              const std::string& item,
+              const unsigned runs = 1,
+              const double work = 0.,
+              const std::string& unit = std::string());
   void run_projectors(const std::string& prefix, const shared_ptr<ProjectorByBinPair> proj_sptr, const unsigned runs);
   void run_all(const unsigned runs = 1);
   void init();
+  //! write configuration and all results in JSON format
+  void write_json(std::ostream& s, const unsigned runs) const;
+
+  double num_voxels() const
+  {
+    return static_cast<double>(this->image_sptr->size_all());
+  }
+  double num_bins() const
+  {
+    return static_cast<double>(this->template_proj_data_sptr->size_all());
+  }
 
   // functions that are timed
 
@@ -281,31 +434,103 @@ public:
 
   void prior_grad()
   {
-    auto im = this->image_sptr->clone();
-    this->prior_sptr->compute_gradient(*im, *this->image_sptr);
+    auto im = this->phantom_sptr->clone();
+    this->prior_sptr->compute_gradient(*im, *this->phantom_sptr);
     delete im;
   }
 
   void prior_value()
   {
-    auto im = this->image_sptr->clone();
-    auto v = this->prior_sptr->compute_value(*this->image_sptr);
+    auto im = this->phantom_sptr->clone();
+    auto v = this->prior_sptr->compute_value(*this->phantom_sptr);
     v += 2; // to avoid compiler warning about unused variable
     delete im;
   }
+
+  //! FBP2D of mem_proj_data_sptr2 (including its set-up)
+  void FBP2D()
+  {
+    FBP2DReconstruction recon(this->mem_proj_data_sptr2);
+    shared_ptr<DiscretisedDensity<3, float>> target_sptr(this->image_sptr->get_empty_copy());
+    recon.set_up(target_sptr);
+    recon.reconstruct(target_sptr);
+  }
+
+  void normalisation_apply()
+  {
+    this->normalisation_sptr->apply(*this->mem_proj_data_sptr);
+  }
+
+  //! construct the scatter simulation object for the phantom, including downsampling
+  void scatter_set_up()
+  {
+    this->scatter_simulation_sptr = std::make_shared<SingleScatterSimulation>();
+    this->scatter_simulation_sptr->set_exam_info(*this->exam_info_sptr);
+    this->scatter_simulation_sptr->set_template_proj_data_info(*this->template_proj_data_sptr->get_proj_data_info_sptr());
+    this->scatter_simulation_sptr->set_activity_image_sptr(this->phantom_sptr);
+    shared_ptr<VoxelsOnCartesianGrid<float>> density_sptr(this->phantom_sptr->clone());
+    // attenuation coefficient of water
+    *density_sptr *= 9.687E-02F;
+    this->scatter_simulation_sptr->set_density_image_sptr(density_sptr);
+    this->scatter_simulation_sptr->downsample_scanner();
+    this->scatter_simulation_sptr->set_output_proj_data_sptr(std::make_shared<ProjDataInMemory>(
+        this->exam_info_sptr, this->scatter_simulation_sptr->get_template_proj_data_info_sptr()));
+    this->scatter_simulation_sptr->set_up();
+  }
+
+  void scatter_simulation()
+  {
+    this->scatter_simulation_sptr->process_data();
+  }
 #endif
+
+  //! add one count for every detection position pair to mem_proj_data_sptr2, as when histogramming list-mode data
+  void histogram_events()
+  {
+    const ProjDataInfo& proj_data_info = *this->mem_proj_data_sptr2->get_proj_data_info_sptr();
+    const auto cylindrical_info_ptr = dynamic_cast<const ProjDataInfoCylindricalNoArcCorr*>(&proj_data_info);
+    const auto generic_info_ptr = dynamic_cast<const ProjDataInfoGenericNoArcCorr*>(&proj_data_info);
+    Bin bin;
+    for (const auto& det_pos_pair : this->det_pos_pairs)
+      {
+        const Succeeded success = cylindrical_info_ptr ? cylindrical_info_ptr->get_bin_for_det_pos_pair(bin, det_pos_pair)
+                                                       : generic_info_ptr->get_bin_for_det_pos_pair(bin, det_pos_pair);
+        if (success == Succeeded::no || bin.tangential_pos_num() < proj_data_info.get_min_tangential_pos_num()
+            || bin.tangential_pos_num() > proj_data_info.get_max_tangential_pos_num()
+            || bin.timing_pos_num() < proj_data_info.get_min_tof_pos_num()
+            || bin.timing_pos_num() > proj_data_info.get_max_tof_pos_num())
+          continue;
+        bin.set_bin_value(this->mem_proj_data_sptr2->get_bin_value(bin) + 1);
+        this->mem_proj_data_sptr2->set_bin_value(bin);
+      }
+  }
 };
 
 void
-Timings::run_it(TimedFunction f, const std::string& item, const unsigned runs)
+Timings::run_it(TimedFunction f, const std::string& item, const unsigned runs, const double work, const std::string& unit)
 {
   this->start_timers(true);
   for (unsigned r = runs; r != 0; --r)
     (this->*f)();
   this->stop_timers();
+  Result result;
+  result.num_threads = this->num_threads;
+  result.item = item;
+  result.runs = runs;
+  result.CPU_time_in_ms = this->get_CPU_timer_value() / runs * 1000;
+  result.wall_clock_time_in_ms = this->get_wall_clock_timer_value() / runs * 1000;
+  result.throughput = (work > 0 && result.wall_clock_time_in_ms > 0) ? work / result.wall_clock_time_in_ms * 1000 : 0.;
+  result.throughput_unit = result.throughput > 0 ? unit : std::string();
+  this->results.push_back(result);
+
   std::cout << name << '\t' << std::setw(32) << std::left << item << '\t' << std::fixed << std::setprecision(3) << std::setw(24)
-            << std::right << this->get_CPU_timer_value() / runs * 1000 << '\t' << std::fixed << std::setprecision(3)
-            << std::setw(24) << std::right << this->get_wall_clock_timer_value() / runs * 1000 << std::endl;
+            << std::right << result.CPU_time_in_ms << '\t' << std::fixed << std::setprecision(3) << std::setw(24) << std::right
+            << result.wall_clock_time_in_ms << '\t' << std::setw(4) << this->num_threads << '\t';
+  if (result.throughput > 0)
+    std::cout << std::scientific << std::setprecision(4) << result.throughput << ' ' << unit;
+  else
+    std::cout << '-';
+  std::cout << std::endl;
 }
 
 void
@@ -313,16 +538,16 @@ Timings::run_projectors(const std::string& prefix, const shared_ptr<ProjectorByB
 {
   this->projectors_sptr = proj_sptr;
   this->run_it(&Timings::projector_setup, prefix + "_projector_setup", 1);
-  this->run_it(&Timings::forward_file, prefix + "_forward_file_first", 1);
-  this->run_it(&Timings::forward_file, prefix + "_forward_file", runs);
-  this->run_it(&Timings::forward_memory, prefix + "_forward_memory", runs);
-  this->run_it(&Timings::back_file, prefix + "_back_file_first", 1);
-  this->run_it(&Timings::back_file, prefix + "_back_file", runs);
-  this->run_it(&Timings::back_memory, prefix + "_back_memory", runs);
+  this->run_it(&Timings::forward_file, prefix + "_forward_file_first", 1, this->num_bins(), "bins/s");
+  this->run_it(&Timings::forward_file, prefix + "_forward_file", runs, this->num_bins(), "bins/s");
+  this->run_it(&Timings::forward_memory, prefix + "_forward_memory", runs, this->num_bins(), "bins/s");
+  this->run_it(&Timings::back_file, prefix + "_back_file_first", 1, this->num_bins(), "bins/s");
+  this->run_it(&Timings::back_file, prefix + "_back_file", runs, this->num_bins(), "bins/s");
+  this->run_it(&Timings::back_memory, prefix + "_back_memory", runs, this->num_bins(), "bins/s");
 #ifndef MINI_STIR
   this->objective_function_sptr->set_projector_pair_sptr(this->projectors_sptr);
   this->run_it(&Timings::obj_func_set_up, prefix + "_LogLik set_up", 1);
-  this->run_it(&Timings::obj_func_grad_no_sens, prefix + "_LogLik grad_no_sens", 1);
+  this->run_it(&Timings::obj_func_grad_no_sens, prefix + "_LogLik grad_no_sens", 1, this->num_bins(), "bins/s");
 #endif
 }
 void
@@ -331,30 +556,68 @@ Timings::run_all(const unsigned runs)
   this->init();
   // this->run_it(&Timings::sleep, "sleep", runs*1);
   this->output_proj_data_sptr->fill(1.F);
+  const ProjDataInfo* const proj_data_info_ptr = this->template_proj_data_sptr->get_proj_data_info_sptr().get();
+  const bool is_cylindrical = dynamic_cast<const ProjDataInfoCylindrical*>(proj_data_info_ptr) != nullptr;
+  // histogramming needs conversion from detection positions to bins
+  const bool has_detection_positions = dynamic_cast<const ProjDataInfoCylindricalNoArcCorr*>(proj_data_info_ptr) != nullptr
+                                       || dynamic_cast<const ProjDataInfoGenericNoArcCorr*>(proj_data_info_ptr) != nullptr;
+  const bool is_TOF = proj_data_info_ptr->is_tof_data();
   if (!this->skip_BB)
     {
       this->mem_proj_data_sptr2
           = std::make_shared<ProjDataInMemory>(this->exam_info_sptr, this->template_proj_data_sptr->get_proj_data_info_sptr());
       this->v1.resize(this->template_proj_data_sptr->size_all());
       this->v2.resize(this->template_proj_data_sptr->size_all());
-      this->run_it(&Timings::copy_image, "copy_image", runs * 20);
-      this->run_it(&Timings::copy_add_image, "copy_add_image", runs * 20);
-      this->run_it(&Timings::copy_mult_image, "copy_mult_image", runs * 20);
+      this->run_it(&Timings::copy_image, "copy_image", runs * 20, this->num_voxels(), "voxels/s");
+      this->run_it(&Timings::copy_add_image, "copy_add_image", runs * 20, this->num_voxels(), "voxels/s");
+      this->run_it(&Timings::copy_mult_image, "copy_mult_image", runs * 20, this->num_voxels(), "voxels/s");
       // reference timings: std::vector should be fast
       this->run_it(&Timings::create_std_vector, "create_vector_of_size_projdata", runs * 2);
-      this->run_it(&Timings::copy_std_vector, "copy_std_vector_of_size_projdata", runs * 2);
+      this->run_it(&Timings::copy_std_vector, "copy_std_vector_of_size_projdata", runs * 2, this->num_bins(), "bins/s");
       v1.clear();
       v2.clear();
       this->run_it(&Timings::create_proj_data_in_mem_no_init, "create_proj_data_in_mem_no_init", runs * 2);
-      this->run_it(&Timings::create_proj_data_in_mem_init, "create_proj_data_in_mem_init", runs * 2);
-      this->run_it(&Timings::copy_only_proj_data_mem_to_mem, "copy_proj_data_mem_to_mem", runs * 2);
-      this->run_it(&Timings::copy_proj_data_mem_to_mem, "create_copy_proj_data_mem_to_mem", runs * 2);
+      this->run_it(&Timings::create_proj_data_in_mem_init, "create_proj_data_in_mem_init", runs * 2, this->num_bins(), "bins/s");
+      this->run_it(&Timings::copy_only_proj_data_mem_to_mem, "copy_proj_data_mem_to_mem", runs * 2, this->num_bins(), "bins/s");
+      this->run_it(
+          &Timings::copy_proj_data_mem_to_mem, "create_copy_proj_data_mem_to_mem", runs * 2, this->num_bins(), "bins/s");
       this->mem_proj_data_sptr2.reset(); // no longer used
-      this->run_it(&Timings::copy_proj_data_mem_to_file, "create_copy_proj_data_mem_to_file", runs * 2);
-      this->run_it(&Timings::copy_proj_data_file_to_mem, "create_copy_proj_data_file_to_mem", runs * 2);
-      this->run_it(&Timings::copy_proj_data_file_to_file, "create_copy_proj_data_file_to_file", runs * 2);
-      this->run_it(&Timings::copy_add_proj_data_mem, "copy_add_proj_data_mem", runs * 2);
-      this->run_it(&Timings::copy_mult_proj_data_mem, "copy_mult_proj_data_mem", runs * 2);
+      this->run_it(
+          &Timings::copy_proj_data_mem_to_file, "create_copy_proj_data_mem_to_file", runs * 2, this->num_bins(), "bins/s");
+      this->run_it(
+          &Timings::copy_proj_data_file_to_mem, "create_copy_proj_data_file_to_mem", runs * 2, this->num_bins(), "bins/s");
+      this->run_it(
+          &Timings::copy_proj_data_file_to_file, "create_copy_proj_data_file_to_file", runs * 2, this->num_bins(), "bins/s");
+      this->run_it(&Timings::copy_add_proj_data_mem, "copy_add_proj_data_mem", runs * 2, this->num_bins(), "bins/s");
+      this->run_it(&Timings::copy_mult_proj_data_mem, "copy_mult_proj_data_mem", runs * 2, this->num_bins(), "bins/s");
+    }
+  if (!this->skip_LM && !has_detection_positions)
+    warning("stir_timings: skipping histogramming as it needs non-arc-corrected projection data");
+  if (!this->skip_LM && has_detection_positions)
+    {
+      // random detection position pairs (with a fixed seed such that timings are reproducible)
+      const Scanner& scanner = *proj_data_info_ptr->get_scanner_ptr();
+      std::mt19937 generator(42);
+      std::uniform_int_distribution<int> det_distribution(0, scanner.get_num_detectors_per_ring() - 1);
+      std::uniform_int_distribution<int> ring_distribution(0, scanner.get_num_rings() - 1);
+      const int max_timing_pos = is_TOF ? scanner.get_max_num_timing_poss() / 2 : 0;
+      std::uniform_int_distribution<int> timing_pos_distribution(-max_timing_pos, max_timing_pos);
+      this->det_pos_pairs.resize(1000000);
+      for (auto& det_pos_pair : this->det_pos_pairs)
+        {
+          const DetectionPosition<> pos1(det_distribution(generator), ring_distribution(generator));
+          const DetectionPosition<> pos2(det_distribution(generator), ring_distribution(generator));
+          det_pos_pair = DetectionPositionPair<>(pos1, pos2, timing_pos_distribution(generator));
+        }
+      this->mem_proj_data_sptr2
+          = std::make_shared<ProjDataInMemory>(this->exam_info_sptr, this->template_proj_data_sptr->get_proj_data_info_sptr());
+      this->run_it(&Timings::histogram_events,
+                   "histogram_events",
+                   runs,
+                   static_cast<double>(this->det_pos_pairs.size()),
+                   "events/s");
+      this->mem_proj_data_sptr2.reset();
+      this->det_pos_pairs.clear();
     }
 #ifndef MINI_STIR
   this->objective_function_sptr.reset(new PoissonLogLikelihoodWithLinearModelForMeanAndProjData<DiscretisedDensity<3, float>>);
@@ -363,6 +626,11 @@ Timings::run_all(const unsigned runs)
   if (!this->skip_PMRT)
     {
       this->run_projectors("PMRT", this->pmrt_projectors_sptr, 1);
+      // without caching, every call recomputes the matrix
+      this->projectors_sptr = this->pmrt_no_cache_projectors_sptr;
+      this->run_it(&Timings::projector_setup, "PMRT_no_cache_projector_setup", 1);
+      this->run_it(&Timings::forward_memory, "PMRT_no_cache_forward_memory", 1, this->num_bins(), "bins/s");
+      this->run_it(&Timings::back_memory, "PMRT_no_cache_back_memory", 1, this->num_bins(), "bins/s");
     }
 #endif
 #ifdef STIR_WITH_Parallelproj_PROJECTOR
@@ -382,21 +650,80 @@ Timings::run_all(const unsigned runs)
     {
       {
         this->prior_sptr = std::make_shared<RelativeDifferencePrior<float>>(false, 1.F, 2.F, 0.1F);
-        this->prior_sptr->set_up(this->image_sptr);
-        this->run_it(&Timings::prior_value, "RDP_value", runs * 10);
-        this->run_it(&Timings::prior_grad, "RDP_grad", runs * 10);
+        this->prior_sptr->set_up(this->phantom_sptr);
+        this->run_it(&Timings::prior_value, "RDP_value", runs * 10, this->num_voxels(), "voxels/s");
+        this->run_it(&Timings::prior_grad, "RDP_grad", runs * 10, this->num_voxels(), "voxels/s");
+        this->prior_sptr = nullptr;
+      }
+      {
+        this->prior_sptr = std::make_shared<QuadraticPrior<float>>(false, 1.F);
+        this->prior_sptr->set_up(this->phantom_sptr);
+        this->run_it(&Timings::prior_value, "Quadratic_value", runs * 10, this->num_voxels(), "voxels/s");
+        this->run_it(&Timings::prior_grad, "Quadratic_grad", runs * 10, this->num_voxels(), "voxels/s");
         this->prior_sptr = nullptr;
       }
 #  ifdef STIR_WITH_CUDA
       {
         this->prior_sptr = std::make_shared<CudaRelativeDifferencePrior<float>>(false, 1.F, 2.F, 0.1F);
-        this->prior_sptr->set_up(this->image_sptr);
-        this->run_it(&Timings::prior_value, "Cuda_RDP_value", runs * 30);
-        this->run_it(&Timings::prior_grad, "Cuda_RDP_grad", runs * 30);
+        this->prior_sptr->set_up(this->phantom_sptr);
+        this->run_it(&Timings::prior_value, "Cuda_RDP_value", runs * 30, this->num_voxels(), "voxels/s");
+        this->run_it(&Timings::prior_grad, "Cuda_RDP_grad", runs * 30, this->num_voxels(), "voxels/s");
         this->prior_sptr = nullptr;
       }
 #  endif
     }
+  if (!skip_norm)
+    {
+      auto norm_proj_data_sptr
+          = std::make_shared<ProjDataInMemory>(this->exam_info_sptr, this->template_proj_data_sptr->get_proj_data_info_sptr());
+      norm_proj_data_sptr->fill(1.F);
+      this->normalisation_sptr = std::make_shared<BinNormalisationFromProjData>(norm_proj_data_sptr);
+      this->normalisation_sptr->set_up(this->exam_info_sptr, this->template_proj_data_sptr->get_proj_data_info_sptr());
+      this->run_it(&Timings::normalisation_apply, "normalisation_apply", runs, this->num_bins(), "bins/s");
+      this->normalisation_sptr = nullptr;
+    }
+  // FBP2D and the scatter simulation currently only handle non-TOF data of cylindrical scanners
+  if (!skip_FBP && is_cylindrical && !is_TOF)
+    {
+      // FBP2D cannot handle mashed views (as they have an offset in the angle), so we use direct sinograms without mashing
+      const ProjDataInfo& proj_data_info = *this->template_proj_data_sptr->get_proj_data_info_sptr();
+      shared_ptr<ProjDataInfo> direct_proj_data_info_sptr(
+          ProjDataInfo::construct_proj_data_info(proj_data_info.get_scanner_sptr(),
+                                                 /*span*/ 1,
+                                                 /*max_delta*/ 0,
+                                                 proj_data_info.get_scanner_ptr()->get_num_detectors_per_ring() / 2,
+                                                 proj_data_info.get_num_tangential_poss(),
+                                                 /* arc_corrected*/ false));
+      if (std::fabs(direct_proj_data_info_sptr->get_phi(Bin(0, 0, 0, 0))) > 1.E-4F)
+        warning("stir_timings: skipping FBP2D as it cannot handle scanners with an intrinsic azimuthal tilt");
+      else
+        {
+          this->mem_proj_data_sptr2 = std::make_shared<ProjDataInMemory>(this->exam_info_sptr, direct_proj_data_info_sptr);
+          this->mem_proj_data_sptr2->fill(1.F);
+          this->run_it(&Timings::FBP2D,
+                       "FBP2D_direct_sinograms",
+                       runs,
+                       static_cast<double>(this->mem_proj_data_sptr2->size_all()),
+                       "bins/s");
+          this->mem_proj_data_sptr2.reset();
+        }
+    }
+  if (!skip_scatter && is_cylindrical && !is_TOF)
+    {
+      if (!this->exam_info_sptr->has_energy_information()
+          || !this->template_proj_data_sptr->get_proj_data_info_sptr()->has_energy_information())
+        warning("stir_timings: skipping scatter simulation as there is no energy information");
+      else
+        {
+          this->run_it(&Timings::scatter_set_up, "scatter_set_up", 1);
+          this->run_it(&Timings::scatter_simulation,
+                       "scatter_simulation",
+                       runs,
+                       static_cast<double>(this->scatter_simulation_sptr->get_output_proj_data_sptr()->size_all()),
+                       "bins/s");
+          this->scatter_simulation_sptr = nullptr;
+        }
+    }
 #endif
 }
 
@@ -407,7 +734,7 @@ Timings::init()
   if (!this->template_proj_data_sptr)
     print_usage_and_exit();
 
-  if (!image_sptr)
+  if (!this->input_image_sptr)
     {
       this->exam_info_sptr = this->template_proj_data_sptr->get_exam_info().create_shared_clone();
       this->image_sptr = std::make_shared<VoxelsOnCartesianGrid<float>>(
@@ -416,6 +743,7 @@ Timings::init()
     }
   else
     {
+      this->image_sptr.reset(this->input_image_sptr->clone());
       this->image_sptr->fill(1.F);
       this->exam_info_sptr = this->image_sptr->get_exam_info().create_shared_clone();
 
@@ -437,6 +765,33 @@ Timings::init()
         }
     }
 
+  // phantom set-up
+#ifndef MINI_STIR
+  {
+    this->phantom_sptr.reset(this->image_sptr->get_empty_voxels_on_cartesian_grid());
+    CartesianCoordinate3D<int> min_indices, max_indices;
+    this->phantom_sptr->get_regular_range(min_indices, max_indices);
+    const CartesianCoordinate3D<float> centre((this->phantom_sptr->get_physical_coordinates_for_indices(min_indices)
+                                               + this->phantom_sptr->get_physical_coordinates_for_indices(max_indices))
+                                              / 2.F);
+    const CartesianCoordinate3D<float> image_size
+        = this->phantom_sptr->get_voxel_size() * BasicCoordinate<3, float>(this->phantom_sptr->get_lengths());
+    const CartesianCoordinate3D<int> num_samples(2, 2, 2);
+    EllipsoidalCylinder cylinder(image_size.z() * .8F, image_size.y() * .35F, image_size.x() * .35F, centre);
+    cylinder.construct_volume(*this->phantom_sptr, num_samples);
+    const CartesianCoordinate3D<float> radii(image_size.z() * .2F, image_size.y() * .1F, image_size.x() * .05F);
+    Ellipsoid hot_spot(radii, centre + CartesianCoordinate3D<float>(0.F, 0.F, image_size.x() * .15F));
+    shared_ptr<VoxelsOnCartesianGrid<float>> hot_spot_sptr(this->image_sptr->get_empty_voxels_on_cartesian_grid());
+    hot_spot.construct_volume(*hot_spot_sptr, num_samples);
+    *hot_spot_sptr *= 3.F;
+    *this->phantom_sptr += *hot_spot_sptr;
+  }
+  if (this->use_phantom)
+    *this->image_sptr = *this->phantom_sptr;
+#else
+  this->phantom_sptr = this->image_sptr;
+#endif
+
   // projection data set-up
   {
     std::string output_filename = "my_timings.hs";
@@ -454,6 +809,10 @@ Timings::init()
     auto PM_sptr = std::make_shared<ProjMatrixByBinUsingRayTracing>();
     PM_sptr->set_num_tangential_LORs(5);
     this->pmrt_projectors_sptr = std::make_shared<ProjectorByBinPairUsingProjMatrixByBin>(PM_sptr);
+    auto PM_no_cache_sptr = std::make_shared<ProjMatrixByBinUsingRayTracing>();
+    PM_no_cache_sptr->set_num_tangential_LORs(5);
+    PM_no_cache_sptr->enable_cache(false);
+    this->pmrt_no_cache_projectors_sptr = std::make_shared<ProjectorByBinPairUsingProjMatrixByBin>(PM_no_cache_sptr);
 #endif
 #ifdef STIR_WITH_Parallelproj_PROJECTOR
     this->parallelproj_projectors_sptr = std::make_shared<ProjectorByBinPairUsingParallelproj>();
@@ -461,6 +820,57 @@ Timings::init()
   }
 }
 
+//! quote a string for JSON output
+static std::string
+JSON_string(const std::string& str)
+{
+  std::ostringstream s;
+  s << '"';
+  for (const char c : str)
+    {
+      if (c == '"' || c == '\\')
+        s << '\\' << c;
+      else if (static_cast<unsigned char>(c) < 0x20)
+        s << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+      else
+        s << c;
+    }
+  s << '"';
+  return s.str();
+}
+
+void
+Timings::write_json(std::ostream& s, const unsigned runs) const
+{
+  const ProjDataInfo& proj_data_info = *this->template_proj_data_sptr->get_proj_data_info_sptr();
+  s << "{\n  \"name\": " << JSON_string(this->name) << ",\n  \"STIR_version\": " << JSON_string(STIR_VERSION_STRING)
+    << ",\n  \"OpenMP\": "
+#ifdef STIR_OPENMP
+    << "true"
+#else
+    << "false"
+#endif
+    << ",\n  \"configuration\": {\n    \"template\": " << JSON_string(this->template_description)
+    << ",\n    \"scanner\": " << JSON_string(proj_data_info.get_scanner_ptr()->get_name())
+    << ",\n    \"num_segments\": " << proj_data_info.get_num_segments()
+    << ",\n    \"num_views\": " << proj_data_info.get_num_views()
+    << ",\n    \"num_tangential_poss\": " << proj_data_info.get_num_tangential_poss()
+    << ",\n    \"num_tof_poss\": " << proj_data_info.get_num_tof_poss()
+    << ",\n    \"num_bins\": " << this->template_proj_data_sptr->size_all()
+    << ",\n    \"num_voxels\": " << (this->image_sptr ? this->image_sptr->size_all() : std::size_t(0))
+    << ",\n    \"runs\": " << runs << "\n  },\n  \"results\": [";
+  s << std::setprecision(9);
+  for (std::size_t i = 0; i < this->results.size(); ++i)
+    {
+      const Result& result = this->results[i];
+      s << (i == 0 ? "\n" : ",\n") << "    {\"threads\": " << result.num_threads << ", \"item\": " << JSON_string(result.item)
+        << ", \"runs\": " << result.runs << ", \"cpu_ms\": " << result.CPU_time_in_ms
+        << ", \"wall_ms\": " << result.wall_clock_time_in_ms << ", \"throughput\": " << result.throughput
+        << ", \"throughput_unit\": " << JSON_string(result.throughput_unit) << "}";
+    }
+  s << "\n  ]\n}\n";
+}
+
 END_NAMESPACE_STIR
 
 #ifdef STIR_MPI
@@ -477,13 +887,21 @@ main(int argc, char** argv)
   std::string image_filename;
   std::string template_proj_data_filename;
   std::string projector_par_filename;
+  std::string synthetic_size;
+  std::string json_filename;
   std::string prog_name = argv[0];
   unsigned num_runs = 3;
-  int num_threads = get_default_num_threads();
+  std::vector<int> num_threads_list(1, get_default_num_threads());
   bool skip_BB = false;
   bool skip_PMRT = false;
   bool skip_PP = false;
   bool skip_priors = false;
+  bool skip_LM = false;
+  bool skip_FBP = false;
+  bool skip_scatter = false;
+  bool skip_norm = false;
+  bool TOF = false;
+  bool blocks = false;
   // prefix output with this string
   std::string name;
 
@@ -500,7 +918,18 @@ main(int argc, char** argv)
       else if (!strcmp(argv[0], "--runs"))
         num_runs = std::atoi(argv[1]);
       else if (!strcmp(argv[0], "--threads"))
-        num_threads = std::atoi(argv[1]);
+        {
+          // comma-separated list
+          num_threads_list.clear();
+          std::istringstream list(argv[1]);
+          std::string num_threads;
+          while (std::getline(list, num_threads, ','))
+            {
+              num_threads_list.push_back(std::atoi(num_threads.c_str()));
+              if (num_threads_list.back() <= 0)
+                print_usage_and_exit();
+            }
+        }
       else if (!strcmp(argv[0], "--skip-BB"))
         skip_BB = std::atoi(argv[1]) != 0;
       else if (!strcmp(argv[0], "--skip-PMRT"))
@@ -509,6 +938,22 @@ main(int argc, char** argv)
         skip_PP = std::atoi(argv[1]) != 0;
       else if (!strcmp(argv[0], "--skip-priors"))
         skip_priors = std::atoi(argv[1]) != 0;
+      else if (!strcmp(argv[0], "--skip-LM"))
+        skip_LM = std::atoi(argv[1]) != 0;
+      else if (!strcmp(argv[0], "--skip-FBP"))
+        skip_FBP = std::atoi(argv[1]) != 0;
+      else if (!strcmp(argv[0], "--skip-scatter"))
+        skip_scatter = std::atoi(argv[1]) != 0;
+      else if (!strcmp(argv[0], "--skip-norm"))
+        skip_norm = std::atoi(argv[1]) != 0;
+      else if (!strcmp(argv[0], "--synthetic"))
+        synthetic_size = argv[1];
+      else if (!strcmp(argv[0], "--TOF"))
+        TOF = std::atoi(argv[1]) != 0;
+      else if (!strcmp(argv[0], "--blocks"))
+        blocks = std::atoi(argv[1]) != 0;
+      else if (!strcmp(argv[0], "--json"))
+        json_filename = argv[1];
       else if (!strcmp(argv[0], "--projector_par_filename"))
         projector_par_filename = argv[1];
       else
@@ -517,18 +962,29 @@ main(int argc, char** argv)
       argc -= 2;
     }
 
-  if (argc > 0)
+  if (argc > 0 || num_threads_list.empty())
+    print_usage_and_exit();
+  if (synthetic_size.empty() == template_proj_data_filename.empty())
     print_usage_and_exit();
-
-  set_num_threads(num_threads);
-  std::cerr << "Using " << num_threads << " threads.\n";
 
   Timings timings(image_filename, template_proj_data_filename);
+  if (!synthetic_size.empty())
+    {
+      timings.template_proj_data_sptr = construct_synthetic_template(synthetic_size, TOF, blocks);
+      timings.use_phantom = true;
+      timings.template_description = "synthetic " + synthetic_size + (TOF ? " TOF" : "") + (blocks ? " blocks" : "");
+    }
+  else
+    timings.template_description = template_proj_data_filename;
   timings.name = name;
   timings.skip_BB = skip_BB;
   timings.skip_PMRT = skip_PMRT;
   timings.skip_PP = skip_PP;
   timings.skip_priors = skip_priors;
+  timings.skip_LM = skip_LM;
+  timings.skip_FBP = skip_FBP;
+  timings.skip_scatter = skip_scatter;
+  timings.skip_norm = skip_norm;
   if (!projector_par_filename.empty())
     {
       KeyParser parser;
@@ -539,6 +995,20 @@ main(int argc, char** argv)
         error("Error parsing " + projector_par_filename);
     }
 
-  timings.run_all(num_runs);
+  for (const int num_threads : num_threads_list)
+    {
+      set_num_threads(num_threads);
+      std::cerr << "Using " << num_threads << " threads.\n";
+      timings.num_threads = num_threads;
+      timings.run_all(num_runs);
+    }
+
+  if (!json_filename.empty())
+    {
+      std::ofstream json_file(json_filename.c_str());
+      if (!json_file)
+        error("stir_timings: error opening " + json_filename);
+      timings.write_json(json_file, num_runs);
+    }
   return EXIT_SUCCESS;
 }